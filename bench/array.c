@@ -0,0 +1,129 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/set/array.h>
+
+#include "bench.h"
+
+#define BENCH_VISITS (1 << 25)
+
+/* Search a missing key so every pass scans the whole array, ns per member */
+static double
+bench_search(
+    struct xtnt_node_set *array,
+    xtnt_uint_t count)
+{
+    struct xtnt_node *found = NULL;
+    xtnt_uint_t passes = (count < BENCH_VISITS) ? BENCH_VISITS / count : 1;
+    double start = xtnt_bench_now();
+    for (xtnt_uint_t pass = 0; pass < passes; pass++) {
+        xtnt_array_search(array, count, &found);
+    }
+    return (xtnt_bench_now() - start) * 1e9 / ((double) passes * count);
+}
+
+/* Push count members into an empty keyed array, ns per push */
+static double
+bench_push(
+    struct xtnt_node *nodes,
+    xtnt_uint_t count,
+    size_t reserve)
+{
+    struct xtnt_node_set *array = NULL;
+    double start = 0;
+    xtnt_array_create_mode(0, XTNT_ARRAY_MODE_KEYED, XTNT_SET_LOCK_NONE, &array);
+    start = xtnt_bench_now();
+    xtnt_array_grow_eval(array, reserve);
+    for (xtnt_uint_t idx = 0; idx < count; idx++) {
+        if (xtnt_array_push(array, &(nodes[idx])) != XTNT_ESUCCESS) {
+            fprintf(stderr, "push %llu failed\n", (unsigned long long) idx);
+            exit(1);
+        }
+    }
+    start = (xtnt_bench_now() - start) * 1e9 / count;
+    xtnt_array_destroy(&array);
+    return start;
+}
+
+static struct xtnt_node_set *
+bench_array(
+    struct xtnt_node *nodes,
+    xtnt_uint_t count,
+    xtnt_uint_t mode)
+{
+    struct xtnt_node_set *array = NULL;
+    if (xtnt_array_create_mode(count, mode, XTNT_SET_LOCK_NONE, &array) != XTNT_ESUCCESS) {
+        fprintf(stderr, "array of %llu members failed\n", (unsigned long long) count);
+        exit(1);
+    }
+    for (xtnt_uint_t idx = 0; idx < count; idx++) {
+        xtnt_array_insert(array, &(nodes[idx]), idx);
+    }
+    return array;
+}
+
+int
+main(
+    int argc,
+    char **argv)
+{
+    xtnt_uint_t max = (argc > 1) ? (xtnt_uint_t) strtoull(argv[1], NULL, 10) : 10000000;
+    struct xtnt_node *nodes = malloc(sizeof(struct xtnt_node) * max);
+    struct xtnt_node_set *array = NULL;
+
+    for (xtnt_uint_t idx = 0; idx < max; idx++) {
+        xtnt_node_initialize(&(nodes[idx]), idx, 0, NULL);
+    }
+#if defined(__AVX2__)
+    printf("key column compared with AVX2\n");
+#elif defined(__SSE2__)
+    printf("key column compared with SSE2\n");
+#else
+    printf("key column compared one key at a time\n");
+#endif /* if defined(__AVX2__) */
+    printf("%10s %12s %12s %8s\n", "members", "pointer ns", "keyed ns", "speedup");
+    for (xtnt_uint_t count = 1000; count <= max; count *= 10) {
+        array = bench_array(nodes, count, XTNT_ARRAY_MODE_POINTER);
+        double pointer = bench_search(array, count);
+        xtnt_array_destroy(&array);
+        array = bench_array(nodes, count, XTNT_ARRAY_MODE_KEYED);
+        double keyed = bench_search(array, count);
+        xtnt_array_destroy(&array);
+        printf("%10llu %12.3f %12.3f %7.1fx\n", (unsigned long long) count,
+               pointer, keyed, pointer / keyed);
+    }
+    printf("%10s %12s %12s\n", "members", "grown ns", "reserved ns");
+    for (xtnt_uint_t count = 1000; count <= max; count *= 10) {
+        double grown = bench_push(nodes, count, 0);
+        double reserved = bench_push(nodes, count, count);
+        printf("%10llu %12.3f %12.3f\n", (unsigned long long) count, grown, reserved);
+    }
+    free(nodes);
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#ifndef _XTNT_BENCH_H_
+#define _XTNT_BENCH_H_
+
+#include <extant/common.h>
+
+#include <time.h>
+
+/**
+ * @struct xtnt_bench_thread
+ *
+ * Per thread context handed to a benchmark worker
+ */
+struct xtnt_bench_thread
+{
+    pthread_t thread;
+    pthread_barrier_t *barrier;
+    void (*fn)(struct xtnt_bench_thread *);
+    void *ctx;
+    xtnt_uint_t index;
+    xtnt_uint_t threads;
+};
+
+/**
+ * @brief Monotonic time in seconds
+ */
+static inline double
+xtnt_bench_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}
+
+static void *
+xtnt_bench_start(
+    void *arg)
+{
+    struct xtnt_bench_thread *t = arg;
+    pthread_barrier_wait(t->barrier);
+    t->fn(t);
+    return NULL;
+}
+
+/**
+ * @brief Run `fn` on `threads` threads released together
+ *
+ * @param[in] threads The number of worker threads
+ * @param[in] fn The worker function
+ * @param[in] ctx Context shared by all workers
+ * @return elapsed seconds from release until all workers joined
+ */
+static inline double
+xtnt_bench_run(
+    xtnt_uint_t threads,
+    void (*fn)(struct xtnt_bench_thread *),
+    void *ctx)
+{
+    pthread_barrier_t barrier;
+    struct xtnt_bench_thread *t = calloc(threads, sizeof(struct xtnt_bench_thread));
+    double start;
+    double elapsed;
+    pthread_barrier_init(&barrier, NULL, (unsigned) threads + 1);
+    for (xtnt_uint_t idx = 0; idx < threads; idx++) {
+        t[idx].barrier = &barrier;
+        t[idx].fn = fn;
+        t[idx].ctx = ctx;
+        t[idx].index = idx;
+        t[idx].threads = threads;
+        pthread_create(&(t[idx].thread), NULL, xtnt_bench_start, &(t[idx]));
+    }
+    start = xtnt_bench_now();
+    pthread_barrier_wait(&barrier);
+    for (xtnt_uint_t idx = 0; idx < threads; idx++) {
+        pthread_join(t[idx].thread, NULL);
+    }
+    elapsed = xtnt_bench_now() - start;
+    pthread_barrier_destroy(&barrier);
+    free(t);
+    return elapsed;
+}
+
+#endif /* _XTNT_BENCH_H_ */
@@ -0,0 +1,97 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/set/stack.h>
+
+#include "bench.h"
+
+#define BENCH_NODES (64)
+
+static struct xtnt_node nodes[BENCH_NODES];
+
+/* Push then pop BENCH_NODES nodes per round through the generic API */
+static double
+bench_generic(
+    struct xtnt_node_set *set,
+    xtnt_uint_t rounds)
+{
+    struct xtnt_node *node = NULL;
+    double start = xtnt_bench_now();
+    for (xtnt_uint_t round = 0; round < rounds; round++) {
+        for (xtnt_uint_t idx = 0; idx < BENCH_NODES; idx++) {
+            xtnt_set_push(set, &(nodes[idx]));
+        }
+        for (xtnt_uint_t idx = 0; idx < BENCH_NODES; idx++) {
+            xtnt_set_pop(set, &node);
+        }
+    }
+    return xtnt_bench_now() - start;
+}
+
+/* The same rounds through the typed operations, inlined at the call */
+static double
+bench_typed(
+    struct xtnt_node_set *set,
+    xtnt_uint_t rounds)
+{
+    struct xtnt_node *node = NULL;
+    double start = xtnt_bench_now();
+    for (xtnt_uint_t round = 0; round < rounds; round++) {
+        for (xtnt_uint_t idx = 0; idx < BENCH_NODES; idx++) {
+            xtnt_stack_push(set, &(nodes[idx]));
+        }
+        for (xtnt_uint_t idx = 0; idx < BENCH_NODES; idx++) {
+            xtnt_stack_pop(set, &node);
+        }
+    }
+    return xtnt_bench_now() - start;
+}
+
+int
+main(
+    int argc,
+    char **argv)
+{
+    const char *name[] = { "mutex", "spin", "none" };
+    xtnt_uint_t policy[] = { XTNT_SET_LOCK_MUTEX, XTNT_SET_LOCK_SPIN, XTNT_SET_LOCK_NONE };
+    xtnt_uint_t rounds = (argc > 1) ? (xtnt_uint_t) strtoull(argv[1], NULL, 10) : (1 << 16);
+    double calls = (double) rounds * BENCH_NODES * 2;
+    struct xtnt_node_set set;
+
+    printf("%llu stack calls, ns/call\n", (unsigned long long) calls);
+    printf("%8s %12s %12s\n", "policy", "xtnt_set_*", "xtnt_stack_*");
+    for (xtnt_uint_t p = 0; p < 3; p++) {
+        xtnt_stack_initialize_lock(&set, policy[p]);
+        double generic = bench_generic(&set, rounds);
+        double typed = bench_typed(&set, rounds);
+        printf("%8s %12.2f %12.2f\n", name[p], generic * 1e9 / calls, typed * 1e9 / calls);
+        xtnt_node_set_uninitialize(&set);
+    }
+    return 0;
+}
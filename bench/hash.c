@@ -0,0 +1,129 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/hash.h>
+
+#include "bench.h"
+
+#include <string.h>
+
+#define BENCH_BUCKETS (1024)
+
+/* The string hash xtnt_hash() used before xtnt_hash_bytes() */
+static xtnt_uint_t
+bench_hash_legacy(
+    void *key)
+{
+    const char *s = (const char *) key;
+    xtnt_uint_t sum = 0;
+    for (xtnt_int_t idx = 0; s[idx] != 0; idx++) {
+        if (idx) {
+            sum <<= sizeof(char);
+        }
+        sum ^= (xtnt_int_t) s[idx];
+    }
+    return sum;
+}
+
+/* Chi-squared of keys "<prefix><index><suffix>" over BENCH_BUCKETS buckets */
+static double
+bench_chi(
+    xtnt_uint_t keys,
+    const char *suffix,
+    int legacy)
+{
+    static unsigned int bucket[BENCH_BUCKETS];
+    double expect = (double) keys / BENCH_BUCKETS;
+    double chi = 0.0;
+    char key[256];
+    memset(bucket, 0, sizeof(bucket));
+    for (xtnt_uint_t idx = 0; idx < keys; idx++) {
+        int len = snprintf(key, sizeof(key), "key-%llu%s", (unsigned long long) idx, suffix);
+        uint64_t hash = legacy ? bench_hash_legacy(key) :
+                                 xtnt_hash_bytes(key, (size_t) len, 0);
+        bucket[hash % BENCH_BUCKETS]++;
+    }
+    for (xtnt_uint_t b = 0; b < BENCH_BUCKETS; b++) {
+        chi += ((bucket[b] - expect) * (bucket[b] - expect)) / expect;
+    }
+    return chi;
+}
+
+int
+main(
+    int argc,
+    char **argv)
+{
+    xtnt_uint_t bytes = (argc > 1) ? (xtnt_uint_t) strtoull(argv[1], NULL, 10) : (1 << 26);
+    static const size_t lengths[] = { 8, 16, 32, 64, 256, 4096 };
+    static const char *suffixes[] = { "", "-with-a-common-suffix-of-forty-bytes.." };
+    char *buf = malloc(4097);
+    volatile uint64_t sink = 0;
+    double legacy;
+    double start;
+
+    memset(buf, 'a', 4096);
+    buf[4096] = '\0';
+
+    // Throughput over keys of fixed length
+    printf("%8s %14s %14s %14s\n", "length", "legacy ns", "bytes ns", "bytes GB/s");
+    for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++) {
+        size_t len = lengths[l];
+        xtnt_uint_t rounds = bytes / len;
+        char saved = buf[len];
+        buf[len] = '\0';
+        start = xtnt_bench_now();
+        for (xtnt_uint_t idx = 0; idx < rounds; idx++) {
+            buf[0] = (char) ('a' + (idx & 15));
+            sink += bench_hash_legacy(buf);
+        }
+        legacy = xtnt_bench_now() - start;
+        start = xtnt_bench_now();
+        for (xtnt_uint_t idx = 0; idx < rounds; idx++) {
+            buf[0] = (char) ('a' + (idx & 15));
+            sink += xtnt_hash_bytes(buf, len, 0);
+        }
+        start = xtnt_bench_now() - start;
+        buf[len] = saved;
+        printf("%8zu %14.2f %14.2f %14.2f\n", len,
+               (legacy * 1e9) / rounds, (start * 1e9) / rounds,
+               ((double) rounds * len) / (start * 1e9));
+    }
+
+    // Distribution of sequential keys, lower is more uniform ( ~1023 expected )
+    printf("\n%8s %14s %14s\n", "suffix", "legacy chi2", "bytes chi2");
+    for (size_t s = 0; s < sizeof(suffixes) / sizeof(suffixes[0]); s++) {
+        printf("%8zu %14.1f %14.1f\n", strlen(suffixes[s]),
+               bench_chi(BENCH_BUCKETS * 64, suffixes[s], 1),
+               bench_chi(BENCH_BUCKETS * 64, suffixes[s], 0));
+    }
+
+    free(buf);
+    return (int) (sink & 0);
+}
@@ -0,0 +1,232 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/log.h>
+
+#include "bench.h"
+
+#include <unistd.h>
+
+#define BENCH_MSG_SIZE (64)
+
+struct bench_data
+{
+    double enqueued;
+};
+
+struct bench_sample
+{
+    struct xtnt_logger_entry entry;
+    struct bench_data data;
+    char msg[BENCH_MSG_SIZE];
+};
+
+struct bench_count
+{
+    xtnt_uint_t index;
+};
+
+struct bench_run
+{
+    struct xtnt_logger *logger;
+    xtnt_uint_t count;
+};
+
+static double bench_latency;
+static xtnt_uint_t bench_written;
+
+/* Called by the consumer just before writing, records enqueue to write time */
+static char *
+bench_format(
+    struct xtnt_logger_entry *entry)
+{
+    struct bench_data *data = entry->data;
+    double latency = xtnt_bench_now() - data->enqueued;
+    if (latency > bench_latency) {
+        bench_latency = latency;
+    }
+    snprintf(entry->msg, entry->msg_length, "%.9f\n", latency);
+    __atomic_add_fetch(&bench_written, 1, __ATOMIC_RELEASE);
+    return entry->msg;
+}
+
+/* Formatter for the producer throughput runs */
+static char *
+bench_format_count(
+    struct xtnt_logger_entry *entry)
+{
+    snprintf(entry->msg, entry->msg_length, "%llu\n",
+             (unsigned long long) ((struct bench_count *) entry->data)->index);
+    return entry->msg;
+}
+
+static void
+bench_produce_queue(
+    struct xtnt_bench_thread *t)
+{
+    struct bench_run *run = t->ctx;
+    for (xtnt_uint_t idx = 0; idx < run->count; idx++) {
+        struct xtnt_logger_entry *entry = NULL;
+        xtnt_logger_entry_acquire(run->logger, sizeof(struct bench_count), BENCH_MSG_SIZE,
+                                  bench_format_count, XTNT_LOG_INFO, &entry);
+        ((struct bench_count *) entry->data)->index = idx;
+        xtnt_log(run->logger, entry);
+    }
+}
+
+static void
+bench_produce_record(
+    struct xtnt_bench_thread *t)
+{
+    struct bench_run *run = t->ctx;
+    struct bench_count data;
+    for (xtnt_uint_t idx = 0; idx < run->count; idx++) {
+        data.index = idx;
+        while (xtnt_log_record(run->logger, bench_format_count, XTNT_LOG_INFO,
+                               &data, sizeof(data)) == EAGAIN) {
+            sched_yield();
+        }
+    }
+}
+
+/* Elapsed seconds of `fn` on `threads` producers until the consumer is idle */
+static double
+bench_drained(
+    xtnt_uint_t threads,
+    void (*fn)(struct xtnt_bench_thread *),
+    struct bench_run *run,
+    double *produced)
+{
+    double start = xtnt_bench_now();
+    *produced = xtnt_bench_run(threads, fn, run);
+    while (!__atomic_load_n(&(run->logger->waiting), __ATOMIC_ACQUIRE)) {
+        sched_yield();
+    }
+    return xtnt_bench_now() - start;
+}
+
+static double
+bench_thread_cpu(
+    pthread_t thread)
+{
+    clockid_t clock;
+    struct timespec ts;
+    pthread_getcpuclockid(thread, &clock);
+    clock_gettime(clock, &ts);
+    return (double) ts.tv_sec + ((double) ts.tv_nsec * 1e-9);
+}
+
+int
+main(
+    int argc,
+    char **argv)
+{
+    xtnt_uint_t samples = (argc > 1) ? (xtnt_uint_t) strtoull(argv[1], NULL, 10) : 1000;
+    useconds_t idle_usec = (argc > 2) ? (useconds_t) strtoul(argv[2], NULL, 10) : 500000;
+    xtnt_uint_t threads = (argc > 3) ? (xtnt_uint_t) strtoull(argv[3], NULL, 10) : 4;
+    struct bench_sample *sample = calloc(samples, sizeof(struct bench_sample));
+    struct xtnt_logger *logger = NULL;
+    struct bench_run run;
+    pthread_t consumer;
+    double cpu;
+    double heap;
+    double start;
+    double total = 0.0;
+
+    if (xtnt_logger_create(fopen("/dev/null", "w"), NULL, &logger) != XTNT_ESUCCESS) {
+        fprintf(stderr, "failed to create logger\n");
+        return 1;
+    }
+    pthread_create(&consumer, NULL, (void *) xtnt_logger_process, logger);
+
+    // Idle cost of the consumer with nothing queued
+    usleep(10000);
+    cpu = bench_thread_cpu(consumer);
+    start = xtnt_bench_now();
+    usleep(idle_usec);
+    printf("idle consumer cpu: %.3f%% over %.3fs\n",
+           ((bench_thread_cpu(consumer) - cpu) * 100.0) / (xtnt_bench_now() - start),
+           xtnt_bench_now() - start);
+
+    // Enqueue to write latency, letting the consumer fall asleep between entries
+    for (xtnt_uint_t idx = 0; idx < samples; idx++) {
+        xtnt_logger_entry_initialize(&(sample[idx].entry), &(sample[idx].data),
+                                     sample[idx].msg, BENCH_MSG_SIZE,
+                                     bench_format, XTNT_LOG_INFO);
+        sample[idx].data.enqueued = xtnt_bench_now();
+        xtnt_log(logger, &(sample[idx].entry));
+        while (__atomic_load_n(&bench_written, __ATOMIC_ACQUIRE) <= idx) {
+            ;
+        }
+        total += xtnt_bench_now() - sample[idx].data.enqueued;
+        usleep(100);
+    }
+    printf("enqueue to write latency: avg %.2f us, max %.2f us over %llu entries\n",
+           (total * 1e6) / samples, bench_latency * 1e6,
+           (unsigned long long) samples);
+
+    // Entry allocation, heap entries against entries recycled by the logger
+    start = xtnt_bench_now();
+    for (xtnt_uint_t idx = 0; idx < samples * 100; idx++) {
+        struct xtnt_logger_entry *entry = NULL;
+        xtnt_logger_entry_create(sizeof(struct bench_data), BENCH_MSG_SIZE,
+                                 bench_format, XTNT_LOG_INFO, &entry);
+        xtnt_logger_entry_destroy(&entry);
+    }
+    heap = xtnt_bench_now() - start;
+    start = xtnt_bench_now();
+    for (xtnt_uint_t idx = 0; idx < samples * 100; idx++) {
+        struct xtnt_logger_entry *entry = NULL;
+        xtnt_logger_entry_acquire(logger, sizeof(struct bench_data), BENCH_MSG_SIZE,
+                                  bench_format, XTNT_LOG_INFO, &entry);
+        xtnt_logger_entry_destroy(&entry);
+    }
+    printf("entry create/destroy: heap %.2f ns, recycled %.2f ns\n",
+           (heap * 1e9) / (samples * 100),
+           ((xtnt_bench_now() - start) * 1e9) / (samples * 100));
+
+    // Producer cost, the shared queue against per-thread rings
+    run.logger = logger;
+    run.count = samples * 100;
+    total = bench_drained(threads, bench_produce_queue, &run, &heap);
+    printf("%llu producers, queue: %.2f ns/log produced, %.2f ns/log written\n",
+           (unsigned long long) threads, (heap * 1e9) / run.count,
+           (total * 1e9) / (run.count * threads));
+    total = bench_drained(threads, bench_produce_record, &run, &heap);
+    printf("%llu producers, ring: %.2f ns/log produced, %.2f ns/log written\n",
+           (unsigned long long) threads, (heap * 1e9) / run.count,
+           (total * 1e9) / (run.count * threads));
+
+    xtnt_logger_exit(logger);
+    pthread_join(consumer, NULL);
+    fclose(logger->log);
+    xtnt_logger_destroy(&logger);
+    free(sample);
+    return 0;
+}
@@ -0,0 +1,113 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/memory/pool.h>
+
+#include "bench.h"
+
+#include <string.h>
+
+#define BENCH_BLOCK_SIZE (64)
+#define BENCH_BATCH (8)
+
+struct bench_ctx
+{
+    struct xtnt_memory_object *pool;
+    xtnt_uint_t ops;
+};
+
+static void
+bench_mpool(
+    struct xtnt_bench_thread *t)
+{
+    struct bench_ctx *ctx = t->ctx;
+    void *block[BENCH_BATCH];
+    for (xtnt_uint_t op = 0; op < ctx->ops; op += BENCH_BATCH) {
+        for (xtnt_uint_t idx = 0; idx < BENCH_BATCH; idx++) {
+            if (xtnt_mpool_allocate(ctx->pool, 1, &(block[idx])) != XTNT_ESUCCESS) {
+                fprintf(stderr, "pool exhausted\n");
+                exit(1);
+            }
+            memset(block[idx], (int) idx, sizeof(xtnt_uint_t));
+        }
+        for (xtnt_uint_t idx = 0; idx < BENCH_BATCH; idx++) {
+            xtnt_mpool_deallocate(ctx->pool, &(block[idx]));
+        }
+    }
+}
+
+static void
+bench_malloc(
+    struct xtnt_bench_thread *t)
+{
+    struct bench_ctx *ctx = t->ctx;
+    void *block[BENCH_BATCH];
+    for (xtnt_uint_t op = 0; op < ctx->ops; op += BENCH_BATCH) {
+        for (xtnt_uint_t idx = 0; idx < BENCH_BATCH; idx++) {
+            if ((block[idx] = malloc(BENCH_BLOCK_SIZE)) == NULL) {
+                fprintf(stderr, "malloc failed\n");
+                exit(1);
+            }
+            memset(block[idx], (int) idx, sizeof(xtnt_uint_t));
+        }
+        for (xtnt_uint_t idx = 0; idx < BENCH_BATCH; idx++) {
+            free(block[idx]);
+        }
+    }
+}
+
+int
+main(
+    int argc,
+    char **argv)
+{
+    const xtnt_uint_t threads[] = {1, 4, 16, 64};
+    struct bench_ctx ctx;
+    ctx.ops = (argc > 1) ? (xtnt_uint_t) strtoull(argv[1], NULL, 10) : (1 << 22);
+
+    printf("%8s %16s %16s\n", "threads", "mpool ns/op", "malloc ns/op");
+    for (size_t idx = 0; idx < sizeof(threads) / sizeof(threads[0]); idx++) {
+        xtnt_uint_t count = threads[idx] * (XTNT_MPOOL_MAGAZINE_SIZE + BENCH_BATCH);
+        double pool_time;
+        double malloc_time;
+        double total = (double) ctx.ops * (double) threads[idx];
+        if (xtnt_mpool_create(BENCH_BLOCK_SIZE, count, &(ctx.pool)) != XTNT_ESUCCESS) {
+            fprintf(stderr, "failed to create pool\n");
+            return 1;
+        }
+        pool_time = xtnt_bench_run(threads[idx], bench_mpool, &ctx);
+        xtnt_mpool_destroy(&(ctx.pool));
+        malloc_time = xtnt_bench_run(threads[idx], bench_malloc, &ctx);
+        printf("%8llu %16.2f %16.2f\n",
+               (unsigned long long) threads[idx],
+               (pool_time * 1e9) / total,
+               (malloc_time * 1e9) / total);
+    }
+    return 0;
+}
@@ -0,0 +1,197 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/set/list.h>
+#include <extant/set/list/clist.h>
+
+#include "bench.h"
+
+#define BENCH_LINE (64)
+#define BENCH_VISITS (1 << 24)
+
+/* Cheap key sequence for shuffling */
+static inline xtnt_uint_t
+bench_next(
+    uint64_t *x)
+{
+    *x ^= *x << 13;
+    *x ^= *x >> 7;
+    *x ^= *x << 17;
+    return (xtnt_uint_t) *x;
+}
+
+/* Link order: ascending addresses, or a Fisher-Yates shuffle of them */
+static void
+bench_order(
+    xtnt_uint_t *order,
+    xtnt_uint_t count,
+    int shuffle)
+{
+    uint64_t x = 88172645463325252ULL;
+    for (xtnt_uint_t idx = 0; idx < count; idx++) {
+        order[idx] = idx;
+    }
+    for (xtnt_uint_t idx = count - 1; shuffle && idx > 0; idx--) {
+        xtnt_uint_t swap = bench_next(&x) % (idx + 1);
+        xtnt_uint_t tmp = order[idx];
+        order[idx] = order[swap];
+        order[swap] = tmp;
+    }
+}
+
+/* Search a missing key so every pass walks the whole list, ns per member */
+static double
+bench_list(
+    struct xtnt_node *nodes,
+    const xtnt_uint_t *order,
+    xtnt_uint_t count)
+{
+    struct xtnt_node_set list;
+    struct xtnt_node *found = NULL;
+    xtnt_uint_t passes = BENCH_VISITS / count;
+    xtnt_list_initialize_lock(&list, XTNT_SET_LOCK_NONE);
+    for (xtnt_uint_t idx = count; idx > 0; idx--) {
+        xtnt_node_initialize(&(nodes[order[idx - 1]]), order[idx - 1], 0, NULL);
+        xtnt_list_insert(&list, &(nodes[order[idx - 1]]));
+    }
+    double start = xtnt_bench_now();
+    for (xtnt_uint_t pass = 0; pass < passes; pass++) {
+        xtnt_list_search(&list, count, &found);
+    }
+    double elapsed = xtnt_bench_now() - start;
+    xtnt_node_set_uninitialize(&list);
+    return elapsed * 1e9 / ((double) passes * count);
+}
+
+static double
+bench_clist(
+    struct xtnt_cnode *nodes,
+    const xtnt_uint_t *order,
+    xtnt_uint_t count)
+{
+    struct xtnt_node_set list;
+    struct xtnt_cnode *found = NULL;
+    xtnt_uint_t passes = BENCH_VISITS / count;
+    xtnt_clist_initialize_lock(&list, XTNT_SET_LOCK_NONE);
+    for (xtnt_uint_t idx = count; idx > 0; idx--) {
+        xtnt_cnode_initialize(&(nodes[order[idx - 1]]), order[idx - 1], NULL);
+        xtnt_clist_insert(&list, &(nodes[order[idx - 1]]));
+    }
+    double start = xtnt_bench_now();
+    for (xtnt_uint_t pass = 0; pass < passes; pass++) {
+        xtnt_clist_search(&list, count, &found);
+    }
+    double elapsed = xtnt_bench_now() - start;
+    xtnt_node_set_uninitialize(&list);
+    return elapsed * 1e9 / ((double) passes * count);
+}
+
+/* Scan a table for a missing key: node pointers, then key and value entries */
+static double
+bench_table(
+    struct xtnt_node *nodes,
+    xtnt_uint_t count)
+{
+    struct xtnt_node **table = malloc(sizeof(struct xtnt_node *) * count);
+    xtnt_uint_t passes = BENCH_VISITS / count;
+    volatile xtnt_uint_t hits = 0;
+    for (xtnt_uint_t idx = 0; idx < count; idx++) {
+        table[idx] = &(nodes[idx]);
+    }
+    double start = xtnt_bench_now();
+    for (xtnt_uint_t pass = 0; pass < passes; pass++) {
+        for (xtnt_uint_t idx = 0; idx < count; idx++) {
+            hits += (table[idx]->key == count);
+        }
+    }
+    double elapsed = xtnt_bench_now() - start;
+    free(table);
+    return elapsed * 1e9 / ((double) passes * count);
+}
+
+static double
+bench_entries(
+    xtnt_uint_t count)
+{
+    struct xtnt_entry *table = malloc(sizeof(struct xtnt_entry) * count);
+    xtnt_uint_t passes = BENCH_VISITS / count;
+    volatile xtnt_uint_t hits = 0;
+    for (xtnt_uint_t idx = 0; idx < count; idx++) {
+        table[idx].key = idx;
+        table[idx].value = NULL;
+    }
+    double start = xtnt_bench_now();
+    for (xtnt_uint_t pass = 0; pass < passes; pass++) {
+        for (xtnt_uint_t idx = 0; idx < count; idx++) {
+            hits += (table[idx].key == count);
+        }
+    }
+    double elapsed = xtnt_bench_now() - start;
+    free(table);
+    return elapsed * 1e9 / ((double) passes * count);
+}
+
+int
+main(
+    int argc,
+    char **argv)
+{
+    xtnt_uint_t max = (argc > 1) ? (xtnt_uint_t) strtoull(argv[1], NULL, 10) : (1 << 22);
+    struct xtnt_node *nodes = malloc(sizeof(struct xtnt_node) * max);
+    struct xtnt_cnode *cnodes = malloc(sizeof(struct xtnt_cnode) * max);
+    xtnt_uint_t *order = malloc(sizeof(xtnt_uint_t) * max);
+
+    printf("lines per member walked in address order: xtnt_node %.3f, xtnt_cnode %.3f\n",
+           (double) sizeof(struct xtnt_node) / BENCH_LINE,
+           (double) sizeof(struct xtnt_cnode) / BENCH_LINE);
+    printf("lines per member scanned: node pointer %.3f, xtnt_entry %.3f\n\n",
+           (double) (sizeof(struct xtnt_node *) + sizeof(struct xtnt_node)) / BENCH_LINE,
+           (double) sizeof(struct xtnt_entry) / BENCH_LINE);
+    printf("%10s %8s %10s %10s %10s %10s\n", "members", "order",
+           "list", "clist", "pointers", "entries");
+    for (xtnt_uint_t count = 1024; count <= max; count <<= 4) {
+        for (int shuffle = 0; shuffle < 2; shuffle++) {
+            bench_order(order, count, shuffle);
+            double list = bench_list(nodes, order, count);
+            double clist = bench_clist(cnodes, order, count);
+            if (shuffle) {
+                printf("%10llu %8s %10.2f %10.2f\n", (unsigned long long) count,
+                       "shuffled", list, clist);
+            } else {
+                printf("%10llu %8s %10.2f %10.2f %10.2f %10.2f\n", (unsigned long long) count,
+                       "address", list, clist, bench_table(nodes, count),
+                       bench_entries(count));
+            }
+        }
+    }
+    free(order);
+    free(cnodes);
+    free(nodes);
+    return 0;
+}
@@ -0,0 +1,113 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/set/queue.h>
+
+#include "bench.h"
+
+#define BENCH_BATCH (64)
+
+struct bench_ctx
+{
+    struct xtnt_node_set queue;
+    struct xtnt_node *nodes;
+    xtnt_uint_t ops;
+    xtnt_uint_t batch;
+};
+
+/* Thread 0 consumes every node, batch at a time, the rest produce ops nodes each, batch at a time */
+static void
+bench_queue(
+    struct xtnt_bench_thread *t)
+{
+    struct bench_ctx *ctx = t->ctx;
+    struct xtnt_node *node[BENCH_BATCH];
+    xtnt_uint_t total = ctx->ops * (t->threads - 1);
+    xtnt_uint_t count = 0;
+    if (t->index == 0) {
+        for (xtnt_uint_t popped = 0; popped < total; popped += count) {
+            if (ctx->batch > 1) {
+                xtnt_queue_pop_batch(&(ctx->queue), ctx->batch, node, &count);
+            } else {
+                xtnt_queue_pop(&(ctx->queue), &(node[0]));
+                count = (node[0] != NULL) ? 1 : 0;
+            }
+        }
+    } else {
+        struct xtnt_node *nodes = &(ctx->nodes[(t->index - 1) * ctx->ops]);
+        for (xtnt_uint_t idx = 0; idx < ctx->ops; idx += count) {
+            if (ctx->batch > 1) {
+                count = (ctx->ops - idx < ctx->batch) ? ctx->ops - idx : ctx->batch;
+                for (xtnt_uint_t off = 0; off < count; off++) {
+                    node[off] = &(nodes[idx + off]);
+                }
+                xtnt_queue_push_many(&(ctx->queue), count, node);
+            } else {
+                xtnt_queue_push(&(ctx->queue), &(nodes[idx]));
+                count = 1;
+            }
+        }
+    }
+}
+
+int
+main(
+    int argc,
+    char **argv)
+{
+    const xtnt_uint_t producers[] = {1, 2, 4, 8, 16};
+    const xtnt_uint_t modes[] = {XTNT_QUEUE_MODE_LOCKED, XTNT_QUEUE_MODE_LOCKED, XTNT_QUEUE_MODE_MPSC};
+    const xtnt_uint_t batch[] = {1, BENCH_BATCH, 1};
+    struct bench_ctx ctx;
+    double elapsed[3];
+    ctx.ops = (argc > 1) ? (xtnt_uint_t) strtoull(argv[1], NULL, 10) : (1 << 18);
+
+    printf("%10s %16s %16s %16s\n", "producers", "mutex ns/op", "batch ns/op", "mpsc ns/op");
+    for (size_t idx = 0; idx < sizeof(producers) / sizeof(producers[0]); idx++) {
+        double total = (double) ctx.ops * (double) producers[idx];
+        ctx.nodes = calloc(producers[idx] * ctx.ops, sizeof(struct xtnt_node));
+        if (ctx.nodes == NULL) {
+            fprintf(stderr, "failed to allocate nodes\n");
+            return 1;
+        }
+        for (size_t mode = 0; mode < 3; mode++) {
+            ctx.batch = batch[mode];
+            xtnt_queue_initialize(&(ctx.queue), modes[mode]);
+            elapsed[mode] = xtnt_bench_run(producers[idx] + 1, bench_queue, &ctx);
+            xtnt_node_set_uninitialize(&(ctx.queue));
+        }
+        free(ctx.nodes);
+        printf("%10llu %16.2f %16.2f %16.2f\n",
+               (unsigned long long) producers[idx],
+               (elapsed[0] * 1e9) / total,
+               (elapsed[1] * 1e9) / total,
+               (elapsed[2] * 1e9) / total);
+    }
+    return 0;
+}
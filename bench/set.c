@@ -0,0 +1,134 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/set/array.h>
+#include <extant/set/list.h>
+
+#include "bench.h"
+
+#define BENCH_KEYS (64)
+#define BENCH_WRITE_EVERY (20)
+
+struct bench_ctx
+{
+    struct xtnt_node_set *array;
+    struct xtnt_node_set list;
+    struct xtnt_node nodes[BENCH_KEYS];
+    xtnt_uint_t ops;
+};
+
+/* Cheap per thread key sequence */
+static inline xtnt_uint_t
+bench_next(
+    uint64_t *x)
+{
+    *x ^= *x << 13;
+    *x ^= *x >> 7;
+    *x ^= *x << 17;
+    return (xtnt_uint_t) (*x & (BENCH_KEYS - 1));
+}
+
+/* 1 in BENCH_WRITE_EVERY ops stores a member back in place */
+static void
+bench_array(
+    struct xtnt_bench_thread *t)
+{
+    struct bench_ctx *ctx = t->ctx;
+    struct xtnt_node *node = NULL;
+    uint64_t x = t->index + 1;
+    for (xtnt_uint_t op = 0; op < ctx->ops; op++) {
+        xtnt_uint_t key = bench_next(&x);
+        if (op % BENCH_WRITE_EVERY == 0) {
+            xtnt_array_insert(ctx->array, &(ctx->nodes[key]), key);
+        } else {
+            xtnt_array_search(ctx->array, key, &node);
+        }
+    }
+}
+
+/* 1 in BENCH_WRITE_EVERY ops moves the head back to the head */
+static void
+bench_list(
+    struct xtnt_bench_thread *t)
+{
+    struct bench_ctx *ctx = t->ctx;
+    struct xtnt_node *node = NULL;
+    uint64_t x = t->index + 1;
+    for (xtnt_uint_t op = 0; op < ctx->ops; op++) {
+        xtnt_uint_t key = bench_next(&x);
+        if (op % BENCH_WRITE_EVERY == 0) {
+            xtnt_list_delete(&(ctx->list), 0, &node);
+            node->link[XTNT_NODE_HEAD] = NULL;
+            xtnt_list_insert(&(ctx->list), node);
+        } else {
+            xtnt_list_search(&(ctx->list), key, &node);
+        }
+    }
+}
+
+int
+main(
+    int argc,
+    char **argv)
+{
+    xtnt_uint_t max_threads = (argc > 2) ? (xtnt_uint_t) strtoull(argv[2], NULL, 10) : 64;
+    const char *name[] = { "mutex", "rwlock", "seqlock", "spin", "none" };
+    xtnt_uint_t policy[] = { XTNT_SET_LOCK_MUTEX, XTNT_SET_LOCK_RWLOCK, XTNT_SET_LOCK_SEQLOCK,
+                             XTNT_SET_LOCK_SPIN, XTNT_SET_LOCK_NONE };
+    struct bench_ctx ctx;
+    ctx.ops = (argc > 1) ? (xtnt_uint_t) strtoull(argv[1], NULL, 10) : (1 << 18);
+
+    printf("%d%% writes over %d keys, Mops/s\n", 100 / BENCH_WRITE_EVERY, BENCH_KEYS);
+    printf("%10s %8s %16s %16s\n", "threads", "policy", "array", "list");
+    for (xtnt_uint_t p = 0; p < 5; p++) {
+        xtnt_array_create_lock(BENCH_KEYS, policy[p], &(ctx.array));
+        xtnt_node_set_initialize_lock(&(ctx.list), policy[p]);
+        for (xtnt_uint_t idx = BENCH_KEYS; idx > 0; idx--) {
+            ctx.nodes[idx - 1].key = idx - 1;
+            ctx.nodes[idx - 1].link[XTNT_NODE_HEAD] = NULL;
+            ctx.nodes[idx - 1].link[XTNT_NODE_TAIL] = NULL;
+            xtnt_array_insert(ctx.array, &(ctx.nodes[idx - 1]), idx - 1);
+            xtnt_list_insert(&(ctx.list), &(ctx.nodes[idx - 1]));
+        }
+        for (xtnt_uint_t threads = 1; threads <= max_threads; threads <<= 1) {
+            if (policy[p] == XTNT_SET_LOCK_NONE && threads > 1) {
+                // An unlocked set is confined to one thread
+                break;
+            }
+            double total = (double) ctx.ops * (double) threads;
+            double array = xtnt_bench_run(threads, bench_array, &ctx);
+            double list = xtnt_bench_run(threads, bench_list, &ctx);
+            printf("%10llu %8s %16.2f %16.2f\n", (unsigned long long) threads, name[p],
+                   total / (array * 1e6), total / (list * 1e6));
+        }
+        xtnt_node_set_uninitialize(&(ctx.list));
+        xtnt_array_destroy(&(ctx.array));
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/set/shardmap.h>
+
+#include "bench.h"
+
+#define BENCH_KEYS (1 << 16)
+#define BENCH_BATCH (64)
+#define BENCH_PUT_EVERY (10)
+
+struct bench_ctx
+{
+    struct xtnt_node_set set;
+    struct xtnt_shardmap *map;
+    struct xtnt_node *nodes;
+    xtnt_uint_t ops;
+};
+
+/* Cheap per thread key sequence */
+static inline xtnt_uint_t
+bench_next(
+    uint64_t *x)
+{
+    *x ^= *x << 13;
+    *x ^= *x >> 7;
+    *x ^= *x << 17;
+    return (xtnt_uint_t) (*x & (BENCH_KEYS - 1));
+}
+
+/* One hash set behind one lock, 1 in BENCH_PUT_EVERY ops a put */
+static void
+bench_single(
+    struct xtnt_bench_thread *t)
+{
+    struct bench_ctx *ctx = t->ctx;
+    struct xtnt_node *node = NULL;
+    uint64_t x = t->index + 1;
+    for (xtnt_uint_t op = 0; op < ctx->ops; op++) {
+        xtnt_uint_t key = bench_next(&x);
+        if (op % BENCH_PUT_EVERY == 0) {
+            xtnt_hashset_replace(&(ctx->set), &(ctx->nodes[key]), &node);
+        } else {
+            xtnt_hashset_search(&(ctx->set), key, &node);
+        }
+    }
+}
+
+static void
+bench_sharded(
+    struct xtnt_bench_thread *t)
+{
+    struct bench_ctx *ctx = t->ctx;
+    struct xtnt_node *node = NULL;
+    uint64_t x = t->index + 1;
+    for (xtnt_uint_t op = 0; op < ctx->ops; op++) {
+        xtnt_uint_t key = bench_next(&x);
+        if (op % BENCH_PUT_EVERY == 0) {
+            xtnt_shardmap_put(ctx->map, &(ctx->nodes[key]), &node);
+        } else {
+            xtnt_shardmap_get(ctx->map, key, &node);
+        }
+    }
+}
+
+static void
+bench_batched(
+    struct xtnt_bench_thread *t)
+{
+    struct bench_ctx *ctx = t->ctx;
+    struct xtnt_node *put[BENCH_BATCH / BENCH_PUT_EVERY + 1];
+    struct xtnt_node *found[BENCH_BATCH];
+    xtnt_uint_t keys[BENCH_BATCH];
+    xtnt_uint_t puts = 0;
+    xtnt_uint_t gets = 0;
+    uint64_t x = t->index + 1;
+    for (xtnt_uint_t op = 0; op < ctx->ops; op++) {
+        xtnt_uint_t key = bench_next(&x);
+        if (op % BENCH_PUT_EVERY == 0) {
+            put[puts++] = &(ctx->nodes[key]);
+        } else {
+            keys[gets++] = key;
+        }
+        if (gets == BENCH_BATCH) {
+            xtnt_shardmap_get_batch(ctx->map, gets, keys, found);
+            xtnt_shardmap_put_batch(ctx->map, puts, put, NULL);
+            gets = puts = 0;
+        }
+    }
+    xtnt_shardmap_get_batch(ctx->map, gets, keys, found);
+    xtnt_shardmap_put_batch(ctx->map, puts, put, NULL);
+}
+
+int
+main(
+    int argc,
+    char **argv)
+{
+    xtnt_uint_t max_threads = (argc > 2) ? (xtnt_uint_t) strtoull(argv[2], NULL, 10) : 64;
+    struct bench_ctx ctx;
+    double single;
+    double sharded;
+    double batched;
+    ctx.ops = (argc > 1) ? (xtnt_uint_t) strtoull(argv[1], NULL, 10) : (1 << 18);
+    ctx.nodes = calloc(BENCH_KEYS, sizeof(struct xtnt_node));
+    if (ctx.nodes == NULL) {
+        fprintf(stderr, "failed to allocate nodes\n");
+        return 1;
+    }
+    for (xtnt_uint_t idx = 0; idx < BENCH_KEYS; idx++) {
+        ctx.nodes[idx].key = idx;
+    }
+    xtnt_hashset_initialize(&(ctx.set));
+    xtnt_shardmap_create(0, &(ctx.map));
+    for (xtnt_uint_t idx = 0; idx < BENCH_KEYS; idx++) {
+        struct xtnt_node *replaced = NULL;
+        xtnt_hashset_insert(&(ctx.set), &(ctx.nodes[idx]));
+        xtnt_shardmap_put(ctx.map, &(ctx.nodes[idx]), &replaced);
+    }
+
+    printf("%zu shards, %d%% puts over %d keys\n", ctx.map->shards,
+           100 / BENCH_PUT_EVERY, BENCH_KEYS);
+    printf("%10s %16s %16s %16s\n", "threads", "single Mops/s", "sharded Mops/s", "batch Mops/s");
+    for (xtnt_uint_t threads = 1; threads <= max_threads; threads <<= 1) {
+        double total = (double) ctx.ops * (double) threads;
+        single = xtnt_bench_run(threads, bench_single, &ctx);
+        sharded = xtnt_bench_run(threads, bench_sharded, &ctx);
+        batched = xtnt_bench_run(threads, bench_batched, &ctx);
+        printf("%10llu %16.2f %16.2f %16.2f\n", (unsigned long long) threads,
+               total / (single * 1e6), total / (sharded * 1e6), total / (batched * 1e6));
+    }
+
+    xtnt_shardmap_destroy(&(ctx.map));
+    xtnt_hashset_uninitialize(&(ctx.set));
+    free(ctx.nodes);
+    return 0;
+}
@@ -0,0 +1,86 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/set/list.h>
+#include <extant/set/list/skiplist.h>
+
+#include "bench.h"
+
+#define BENCH_GETS (1 << 16)
+
+/* Get members at scattered indices, ns per get */
+static double
+bench_get(
+    struct xtnt_node_set *set,
+    xtnt_status_t (*get)(struct xtnt_node_set *, xtnt_uint_t, struct xtnt_node **),
+    xtnt_uint_t count,
+    xtnt_uint_t gets)
+{
+    struct xtnt_node *found = NULL;
+    double start = xtnt_bench_now();
+    for (xtnt_uint_t idx = 0; idx < gets; idx++) {
+        get(set, (idx * 7919) % count, &found);
+    }
+    return (xtnt_bench_now() - start) * 1e9 / gets;
+}
+
+int
+main(
+    int argc,
+    char **argv)
+{
+    xtnt_uint_t max = (argc > 1) ? (xtnt_uint_t) strtoull(argv[1], NULL, 10) : 1000000;
+    struct xtnt_node *nodes = malloc(sizeof(struct xtnt_node) * max);
+    struct xtnt_node_set list;
+    struct xtnt_node_set skiplist;
+    double listed = 0;
+    double skipped = 0;
+
+    printf("%10s %12s %12s %8s\n", "members", "list ns", "skiplist ns", "speedup");
+    for (xtnt_uint_t count = 1000; count <= max; count *= 10) {
+        xtnt_list_initialize_lock(&list, XTNT_SET_LOCK_NONE);
+        xtnt_skiplist_initialize_lock(&skiplist, XTNT_SET_LOCK_NONE);
+        for (xtnt_uint_t idx = 0; idx < count; idx++) {
+            xtnt_node_initialize(&(nodes[idx]), idx, 0, NULL);
+            xtnt_list_insert(&list, &(nodes[idx]));
+        }
+        // A list walks from the nearer end, so it gets fewer tries
+        listed = bench_get(&list, xtnt_list_get, count, (count < BENCH_GETS) ? BENCH_GETS : BENCH_GETS / (count / 1000));
+        for (xtnt_uint_t idx = 0; idx < count; idx++) {
+            xtnt_skiplist_insert(&skiplist, &(nodes[idx]));
+        }
+        skipped = bench_get(&skiplist, xtnt_skiplist_get, count, BENCH_GETS);
+        xtnt_skiplist_uninitialize(&skiplist);
+        xtnt_node_set_uninitialize(&list);
+        printf("%10llu %12.3f %12.3f %7.1fx\n", (unsigned long long) count,
+               listed, skipped, listed / skipped);
+    }
+    free(nodes);
+    return 0;
+}
@@ -0,0 +1,113 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/set/array.h>
+#include <extant/set/list.h>
+
+#include "bench.h"
+
+static xtnt_uint_t seed = 7;
+
+/* Reload shuffled keys into the nodes and the table in address order */
+static void
+bench_shuffle(
+    struct xtnt_node *nodes,
+    struct xtnt_node_set *array,
+    xtnt_uint_t count)
+{
+    for (xtnt_uint_t idx = 0; idx < count; idx++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        nodes[idx].key = seed >> 16;
+        ((struct xtnt_node **) array->root.link[XTNT_NODE_HEAD])[idx] = &(nodes[idx]);
+    }
+}
+
+static int
+bench_qsort_key(
+    const void *a,
+    const void *b)
+{
+    return (int) xtnt_node_compare_key(*(const struct xtnt_node * const *) a,
+                                       *(const struct xtnt_node * const *) b);
+}
+
+int
+main(
+    int argc,
+    char **argv)
+{
+    xtnt_uint_t max = (argc > 1) ? (xtnt_uint_t) strtoull(argv[1], NULL, 10) : 10000000;
+    size_t threads = (argc > 2) ? (size_t) strtoull(argv[2], NULL, 10) : 0;
+    struct xtnt_node *nodes = malloc(sizeof(struct xtnt_node) * max);
+    struct xtnt_node_set *array = NULL;
+    struct xtnt_node_set list;
+    double start = 0;
+    double qsorted = 0;
+    double intro = 0;
+    double radix = 0;
+    double merged = 0;
+    double parallel = 0;
+
+    printf("%10s %12s %12s %12s %12s %12s\n", "members", "qsort ns", "sort_fn ns", "sort ns",
+           "parallel ns", "list ns");
+    for (xtnt_uint_t count = 1000; count <= max; count *= 10) {
+        xtnt_array_create_lock(count, XTNT_SET_LOCK_NONE, &array);
+        bench_shuffle(nodes, array, count);
+        start = xtnt_bench_now();
+        qsort(array->root.link[XTNT_NODE_HEAD], count, sizeof(struct xtnt_node *), bench_qsort_key);
+        qsorted = (xtnt_bench_now() - start) * 1e9 / count;
+        bench_shuffle(nodes, array, count);
+        start = xtnt_bench_now();
+        xtnt_array_sort_fn(array, xtnt_node_compare_key);
+        intro = (xtnt_bench_now() - start) * 1e9 / count;
+        bench_shuffle(nodes, array, count);
+        start = xtnt_bench_now();
+        xtnt_array_sort(array);
+        radix = (xtnt_bench_now() - start) * 1e9 / count;
+        bench_shuffle(nodes, array, count);
+        start = xtnt_bench_now();
+        xtnt_array_sort_parallel(array, xtnt_node_compare_key, threads, XTNT_ZERO);
+        parallel = (xtnt_bench_now() - start) * 1e9 / count;
+        xtnt_array_destroy(&array);
+
+        xtnt_list_initialize_lock(&list, XTNT_SET_LOCK_NONE);
+        for (xtnt_uint_t idx = 0; idx < count; idx++) {
+            nodes[idx].link[XTNT_NODE_TAIL] = NULL;
+            xtnt_list_insert(&list, &(nodes[idx]));
+        }
+        start = xtnt_bench_now();
+        xtnt_list_sort(&list);
+        merged = (xtnt_bench_now() - start) * 1e9 / count;
+        xtnt_node_set_uninitialize(&list);
+        printf("%10llu %12.3f %12.3f %12.3f %12.3f %12.3f\n", (unsigned long long) count,
+               qsorted, intro, radix, parallel, merged);
+    }
+    free(nodes);
+    return 0;
+}
@@ -0,0 +1,157 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/set/tree.h>
+#include <extant/set/tree/avltree.h>
+
+#include "bench.h"
+
+/* AVL trees under 4180 nodes always fit the default XTNT_TREE_MAX_HEIGHT */
+#define BENCH_KEYS (4096)
+#define BENCH_LOOKUPS (9)
+
+struct bench_tree
+{
+    const char *name;
+    xtnt_status_t (*initialize)(struct xtnt_node_set *);
+    xtnt_status_t (*insert)(struct xtnt_node_set *, struct xtnt_node *);
+    xtnt_status_t (*delete)(struct xtnt_node_set *, xtnt_uint_t, struct xtnt_node **);
+    xtnt_status_t (*search)(struct xtnt_node_set *, xtnt_uint_t, struct xtnt_node **);
+};
+
+struct bench_ctx
+{
+    const struct bench_tree *impl;
+    struct xtnt_node_set tree;
+    struct xtnt_node nodes[BENCH_KEYS];
+    xtnt_uint_t order[BENCH_KEYS];
+    xtnt_uint_t rounds;
+};
+
+static void
+bench_fail(
+    const char *what)
+{
+    fprintf(stderr, "%s failed\n", what);
+    exit(1);
+}
+
+/* Insert every key then delete every key, all writes */
+static void
+bench_insert_heavy(
+    struct xtnt_bench_thread *t)
+{
+    struct bench_ctx *ctx = t->ctx;
+    struct xtnt_node *deleted = NULL;
+    for (xtnt_uint_t round = 0; round < ctx->rounds; round++) {
+        for (xtnt_uint_t idx = 0; idx < BENCH_KEYS; idx++) {
+            if (ctx->impl->insert(&(ctx->tree), &(ctx->nodes[ctx->order[idx]])) != XTNT_ESUCCESS) {
+                bench_fail("insert");
+            }
+        }
+        for (xtnt_uint_t idx = 0; idx < BENCH_KEYS; idx++) {
+            ctx->impl->delete(&(ctx->tree), ctx->order[(idx * 7) % BENCH_KEYS], &deleted);
+        }
+    }
+}
+
+/* Against a full tree, BENCH_LOOKUPS searches for each delete and insert */
+static void
+bench_lookup_heavy(
+    struct xtnt_bench_thread *t)
+{
+    struct bench_ctx *ctx = t->ctx;
+    struct xtnt_node *found = NULL;
+    xtnt_uint_t key;
+    for (xtnt_uint_t round = 0; round < ctx->rounds; round++) {
+        for (xtnt_uint_t idx = 0; idx < BENCH_KEYS; idx++) {
+            for (xtnt_uint_t look = 0; look < BENCH_LOOKUPS; look++) {
+                ctx->impl->search(&(ctx->tree), ctx->order[(idx + look * 131) % BENCH_KEYS], &found);
+            }
+            key = ctx->order[idx];
+            ctx->impl->delete(&(ctx->tree), key, &found);
+            if (ctx->impl->insert(&(ctx->tree), &(ctx->nodes[key])) != XTNT_ESUCCESS) {
+                bench_fail("insert");
+            }
+        }
+    }
+}
+
+int
+main(
+    int argc,
+    char **argv)
+{
+    const struct bench_tree impl[] = {
+        { "avl", xtnt_avltree_initialize, xtnt_avltree_insert, xtnt_avltree_delete, xtnt_avltree_search },
+        { "rb", xtnt_rbtree_initialize, xtnt_rbtree_insert, xtnt_rbtree_delete, xtnt_rbtree_search }
+    };
+    struct bench_ctx *ctx = calloc(1, sizeof(struct bench_ctx));
+    xtnt_uint_t rounds = (argc > 1) ? (xtnt_uint_t) strtoull(argv[1], NULL, 10) : 256;
+    double insert_time;
+    double lookup_time;
+    double ops;
+    xtnt_uint_t swap;
+    xtnt_uint_t pick;
+
+    srand(1);
+    for (xtnt_uint_t idx = 0; idx < BENCH_KEYS; idx++) {
+        ctx->order[idx] = idx;
+        ctx->nodes[idx].key = idx;
+    }
+    for (xtnt_uint_t idx = BENCH_KEYS - 1; idx > 0; idx--) {
+        pick = (xtnt_uint_t) rand() % (idx + 1);
+        swap = ctx->order[idx];
+        ctx->order[idx] = ctx->order[pick];
+        ctx->order[pick] = swap;
+    }
+    ctx->rounds = rounds;
+
+    printf("%6s %20s %20s\n", "tree", "insert-heavy ns/op", "lookup-heavy ns/op");
+    for (size_t idx = 0; idx < sizeof(impl) / sizeof(impl[0]); idx++) {
+        ctx->impl = &(impl[idx]);
+        if (impl[idx].initialize(&(ctx->tree)) != XTNT_ESUCCESS) {
+            bench_fail("initialize");
+        }
+        insert_time = xtnt_bench_run(1, bench_insert_heavy, ctx);
+        for (xtnt_uint_t key = 0; key < BENCH_KEYS; key++) {
+            if (impl[idx].insert(&(ctx->tree), &(ctx->nodes[ctx->order[key]])) != XTNT_ESUCCESS) {
+                bench_fail("insert");
+            }
+        }
+        lookup_time = xtnt_bench_run(1, bench_lookup_heavy, ctx);
+        xtnt_node_set_uninitialize(&(ctx->tree));
+        ops = (double) rounds * BENCH_KEYS;
+        printf("%6s %20.2f %20.2f\n", impl[idx].name,
+               (insert_time * 1e9) / (ops * 2),
+               (lookup_time * 1e9) / (ops * (BENCH_LOOKUPS + 2)));
+    }
+    free(ctx);
+    return 0;
+}
@@ -217,20 +217,21 @@
  *
  * @fn xtnt_status_t (* xtnt_node_set_if::sort)(struct xtnt_node_set_if *set)
  * @see xtnt_set_sort()
- * Sort Node Set
+ * Sort Node Set by ascending key
+ * @param set The Node Set to operate on
  * @return status result of operation
  * 
  * @fn xtnt_status_t (* xtnt_node_set_if::sort_reverse)(struct xtnt_node_set_if *set)
  * @see xtnt_set_sort_reverse()
- * Sort Node Set in reverse
+ * Sort Node Set by descending key
  * @param set The Node Set to operate on
  * @return status result of operation
  * 
- * @fn xtnt_status_t (* xtnt_node_set_if::sort_fn)(struct xtnt_node_set_if *set, void *fn)
+ * @fn xtnt_status_t (* xtnt_node_set_if::sort_fn)(struct xtnt_node_set_if *set, xtnt_node_compare_fn compare)
  * @see xtnt_set_sort_fn()
- * Sort Node Set by sort function fn
+ * Sort Node Set by comparison function compare
  * @param set The Node Set to operate on
- * @param fn The function to sort Nodes with
+ * @param compare The function to order Nodes with
  * @return status result of operation
  * 
  * @fn xtnt_status_t (* xtnt_node_set_if::grow)(struct xtnt_node_set_if *set)
@@ -259,4 +260,21 @@
  * @param eval The size to evaluate with
  * @return status result of operation
  * 
+ * @fn xtnt_status_t (* xtnt_node_set_if::next)(struct xtnt_node_set *set, struct xtnt_set_iter *iter, struct xtnt_node **node)
+ * @see xtnt_set_iter_next()
+ * Return the Node after the last one the cursor visited, with the Node Set read locked
+ * @param set The Node Set to operate on
+ * @param iter The cursor, its Node NULL before the first visit
+ * @param node[out] The pointer to store the Node at, or NULL past the last Node
+ * @return status result of operation
+ *
+ * @fn xtnt_status_t (* xtnt_node_set_if::seek)(struct xtnt_node_set *set, struct xtnt_set_iter *iter, xtnt_uint_t key)
+ * @see xtnt_set_iter_range()
+ * Place the cursor so next returns the least Node with key or greater, with the Node Set read locked
+ * @note Only Node Sets ordered by key ( e.g. trees ) support seek
+ * @param set The Node Set to operate on
+ * @param iter The cursor
+ * @param key The least key to visit
+ * @return status result of operation
+ *
  */
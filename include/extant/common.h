@@ -35,6 +35,7 @@ SOFTWARE.
 #define _XTNT_COMMON_H_
 
 #include <errno.h>
+#include <limits.h>
 #include <sched.h>
 #include <stdlib.h>
 #include <stdarg.h>
@@ -32,6 +32,8 @@ SOFTWARE.
 
 #include <extant/dso.h>
 
+#include <extant/hash.h>
+
 #include <extant/log.h>
 
 #include <extant/memory.h>
@@ -32,6 +32,8 @@ SOFTWARE.
 
 #include <extant/error.h>
 
+#include <extant/memory/pool.h>
+
 #include <extant/set.h>
 
 #ifdef XTNT_DEFAULT_LOG_BATCH_SIZE
@@ -40,6 +42,62 @@ SOFTWARE.
 #define XTNT_LOG_BATCH_SIZE (16) /**< Default entry batch size */
 #endif /* ifndef XTNT_DEFAULT_LOG_BATCH_SIZE */
 
+#ifdef XTNT_DEFAULT_LOG_ENTRY_DATA_SIZE
+#define XTNT_LOG_ENTRY_DATA_SIZE (XTNT_DEFAULT_LOG_ENTRY_DATA_SIZE) /**< Data size of recycled entries */
+#else
+#define XTNT_LOG_ENTRY_DATA_SIZE (64) /**< Data size of recycled entries */
+#endif /* ifndef XTNT_DEFAULT_LOG_ENTRY_DATA_SIZE */
+
+#ifdef XTNT_DEFAULT_LOG_ENTRY_MSG_SIZE
+#define XTNT_LOG_ENTRY_MSG_SIZE (XTNT_DEFAULT_LOG_ENTRY_MSG_SIZE) /**< Message size of recycled entries */
+#else
+#define XTNT_LOG_ENTRY_MSG_SIZE (128) /**< Message size of recycled entries */
+#endif /* ifndef XTNT_DEFAULT_LOG_ENTRY_MSG_SIZE */
+
+#ifdef XTNT_DEFAULT_LOG_ENTRY_POOL_SIZE
+#define XTNT_LOG_ENTRY_POOL_SIZE (XTNT_DEFAULT_LOG_ENTRY_POOL_SIZE) /**< Recycled entries per logger */
+#else
+#define XTNT_LOG_ENTRY_POOL_SIZE (1024) /**< Recycled entries per logger */
+#endif /* ifndef XTNT_DEFAULT_LOG_ENTRY_POOL_SIZE */
+
+#define XTNT_LOG_ENTRY_ALIGN (16) /**< Alignment of data trailing an entry */
+
+#ifdef XTNT_DEFAULT_LOG_BUFFER_SIZE
+#define XTNT_LOG_BUFFER_SIZE (XTNT_DEFAULT_LOG_BUFFER_SIZE) /**< Consumer write buffer size */
+#else
+#define XTNT_LOG_BUFFER_SIZE (65536) /**< Consumer write buffer size */
+#endif /* ifndef XTNT_DEFAULT_LOG_BUFFER_SIZE */
+
+#ifdef XTNT_DEFAULT_LOG_FLUSH_SIZE
+#define XTNT_LOG_FLUSH_SIZE (XTNT_DEFAULT_LOG_FLUSH_SIZE) /**< Buffered bytes forcing a write */
+#else
+#define XTNT_LOG_FLUSH_SIZE (16384) /**< Buffered bytes forcing a write */
+#endif /* ifndef XTNT_DEFAULT_LOG_FLUSH_SIZE */
+
+#ifdef XTNT_DEFAULT_LOG_FLUSH_USEC
+#define XTNT_LOG_FLUSH_USEC (XTNT_DEFAULT_LOG_FLUSH_USEC) /**< Microseconds buffered before a write */
+#else
+#define XTNT_LOG_FLUSH_USEC (100000) /**< Microseconds buffered before a write */
+#endif /* ifndef XTNT_DEFAULT_LOG_FLUSH_USEC */
+
+#ifdef XTNT_DEFAULT_LOG_RECORD_DATA_SIZE
+#define XTNT_LOG_RECORD_DATA_SIZE (XTNT_DEFAULT_LOG_RECORD_DATA_SIZE) /**< Data size of ring records */
+#else
+#define XTNT_LOG_RECORD_DATA_SIZE (64) /**< Data size of ring records */
+#endif /* ifndef XTNT_DEFAULT_LOG_RECORD_DATA_SIZE */
+
+#ifdef XTNT_DEFAULT_LOG_RING_SIZE
+#define XTNT_LOG_RING_SIZE (XTNT_DEFAULT_LOG_RING_SIZE) /**< Records per thread ring, a power of 2 */
+#else
+#define XTNT_LOG_RING_SIZE (256) /**< Records per thread ring, a power of 2 */
+#endif /* ifndef XTNT_DEFAULT_LOG_RING_SIZE */
+
+#ifdef XTNT_DEFAULT_LOG_RINGS
+#define XTNT_LOG_RINGS (XTNT_DEFAULT_LOG_RINGS) /**< Rings cached per thread */
+#else
+#define XTNT_LOG_RINGS (4) /**< Rings cached per thread */
+#endif /* ifndef XTNT_DEFAULT_LOG_RINGS */
+
 /**
  * @todo Build out a default log directory, file name and configure options
  */
@@ -74,6 +132,8 @@ SOFTWARE.
 #define XTNT_LOGGER_PENDING_EXIT (6144) /**< Requested logger exit */
 #define XTNT_LOGGER_COMPLETED_EXIT (2048) /**< Logger completed exit */
 
+struct xtnt_log_ring;
+
 /**
  * @struct xtnt_logger
  *
@@ -106,14 +166,65 @@ struct xtnt_logger
  * The queue of entries the logger operates on
  */
     struct xtnt_node_set queue;
+/**
+ * @private
+ * Pool of recycled entries handed out by `xtnt_logger_entry_acquire()`
+ */
+    struct xtnt_memory_object *entries;
+/**
+ * @private
+ * Per-thread record rings written by `xtnt_log_record()`
+ */
+    struct xtnt_log_ring *rings;
+/**
+ * @private
+ * Unique identifier matching the calling thread to its ring
+ */
+    uint64_t id;
+/**
+ * @private
+ * Formatted messages awaiting a single write by the consumer
+ */
+    char *buffer;
+/**
+ * @private
+ * Bytes held in `buffer`
+ */
+    size_t buffered;
+/**
+ * @private
+ * Buffered bytes after which the consumer writes
+ */
+    size_t flush_size;
+/**
+ * @private
+ * Microseconds after the last write after which the consumer writes
+ */
+    uint64_t flush_usec;
+/**
+ * @private
+ * Monotonic time in nanoseconds of the last write by the consumer
+ */
+    uint64_t flushed;
 /**
  * @public
  * The lock for the logger used when changing state
  */
     pthread_mutex_t lock;
+/**
+ * @private
+ * Condition the consumer sleeps on while the queue is empty
+ */
+    pthread_cond_t wake;
+/**
+ * @private
+ * Non-zero while the consumer is, or is about to be, asleep on `wake`
+ */
+    xtnt_uint_t waiting;
 };
 
 #define XTNT_LOG_ENTRY_INIT_FAIL (1) /**< Failed to initialize */
+#define XTNT_LOG_ENTRY_EXTERNAL (2) /**< Entry memory not owned by logger */
 
 /**
  * @struct xtnt_logger_entry
@@ -156,6 +267,11 @@ struct xtnt_logger_entry
  * Self-referential node for queueing
  */
     struct xtnt_node node;
+/**
+ * @private
+ * Pool the entry is recycled to, or NULL when allocated from the heap
+ */
+    struct xtnt_memory_object *pool;
 };
 
 xtnt_status_t
@@ -163,11 +279,25 @@ xtnt_log(
     struct xtnt_logger *logger,
     struct xtnt_logger_entry *entry);
 
+xtnt_status_t
+xtnt_log_record(
+    struct xtnt_logger *logger,
+    void *fmt_fn,
+    xtnt_uint_t level,
+    const void *data,
+    size_t data_length);
+
 xtnt_status_t
 xtnt_logger_change_default_level(
     struct xtnt_logger *logger,
     xtnt_uint_t default_level);
 
+xtnt_status_t
+xtnt_logger_change_flush(
+    struct xtnt_logger *logger,
+    size_t flush_size,
+    uint64_t flush_usec);
+
 xtnt_status_t
 xtnt_logger_create(
     FILE *log,
@@ -178,6 +308,15 @@ xtnt_status_t
 xtnt_logger_destroy(
     struct xtnt_logger **logger);
 
+xtnt_status_t
+xtnt_logger_entry_acquire(
+    struct xtnt_logger *logger,
+    size_t data_length,
+    size_t msg_length,
+    void *fmt_fn,
+    xtnt_uint_t level,
+    struct xtnt_logger_entry **entry);
+
 xtnt_status_t
 xtnt_logger_entry_create(
     size_t data_length,
@@ -190,6 +329,19 @@ xtnt_status_t
 xtnt_logger_entry_destroy(
     struct xtnt_logger_entry **entry);
 
+xtnt_status_t
+xtnt_logger_entry_initialize(
+    struct xtnt_logger_entry *entry,
+    void *data,
+    char *msg,
+    size_t msg_length,
+    void *fmt_fn,
+    xtnt_uint_t level);
+
+xtnt_status_t
+xtnt_logger_entry_uninitialize(
+    struct xtnt_logger_entry *entry);
+
 xtnt_status_t
 xtnt_logger_exit(
     struct xtnt_logger *logger);
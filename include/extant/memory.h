@@ -30,4 +30,8 @@ SOFTWARE.
 #ifndef _XTNT_MEMORY_H_
 #define _XTNT_MEMORY_H_
 
+#include <extant/memory/pool.h>
+
+#include <extant/memory/region.h>
+
 #endif /* _XTNT_MEMORY_H_ */
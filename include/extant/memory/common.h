@@ -34,13 +34,53 @@ SOFTWARE.
 
 #include <extant/set/common.h>
 
+/**
+ * @struct xtnt_memory_object
+ *
+ * The xtnt_memory_object is the handle shared by memory pools and regions
+ */
 struct xtnt_memory_object
 {
+/**
+ * @private
+ * Base address of the managed memory
+ */
     void *base;
+/**
+ * @private
+ * Block size for pools, chunk size for regions
+ */
     size_t size;
+/**
+ * @private
+ * The state of the memory object
+ */
     xtnt_uint_t state;
+/**
+ * @private
+ * Node set used for bookkeeping by the memory object
+ */
     struct xtnt_node_set set;
+/**
+ * @private
+ * The lock for the memory object used when changing state
+ */
     pthread_mutex_t lock;
+/**
+ * @private
+ * Number of blocks managed by a pool
+ */
+    xtnt_uint_t count;
+/**
+ * @private
+ * Tagged free list head ( [tag:32][index + 1:32] ) of a pool
+ */
+    uint64_t head;
+/**
+ * @private
+ * Process unique identifier used to match thread local caches
+ */
+    uint64_t id;
 };
 
 #endif /* _XTNT_MEMORY_COMMON_H_ */
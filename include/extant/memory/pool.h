@@ -34,6 +34,18 @@ SOFTWARE.
 
 #include <extant/memory/common.h>
 
+#ifndef XTNT_MPOOL_ALIGN
+#define XTNT_MPOOL_ALIGN (16) /**< Block alignment and size granularity */
+#endif /* ifndef XTNT_MPOOL_ALIGN */
+
+#ifndef XTNT_MPOOL_MAGAZINE_SIZE
+#define XTNT_MPOOL_MAGAZINE_SIZE (32) /**< Blocks cached per thread per pool */
+#endif /* ifndef XTNT_MPOOL_MAGAZINE_SIZE */
+
+#ifndef XTNT_MPOOL_MAGAZINES
+#define XTNT_MPOOL_MAGAZINES (4) /**< Thread local magazine slots */
+#endif /* ifndef XTNT_MPOOL_MAGAZINES */
+
 xtnt_status_t
 xtnt_mpool_allocate(
     struct xtnt_memory_object *pool,
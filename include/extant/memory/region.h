@@ -27,19 +27,30 @@ SOFTWARE.
 ===============================================================================
 */
 
-#ifndef _XTNT_MEMORY_POOL_H_
-#define _XTNT_MEMORY_POOL_H_
+#ifndef _XTNT_MEMORY_REGION_H_
+#define _XTNT_MEMORY_REGION_H_
 
 #include <extant/error.h>
 
 #include <extant/memory/common.h>
 
+#ifndef XTNT_MREGION_ALIGN
+#define XTNT_MREGION_ALIGN (16) /**< Default allocation alignment */
+#endif /* ifndef XTNT_MREGION_ALIGN */
+
 xtnt_status_t
 xtnt_mregion_allocate(
     struct xtnt_memory_object *region,
     size_t size,
     void **allocation);
 
+xtnt_status_t
+xtnt_mregion_allocate_aligned(
+    struct xtnt_memory_object *region,
+    size_t size,
+    size_t alignment,
+    void **allocation);
+
 xtnt_status_t
 xtnt_mregion_create(
     size_t size,
@@ -54,4 +65,8 @@ xtnt_status_t
 xtnt_mregion_destroy(
     struct xtnt_memory_object **region);
 
-#endif /* _XTNT_MEMORY_POOL_H_ */
+xtnt_status_t
+xtnt_mregion_reset(
+    struct xtnt_memory_object *region);
+
+#endif /* _XTNT_MEMORY_REGION_H_ */
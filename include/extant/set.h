@@ -32,10 +32,20 @@ SOFTWARE.
 
 #include <extant/set/array.h>
 
+#include <extant/set/hashset.h>
+
 #include <extant/set/list.h>
 
+#include <extant/set/list/clist.h>
+
+#include <extant/set/list/skiplist.h>
+
 #include <extant/set/queue.h>
 
+#include <extant/set/shardmap.h>
+
+#include <extant/set/sort.h>
+
 #include <extant/set/stack.h>
 
 #include <extant/set/tree.h>
@@ -38,32 +38,83 @@ SOFTWARE.
 #define XTNT_LIST_MODE_DEFAULT 1
 #endif /* ifndef XTNT_LIST_MODE_DEFAULT */
 
+#ifdef XTNT_DEFAULT_ARRAY_SIZE
+#define XTNT_ARRAY_SIZE (XTNT_DEFAULT_ARRAY_SIZE) /**< Fewest slots a growing array holds */
+#else
+#define XTNT_ARRAY_SIZE (16) /**< Fewest slots a growing array holds */
+#endif /* ifndef XTNT_DEFAULT_ARRAY_SIZE */
+
+#ifdef XTNT_DEFAULT_ARRAY_MAP_SIZE
+#define XTNT_ARRAY_MAP_SIZE (XTNT_DEFAULT_ARRAY_MAP_SIZE) /**< Column bytes from which a column is mapped */
+#else
+#define XTNT_ARRAY_MAP_SIZE (1 << 20) /**< Column bytes from which a column is mapped */
+#endif /* ifndef XTNT_DEFAULT_ARRAY_MAP_SIZE */
+
+#define XTNT_ARRAY_MODE_POINTER (XTNT_MODE_1) /**< Members are compared through their node pointers */
+#define XTNT_ARRAY_MODE_KEYED (XTNT_MODE_2) /**< Member keys are also kept in a contiguous column */
+
+extern const struct xtnt_node_set_if xtnt_array_if;
+
 xtnt_status_t
 xtnt_array_create(
     xtnt_uint_t count,
     struct xtnt_node_set **array);
 
 xtnt_status_t
-xtnt_array_delete(
+xtnt_array_create_lock(
+    xtnt_uint_t count,
+    xtnt_uint_t policy,
+    struct xtnt_node_set **array);
+
+xtnt_status_t
+xtnt_array_create_mode(
+    xtnt_uint_t count,
+    xtnt_uint_t mode,
+    xtnt_uint_t policy,
+    struct xtnt_node_set **array);
+
+xtnt_status_t
+xtnt_array_delete_many(
     struct xtnt_node_set *array,
     xtnt_uint_t index,
-    struct xtnt_node **deleted);
+    xtnt_uint_t count,
+    struct xtnt_node **nodes);
 
 xtnt_status_t
 xtnt_array_destroy(
     struct xtnt_node_set **array);
 
 xtnt_status_t
-xtnt_array_get(
+xtnt_array_grow(
+    struct xtnt_node_set *array);
+
+xtnt_status_t
+xtnt_array_grow_eval(
+    struct xtnt_node_set *array,
+    size_t eval);
+
+xtnt_status_t
+xtnt_array_insert_many(
     struct xtnt_node_set *array,
     xtnt_uint_t index,
+    xtnt_uint_t count,
+    struct xtnt_node **nodes);
+
+xtnt_status_t
+xtnt_array_pop(
+    struct xtnt_node_set *array,
     struct xtnt_node **node);
 
 xtnt_status_t
-xtnt_array_insert(
+xtnt_array_push(
     struct xtnt_node_set *array,
-    struct xtnt_node *node,
-    xtnt_uint_t index);
+    struct xtnt_node *node);
+
+xtnt_status_t
+xtnt_array_push_many(
+    struct xtnt_node_set *array,
+    xtnt_uint_t count,
+    struct xtnt_node **nodes);
 
 xtnt_status_t
 xtnt_array_search(
@@ -78,4 +129,159 @@ xtnt_array_search_fn(
     void *ctx,
     struct xtnt_node **node);
 
+xtnt_status_t
+xtnt_array_shrink(
+    struct xtnt_node_set *array);
+
+xtnt_status_t
+xtnt_array_shrink_eval(
+    struct xtnt_node_set *array,
+    size_t eval);
+
+xtnt_status_t
+xtnt_array_sort(
+    struct xtnt_node_set *array);
+
+xtnt_status_t
+xtnt_array_sort_fn(
+    struct xtnt_node_set *array,
+    xtnt_node_compare_fn compare);
+
+xtnt_status_t
+xtnt_array_sort_parallel(
+    struct xtnt_node_set *array,
+    xtnt_node_compare_fn compare,
+    size_t threads,
+    size_t cutoff);
+
+xtnt_status_t
+xtnt_array_sort_reverse(
+    struct xtnt_node_set *array);
+
+/**
+ * @brief Delete a node from an array
+ *
+ * @param[in] array the node set to delete from
+ * @param[in] index the node to delete
+ * @param[out] node pointer of deleted node ( can be NULL )
+ * @return node pointer of deleted or NULL
+ *
+ * @note Deleted nodes in an array are a NULL pointer
+ *
+ * @todo Fix function documentation, implementation and create unit tests.
+ */
+inline xtnt_status_t
+xtnt_array_delete(
+    struct xtnt_node_set *array,
+    xtnt_uint_t index,
+    struct xtnt_node **node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    *node = NULL;
+    if ((res = xtnt_node_set_write_lock(array)) == XTNT_ESUCCESS) {
+        if (index < array->count) {
+            if (((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[index] != NULL) {
+                *node = ((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[index];
+                ((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[index] = NULL;
+                if (XTNT_MODE(array->root.state) == XTNT_ARRAY_MODE_KEYED) {
+                    ((xtnt_uint_t *) array->root.link[XTNT_NODE_MIDDLE])[index] = XTNT_ZERO;
+                }
+            }
+        }
+        res = xtnt_node_set_write_unlock(array);
+    }
+    return res;
+}
+
+/**
+ * @brief Get an array member
+ *
+ * @param[in] array The node set to get from
+ * @param[in] index The index to get
+ * @param[out] node Pointer to node pointer retrieved
+ * @return node or NULL on empty or invalid index
+ *
+ * @note A XTNT_SET_LOCK_SEQLOCK array is read without locking while no
+ * writer interferes. The table and count are read under one sequence, since
+ * a growing array may move its table.
+ *
+ * @todo Fix function documentation, implementation and create unit tests.
+ */
+inline xtnt_status_t
+xtnt_array_get(
+    struct xtnt_node_set *array,
+    xtnt_uint_t index,
+    struct xtnt_node **node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_uint_t sequence = XTNT_ZERO;
+    xtnt_uint_t count = XTNT_ZERO;
+    struct xtnt_node **table = NULL;
+    struct xtnt_node *member = NULL;
+    if (array->policy == XTNT_SET_LOCK_SEQLOCK) {
+        for (xtnt_uint_t retry = 0; retry < XTNT_SET_SEQLOCK_RETRY; retry++) {
+            sequence = xtnt_node_set_read_begin(array);
+            table = (struct xtnt_node **) array->root.link[XTNT_NODE_HEAD];
+            count = array->count;
+            // Load a member only from a table and count no writer changed
+            if (!xtnt_node_set_read_validate(array, sequence)) {
+                continue;
+            }
+            member = (index < count) ? __atomic_load_n(&(table[index]), __ATOMIC_ACQUIRE) : NULL;
+            if (xtnt_node_set_read_validate(array, sequence)) {
+                if (member != NULL) {
+                    *node = member;
+                }
+                return XTNT_ESUCCESS;
+            }
+        }
+    }
+    if ((res = xtnt_node_set_read_lock(array)) == XTNT_ESUCCESS) {
+        if (index < array->count) {
+            if (((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[index] != NULL) {
+                 *node = ((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[index];
+            }
+        }
+        res = xtnt_node_set_read_unlock(array);
+    }
+    return res;
+}
+
+/**
+ * @brief Insert a node into an array
+ *
+ * @param[in] array The node set to insert into
+ * @param[in] node The node to insert
+ * @param[in] index The index to insert the node at
+ * @return node pointer or NULL on failure
+ *
+ * @note An XTNT_ARRAY_MODE_KEYED array copies the key of the node into its
+ * key column, a member whose key changes must be inserted again.
+ *
+ * @todo Fix function documentation, implementation and create unit tests.
+ */
+inline xtnt_status_t
+xtnt_array_insert(
+    struct xtnt_node_set *array,
+    struct xtnt_node *node,
+    xtnt_uint_t index)
+{
+    xtnt_int_t fail = XTNT_ESUCCESS;
+    if ((fail = xtnt_node_set_write_lock(array)) == XTNT_ESUCCESS) {
+        if (index < array->count) {
+                ((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[index] = node;
+                if (XTNT_MODE(array->root.state) == XTNT_ARRAY_MODE_KEYED) {
+                    ((xtnt_uint_t *) array->root.link[XTNT_NODE_MIDDLE])[index] = (node != NULL) ? node->key : XTNT_ZERO;
+                }
+        } else {
+            fail = EINVAL;
+        }
+        xtnt_int_t fail_unlock = xtnt_node_set_write_unlock(array);
+        if (fail_unlock){
+            fail = fail_unlock;
+        }
+    }
+    return fail;
+}
+
 #endif /* ifndef _XTNT_SET_ARRAY_H_ */
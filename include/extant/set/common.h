@@ -33,6 +33,30 @@ SOFTWARE.
 #include <extant/error.h>
 #include <extant/set/node.h>
 
+#define XTNT_SET_LOCK_MUTEX 0 /**< Readers and writers take the mutex */
+#define XTNT_SET_LOCK_RWLOCK 1 /**< Readers share a rwlock, writers take it alone */
+#define XTNT_SET_LOCK_SEQLOCK 2 /**< Readers validate the sequence, writers take the mutex */
+#define XTNT_SET_LOCK_SPIN 3 /**< Readers and writers spin on a flag, then yield */
+#define XTNT_SET_LOCK_NONE 4 /**< No synchronization, the set is confined to one thread */
+
+#define XTNT_SET_ITER_LOCK 0 /**< A cursor holds the read lock from begin to end */
+#define XTNT_SET_ITER_SNAPSHOT 1 /**< A cursor copies the members at begin and walks the copy unlocked */
+#define XTNT_SET_ITER_RANGE 2 /**< Set by `xtnt_set_iter_range()`, the cursor stops past its upper key */
+#define XTNT_SET_ITER_END 4 /**< Set once the cursor has passed the last member */
+#define XTNT_SET_ITER_PATH (2 * 8 * sizeof(xtnt_uint_t)) /**< Pending ancestors a cursor keeps, enough for a red-black tree of any count */
+
+#ifdef XTNT_DEFAULT_SET_SEQLOCK_RETRY
+#define XTNT_SET_SEQLOCK_RETRY (XTNT_DEFAULT_SET_SEQLOCK_RETRY) /**< Optimistic reads before a reader takes the mutex */
+#else
+#define XTNT_SET_SEQLOCK_RETRY (4) /**< Optimistic reads before a reader takes the mutex */
+#endif /* ifndef XTNT_DEFAULT_SET_SEQLOCK_RETRY */
+
+#ifdef XTNT_DEFAULT_SET_SPIN_LIMIT
+#define XTNT_SET_SPIN_LIMIT (XTNT_DEFAULT_SET_SPIN_LIMIT) /**< Longest pause run before a spinning thread yields */
+#else
+#define XTNT_SET_SPIN_LIMIT (1024) /**< Longest pause run before a spinning thread yields */
+#endif /* ifndef XTNT_DEFAULT_SET_SPIN_LIMIT */
+
 struct xtnt_node_set_if; // Forward Declaration
 
 struct xtnt_node_set {
@@ -42,7 +66,30 @@ struct xtnt_node_set {
     xtnt_uint_t count;
     xtnt_uint_t size;
     const struct xtnt_node_set_if *fn;
-    pthread_mutex_t lock;
+    union {
+        pthread_mutex_t lock;
+        pthread_rwlock_t rwlock;
+        xtnt_uint_t spin;
+    };
+    xtnt_uint_t policy; /**< XTNT_SET_LOCK_*, fixed at initialization */
+    xtnt_uint_t sequence; /**< Odd while a writer holds a XTNT_SET_LOCK_SEQLOCK set */
+};
+
+/*
+ * A cursor over the members of a Node Set, see `xtnt_set_iter_begin()`.
+ * The set's next operation visits the member after `node`, or the first
+ * when `node` is NULL. Tables keep their position in `index` instead, and
+ * trees keep the ancestors still to visit in `path`, `index` deep.
+ */
+struct xtnt_set_iter {
+    struct xtnt_node_set *set;
+    struct xtnt_node *node; /**< Member visited last, NULL before the first */
+    struct xtnt_node **table; /**< Members copied by XTNT_SET_ITER_SNAPSHOT */
+    size_t index; /**< Position of the next slot or copied member, or depth of path */
+    size_t count; /**< Members copied by XTNT_SET_ITER_SNAPSHOT */
+    xtnt_uint_t upper; /**< Greatest key visited by a range */
+    xtnt_uint_t mode; /**< XTNT_SET_ITER_LOCK or XTNT_SET_ITER_SNAPSHOT, with XTNT_SET_ITER_RANGE and XTNT_SET_ITER_END */
+    struct xtnt_node *path[XTNT_SET_ITER_PATH]; /**< Ancestors of a tree cursor not yet visited */
 };
 
 /* See https://stackoverflow.com/questions/17621544/dynamic-method-dispatching-in-c/17622474#17622474 */
@@ -68,14 +115,91 @@ struct xtnt_node_set_if {
 
     xtnt_status_t (*sort)(struct xtnt_node_set *set);
     xtnt_status_t (*sort_reverse)(struct xtnt_node_set *set);
-    xtnt_status_t (*sort_fn)(struct xtnt_node_set *set, void *fn);
+    xtnt_status_t (*sort_fn)(struct xtnt_node_set *set, xtnt_node_compare_fn compare);
 
     xtnt_status_t (*grow)(struct xtnt_node_set *set);
     xtnt_status_t (*grow_eval)(struct xtnt_node_set *set, size_t eval);
     xtnt_status_t (*shrink)(struct xtnt_node_set *set);
     xtnt_status_t (*shrink_eval)(struct xtnt_node_set *set, size_t eval);
+/* Cursors, called by the xtnt_set_iter_* functions with the set read locked */
+    xtnt_status_t (*next)(struct xtnt_node_set *set, struct xtnt_set_iter *iter, struct xtnt_node **node);
+    xtnt_status_t (*seek)(struct xtnt_node_set *set, struct xtnt_set_iter *iter, xtnt_uint_t key);
 };
 
+/*
+ * A set type points the operations it does not support at these stubs, so
+ * every member of its `xtnt_node_set_if` is callable and returns ENOTSUP.
+ */
+
+extern const struct xtnt_node_set_if xtnt_node_set_enotsup_if;
+
+xtnt_status_t
+xtnt_node_set_enotsup(
+    struct xtnt_node_set *set);
+
+xtnt_status_t
+xtnt_node_set_enotsup_eval(
+    struct xtnt_node_set *set,
+    size_t eval);
+
+xtnt_status_t
+xtnt_node_set_enotsup_fn(
+    struct xtnt_node_set *set,
+    xtnt_node_compare_fn compare);
+
+xtnt_status_t
+xtnt_node_set_enotsup_index(
+    struct xtnt_node_set *set,
+    xtnt_int_t index,
+    struct xtnt_node **found);
+
+xtnt_status_t
+xtnt_node_set_enotsup_insert_at(
+    struct xtnt_node_set *set,
+    xtnt_uint_t index,
+    struct xtnt_node *node,
+    struct xtnt_node **replaced);
+
+xtnt_status_t
+xtnt_node_set_enotsup_key(
+    struct xtnt_node_set *set,
+    xtnt_uint_t key,
+    struct xtnt_node **found);
+
+xtnt_status_t
+xtnt_node_set_enotsup_next(
+    struct xtnt_node_set *set,
+    struct xtnt_set_iter *iter,
+    struct xtnt_node **node);
+
+xtnt_status_t
+xtnt_node_set_enotsup_node(
+    struct xtnt_node_set *set,
+    struct xtnt_node *node);
+
+xtnt_status_t
+xtnt_node_set_enotsup_out(
+    struct xtnt_node_set *set,
+    struct xtnt_node **node);
+
+xtnt_status_t
+xtnt_node_set_enotsup_search_fn(
+    struct xtnt_node_set *set,
+    void *fn,
+    void *needle,
+    struct xtnt_node **found);
+
+xtnt_status_t
+xtnt_node_set_enotsup_seek(
+    struct xtnt_node_set *set,
+    struct xtnt_set_iter *iter,
+    xtnt_uint_t key);
+
+xtnt_status_t
+xtnt_node_set_enotsup_state(
+    struct xtnt_node_set *set,
+    xtnt_uint_t **state);
+
 xtnt_status_t
 xtnt_set_index(
     struct xtnt_node_set *set,
@@ -164,7 +288,7 @@ xtnt_set_sort_reverse(
 xtnt_status_t
 xtnt_set_sort_fn(
     struct xtnt_node_set *set,
-    void *fn);
+    xtnt_node_compare_fn compare);
 
 xtnt_status_t
 xtnt_set_grow(
@@ -184,6 +308,43 @@ xtnt_set_shrink_eval(
     struct xtnt_node_set *set,
     size_t eval);
 
+xtnt_status_t
+xtnt_set_iter_begin(
+    struct xtnt_node_set *set,
+    struct xtnt_set_iter *iter,
+    xtnt_uint_t mode);
+
+xtnt_status_t
+xtnt_set_iter_range(
+    struct xtnt_node_set *set,
+    struct xtnt_set_iter *iter,
+    xtnt_uint_t lower,
+    xtnt_uint_t upper,
+    xtnt_uint_t mode);
+
+xtnt_status_t
+xtnt_set_iter_next(
+    struct xtnt_set_iter *iter,
+    struct xtnt_node **node);
+
+xtnt_status_t
+xtnt_set_iter_end(
+    struct xtnt_set_iter *iter);
+
+xtnt_status_t
+xtnt_set_for_each(
+    struct xtnt_node_set *set,
+    xtnt_node_visit_fn visit,
+    void *ctx);
+
+xtnt_status_t
+xtnt_set_for_each_range(
+    struct xtnt_node_set *set,
+    xtnt_uint_t lower,
+    xtnt_uint_t upper,
+    xtnt_node_visit_fn visit,
+    void *ctx);
+
 xtnt_status_t
 xtnt_node_set_copy(
     struct xtnt_node_set *src,
@@ -193,8 +354,198 @@ xtnt_status_t
 xtnt_node_set_initialize(
     struct xtnt_node_set *set);
 
+xtnt_status_t
+xtnt_node_set_initialize_lock(
+    struct xtnt_node_set *set,
+    xtnt_uint_t policy);
+
 xtnt_status_t
 xtnt_node_set_uninitialize(
     struct xtnt_node_set *set);
 
+void
+xtnt_node_set_spin_wait(
+    struct xtnt_node_set *set);
+
+/*
+ * The lock operations are inline so the policy branch and the lock itself
+ * compile into each set operation, a XTNT_SET_LOCK_NONE set only tests the
+ * policy. src/set/common.c holds the external definitions.
+ */
+
+/**
+ * @brief Lock a Node Set for reading
+ *
+ * @param[in] set The Node Set to lock
+ * @retval XTNT_ESUCCESS on lock
+ * @retval return value of `pthread_rwlock_rdlock()` or `pthread_mutex_lock()`
+ *
+ * @note A XTNT_SET_LOCK_SEQLOCK set takes the mutex, excluding writers.
+ */
+inline xtnt_status_t
+xtnt_node_set_read_lock(
+    struct xtnt_node_set *set)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    switch (set->policy) {
+        case XTNT_SET_LOCK_NONE:
+            return XTNT_ESUCCESS;
+        case XTNT_SET_LOCK_SPIN:
+            if (__atomic_exchange_n(&(set->spin), 1, __ATOMIC_ACQUIRE)) {
+                xtnt_node_set_spin_wait(set);
+            }
+            return XTNT_ESUCCESS;
+        case XTNT_SET_LOCK_RWLOCK:
+            res = pthread_rwlock_rdlock(&(set->rwlock));
+            break;
+        default:
+            res = pthread_mutex_lock(&(set->lock));
+            break;
+    }
+    if (res != XTNT_ESUCCESS) {
+        XTNT_LOCK_SET_LOCK_FAIL(set->root.state);
+    }
+    return res;
+}
+
+/**
+ * @brief Unlock a Node Set locked with `xtnt_node_set_read_lock()`
+ *
+ * @param[in] set The Node Set to unlock
+ * @retval XTNT_ESUCCESS on unlock
+ * @retval return value of `pthread_rwlock_unlock()` or `pthread_mutex_unlock()`
+ */
+inline xtnt_status_t
+xtnt_node_set_read_unlock(
+    struct xtnt_node_set *set)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    switch (set->policy) {
+        case XTNT_SET_LOCK_NONE:
+            return XTNT_ESUCCESS;
+        case XTNT_SET_LOCK_SPIN:
+            __atomic_store_n(&(set->spin), XTNT_ZERO, __ATOMIC_RELEASE);
+            return XTNT_ESUCCESS;
+        case XTNT_SET_LOCK_RWLOCK:
+            res = pthread_rwlock_unlock(&(set->rwlock));
+            break;
+        default:
+            res = pthread_mutex_unlock(&(set->lock));
+            break;
+    }
+    if (res != XTNT_ESUCCESS) {
+        XTNT_LOCK_SET_UNLOCK_FAIL(set->root.state);
+    }
+    return res;
+}
+
+/**
+ * @brief Lock a Node Set for writing
+ *
+ * @param[in] set The Node Set to lock
+ * @retval XTNT_ESUCCESS on lock
+ * @retval return value of `pthread_rwlock_wrlock()` or `pthread_mutex_lock()`
+ *
+ * @note A XTNT_SET_LOCK_SEQLOCK set has an odd sequence until
+ * `xtnt_node_set_write_unlock()`, failing optimistic reads started meanwhile.
+ */
+inline xtnt_status_t
+xtnt_node_set_write_lock(
+    struct xtnt_node_set *set)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    switch (set->policy) {
+        case XTNT_SET_LOCK_NONE:
+            return XTNT_ESUCCESS;
+        case XTNT_SET_LOCK_SPIN:
+            if (__atomic_exchange_n(&(set->spin), 1, __ATOMIC_ACQUIRE)) {
+                xtnt_node_set_spin_wait(set);
+            }
+            return XTNT_ESUCCESS;
+        case XTNT_SET_LOCK_RWLOCK:
+            res = pthread_rwlock_wrlock(&(set->rwlock));
+            break;
+        default:
+            res = pthread_mutex_lock(&(set->lock));
+            break;
+    }
+    if (res != XTNT_ESUCCESS) {
+        XTNT_LOCK_SET_LOCK_FAIL(set->root.state);
+    } else if (set->policy == XTNT_SET_LOCK_SEQLOCK) {
+        __atomic_store_n(&(set->sequence), set->sequence + 1, __ATOMIC_RELAXED);
+        // The odd sequence is visible before any store to the set
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+    }
+    return res;
+}
+
+/**
+ * @brief Unlock a Node Set locked with `xtnt_node_set_write_lock()`
+ *
+ * @param[in] set The Node Set to unlock
+ * @retval XTNT_ESUCCESS on unlock
+ * @retval return value of `pthread_rwlock_unlock()` or `pthread_mutex_unlock()`
+ */
+inline xtnt_status_t
+xtnt_node_set_write_unlock(
+    struct xtnt_node_set *set)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    switch (set->policy) {
+        case XTNT_SET_LOCK_NONE:
+            return XTNT_ESUCCESS;
+        case XTNT_SET_LOCK_SPIN:
+            __atomic_store_n(&(set->spin), XTNT_ZERO, __ATOMIC_RELEASE);
+            return XTNT_ESUCCESS;
+        case XTNT_SET_LOCK_RWLOCK:
+            res = pthread_rwlock_unlock(&(set->rwlock));
+            break;
+        case XTNT_SET_LOCK_SEQLOCK:
+            __atomic_store_n(&(set->sequence), set->sequence + 1, __ATOMIC_RELEASE);
+            res = pthread_mutex_unlock(&(set->lock));
+            break;
+        default:
+            res = pthread_mutex_unlock(&(set->lock));
+            break;
+    }
+    if (res != XTNT_ESUCCESS) {
+        XTNT_LOCK_SET_UNLOCK_FAIL(set->root.state);
+    }
+    return res;
+}
+
+/**
+ * @brief Begin an optimistic read of a XTNT_SET_LOCK_SEQLOCK Node Set
+ *
+ * @param[in] set The Node Set to read
+ * @return the sequence to pass to `xtnt_node_set_read_validate()`
+ *
+ * @note Reads between begin and a successful validate must only be used
+ * after validation, they may observe a set in the middle of a write.
+ */
+inline xtnt_uint_t
+xtnt_node_set_read_begin(
+    struct xtnt_node_set *set)
+{
+    return __atomic_load_n(&(set->sequence), __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Validate an optimistic read of a XTNT_SET_LOCK_SEQLOCK Node Set
+ *
+ * @param[in] set The Node Set read
+ * @param[in] sequence The value returned by `xtnt_node_set_read_begin()`
+ * @return non-zero when no writer ran during the read, zero to retry
+ */
+inline xtnt_uint_t
+xtnt_node_set_read_validate(
+    struct xtnt_node_set *set,
+    xtnt_uint_t sequence)
+{
+    // The reads of the set complete before the sequence is read again
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return !(sequence & 1) &&
+        __atomic_load_n(&(set->sequence), __ATOMIC_RELAXED) == sequence;
+}
+
 #endif /* ifndef _XTNT_SET_COMMON_H_ */
@@ -0,0 +1,134 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#ifndef _XTNT_SET_HASHSET_H_
+#define _XTNT_SET_HASHSET_H_
+
+#include <extant/set/common.h>
+
+#ifdef XTNT_DEFAULT_HASHSET_SIZE
+#define XTNT_HASHSET_SIZE (XTNT_DEFAULT_HASHSET_SIZE) /**< Minimum slots, a power of 2 */
+#else
+#define XTNT_HASHSET_SIZE (16) /**< Minimum slots, a power of 2 */
+#endif /* ifndef XTNT_DEFAULT_HASHSET_SIZE */
+
+#ifdef XTNT_DEFAULT_HASHSET_MIGRATE
+#define XTNT_HASHSET_MIGRATE (XTNT_DEFAULT_HASHSET_MIGRATE) /**< Members moved per modification while resizing */
+#else
+#define XTNT_HASHSET_MIGRATE (8) /**< Members moved per modification while resizing */
+#endif /* ifndef XTNT_DEFAULT_HASHSET_MIGRATE */
+
+#define XTNT_HASHSET_LOAD_NUM (7) /**< Maximum load factor numerator */
+#define XTNT_HASHSET_LOAD_DEN (8) /**< Maximum load factor denominator */
+
+extern const struct xtnt_node_set_if xtnt_hashset_if;
+
+xtnt_status_t
+xtnt_hashset_delete(
+    struct xtnt_node_set *set,
+    xtnt_uint_t key,
+    struct xtnt_node **deleted);
+
+struct xtnt_node *
+xtnt_hashset_delete_locked(
+    struct xtnt_node_set *set,
+    xtnt_uint_t key);
+
+xtnt_status_t
+xtnt_hashset_grow(
+    struct xtnt_node_set *set);
+
+xtnt_status_t
+xtnt_hashset_grow_eval(
+    struct xtnt_node_set *set,
+    size_t eval);
+
+xtnt_status_t
+xtnt_hashset_initialize(
+    struct xtnt_node_set *set);
+
+xtnt_status_t
+xtnt_hashset_initialize_lock(
+    struct xtnt_node_set *set,
+    xtnt_uint_t policy);
+
+xtnt_status_t
+xtnt_hashset_insert(
+    struct xtnt_node_set *set,
+    struct xtnt_node *node);
+
+xtnt_status_t
+xtnt_hashset_insert_locked(
+    struct xtnt_node_set *set,
+    struct xtnt_node *node);
+
+xtnt_status_t
+xtnt_hashset_replace(
+    struct xtnt_node_set *set,
+    struct xtnt_node *node,
+    struct xtnt_node **replaced);
+
+xtnt_status_t
+xtnt_hashset_replace_locked(
+    struct xtnt_node_set *set,
+    struct xtnt_node *node,
+    struct xtnt_node **replaced);
+
+xtnt_status_t
+xtnt_hashset_search(
+    struct xtnt_node_set *set,
+    xtnt_uint_t key,
+    struct xtnt_node **found);
+
+struct xtnt_node *
+xtnt_hashset_search_locked(
+    struct xtnt_node_set *set,
+    xtnt_uint_t key);
+
+xtnt_status_t
+xtnt_hashset_search_fn(
+    struct xtnt_node_set *set,
+    void *test_fn,
+    void *ctx,
+    struct xtnt_node **found);
+
+xtnt_status_t
+xtnt_hashset_shrink(
+    struct xtnt_node_set *set);
+
+xtnt_status_t
+xtnt_hashset_shrink_eval(
+    struct xtnt_node_set *set,
+    size_t eval);
+
+xtnt_status_t
+xtnt_hashset_uninitialize(
+    struct xtnt_node_set *set);
+
+#endif /* ifndef _XTNT_SET_HASHSET_H_ */
@@ -34,6 +34,8 @@ SOFTWARE.
 #include <extant/set/common.h>
 #endif /* _XTNT_SET_COMMON_H_ */
 
+extern const struct xtnt_node_set_if xtnt_list_if;
+
 xtnt_status_t
 xtnt_list_delete(
     struct xtnt_node_set *list,
@@ -47,9 +49,30 @@ xtnt_list_get(
     struct xtnt_node **node);
 
 xtnt_status_t
-xtnt_list_insert(
+xtnt_list_initialize(
+    struct xtnt_node_set *list);
+
+xtnt_status_t
+xtnt_list_initialize_lock(
+    struct xtnt_node_set *list,
+    xtnt_uint_t policy);
+
+xtnt_status_t
+xtnt_list_insert_chain(
+    struct xtnt_node_set *list,
+    struct xtnt_node *head);
+
+xtnt_status_t
+xtnt_list_insert_many(
     struct xtnt_node_set *list,
-    struct xtnt_node *node);
+    xtnt_uint_t count,
+    struct xtnt_node **nodes);
+
+xtnt_status_t
+xtnt_list_remove_many(
+    struct xtnt_node_set *list,
+    xtnt_uint_t count,
+    struct xtnt_node **nodes);
 
 xtnt_status_t
 xtnt_list_replace(
@@ -71,4 +94,53 @@ xtnt_list_search_fn(
     void *ctx,
     struct xtnt_node **found);
 
+xtnt_status_t
+xtnt_list_sort(
+    struct xtnt_node_set *list);
+
+xtnt_status_t
+xtnt_list_sort_fn(
+    struct xtnt_node_set *list,
+    xtnt_node_compare_fn compare);
+
+xtnt_status_t
+xtnt_list_sort_reverse(
+    struct xtnt_node_set *list);
+
+/**
+ * @brief Add a node to the list
+ *
+ * @param[in] list The Node Set to add to
+ * @param[in] node The Node to add
+ * @return node added or NULL on error
+ *
+ * @warning
+ * Do not re-add an existing member to the list. To attach the same value,
+ * create a new node with the value, and add the new node instead.
+ */
+inline xtnt_status_t
+xtnt_list_insert(
+    struct xtnt_node_set *list,
+    struct xtnt_node *node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(list)) == XTNT_ESUCCESS) {
+        if (list->count == 0){
+            // We are the head and tail
+            list->root.link[XTNT_NODE_HEAD] = node;
+            list->root.link[XTNT_NODE_TAIL] = node;
+        } else {
+            // We have a new tail
+            node->link[XTNT_NODE_TAIL] = list->root.link[XTNT_NODE_HEAD];
+            // We are a new head to our tail
+            list->root.link[XTNT_NODE_HEAD]->link[XTNT_NODE_HEAD] = node;
+            // We are the new head
+            list->root.link[XTNT_NODE_HEAD] = node;
+        }
+        list->count++;
+        res = xtnt_node_set_write_unlock(list);
+    }
+    return res;
+}
+
 #endif /* ifndef _XTNT_SET_LIST_H_ */
@@ -0,0 +1,100 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#ifndef _XTNT_SET_LIST_CLIST_H_
+#define _XTNT_SET_LIST_CLIST_H_
+
+#ifndef _XTNT_SET_COMMON_H_
+#include <extant/set/common.h>
+#endif /* _XTNT_SET_COMMON_H_ */
+
+/*
+ * A compact list links `struct xtnt_cnode` members instead of
+ * `struct xtnt_node`. The root keeps the newest member in
+ * root.link[XTNT_NODE_HEAD] and the oldest in root.link[XTNT_NODE_TAIL],
+ * and each member links to the next older one through
+ * link[XTNT_CNODE_TAIL], as a list does.
+ *
+ * Through `xtnt_clist_if` the `xtnt_set_*` insert, push and remove take
+ * compact nodes cast to `struct xtnt_node`. Operations returning or visiting
+ * members, cursors and `xtnt_set_for_each()` included, are ENOTSUP.
+ */
+
+extern const struct xtnt_node_set_if xtnt_clist_if;
+
+xtnt_status_t
+xtnt_clist_delete(
+    struct xtnt_node_set *list,
+    xtnt_uint_t index,
+    struct xtnt_cnode **deleted);
+
+xtnt_status_t
+xtnt_clist_get(
+    struct xtnt_node_set *list,
+    xtnt_uint_t index,
+    struct xtnt_cnode **node);
+
+xtnt_status_t
+xtnt_clist_initialize(
+    struct xtnt_node_set *list);
+
+xtnt_status_t
+xtnt_clist_initialize_lock(
+    struct xtnt_node_set *list,
+    xtnt_uint_t policy);
+
+xtnt_status_t
+xtnt_clist_insert(
+    struct xtnt_node_set *list,
+    struct xtnt_cnode *node);
+
+xtnt_status_t
+xtnt_clist_pop(
+    struct xtnt_node_set *list,
+    struct xtnt_cnode **node);
+
+xtnt_status_t
+xtnt_clist_remove(
+    struct xtnt_node_set *list,
+    struct xtnt_cnode *node);
+
+xtnt_status_t
+xtnt_clist_search(
+    struct xtnt_node_set *list,
+    xtnt_uint_t key,
+    struct xtnt_cnode **found);
+
+xtnt_status_t
+xtnt_clist_search_fn(
+    struct xtnt_node_set *list,
+    void *test_fn,
+    void *ctx,
+    struct xtnt_cnode **found);
+
+#endif /* ifndef _XTNT_SET_LIST_CLIST_H_ */
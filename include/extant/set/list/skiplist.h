@@ -0,0 +1,115 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#ifndef _XTNT_SET_LIST_SKIPLIST_H_
+#define _XTNT_SET_LIST_SKIPLIST_H_
+
+#ifndef _XTNT_SET_COMMON_H_
+#include <extant/set/common.h>
+#endif /* _XTNT_SET_COMMON_H_ */
+
+#define XTNT_SKIPLIST_LEVELS (32) /**< Most levels of a skip list */
+
+/*
+ * An indexed skip list keeps its members ordered by key. Each member has a
+ * tower of forward links, one per level, each recording the members it
+ * skips, so members are reached by key or by index in O(log n).
+ *
+ * Members stay linked as a list does: root.link[XTNT_NODE_HEAD] is the
+ * least key and root.link[XTNT_NODE_TAIL] the greatest, each member links
+ * to the next greater through link[XTNT_NODE_TAIL] and back through
+ * link[XTNT_NODE_HEAD]. A member's tower is at link[XTNT_NODE_MIDDLE] and
+ * the list's own at root.link[XTNT_NODE_MIDDLE].
+ *
+ * Under XTNT_SET_LOCK_SEQLOCK get, rank and search read without locking.
+ * The towers of removed members are then kept for reuse instead of freed,
+ * and each tower holds the key of its member, so a walk reads towers only.
+ * A member is returned once the read validated, but a writer may remove it
+ * right after, so removed members must stay readable memory while readers
+ * may still be running, as with every optimistic reader.
+ */
+
+extern const struct xtnt_node_set_if xtnt_skiplist_if;
+
+xtnt_status_t
+xtnt_skiplist_delete(
+    struct xtnt_node_set *list,
+    xtnt_uint_t index,
+    struct xtnt_node **deleted);
+
+xtnt_status_t
+xtnt_skiplist_get(
+    struct xtnt_node_set *list,
+    xtnt_uint_t index,
+    struct xtnt_node **node);
+
+xtnt_status_t
+xtnt_skiplist_initialize(
+    struct xtnt_node_set *list);
+
+xtnt_status_t
+xtnt_skiplist_initialize_lock(
+    struct xtnt_node_set *list,
+    xtnt_uint_t policy);
+
+xtnt_status_t
+xtnt_skiplist_insert(
+    struct xtnt_node_set *list,
+    struct xtnt_node *node);
+
+xtnt_status_t
+xtnt_skiplist_rank(
+    struct xtnt_node_set *list,
+    xtnt_uint_t key,
+    xtnt_uint_t *index);
+
+xtnt_status_t
+xtnt_skiplist_remove(
+    struct xtnt_node_set *list,
+    xtnt_uint_t key,
+    struct xtnt_node **removed);
+
+xtnt_status_t
+xtnt_skiplist_search(
+    struct xtnt_node_set *list,
+    xtnt_uint_t key,
+    struct xtnt_node **found);
+
+xtnt_status_t
+xtnt_skiplist_search_fn(
+    struct xtnt_node_set *list,
+    void *test_fn,
+    void *ctx,
+    struct xtnt_node **found);
+
+xtnt_status_t
+xtnt_skiplist_uninitialize(
+    struct xtnt_node_set *list);
+
+#endif /* ifndef _XTNT_SET_LIST_SKIPLIST_H_ */
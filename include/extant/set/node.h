@@ -48,6 +48,63 @@ struct xtnt_node {
     xtnt_uint_t state;
 };
 
+#define XTNT_CNODE_HEAD 0
+#define XTNT_CNODE_TAIL 1
+
+/*
+ * A compact node keeps only what a traversal reads, 32 bytes with 64 bit
+ * pointers where `struct xtnt_node` takes 48 to 56, so two share a cache
+ * line. Following link[XTNT_CNODE_TAIL] alone makes a singly linked chain.
+ */
+struct xtnt_cnode {
+    struct xtnt_cnode *link[2];
+    xtnt_uint_t key;
+    const void *value;
+};
+
+/*
+ * A key and value pair for tables scanned by key, 16 bytes, four to a line.
+ */
+struct xtnt_entry {
+    xtnt_uint_t key;
+    const void *value;
+};
+
+/*
+ * Orders two nodes for the sort operations, negative when `a` sorts before
+ * `b`, zero when they are equal and positive when `a` sorts after `b`.
+ */
+typedef xtnt_int_t (*xtnt_node_compare_fn)(const struct xtnt_node *a, const struct xtnt_node *b);
+
+/*
+ * Called on each member by the for each operations, which stop at and
+ * return the first status other than XTNT_ESUCCESS.
+ */
+typedef xtnt_status_t (*xtnt_node_visit_fn)(void *ctx, struct xtnt_node *node);
+
+xtnt_status_t
+xtnt_node_chain(
+    struct xtnt_node *head,
+    struct xtnt_node **tail,
+    xtnt_uint_t *count);
+
+xtnt_status_t
+xtnt_node_chain_table(
+    struct xtnt_node **nodes,
+    xtnt_uint_t count,
+    struct xtnt_node **head,
+    struct xtnt_node **tail);
+
+xtnt_int_t
+xtnt_node_compare_key(
+    const struct xtnt_node *a,
+    const struct xtnt_node *b);
+
+xtnt_int_t
+xtnt_node_compare_key_reverse(
+    const struct xtnt_node *a,
+    const struct xtnt_node *b);
+
 xtnt_status_t
 xtnt_node_initialize(
     struct xtnt_node *node,
@@ -59,6 +116,12 @@ xtnt_status_t
 xtnt_node_uninitialize(
     struct xtnt_node *node);
 
+xtnt_status_t
+xtnt_cnode_initialize(
+    struct xtnt_cnode *node,
+    xtnt_uint_t key,
+    void *value);
+
 xtnt_status_t
 xtnt_node_copy(
     struct xtnt_node *src,
@@ -34,19 +34,209 @@ SOFTWARE.
 #include <extant/set/common.h>
 #endif /* _XTNT_SET_COMMON_H_ */
 
+#define XTNT_QUEUE_MODE_LOCKED (XTNT_MODE_1) /**< Mutex guarded queue */
+#define XTNT_QUEUE_MODE_MPSC (XTNT_MODE_2) /**< Lock-free multi-producer, single consumer queue */
+
+extern const struct xtnt_node_set_if xtnt_queue_if;
+
 xtnt_status_t
-xtnt_queue_peek(
+xtnt_queue_drain(
     struct xtnt_node_set *queue,
-    struct xtnt_node **node);
+    struct xtnt_node **head);
 
 xtnt_status_t
-xtnt_queue_pop(
+xtnt_queue_initialize(
+    struct xtnt_node_set *queue,
+    xtnt_uint_t mode);
+
+xtnt_status_t
+xtnt_queue_initialize_lock(
     struct xtnt_node_set *queue,
-    struct xtnt_node **node);
+    xtnt_uint_t mode,
+    xtnt_uint_t policy);
 
 xtnt_status_t
+xtnt_queue_pop_batch(
+    struct xtnt_node_set *queue,
+    xtnt_uint_t max,
+    struct xtnt_node **nodes,
+    xtnt_uint_t *count);
+
+xtnt_status_t
+xtnt_queue_push_chain(
+    struct xtnt_node_set *queue,
+    struct xtnt_node *head);
+
+xtnt_status_t
+xtnt_queue_push_many(
+    struct xtnt_node_set *queue,
+    xtnt_uint_t count,
+    struct xtnt_node **nodes);
+
+struct xtnt_node *
+xtnt_queue_mpsc_pop(
+    struct xtnt_node_set *queue);
+
+/*
+ * The single node operations are inline so a queue known at the call site
+ * compiles without a call, src/set/queue.c holds the external definitions.
+ *
+ * In XTNT_QUEUE_MODE_MPSC the root of the set is the stub node of an
+ * intrusive Vyukov queue. root.link[XTNT_NODE_MIDDLE] is the producer end,
+ * root.link[XTNT_NODE_TAIL] the consumer end, and each node links to the
+ * next newer node through link[XTNT_NODE_HEAD], as in the locked queue.
+ */
+
+/**
+ * @brief Link a node onto the producer end of an MPSC queue
+ *
+ * @param[in] queue The `xtnt_node_set` to operate on
+ * @param[in] node The `xtnt_node` to add to the queue
+ */
+inline void
+xtnt_queue_mpsc_link(
+    struct xtnt_node_set *queue,
+    struct xtnt_node *node)
+{
+    struct xtnt_node *prev = NULL;
+    __atomic_store_n(&(node->link[XTNT_NODE_HEAD]), NULL, __ATOMIC_RELAXED);
+    prev = __atomic_exchange_n(&(queue->root.link[XTNT_NODE_MIDDLE]), node, __ATOMIC_ACQ_REL);
+    __atomic_store_n(&(prev->link[XTNT_NODE_HEAD]), node, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Remove the next entry from a locked queue, with the lock held
+ *
+ * @param[in] queue The `xtnt_node_set` to operate on
+ * @return the oldest node, or NULL if empty
+ */
+inline struct xtnt_node *
+xtnt_queue_locked_pop(
+    struct xtnt_node_set *queue)
+{
+    struct xtnt_node *node = queue->root.link[XTNT_NODE_TAIL];
+    if (node != NULL) {
+        if ((uintptr_t) queue->root.link[XTNT_NODE_HEAD] ^
+            (uintptr_t) queue->root.link[XTNT_NODE_TAIL]) {
+            node->link[XTNT_NODE_HEAD]->link[XTNT_NODE_TAIL] = NULL;
+            queue->root.link[XTNT_NODE_TAIL] = node->link[XTNT_NODE_HEAD];
+        } else {
+            queue->root.link[XTNT_NODE_TAIL] = NULL;
+            queue->root.link[XTNT_NODE_HEAD] = NULL;
+        }
+        queue->count--;
+    }
+    return node;
+}
+
+/**
+ * @brief Peek at the next entry in a queue
+ *
+ * @param[in] queue The xtnt_node_set to operate on
+ * @param[out] node The xtnt_node or NULL if queue is empty
+ * @retval XTNT_ESUCCESS on successful peek
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ *
+ * @note A XTNT_SET_LOCK_SEQLOCK queue is peeked without locking.
+ *
+ * @note In XTNT_QUEUE_MODE_MPSC only the consumer may peek.
+ */
+inline xtnt_status_t
+xtnt_queue_peek(
+    struct xtnt_node_set *queue,
+    struct xtnt_node **node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_node *peek = NULL;
+    if (XTNT_MODE(queue->root.state) == XTNT_QUEUE_MODE_MPSC) {
+        *node = queue->root.link[XTNT_NODE_TAIL];
+        if (*node == &(queue->root)) {
+            *node = __atomic_load_n(&((*node)->link[XTNT_NODE_HEAD]), __ATOMIC_ACQUIRE);
+        }
+        return XTNT_ESUCCESS;
+    }
+    if (queue->policy == XTNT_SET_LOCK_SEQLOCK) {
+        // One pointer load is a consistent read, no sequence to validate
+        if ((peek = __atomic_load_n(&(queue->root.link[XTNT_NODE_TAIL]), __ATOMIC_ACQUIRE)) != NULL) {
+            *node = peek;
+        }
+        return XTNT_ESUCCESS;
+    }
+    if ((res = xtnt_node_set_read_lock(queue)) == XTNT_ESUCCESS) {
+        if (queue->root.link[XTNT_NODE_TAIL] != NULL) {
+            *node = queue->root.link[XTNT_NODE_TAIL];
+        }
+        res = xtnt_node_set_read_unlock(queue);
+    }
+    return res;
+}
+
+/**
+ * @brief Remove the next entry in the queue
+ *
+ * @param[in] queue The `xtnt_node_set` to operate on
+ * @param[out] node The xtnt_node or NULL if queue is empty
+ * @retval XTNT_ESUCCESS on successful pop
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note In XTNT_QUEUE_MODE_MPSC only one thread may pop, without locking.
+ */
+inline xtnt_status_t
+xtnt_queue_pop(
+    struct xtnt_node_set *queue,
+    struct xtnt_node **node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if (XTNT_MODE(queue->root.state) == XTNT_QUEUE_MODE_MPSC) {
+        *node = xtnt_queue_mpsc_pop(queue);
+        return XTNT_ESUCCESS;
+    }
+    if ((res = xtnt_node_set_write_lock(queue)) == XTNT_ESUCCESS) {
+        *node = xtnt_queue_locked_pop(queue);
+        res = xtnt_node_set_write_unlock(queue);
+    }
+    return res;
+}
+
+/**
+ * @brief Add an entry to the queue
+ *
+ * @param[in] queue The `xtnt_node_set` to operate on
+ * @param[in] node The `xtnt_node` to add to the queue
+ * @retval XTNT_ESUCCESS on successful push
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note In XTNT_QUEUE_MODE_MPSC any number of threads may push without
+ * locking.
+ */
+inline xtnt_status_t
 xtnt_queue_push(
     struct xtnt_node_set *queue,
-    struct xtnt_node *node);
+    struct xtnt_node *node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if (XTNT_MODE(queue->root.state) == XTNT_QUEUE_MODE_MPSC) {
+        // Count first so the count never trails a node the consumer can pop
+        __atomic_add_fetch(&(queue->count), 1, __ATOMIC_RELAXED);
+        xtnt_queue_mpsc_link(queue, node);
+        return XTNT_ESUCCESS;
+    }
+    if ((res = xtnt_node_set_write_lock(queue)) == XTNT_ESUCCESS) {
+        if (queue->root.link[XTNT_NODE_HEAD] != NULL) {
+            queue->root.link[XTNT_NODE_HEAD]->link[XTNT_NODE_HEAD] = node;
+            node->link[XTNT_NODE_TAIL] = queue->root.link[XTNT_NODE_HEAD];
+            queue->root.link[XTNT_NODE_HEAD] = node;
+        } else {
+            queue->root.link[XTNT_NODE_TAIL] = node;
+            queue->root.link[XTNT_NODE_HEAD] = node;
+        }
+        queue->count++;
+        res = xtnt_node_set_write_unlock(queue);
+    }
+    return res;
+}
 
 #endif /* ifndef _XTNT_SET_QUEUE_H_ */
@@ -0,0 +1,113 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#ifndef _XTNT_SET_SHARDMAP_H_
+#define _XTNT_SET_SHARDMAP_H_
+
+#include <extant/set/hashset.h>
+
+#ifdef XTNT_DEFAULT_SHARDMAP_FACTOR
+#define XTNT_SHARDMAP_FACTOR (XTNT_DEFAULT_SHARDMAP_FACTOR) /**< Shards per online CPU */
+#else
+#define XTNT_SHARDMAP_FACTOR (4) /**< Shards per online CPU */
+#endif /* ifndef XTNT_DEFAULT_SHARDMAP_FACTOR */
+
+#define XTNT_SHARDMAP_MAX (256) /**< Maximum shards of a map */
+#define XTNT_SHARDMAP_BATCH (256) /**< Keys grouped by shard at a time */
+#define XTNT_SHARDMAP_ALIGN (64) /**< Alignment separating shard locks */
+
+struct xtnt_shardmap_shard;
+
+/**
+ * @struct xtnt_shardmap
+ *
+ * Concurrent map of nodes by key over independently locked hash set shards
+ */
+struct xtnt_shardmap
+{
+/**
+ * @private
+ * The hash set shards, each on its own cache lines
+ */
+    struct xtnt_shardmap_shard *shard;
+/**
+ * @private
+ * Number of shards, a power of 2
+ */
+    size_t shards;
+};
+
+xtnt_status_t
+xtnt_shardmap_create(
+    size_t shards,
+    struct xtnt_shardmap **map);
+
+xtnt_status_t
+xtnt_shardmap_delete(
+    struct xtnt_shardmap *map,
+    xtnt_uint_t key,
+    struct xtnt_node **deleted);
+
+xtnt_status_t
+xtnt_shardmap_destroy(
+    struct xtnt_shardmap **map);
+
+xtnt_status_t
+xtnt_shardmap_for_each(
+    struct xtnt_shardmap *map,
+    xtnt_node_visit_fn visit,
+    void *ctx);
+
+xtnt_status_t
+xtnt_shardmap_get(
+    struct xtnt_shardmap *map,
+    xtnt_uint_t key,
+    struct xtnt_node **found);
+
+xtnt_status_t
+xtnt_shardmap_get_batch(
+    struct xtnt_shardmap *map,
+    size_t count,
+    const xtnt_uint_t *keys,
+    struct xtnt_node **found);
+
+xtnt_status_t
+xtnt_shardmap_put(
+    struct xtnt_shardmap *map,
+    struct xtnt_node *node,
+    struct xtnt_node **replaced);
+
+xtnt_status_t
+xtnt_shardmap_put_batch(
+    struct xtnt_shardmap *map,
+    size_t count,
+    struct xtnt_node **nodes,
+    struct xtnt_node **replaced);
+
+#endif /* ifndef _XTNT_SET_SHARDMAP_H_ */
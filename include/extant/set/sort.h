@@ -0,0 +1,81 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#ifndef _XTNT_SET_SORT_H_
+#define _XTNT_SET_SORT_H_
+
+#include <extant/set/node.h>
+
+#ifdef XTNT_DEFAULT_SORT_INSERTION
+#define XTNT_SORT_INSERTION (XTNT_DEFAULT_SORT_INSERTION) /**< Most members sorted by insertion */
+#else
+#define XTNT_SORT_INSERTION (16) /**< Most members sorted by insertion */
+#endif /* ifndef XTNT_DEFAULT_SORT_INSERTION */
+
+#ifdef XTNT_DEFAULT_SORT_RADIX
+#define XTNT_SORT_RADIX (XTNT_DEFAULT_SORT_RADIX) /**< Fewest members sorted by key with a radix sort */
+#else
+#define XTNT_SORT_RADIX (1024) /**< Fewest members sorted by key with a radix sort */
+#endif /* ifndef XTNT_DEFAULT_SORT_RADIX */
+
+#ifdef XTNT_DEFAULT_SORT_PARALLEL
+#define XTNT_SORT_PARALLEL (XTNT_DEFAULT_SORT_PARALLEL) /**< Fewest members each thread of a parallel sort takes */
+#else
+#define XTNT_SORT_PARALLEL (1 << 16) /**< Fewest members each thread of a parallel sort takes */
+#endif /* ifndef XTNT_DEFAULT_SORT_PARALLEL */
+
+#define XTNT_SORT_THREADS (256) /**< Most threads of a parallel sort */
+
+xtnt_status_t
+xtnt_sort_chain(
+    struct xtnt_node **head,
+    struct xtnt_node **tail,
+    xtnt_node_compare_fn compare);
+
+xtnt_status_t
+xtnt_sort_table(
+    struct xtnt_node **table,
+    size_t count,
+    xtnt_node_compare_fn compare);
+
+xtnt_status_t
+xtnt_sort_table_parallel(
+    struct xtnt_node **table,
+    size_t count,
+    xtnt_node_compare_fn compare,
+    size_t threads,
+    size_t cutoff);
+
+xtnt_status_t
+xtnt_sort_table_key(
+    struct xtnt_node **table,
+    size_t count,
+    xtnt_uint_t reverse);
+
+#endif /* ifndef _XTNT_SET_SORT_H_ */
@@ -34,19 +34,144 @@ SOFTWARE.
 #include <extant/set/common.h>
 #endif /* _XTNT_SET_COMMON_H_ */
 
+extern const struct xtnt_node_set_if xtnt_stack_if;
+
 xtnt_status_t
-xtnt_stack_peek(
+xtnt_stack_initialize(
+    struct xtnt_node_set *stack);
+
+xtnt_status_t
+xtnt_stack_initialize_lock(
     struct xtnt_node_set *stack,
-    struct xtnt_node **node);
+    xtnt_uint_t policy);
 
 xtnt_status_t
-xtnt_stack_pop(
+xtnt_stack_pop_batch(
     struct xtnt_node_set *stack,
-    struct xtnt_node **node);
+    xtnt_uint_t max,
+    struct xtnt_node **nodes,
+    xtnt_uint_t *count);
 
 xtnt_status_t
+xtnt_stack_push_chain(
+    struct xtnt_node_set *stack,
+    struct xtnt_node *head);
+
+xtnt_status_t
+xtnt_stack_push_many(
+    struct xtnt_node_set *stack,
+    xtnt_uint_t count,
+    struct xtnt_node **nodes);
+
+/**
+ * @brief Remove the top entry from a stack, with the lock held
+ *
+ * @param[in] stack The `xtnt_node_set` to operate on
+ * @return the top node, or NULL if empty
+ */
+inline struct xtnt_node *
+xtnt_stack_locked_pop(
+    struct xtnt_node_set *stack)
+{
+    struct xtnt_node *node = stack->root.link[XTNT_NODE_HEAD];
+    if (node != NULL) {
+        // Use of size_t to compare pointers lead to any bugs?
+        if ((size_t) stack->root.link[XTNT_NODE_HEAD] ^ (size_t) stack->root.link[XTNT_NODE_TAIL]) {
+            node->link[XTNT_NODE_TAIL]->link[XTNT_NODE_HEAD] = NULL;
+            stack->root.link[XTNT_NODE_HEAD] = node->link[XTNT_NODE_TAIL];
+        } else {
+            stack->root.link[XTNT_NODE_HEAD] = NULL;
+            stack->root.link[XTNT_NODE_TAIL] = NULL;
+        }
+        stack->count--;
+    }
+    return node;
+}
+
+/**
+ * @brief Peek at the next entry in a stack
+ *
+ * @param[in] stack The xtnt_node_set to operate on
+ * @param[out] node The xtnt_node or NULL if stack is empty
+ * @retval XTNT_ESUCCESS on successful peek
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ *
+ * @note A XTNT_SET_LOCK_SEQLOCK stack is peeked without locking.
+ */
+inline xtnt_status_t
+xtnt_stack_peek(
+    struct xtnt_node_set *stack,
+    struct xtnt_node **node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_node *peek = NULL;
+    if (stack->policy == XTNT_SET_LOCK_SEQLOCK) {
+        // The top is a single pointer, read without the sequence
+        if ((peek = __atomic_load_n(&(stack->root.link[XTNT_NODE_HEAD]), __ATOMIC_ACQUIRE)) != NULL) {
+            *node = peek;
+        }
+        return XTNT_ESUCCESS;
+    }
+    if ((res = xtnt_node_set_read_lock(stack)) == XTNT_ESUCCESS) {
+        if (stack->root.link[XTNT_NODE_HEAD] != NULL) {
+            *node = stack->root.link[XTNT_NODE_HEAD];
+        }
+        res = xtnt_node_set_read_unlock(stack);
+    }
+    return res;
+}
+
+/**
+ * @brief Remove the next entry in the stack
+ *
+ * @param[in] stack The `xtnt_node_set` to operate on
+ * @param[out] node The xtnt_node or NULL if stack is empty
+ * @retval XTNT_ESUCCESS on successful pop
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ */
+inline xtnt_status_t
+xtnt_stack_pop(
+    struct xtnt_node_set *stack,
+    struct xtnt_node **node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(stack)) == XTNT_ESUCCESS) {
+        *node = xtnt_stack_locked_pop(stack);
+        res = xtnt_node_set_write_unlock(stack);
+    }
+    return res;
+}
+
+/**
+ * @brief Add an entry to the stack
+ *
+ * @param[in] stack The `xtnt_node_set` to operate on
+ * @param[in] node The `xtnt_node` to add to the stack
+ * @retval XTNT_ESUCCESS on successful push
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ */
+inline xtnt_status_t
 xtnt_stack_push(
     struct xtnt_node_set *stack,
-    struct xtnt_node *node);
+    struct xtnt_node *node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(stack)) == XTNT_ESUCCESS) {
+        if (stack->root.link[XTNT_NODE_TAIL] != NULL) {
+            stack->root.link[XTNT_NODE_HEAD]->link[XTNT_NODE_HEAD] = node;
+            node->link[XTNT_NODE_TAIL] = stack->root.link[XTNT_NODE_HEAD];
+            stack->root.link[XTNT_NODE_HEAD] = node;
+        } else {
+            stack->root.link[XTNT_NODE_TAIL] = node;
+            stack->root.link[XTNT_NODE_HEAD] = node;
+        }
+        stack->count++;
+        res = xtnt_node_set_write_unlock(stack);
+    }
+    return res;
+}
 
 #endif /* ifndef _XTNT_SET_STACK_H_ */
@@ -38,38 +38,88 @@ SOFTWARE.
 #define XTNT_TREE_MAX_HEIGHT (16)
 #endif /* ifndef XTNT_DEFAULT_TREE_MAX_HEIGHT */
 
-#define XTNT_TREE_RED (0)
-#define XTNT_TREE_BLACK (1)
+#define XTNT_TREE_RED (0) /**< Red node color */
+#define XTNT_TREE_BLACK (1) /**< Black node color */
 
 #define XTNT_TREE_UNINITIALIZED (0)
 #define XTNT_TREE_INITIALIZED (1)
 #define XTNT_TREE_NOROOT (1)
 #define XTNT_TREE_ROOT (3)
 
-struct xtnt_node *
+/**
+ * @def XTNT_TREE_COLOR(N)
+ * Evaluate the color of node N stored in the mode of its state
+ */
+#define XTNT_TREE_COLOR(N) (XTNT_MODE((N)->state))
+
+extern const struct xtnt_node_set_if xtnt_rbtree_if;
+
+xtnt_status_t
 xtnt_rbtree_delete(
     struct xtnt_node_set *tree,
-	    xtnt_uint_t key);
+    xtnt_uint_t key,
+    struct xtnt_node **deleted);
+
+xtnt_status_t
+xtnt_rbtree_initialize(
+    struct xtnt_node_set *tree);
+
+xtnt_status_t
+xtnt_rbtree_initialize_lock(
+    struct xtnt_node_set *tree,
+    xtnt_uint_t policy);
 
-struct xtnt_node *
+xtnt_status_t
 xtnt_rbtree_insert(
     struct xtnt_node_set *tree,
     struct xtnt_node *node);
 
-struct xtnt_node *
+xtnt_status_t
 xtnt_rbtree_replace(
     struct xtnt_node_set *tree,
-    struct xtnt_node *node);
+    struct xtnt_node *node,
+    struct xtnt_node **replaced);
 
-struct xtnt_node *
+xtnt_status_t
 xtnt_rbtree_search(
     struct xtnt_node_set *tree,
-    xtnt_uint_t key);
+    xtnt_uint_t key,
+    struct xtnt_node **found);
 
-struct xtnt_node *
+xtnt_status_t
 xtnt_rbtree_search_fn(
     struct xtnt_node_set *tree,
     void *test_fn,
-    void *ctx);
+    void *ctx,
+    struct xtnt_node **found);
+
+/*
+ * AVL and red-black trees share a layout, so the cursor operations and
+ * the bounds below serve both.
+ */
+
+xtnt_status_t
+xtnt_tree_iter_next(
+    struct xtnt_node_set *tree,
+    struct xtnt_set_iter *iter,
+    struct xtnt_node **node);
+
+xtnt_status_t
+xtnt_tree_iter_seek(
+    struct xtnt_node_set *tree,
+    struct xtnt_set_iter *iter,
+    xtnt_uint_t key);
+
+xtnt_status_t
+xtnt_tree_lower_bound(
+    struct xtnt_node_set *tree,
+    xtnt_uint_t key,
+    struct xtnt_node **found);
+
+xtnt_status_t
+xtnt_tree_upper_bound(
+    struct xtnt_node_set *tree,
+    xtnt_uint_t key,
+    struct xtnt_node **found);
 
 #endif /* ifndef _XTNT_SET_TREE_H_ */
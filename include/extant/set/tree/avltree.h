@@ -32,12 +32,33 @@ SOFTWARE.
 
 #include <extant/set/tree.h>
 
+#define XTNT_AVLTREE_BALANCED (XTNT_MODE_1) /**< Subtrees of equal height */
+#define XTNT_AVLTREE_RIGHT_HEAVY (XTNT_MODE_2) /**< Right subtree taller */
+#define XTNT_AVLTREE_LEFT_HEAVY (XTNT_MODE_4) /**< Left subtree taller */
+
+/**
+ * @def XTNT_AVLTREE_BALANCE(N)
+ * Evaluate the balance factor ( -1, 0, 1 ) stored in the mode of node N
+ */
+#define XTNT_AVLTREE_BALANCE(N) ((xtnt_int_t) (XTNT_MODE((N)->state) ^ 2) - 2)
+
+extern const struct xtnt_node_set_if xtnt_avltree_if;
+
 xtnt_status_t
 xtnt_avltree_delete(
     struct xtnt_node_set *tree,
     xtnt_uint_t key,
     struct xtnt_node **deleted);
 
+xtnt_status_t
+xtnt_avltree_initialize(
+    struct xtnt_node_set *tree);
+
+xtnt_status_t
+xtnt_avltree_initialize_lock(
+    struct xtnt_node_set *tree,
+    xtnt_uint_t policy);
+
 xtnt_status_t
 xtnt_avltree_insert(
     struct xtnt_node_set *tree,
@@ -29,24 +29,20 @@ SOFTWARE.
 
 #include <extant/extant.h>
 
+#include <extant/hash.h>
+
+#include <string.h>
+
 /**
- * @brief Generate a hash from a key
+ * @brief Generate a hash from a null terminated string key
  *
- * Generate a unique integer evaluating the bytes of a key. There is collision
- * but for null terminated string keys < 128 bytes long this works well.
- *
- * @param[in] key Value to be hashed
+ * @param[in] key Null terminated string to be hashed
  * @return xtnt_uint_t hash value
+ *
+ * @note This is `xtnt_hash_bytes()` seeded with XTNT_HASH_SEED over the
+ * string length. Prefer `xtnt_hash_bytes()` where the length is known.
  */
 xtnt_uint_t xtnt_hash(void *key)
 {
-    const char *s = (const char*) key;
-    xtnt_uint_t sum = 0;
-    for (xtnt_int_t idx = 0; s[idx] != 0; idx++) {
-        if (idx && 1) {
-            sum <<= sizeof(char);
-        }
-        sum ^= (xtnt_int_t) s[idx];
-    }
-    return sum;
+    return (xtnt_uint_t) xtnt_hash_bytes(key, strlen(key), XTNT_HASH_SEED);
 }
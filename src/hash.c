@@ -0,0 +1,168 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/hash.h>
+
+#include <string.h>
+
+#define XTNT_HASH_P0 (0xa0761d6478bd642fULL) /**< Mixing constant */
+#define XTNT_HASH_P1 (0xe7037ed1a0b428dbULL) /**< Mixing constant */
+#define XTNT_HASH_P2 (0x8ebc6af09c88c6e3ULL) /**< Mixing constant */
+#define XTNT_HASH_P3 (0x589965cc75374cc3ULL) /**< Mixing constant */
+
+/**
+ * @brief Multiply to 128 bits, storing the low and high halves
+ *
+ * @param[in,out] a First factor, replaced by the low 64 bits
+ * @param[in,out] b Second factor, replaced by the high 64 bits
+ */
+static inline void
+xtnt_hash_multiply(
+    uint64_t *a,
+    uint64_t *b)
+{
+#ifdef __SIZEOF_INT128__
+    __uint128_t r = (__uint128_t) *a * *b;
+    *a = (uint64_t) r;
+    *b = (uint64_t) (r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t) *a, lb = (uint32_t) *b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif /* ifdef __SIZEOF_INT128__ */
+}
+
+/**
+ * @brief Fold the 128 bit product of two words into 64 bits
+ */
+static inline uint64_t
+xtnt_hash_mix(
+    uint64_t a,
+    uint64_t b)
+{
+    xtnt_hash_multiply(&a, &b);
+    return a ^ b;
+}
+
+/**
+ * @brief Read 8 unaligned bytes as a native word
+ */
+static inline uint64_t
+xtnt_hash_read8(
+    const uint8_t *p)
+{
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/**
+ * @brief Read 4 unaligned bytes as a native word
+ */
+static inline uint64_t
+xtnt_hash_read4(
+    const uint8_t *p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/**
+ * @brief Hash a run of bytes
+ *
+ * @param[in] key The bytes to hash
+ * @param[in] length The number of bytes at `key`
+ * @param[in] seed Value selecting one of a family of hash functions
+ * @return 64 bit hash value
+ *
+ * @note Input is consumed 8 bytes at a time. Runs longer than 48 bytes are
+ * mixed in three independent lanes of 16 bytes, so the multiplies overlap.
+ * Runs of up to 16 bytes are read with at most four overlapping loads and
+ * no loop.
+ *
+ * @note Words are read in native byte order, so hash values differ between
+ * little and big endian hosts. The hash is not cryptographic; use a secret
+ * seed where keys may be chosen by an attacker.
+ */
+uint64_t
+xtnt_hash_bytes(
+    const void *key,
+    size_t length,
+    uint64_t seed)
+{
+    const uint8_t *p = key;
+    size_t remain = length;
+    uint64_t a = XTNT_ZERO;
+    uint64_t b = XTNT_ZERO;
+
+    seed ^= xtnt_hash_mix(seed ^ XTNT_HASH_P0, XTNT_HASH_P1);
+    if (length <= 16) {
+        if (length >= 4) {
+            a = (xtnt_hash_read4(p) << 32) | xtnt_hash_read4(p + ((length >> 3) << 2));
+            b = (xtnt_hash_read4(p + length - 4) << 32) |
+                xtnt_hash_read4(p + length - 4 - ((length >> 3) << 2));
+        } else if (length > 0) {
+            a = ((uint64_t) p[0] << 16) | ((uint64_t) p[length >> 1] << 8) | p[length - 1];
+        }
+    } else {
+        if (remain > 48) {
+            uint64_t lane1 = seed;
+            uint64_t lane2 = seed;
+            do {
+                seed = xtnt_hash_mix(xtnt_hash_read8(p) ^ XTNT_HASH_P1,
+                                     xtnt_hash_read8(p + 8) ^ seed);
+                lane1 = xtnt_hash_mix(xtnt_hash_read8(p + 16) ^ XTNT_HASH_P2,
+                                      xtnt_hash_read8(p + 24) ^ lane1);
+                lane2 = xtnt_hash_mix(xtnt_hash_read8(p + 32) ^ XTNT_HASH_P3,
+                                      xtnt_hash_read8(p + 40) ^ lane2);
+                p += 48;
+                remain -= 48;
+            } while (remain > 48);
+            seed ^= lane1 ^ lane2;
+        }
+        while (remain > 16) {
+            seed = xtnt_hash_mix(xtnt_hash_read8(p) ^ XTNT_HASH_P1,
+                                 xtnt_hash_read8(p + 8) ^ seed);
+            p += 16;
+            remain -= 16;
+        }
+        a = xtnt_hash_read8(p + remain - 16);
+        b = xtnt_hash_read8(p + remain - 8);
+    }
+    a ^= XTNT_HASH_P1;
+    b ^= seed;
+    xtnt_hash_multiply(&a, &b);
+    return xtnt_hash_mix(a ^ XTNT_HASH_P0 ^ (uint64_t) length, b ^ XTNT_HASH_P1);
+}
@@ -29,6 +29,403 @@ SOFTWARE.
 
 #include <extant/log.h>
 
+#include <string.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+#define XTNT_LOG_RING_MASK (XTNT_LOG_RING_SIZE - 1) /**< Ring index mask */
+#define XTNT_LOG_RING_ALIGN (64) /**< Alignment separating ring indexes */
+
+/**
+ * @struct xtnt_log_record
+ *
+ * Fixed size log record copied into a ring by `xtnt_log_record()`
+ */
+struct xtnt_log_record
+{
+    uint64_t timestamp;
+    void *fmt_fn;
+    xtnt_uint_t level;
+    char data[XTNT_LOG_RECORD_DATA_SIZE] __attribute__((aligned(XTNT_LOG_ENTRY_ALIGN)));
+};
+
+/**
+ * @struct xtnt_log_ring
+ *
+ * Single producer, single consumer ring of records owned by one thread
+ *
+ * The producer only writes `head` and the consumer only writes `tail`, each
+ * on its own cache line alongside the last value seen of the other index,
+ * so neither reads the other's line until the cached value is exhausted.
+ */
+struct xtnt_log_ring
+{
+    struct xtnt_log_ring *next;
+    pthread_t owner;
+    uint64_t head __attribute__((aligned(XTNT_LOG_RING_ALIGN)));
+    uint64_t tail_seen;
+    uint64_t tail __attribute__((aligned(XTNT_LOG_RING_ALIGN)));
+    uint64_t head_seen;
+    struct xtnt_log_record record[XTNT_LOG_RING_SIZE];
+};
+
+/**
+ * @struct xtnt_log_ring_cache
+ *
+ * Thread local reference to the calling thread's ring of a single logger
+ */
+struct xtnt_log_ring_cache
+{
+    uint64_t id;
+    struct xtnt_log_ring *ring;
+};
+
+static __thread struct xtnt_log_ring_cache xtnt_log_ring_caches[XTNT_LOG_RINGS];
+
+static uint64_t xtnt_logger_ids = XTNT_ZERO;
+
+/**
+ * @brief Monotonic time in nanoseconds
+ */
+static inline uint64_t
+xtnt_logger_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec;
+}
+
+/**
+ * @brief Find or register the calling thread's ring on a logger
+ *
+ * @param[in] logger The logger to find the ring of
+ * @param[out] ring Pointer reference to store the ring to
+ * @retval XTNT_ESUCCESS on finding or registering the ring
+ * @retval return value of `posix_memalign()`, `pthread_mutex_lock()` or
+ * `pthread_mutex_unlock()`
+ *
+ * @note Registration takes the logger lock once per thread, or again when
+ * another logger displaced the thread local cache slot.
+ */
+static xtnt_status_t
+xtnt_log_ring_find(
+    struct xtnt_logger *logger,
+    struct xtnt_log_ring **ring)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_log_ring_cache *cache = &(xtnt_log_ring_caches[logger->id % XTNT_LOG_RINGS]);
+    struct xtnt_log_ring *mring = NULL;
+    void *block = NULL;
+    if (cache->id == logger->id) {
+        *ring = cache->ring;
+        return XTNT_ESUCCESS;
+    }
+    if ((res = pthread_mutex_lock(&(logger->lock))) == XTNT_ESUCCESS) {
+        for (mring = logger->rings; mring != NULL; mring = mring->next) {
+            if (pthread_equal(mring->owner, pthread_self())) {
+                break;
+            }
+        }
+        if (mring == NULL) {
+            if ((res = posix_memalign(&block, XTNT_LOG_RING_ALIGN,
+                                      sizeof(struct xtnt_log_ring))) == XTNT_ESUCCESS) {
+                mring = block;
+                mring->owner = pthread_self();
+                mring->head = XTNT_ZERO;
+                mring->tail_seen = XTNT_ZERO;
+                mring->tail = XTNT_ZERO;
+                mring->head_seen = XTNT_ZERO;
+                mring->next = logger->rings;
+                // The consumer walks the rings without the lock
+                __atomic_store_n(&(logger->rings), mring, __ATOMIC_RELEASE);
+            }
+        }
+        if (mring != NULL) {
+            cache->id = logger->id;
+            cache->ring = mring;
+            *ring = mring;
+        }
+        if (pthread_mutex_unlock(&(logger->lock)) != XTNT_ESUCCESS) {
+            XTNT_LOCK_SET_UNLOCK_FAIL(logger->state);
+        }
+    } else {
+        XTNT_LOCK_SET_LOCK_FAIL(logger->state);
+    }
+    return res;
+}
+
+/**
+ * @brief Evaluate if any ring of a logger holds unread records
+ *
+ * @param[in] logger The logger to check
+ * @return non-zero when a record is pending
+ */
+static int
+xtnt_log_rings_pending(
+    struct xtnt_logger *logger)
+{
+    struct xtnt_log_ring *ring = __atomic_load_n(&(logger->rings), __ATOMIC_ACQUIRE);
+    for (; ring != NULL; ring = ring->next) {
+        if (__atomic_load_n(&(ring->head), __ATOMIC_RELAXED) != ring->tail) {
+            return 1;
+        }
+    }
+    return XTNT_ZERO;
+}
+
+/**
+ * @brief Write the buffered messages, followed by `msg`, with one `writev()`
+ *
+ * @param[in] logger The logger owning the buffer
+ * @param[in] msg A message too large for the buffer, or NULL
+ * @param[in] length Length of `msg`
+ * @retval XTNT_ESUCCESS on writing everything
+ * @retval errno on `writev()`
+ *
+ * @note Writes go to the file descriptor of the log stream, bypassing stdio.
+ */
+static xtnt_status_t
+xtnt_logger_flush(
+    struct xtnt_logger *logger,
+    const char *msg,
+    size_t length)
+{
+    struct iovec iov[2] = {
+        { logger->buffer, logger->buffered },
+        { (void *) msg, length }
+    };
+    struct iovec *vec = iov;
+    int count = (length != XTNT_ZERO) ? 2 : 1;
+    int fd = fileno(logger->log);
+    ssize_t written;
+
+    while (count > 0) {
+        if (vec->iov_len == XTNT_ZERO) {
+            vec++;
+            count--;
+            continue;
+        }
+        if ((written = writev(fd, vec, count)) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno;
+        }
+        while (count > 0 && (size_t) written >= vec->iov_len) {
+            written -= vec->iov_len;
+            vec++;
+            count--;
+        }
+        if (count > 0) {
+            vec->iov_base = (char *) vec->iov_base + written;
+            vec->iov_len -= written;
+        }
+    }
+    logger->buffered = XTNT_ZERO;
+    logger->flushed = xtnt_logger_now();
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Buffer an entry for writing if its level is active
+ *
+ * @param[in] logger The logger writing the entry
+ * @param[in] entry The entry to format and write
+ * @param[in] level The active level of the logger
+ * @retval XTNT_ESUCCESS on buffering, or when the level is inactive
+ * @retval result of `xtnt_logger_flush()` when the buffer is full
+ */
+static xtnt_status_t
+xtnt_logger_write(
+    struct xtnt_logger *logger,
+    struct xtnt_logger_entry *entry,
+    xtnt_uint_t level)
+{
+    char * (*get_string)(struct xtnt_logger_entry *) = entry->fmt_fn;
+    const char *msg = NULL;
+    size_t length;
+    if (entry->level & level) {
+        msg = get_string(entry);
+        length = strlen(msg);
+        if (logger->buffered + length > XTNT_LOG_BUFFER_SIZE) {
+            return xtnt_logger_flush(logger, msg, length);
+        }
+        memcpy(logger->buffer + logger->buffered, msg, length);
+        logger->buffered += length;
+    }
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Write the buffered messages if the consumer is cancelled
+ *
+ * @param[in] arg The xtnt_logger being cancelled
+ */
+static void
+xtnt_logger_flush_cleanup(
+    void *arg)
+{
+    xtnt_logger_flush(arg, NULL, XTNT_ZERO);
+}
+
+/**
+ * @brief Act on a pending cancel of the consumer between batches
+ *
+ * @param[in] logger The xtnt_logger being processed
+ */
+static void
+xtnt_logger_testcancel(
+    struct xtnt_logger *logger)
+{
+    pthread_cleanup_push(xtnt_logger_flush_cleanup, logger);
+    pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
+    pthread_testcancel();
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+    pthread_cleanup_pop(0);
+}
+
+/**
+ * @brief Write up to XTNT_LOG_BATCH_SIZE ring records, oldest first
+ *
+ * @param[in] logger The logger owning the rings
+ * @param[in] level The active level of the logger
+ * @param[out] merged Number of records consumed
+ * @retval XTNT_ESUCCESS on writing the records
+ * @retval result of `xtnt_logger_write()`
+ *
+ * @note Each ring is ordered by its producer, the rings are merged by the
+ * timestamp at the head of each ring.
+ */
+static xtnt_status_t
+xtnt_logger_merge(
+    struct xtnt_logger *logger,
+    xtnt_uint_t level,
+    xtnt_uint_t *merged)
+{
+    xtnt_status_t res = XTNT_ESUCCESS;
+    char msg[XTNT_LOG_ENTRY_MSG_SIZE];
+    struct xtnt_logger_entry entry;
+    struct xtnt_log_ring *ring = NULL;
+    struct xtnt_log_ring *oldest = NULL;
+    struct xtnt_log_record *record = NULL;
+    xtnt_uint_t count = XTNT_ZERO;
+
+    for (; count < XTNT_LOG_BATCH_SIZE; count++) {
+        oldest = NULL;
+        for (ring = __atomic_load_n(&(logger->rings), __ATOMIC_ACQUIRE);
+             ring != NULL; ring = ring->next) {
+            if (ring->head_seen == ring->tail) {
+                ring->head_seen = __atomic_load_n(&(ring->head), __ATOMIC_ACQUIRE);
+            }
+            if (ring->head_seen != ring->tail) {
+                struct xtnt_log_record *head = &(ring->record[ring->tail & XTNT_LOG_RING_MASK]);
+                if (oldest == NULL || head->timestamp < record->timestamp) {
+                    oldest = ring;
+                    record = head;
+                }
+            }
+        }
+        if (oldest == NULL) {
+            break;
+        }
+        entry.fmt_fn = record->fmt_fn;
+        entry.data = record->data;
+        entry.msg = msg;
+        entry.msg_length = sizeof(msg);
+        entry.state = XTNT_ZERO;
+        entry.level = record->level;
+        entry.pool = NULL;
+        res = xtnt_logger_write(logger, &entry, level);
+        // Hand the slot back to the producer
+        __atomic_store_n(&(oldest->tail), oldest->tail + 1, __ATOMIC_RELEASE);
+        if (res != XTNT_ESUCCESS) {
+            count++;
+            break;
+        }
+    }
+    *merged = count;
+    return res;
+}
+
+/**
+ * @brief Release the logger lock if the consumer is cancelled while waiting
+ *
+ * @param[in] arg The xtnt_logger being waited on
+ */
+static void
+xtnt_logger_wait_cleanup(
+    void *arg)
+{
+    struct xtnt_logger *logger = arg;
+    __atomic_store_n(&(logger->waiting), XTNT_ZERO, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&(logger->lock));
+}
+
+/**
+ * @brief Sleep the consumer until a queue or ring is non-empty or exit is
+ * requested
+ *
+ * @param[in] logger The xtnt_logger to wait on
+ * @param[out] level The default level of the logger when woken
+ * @return the state value of the logger when woken on an empty queue and
+ * empty rings,
+ * otherwise XTNT_LOGGER_OPEN
+ *
+ * @note The consumer can be cancelled while asleep.
+ */
+static xtnt_uint_t
+xtnt_logger_wait(
+    struct xtnt_logger *logger,
+    xtnt_uint_t *level)
+{
+    pthread_mutex_lock(&(logger->lock));
+    pthread_cleanup_push(xtnt_logger_wait_cleanup, logger);
+    __atomic_store_n(&(logger->waiting), 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&(logger->queue.count), __ATOMIC_RELAXED) == XTNT_ZERO &&
+           !xtnt_log_rings_pending(logger) &&
+           XTNT_STATE(logger->state) != XTNT_LOGGER_PENDING_EXIT) {
+        pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
+        pthread_cond_wait(&(logger->wake), &(logger->lock));
+        pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+    }
+    pthread_cleanup_pop(0);
+
+    xtnt_uint_t state = XTNT_LOGGER_OPEN;
+    __atomic_store_n(&(logger->waiting), XTNT_ZERO, __ATOMIC_RELAXED);
+    if (__atomic_load_n(&(logger->queue.count), __ATOMIC_RELAXED) == XTNT_ZERO &&
+        !xtnt_log_rings_pending(logger)) {
+        state = XTNT_STATE(logger->state);
+    }
+    *level = logger->default_level;
+    pthread_mutex_unlock(&(logger->lock));
+    return state;
+}
+
+/**
+ * @brief Wake the consumer asleep on an empty queue
+ *
+ * @param[in] logger The xtnt_logger to wake
+ * @retval XTNT_ESUCCESS on signal
+ * @retval return value of `pthread_mutex_lock()` or `pthread_mutex_unlock()`
+ */
+static xtnt_status_t
+xtnt_logger_wake(
+    struct xtnt_logger *logger)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = pthread_mutex_lock(&(logger->lock))) == XTNT_ESUCCESS) {
+        pthread_cond_signal(&(logger->wake));
+        if ((res = pthread_mutex_unlock(&(logger->lock))) != XTNT_ESUCCESS) {
+            XTNT_LOCK_SET_UNLOCK_FAIL(logger->state);
+        }
+    } else {
+        XTNT_LOCK_SET_LOCK_FAIL(logger->state);
+    }
+    return res;
+}
+
 /**
  * @brief Insert a log entry into the logger
  *
@@ -39,13 +436,89 @@ SOFTWARE.
  *
  * @note The logging system is a producer/consumer model. Once a log entry is
  * queued with a logger, the producer should consider the entry immutable.
+ *
+ * @note The consumer is only signalled when it is asleep on an empty queue,
+ * so a busy logger costs producers no more than the queue push.
  */
 xtnt_status_t
 xtnt_log(
     struct xtnt_logger *logger,
     struct xtnt_logger_entry *entry)
 {
-    return xtnt_queue_push(&(logger->queue), &(entry->node));
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_queue_push(&(logger->queue), &(entry->node))) == XTNT_ESUCCESS) {
+        // Pairs with the fence in xtnt_logger_wait, either the consumer sees
+        // the entry or this sees the consumer waiting
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&(logger->waiting), __ATOMIC_RELAXED)) {
+            res = xtnt_logger_wake(logger);
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Copy a log record into the calling thread's ring of the logger
+ *
+ * @param[in] logger The logger handling the record
+ * @param[in] fmt_fn Function for formatting string
+ * @param[in] level Level for log record
+ * @param[in] data Data copied for the `fmt_fn`
+ * @param[in] data_length Length of `data`
+ * @retval XTNT_ESUCCESS on copying the record to the ring
+ * @retval EMSGSIZE when `data_length` exceeds XTNT_LOG_RECORD_DATA_SIZE
+ * @retval EAGAIN when the ring is full
+ * @retval result of registering the thread ring or waking the consumer
+ *
+ * @note Each producing thread owns a ring of XTNT_LOG_RING_SIZE records, so
+ * producers never contend with each other. After the first record a thread
+ * logs, this costs a timestamp and the copy of `data`.
+ *
+ * @note The consumer formats the record with `fmt_fn` over an entry whose
+ * `data` references the copy, so `fmt_fn` must not keep references to it.
+ * Records from different threads are written in timestamp order, records
+ * queued with `xtnt_log()` are not ordered against them.
+ *
+ * @note A full ring is not waited on, the caller may retry or fall back to
+ * `xtnt_log()`.
+ */
+xtnt_status_t
+xtnt_log_record(
+    struct xtnt_logger *logger,
+    void *fmt_fn,
+    xtnt_uint_t level,
+    const void *data,
+    size_t data_length)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_log_ring *ring = NULL;
+    struct xtnt_log_record *record = NULL;
+    uint64_t head;
+    if (data_length > XTNT_LOG_RECORD_DATA_SIZE) {
+        return EMSGSIZE;
+    }
+    if ((res = xtnt_log_ring_find(logger, &ring)) != XTNT_ESUCCESS) {
+        return res;
+    }
+    head = ring->head;
+    if (head - ring->tail_seen >= XTNT_LOG_RING_SIZE) {
+        ring->tail_seen = __atomic_load_n(&(ring->tail), __ATOMIC_ACQUIRE);
+        if (head - ring->tail_seen >= XTNT_LOG_RING_SIZE) {
+            return EAGAIN;
+        }
+    }
+    record = &(ring->record[head & XTNT_LOG_RING_MASK]);
+    record->timestamp = xtnt_logger_now();
+    record->fmt_fn = fmt_fn;
+    record->level = level;
+    memcpy(record->data, data, data_length);
+    __atomic_store_n(&(ring->head), head + 1, __ATOMIC_RELEASE);
+    // Pairs with the fence in xtnt_logger_wait, as in xtnt_log
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&(logger->waiting), __ATOMIC_RELAXED)) {
+        res = xtnt_logger_wake(logger);
+    }
+    return res;
 }
 
 /**
@@ -72,6 +545,43 @@ xtnt_logger_change_default_level(
     return res;
 }
 
+/**
+ * @brief Change the thresholds after which the consumer writes
+ *
+ * @param[in] logger Logger reference to update
+ * @param[in] flush_size Buffered bytes after which the consumer writes
+ * @param[in] flush_usec Microseconds after the last write after which the
+ * consumer writes
+ * @retval XTNT_ESUCCESS on change
+ * @retval EINVAL when `flush_size` exceeds XTNT_LOG_BUFFER_SIZE
+ * @retval Status of pthread_mutex operations
+ *
+ * @note The consumer checks the thresholds after each batch, and always
+ * writes before it sleeps on an empty logger. A `flush_size` of 0 writes
+ * every batch.
+ */
+xtnt_status_t
+xtnt_logger_change_flush(
+    struct xtnt_logger *logger,
+    size_t flush_size,
+    uint64_t flush_usec)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if (flush_size > XTNT_LOG_BUFFER_SIZE) {
+        return EINVAL;
+    }
+    if ((res = pthread_mutex_lock(&(logger->lock))) == XTNT_ESUCCESS) {
+        logger->flush_size = flush_size;
+        logger->flush_usec = flush_usec;
+        if ((res = pthread_mutex_unlock(&(logger->lock))) != XTNT_ESUCCESS) {
+            XTNT_LOCK_SET_UNLOCK_FAIL(logger->state);
+        }
+    } else {
+        XTNT_LOCK_SET_LOCK_FAIL(logger->state);
+    }
+    return res;
+}
+
 /**
  * @brief Allocate, ininitialize and return an xtnt_logger pointer
  *
@@ -121,7 +631,6 @@ xtnt_logger_create(
                     XTNT_LOCK_SET_LOCK_FAIL(mlogger->state);
                 }
             } else {
-                res = xtnt_logger_uninitialize(mlogger);
                 free(mlogger);
                 mlogger = NULL;
             }
@@ -155,6 +664,8 @@ xtnt_logger_destroy(
  *
  * @param[in] logger xtnt_logger to exit
  * @returns result of xtnt_logger_exit
+ *
+ * @note A consumer asleep on an empty queue is woken to exit.
  */
 xtnt_status_t
 xtnt_logger_exit(
@@ -163,6 +674,7 @@ xtnt_logger_exit(
     xtnt_status_t res = XTNT_EFAILURE;
     if ((res = pthread_mutex_lock(&(logger->lock))) == XTNT_ESUCCESS) {
         XTNT_STATE_SET_VALUE(logger->state, XTNT_LOGGER_PENDING_EXIT);
+        pthread_cond_signal(&(logger->wake));
         if ((res = pthread_mutex_unlock(&(logger->lock))) != XTNT_ESUCCESS) {
             XTNT_LOCK_SET_UNLOCK_FAIL(logger->state);
         }
@@ -172,6 +684,96 @@ xtnt_logger_exit(
     return res;
 }
 
+/**
+ * @def XTNT_LOG_ENTRY_DATA_OFFSET
+ * Offset of the data trailing an entry in its allocation
+ */
+#define XTNT_LOG_ENTRY_DATA_OFFSET \
+    ((sizeof(struct xtnt_logger_entry) + XTNT_LOG_ENTRY_ALIGN - 1) & \
+     ~((size_t) XTNT_LOG_ENTRY_ALIGN - 1))
+
+/**
+ * @def XTNT_LOG_ENTRY_SIZE(D, M)
+ * Size of a single allocation entry with data length D and msg length M
+ */
+#define XTNT_LOG_ENTRY_SIZE(D, M) \
+    (XTNT_LOG_ENTRY_DATA_OFFSET + \
+     (((D) + XTNT_LOG_ENTRY_ALIGN - 1) & ~((size_t) XTNT_LOG_ENTRY_ALIGN - 1)) + (M))
+
+/**
+ * @brief Lay out an entry over its single allocation
+ *
+ * @param[in] entry The entry at the start of the allocation
+ * @param[in] data_length Memory size for data following the entry
+ * @param[in] msg_length Memory size for message following the data
+ * @param[in] fmt_fn Function for formatting string
+ * @param[in] level Level for log entry
+ * @param[in] pool Pool the allocation returns to, or NULL for the heap
+ * @returns result of xtnt_node_initialize
+ */
+static xtnt_status_t
+xtnt_logger_entry_layout(
+    struct xtnt_logger_entry *entry,
+    size_t data_length,
+    size_t msg_length,
+    void *fmt_fn,
+    xtnt_uint_t level,
+    struct xtnt_memory_object *pool)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    char *storage = (char *) entry + XTNT_LOG_ENTRY_DATA_OFFSET;
+    entry->fmt_fn = fmt_fn;
+    entry->data = storage;
+    entry->msg = storage + (XTNT_LOG_ENTRY_SIZE(data_length, 0) - XTNT_LOG_ENTRY_DATA_OFFSET);
+    entry->msg_length = msg_length;
+    entry->state = XTNT_ZERO;
+    entry->level = level;
+    entry->pool = pool;
+    if ((res = xtnt_node_initialize(&(entry->node), level, 0, entry)) != XTNT_ESUCCESS) {
+        XTNT_STATE_SET_VALUE(entry->state, XTNT_LOG_ENTRY_INIT_FAIL);
+    }
+    return res;
+}
+
+/**
+ * @brief Take a recycled xtnt_logger_entry from a logger
+ *
+ * @param[in] logger The logger the entry will be logged to
+ * @param[in] data_length Memory size needed for data
+ * @param[in] msg_length Memory size needed for message
+ * @param[in] fmt_fn Function for formatting string
+ * @param[in] level Level for log entry
+ * @param[out] entry Pointer reference to store entry to
+ * @retval XTNT_ESUCCESS on acquiring and initializing the entry
+ * @retval result of `xtnt_logger_entry_create()` when falling back to the heap
+ *
+ * @note Entries up to XTNT_LOG_ENTRY_DATA_SIZE data and
+ * XTNT_LOG_ENTRY_MSG_SIZE message length come from a pool owned by the
+ * logger, and the consumer returns them there once written. Larger entries,
+ * or any entry while the pool is exhausted, are created on the heap.
+ */
+xtnt_status_t
+xtnt_logger_entry_acquire(
+    struct xtnt_logger *logger,
+    size_t data_length,
+    size_t msg_length,
+    void *fmt_fn,
+    xtnt_uint_t level,
+    struct xtnt_logger_entry **entry)
+{
+    void *block = NULL;
+    if (logger->entries != NULL &&
+        data_length <= XTNT_LOG_ENTRY_DATA_SIZE &&
+        msg_length <= XTNT_LOG_ENTRY_MSG_SIZE &&
+        xtnt_mpool_allocate(logger->entries, 1, &block) == XTNT_ESUCCESS) {
+        *entry = block;
+        return xtnt_logger_entry_layout(*entry, XTNT_LOG_ENTRY_DATA_SIZE,
+                                        XTNT_LOG_ENTRY_MSG_SIZE, fmt_fn,
+                                        level, logger->entries);
+    }
+    return xtnt_logger_entry_create(data_length, msg_length, fmt_fn, level, entry);
+}
+
 /**
  * @brief Allocate and initialize an xtnt_logger_entry
  *
@@ -180,10 +782,12 @@ xtnt_logger_exit(
  * @param[in] level Level for log entry
  * @param[in] fmt_fn Function for formatting string
  * @param[out] entry Pointer reference to store entry to
- * @retval XTNT_EFAILURE on allocation failure
  * @retval XTNT_ESUCCESS on allocation and initialization
  * @retval status of xtnt_node_initialize
  * @retval errno of malloc
+ *
+ * @note The entry, data and msg share a single allocation, with data and msg
+ * trailing the entry.
  */
 xtnt_status_t
 xtnt_logger_entry_create(
@@ -194,24 +798,11 @@ xtnt_logger_entry_create(
     struct xtnt_logger_entry **entry)
 {
     xtnt_status_t res = XTNT_EFAILURE;
-    void *data = malloc(data_length);
-    void *msg = malloc(msg_length);
-    *entry = malloc(sizeof(struct xtnt_logger_entry));
-    if (data != NULL || msg != NULL || entry != NULL){
-        (*entry)->fmt_fn = fmt_fn;
-        (*entry)->data = data;
-        (*entry)->msg = msg;
-        (*entry)->msg_length = msg_length;
-        (*entry)->level = level;
-        (*entry)->level = XTNT_LOG_LEVEL_DEFAULT;
-        if ((res = xtnt_node_initialize(&((*entry)->node), level, 0, *entry)) != XTNT_ESUCCESS) {
-            XTNT_STATE_SET_VALUE((*entry)->state, XTNT_LOG_ENTRY_INIT_FAIL);
-        }
+    *entry = malloc(XTNT_LOG_ENTRY_SIZE(data_length, msg_length));
+    if (*entry != NULL) {
+        res = xtnt_logger_entry_layout(*entry, data_length, msg_length,
+                                       fmt_fn, level, NULL);
     } else {
-        free(entry);
-        free(msg);
-        free(data);
-        *entry = NULL;
         res = errno;
     }
     return res;
@@ -225,42 +816,140 @@ xtnt_logger_entry_create(
  *
  * @note The logging is a producer/consumer model. This should not be called
  * by any thread other than the logger consumer.
+ *
+ * @note Entries acquired from a logger pool are returned to it.
  */
 xtnt_status_t
 xtnt_logger_entry_destroy(
     struct xtnt_logger_entry **entry)
 {
     xtnt_status_t res = XTNT_ESUCCESS;
+    void *block = *entry;
     res = xtnt_node_uninitialize(&((*entry)->node));
-    free((*entry)->msg);
-    free((*entry)->data);
-    free(*entry);
+    if ((*entry)->pool != NULL) {
+        xtnt_mpool_deallocate((*entry)->pool, &block);
+    } else {
+        free(block);
+    }
     *entry = NULL;
     return res;
 }
 
+/**
+ * @brief Initialize an xtnt_logger_entry over caller provided memory
+ *
+ * @param[in] entry The entry to initialize
+ * @param[in] data Memory for the formatter data
+ * @param[in] msg Memory for the formatted message
+ * @param[in] msg_length String length that can be stored at `msg`
+ * @param[in] fmt_fn Function for formatting string
+ * @param[in] level Level for log entry
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval status of xtnt_node_initialize
+ *
+ * @note The entry, data and msg memory is owned by the caller, e.g. allocated
+ * from a [memory region](@ref xtnt_mregion_allocate). The logger consumer
+ * uninitializes the entry instead of destroying it, and the memory must stay
+ * valid until the consumer has processed the entry.
+ */
+xtnt_status_t
+xtnt_logger_entry_initialize(
+    struct xtnt_logger_entry *entry,
+    void *data,
+    char *msg,
+    size_t msg_length,
+    void *fmt_fn,
+    xtnt_uint_t level)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    entry->fmt_fn = fmt_fn;
+    entry->data = data;
+    entry->msg = msg;
+    entry->msg_length = msg_length;
+    entry->state = XTNT_ZERO;
+    entry->level = level;
+    entry->pool = NULL;
+    XTNT_STATE_SET_VALUE(entry->state, XTNT_LOG_ENTRY_EXTERNAL);
+    res = xtnt_node_initialize(&(entry->node), level, 0, entry);
+    return res;
+}
+
+/**
+ * @brief Uninitialize an xtnt_logger_entry without deallocating it
+ *
+ * @param[in] entry xtnt_logger_entry to uninitialize
+ * @returns result of xtnt_node_uninitialize
+ */
+xtnt_status_t
+xtnt_logger_entry_uninitialize(
+    struct xtnt_logger_entry *entry)
+{
+    entry->fmt_fn = NULL;
+    entry->data = NULL;
+    entry->msg = NULL;
+    entry->msg_length = XTNT_ZERO;
+    return xtnt_node_uninitialize(&(entry->node));
+}
+
 /**
  * @brief Initialize a xtnt_logger
  *
  * @param[in] logger The xtnt_logger to initialize
- * @returns result of mutex operations
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval ENOMEM when the write buffer can not be allocated
+ * @returns otherwise result of mutex operations, `xtnt_mpool_create()` or
+ * `xtnt_queue_initialize()`
+ *
+ * @note When the buffer, entry pool or queue fail, everything initialized
+ * so far is released again and the logger must not be uninitialized.
  */
 xtnt_status_t
 xtnt_logger_initialize(
     struct xtnt_logger *logger)
 {
     xtnt_status_t res = XTNT_EFAILURE;
-    if ((res = pthread_mutex_init(&(logger->lock), NULL)) == XTNT_ZERO) {
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    logger->state = XTNT_ZERO;
+    logger->entries = NULL;
+    logger->rings = NULL;
+    logger->buffer = NULL;
+    logger->id = __atomic_add_fetch(&xtnt_logger_ids, 1, __ATOMIC_RELAXED);
+    if ((res = pthread_mutex_init(&(logger->lock), NULL)) == XTNT_ZERO &&
+        (res = pthread_cond_init(&(logger->wake), NULL)) == XTNT_ZERO) {
         if ((res = pthread_mutex_lock(&(logger->lock))) == XTNT_ZERO) {
             logger->log = NULL;
             logger->filename = NULL;
             logger->default_level = XTNT_LOG_LEVEL_DEFAULT;
-            /** @todo upate xtnt_node_set_initialize to return xtnt_status_t */
-            if ((res = xtnt_node_set_initialize(&(logger->queue))) != XTNT_ZERO) {
+            logger->waiting = XTNT_ZERO;
+            logger->buffered = XTNT_ZERO;
+            logger->flush_size = XTNT_LOG_FLUSH_SIZE;
+            logger->flush_usec = XTNT_LOG_FLUSH_USEC;
+            logger->flushed = XTNT_ZERO;
+            if ((logger->buffer = malloc(XTNT_LOG_BUFFER_SIZE)) == NULL) {
+                res = ENOMEM;
+            } else if ((res = xtnt_mpool_create(
+                    XTNT_LOG_ENTRY_SIZE(XTNT_LOG_ENTRY_DATA_SIZE, XTNT_LOG_ENTRY_MSG_SIZE),
+                    XTNT_LOG_ENTRY_POOL_SIZE, &(logger->entries))) == XTNT_ZERO) {
+                // Producers push without locking, the consumer is the only popper
+                res = xtnt_queue_initialize(&(logger->queue), XTNT_QUEUE_MODE_MPSC);
+            }
+            if (res != XTNT_ZERO) {
+                if (logger->entries != NULL) {
+                    xtnt_mpool_destroy(&(logger->entries));
+                }
+                free(logger->buffer);
+                logger->buffer = NULL;
                 XTNT_STATE_SET_VALUE(logger->state, XTNT_LOG_ENTRY_INIT_FAIL);
             }
-            if ((res = pthread_mutex_unlock(&(logger->lock))) != XTNT_ZERO) {
+            if ((unlock = pthread_mutex_unlock(&(logger->lock))) != XTNT_ZERO) {
                 XTNT_LOCK_SET_UNLOCK_FAIL(logger->state);
+                if (res == XTNT_ZERO) {
+                    res = unlock;
+                }
+            } else if (res != XTNT_ZERO) {
+                // Nothing is left for xtnt_logger_uninitialize() to release
+                pthread_cond_destroy(&(logger->wake));
+                pthread_mutex_destroy(&(logger->lock));
             }
         } else {
             XTNT_LOCK_SET_LOCK_FAIL(logger->state);
@@ -277,8 +966,19 @@ xtnt_logger_initialize(
  * @param[in] logger xtnt_logger to process
  *
  * @note This is the function used when initiating a thread for processing
- * a logger. This thread will yield when logger is empty, but otherwise must
- * be terminated (e.g. pthread_cancel & pthread_join )
+ * a logger. This thread sleeps when logger is empty, until woken by
+ * `xtnt_log()`, and otherwise must be terminated (e.g. `xtnt_logger_exit()`
+ * or pthread_cancel & pthread_join )
+ *
+ * @note Entries are taken from the queue up to `XTNT_LOG_BATCH_SIZE` at a
+ * time with `xtnt_queue_pop_batch()`, followed by up to as many records
+ * merged from the thread rings of `xtnt_log_record()`. A failed pop marks
+ * the logger XTNT_LOGGER_WRITE_FAIL and counts as an empty batch.
+ *
+ * @note Formatted messages are collected in a private buffer and written to
+ * the file descriptor of the log stream with a single `writev()` once the
+ * flush size or time set by `xtnt_logger_change_flush()` is passed, the
+ * buffer fills, or the logger is empty.
  */
 void
 xtnt_logger_process(
@@ -286,64 +986,87 @@ xtnt_logger_process(
 {
     pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
 
-    xtnt_uint_t iter = XTNT_LOG_BATCH_SIZE;
+    struct xtnt_node *batch[XTNT_LOG_BATCH_SIZE];
+    xtnt_uint_t popped = XTNT_ZERO;
+    xtnt_uint_t merged = XTNT_ZERO;
     xtnt_status_t res = XTNT_ESUCCESS;
     xtnt_uint_t level;
     xtnt_uint_t state;
+    size_t flush_size;
+    uint64_t flush_nsec;
+
+    pthread_mutex_lock(&(logger->lock));
+    level = logger->default_level;
+    flush_size = logger->flush_size;
+    flush_nsec = logger->flush_usec * 1000;
+    pthread_mutex_unlock(&(logger->lock));
+
+    // Anything already buffered by stdio precedes the consumer's writes
+    fflush(logger->log);
+    logger->flushed = xtnt_logger_now();
 
     while (1){
         struct xtnt_logger_entry *entry= NULL;
-        struct xtnt_node *node = NULL;
         xtnt_int_t error = errno;
 
+        if ((res = xtnt_queue_pop_batch(&(logger->queue), XTNT_LOG_BATCH_SIZE, batch, &popped)) != XTNT_ESUCCESS ) {
+            // Nothing was taken, the rings are still merged below
+            popped = XTNT_ZERO;
+            XTNT_STATE_SET_VALUE(logger->state, XTNT_LOGGER_WRITE_FAIL);
+        }
 
-        if ((res = xtnt_queue_pop(&(logger->queue), &node)) != XTNT_ESUCCESS ) {
-            printf("xtnt error:: Logger queue state invalid : xtnt_queue_pop returned %i", res);
-/**
- * @todo Catch queue state and try to recover
- */
+        for (xtnt_uint_t idx = 0; idx < popped; idx++) {
+            entry = (struct xtnt_logger_entry *) batch[idx]->value;
+            if ((res = xtnt_logger_write(logger, entry, level)) != XTNT_ESUCCESS) {
+                error = res;
+                XTNT_STATE_SET_VALUE(logger->state, XTNT_LOGGER_WRITE_FAIL);
+                pthread_exit(&error);
+            }
+            if (XTNT_STATE(entry->state) == XTNT_LOG_ENTRY_EXTERNAL) {
+                xtnt_logger_entry_uninitialize(entry);
+            } else {
+                xtnt_logger_entry_destroy(&entry);
+            }
         }
 
-// If we've completed our batch size iterations or empty queue
-        if (node == NULL) {
-            fflush(logger->log); // flush
-            state = XTNT_STATE(logger->state);
+        if ((res = xtnt_logger_merge(logger, level, &merged)) != XTNT_ESUCCESS) {
+            error = res;
+            XTNT_STATE_SET_VALUE(logger->state, XTNT_LOGGER_WRITE_FAIL);
+            pthread_exit(&error);
+        }
+
+// If the queue and rings are empty
+        if (popped == 0 && merged == 0) {
+            if (logger->buffered != XTNT_ZERO &&
+                (res = xtnt_logger_flush(logger, NULL, XTNT_ZERO)) != XTNT_ESUCCESS) {
+                error = res;
+                XTNT_STATE_SET_VALUE(logger->state, XTNT_LOGGER_WRITE_FAIL);
+                pthread_exit(&error);
+            }
+            state = xtnt_logger_wait(logger, &level); // sleep until woken
             if (state == XTNT_LOGGER_PENDING_EXIT) {
                 pthread_exit(0);
             }
-            sched_yield(); // wait for scheduling
-        } else {
-            entry = (struct xtnt_logger_entry *) node->value;
-            char * (*get_string)(struct xtnt_logger_entry *) = entry->fmt_fn;
-
-            /**
-             * @todo Review need for optimization for lock here.
-             */
-            if (entry->level & level) {
-                if(XTNT_IS_EFAILURE((res = fputs(get_string(entry), logger->log)))) {
-                    error = errno;
-                    XTNT_STATE_SET_VALUE(logger->state, XTNT_LOGGER_WRITE_FAIL);
-                    pthread_exit(&error);
-                }
-            }
-            xtnt_logger_entry_destroy(&entry);
-            if (iter == 0) {
-                fflush(logger->log);
+            continue;
+        }
 
-                pthread_mutex_lock(&(logger->lock));
-                level = logger->default_level;
-                state = XTNT_STATE(logger->state);
-                pthread_mutex_unlock(&(logger->lock));
+// After each batch
+        if ((logger->buffered > flush_size ||
+             xtnt_logger_now() - logger->flushed >= flush_nsec) &&
+            (res = xtnt_logger_flush(logger, NULL, XTNT_ZERO)) != XTNT_ESUCCESS) {
+            error = res;
+            XTNT_STATE_SET_VALUE(logger->state, XTNT_LOGGER_WRITE_FAIL);
+            pthread_exit(&error);
+        }
 
-                pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
-                pthread_testcancel();
-                pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, NULL);
+        pthread_mutex_lock(&(logger->lock));
+        level = logger->default_level;
+        flush_size = logger->flush_size;
+        flush_nsec = logger->flush_usec * 1000;
+        state = XTNT_STATE(logger->state);
+        pthread_mutex_unlock(&(logger->lock));
 
-                iter = XTNT_LOG_BATCH_SIZE;
-            } else {
-                iter--;
-            }
-        }
+        xtnt_logger_testcancel(logger);
     }
 }
 
@@ -352,6 +1075,9 @@ xtnt_logger_process(
  *
  * @param[in] logger xtnt_logger to uninitialize
  * @return XTNT_ESUCCESS or error from subfunctions
+ *
+ * @warning Entries acquired from the logger and thread rings are released
+ * with it, the consumer must have written them first.
  */
 xtnt_status_t
 xtnt_logger_uninitialize(
@@ -360,8 +1086,19 @@ xtnt_logger_uninitialize(
     xtnt_status_t res = XTNT_EFAILURE;
     if ((res = pthread_mutex_lock(&(logger->lock))) == XTNT_ZERO) {
         xtnt_node_set_uninitialize(&(logger->queue));
+        if (logger->entries != NULL) {
+            xtnt_mpool_destroy(&(logger->entries));
+        }
+        free(logger->buffer);
+        logger->buffer = NULL;
+        while (logger->rings != NULL) {
+            struct xtnt_log_ring *ring = logger->rings;
+            logger->rings = ring->next;
+            free(ring);
+        }
         if ((res = pthread_mutex_unlock(&(logger->lock))) == XTNT_ZERO) {
-            if ((res = pthread_mutex_destroy(&(logger->lock))) != XTNT_ZERO) {
+            if ((res = pthread_mutex_destroy(&(logger->lock))) != XTNT_ZERO ||
+                (res = pthread_cond_destroy(&(logger->wake))) != XTNT_ZERO) {
                 XTNT_LOCK_SET_DESTROY_FAIL(logger->state);
             }
         } else {
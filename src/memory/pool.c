@@ -26,3 +26,432 @@ SOFTWARE.
 
 ===============================================================================
 */
+
+#include <extant/memory/pool.h>
+
+#define XTNT_MPOOL_INDEX_MASK (0xFFFFFFFFULL) /**< Free list index bits */
+#define XTNT_MPOOL_TAG ((uint64_t) 1 << 32) /**< Free list tag increment */
+
+/**
+ * @struct xtnt_mpool_magazine
+ *
+ * Thread local cache of free blocks for a single pool
+ */
+struct xtnt_mpool_magazine
+{
+    struct xtnt_node node; /**< Link in the magazine list of the pool */
+    struct xtnt_memory_object *pool; /**< Pool of the cached blocks, NULL when detached */
+    uint64_t id;
+    xtnt_uint_t count;
+    void *block[XTNT_MPOOL_MAGAZINE_SIZE];
+};
+
+static __thread struct xtnt_mpool_magazine xtnt_mpool_magazines[XTNT_MPOOL_MAGAZINES];
+
+static uint64_t xtnt_mpool_ids = XTNT_ZERO;
+
+/* Guards the magazine lists of every pool, taken when a slot changes pool */
+static pthread_mutex_t xtnt_mpool_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_once_t xtnt_mpool_once = PTHREAD_ONCE_INIT;
+
+static pthread_key_t xtnt_mpool_key;
+
+static xtnt_status_t xtnt_mpool_key_res = XTNT_EFAILURE;
+
+/**
+ * @brief Reference the free list link stored in a block
+ *
+ * @param[in] pool The pool owning the block
+ * @param[in] index The block index + 1
+ * @return pointer to the link word of the block
+ */
+static inline uint32_t *
+xtnt_mpool_link(
+    struct xtnt_memory_object *pool,
+    uint32_t index)
+{
+    return (uint32_t *) ((char *) pool->base + ((size_t) (index - 1) * pool->size));
+}
+
+/**
+ * @brief Evaluate the free list index of a block
+ *
+ * @param[in] pool The pool owning the block
+ * @param[in] block The block address
+ * @return the block index + 1
+ */
+static inline uint32_t
+xtnt_mpool_index(
+    struct xtnt_memory_object *pool,
+    void *block)
+{
+    return (uint32_t) (((char *) block - (char *) pool->base) / pool->size) + 1;
+}
+
+/**
+ * @brief Unlink a magazine from the list of its pool and empty it
+ *
+ * @param[in] mag The magazine, with `xtnt_mpool_lock` held
+ */
+static void
+xtnt_mpool_magazine_detach(
+    struct xtnt_mpool_magazine *mag)
+{
+    struct xtnt_node *prev = mag->node.link[XTNT_NODE_HEAD];
+    struct xtnt_node *next = mag->node.link[XTNT_NODE_TAIL];
+    if (mag->pool != NULL) {
+        if (prev != NULL) {
+            prev->link[XTNT_NODE_TAIL] = next;
+        } else {
+            mag->pool->set.root.link[XTNT_NODE_HEAD] = next;
+        }
+        if (next != NULL) {
+            next->link[XTNT_NODE_HEAD] = prev;
+        }
+        mag->pool->set.count--;
+    }
+    mag->node.link[XTNT_NODE_HEAD] = NULL;
+    mag->node.link[XTNT_NODE_TAIL] = NULL;
+    mag->pool = NULL;
+    mag->id = XTNT_ZERO;
+    mag->count = XTNT_ZERO;
+}
+
+/**
+ * @brief Detach up to `want` blocks from the shared free list
+ *
+ * @param[in] pool The pool to take blocks from
+ * @param[in] want The maximum number of blocks to take
+ * @param[out] blocks Array receiving the blocks
+ * @return number of blocks taken
+ *
+ * @note Every successful exchange of the head increments the tag, so a
+ * successful exchange guarantees the chain walked was not modified.
+ */
+static xtnt_uint_t
+xtnt_mpool_pop(
+    struct xtnt_memory_object *pool,
+    xtnt_uint_t want,
+    void **blocks)
+{
+    uint64_t head = __atomic_load_n(&(pool->head), __ATOMIC_ACQUIRE);
+    uint64_t next;
+    uint32_t index;
+    xtnt_uint_t got;
+    do {
+        got = XTNT_ZERO;
+        index = (uint32_t) (head & XTNT_MPOOL_INDEX_MASK);
+        while (index != XTNT_ZERO && got < want) {
+            blocks[got++] = xtnt_mpool_link(pool, index);
+            index = __atomic_load_n(xtnt_mpool_link(pool, index), __ATOMIC_RELAXED);
+            if (index > pool->count) {
+                // Chain changed under us, the exchange below will fail
+                index = XTNT_ZERO;
+            }
+        }
+        if (got == XTNT_ZERO) {
+            break;
+        }
+        next = ((head & ~XTNT_MPOOL_INDEX_MASK) + XTNT_MPOOL_TAG) | index;
+    } while (!__atomic_compare_exchange_n(&(pool->head), &head, next, 1,
+                                          __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+    return got;
+}
+
+/**
+ * @brief Attach blocks to the shared free list
+ *
+ * @param[in] pool The pool to return blocks to
+ * @param[in] blocks Array of blocks to return
+ * @param[in] count The number of blocks in the array
+ */
+static void
+xtnt_mpool_push(
+    struct xtnt_memory_object *pool,
+    void **blocks,
+    xtnt_uint_t count)
+{
+    uint32_t first = xtnt_mpool_index(pool, blocks[0]);
+    uint32_t *last = blocks[count - 1];
+    uint64_t head = __atomic_load_n(&(pool->head), __ATOMIC_RELAXED);
+    uint64_t next;
+    for (xtnt_uint_t idx = 1; idx < count; idx++) {
+        __atomic_store_n((uint32_t *) blocks[idx - 1],
+                         xtnt_mpool_index(pool, blocks[idx]),
+                         __ATOMIC_RELAXED);
+    }
+    do {
+        __atomic_store_n(last, (uint32_t) (head & XTNT_MPOOL_INDEX_MASK), __ATOMIC_RELAXED);
+        next = ((head & ~XTNT_MPOOL_INDEX_MASK) + XTNT_MPOOL_TAG) | first;
+    } while (!__atomic_compare_exchange_n(&(pool->head), &head, next, 1,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+/**
+ * @brief Return the magazines of an exiting thread to their pools
+ *
+ * @param[in] arg The magazines of the thread
+ *
+ * @note This is the destructor of `xtnt_mpool_key`, so blocks cached by a
+ * thread are not lost when it exits.
+ */
+static void
+xtnt_mpool_magazine_flush(
+    void *arg)
+{
+    struct xtnt_mpool_magazine *mags = arg;
+    if (pthread_mutex_lock(&xtnt_mpool_lock) == XTNT_ESUCCESS) {
+        for (xtnt_uint_t idx = 0; idx < XTNT_MPOOL_MAGAZINES; idx++) {
+            if (mags[idx].pool != NULL && mags[idx].count != XTNT_ZERO) {
+                xtnt_mpool_push(mags[idx].pool, mags[idx].block, mags[idx].count);
+            }
+            xtnt_mpool_magazine_detach(&(mags[idx]));
+        }
+        pthread_mutex_unlock(&xtnt_mpool_lock);
+    }
+}
+
+/**
+ * @brief Create the key whose destructor flushes the magazines of a thread
+ */
+static void
+xtnt_mpool_key_create(void)
+{
+    xtnt_mpool_key_res = pthread_key_create(&xtnt_mpool_key, xtnt_mpool_magazine_flush);
+}
+
+/**
+ * @brief Attach a magazine to the list of a pool
+ *
+ * @param[in] mag The empty magazine
+ * @param[in] pool The pool to cache blocks of
+ * @retval XTNT_ESUCCESS on attach
+ * @retval return value of `pthread_once()`, `pthread_key_create()`,
+ * `pthread_setspecific()`, `pthread_mutex_lock()` or `pthread_mutex_unlock()`
+ *
+ * @note The calling thread registers its magazines with `xtnt_mpool_key`
+ * on its first attach.
+ */
+static xtnt_status_t
+xtnt_mpool_magazine_attach(
+    struct xtnt_mpool_magazine *mag,
+    struct xtnt_memory_object *pool)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = pthread_once(&xtnt_mpool_once, xtnt_mpool_key_create)) != XTNT_ESUCCESS ||
+        (res = xtnt_mpool_key_res) != XTNT_ESUCCESS) {
+        return res;
+    }
+    if (pthread_getspecific(xtnt_mpool_key) == NULL &&
+        (res = pthread_setspecific(xtnt_mpool_key, xtnt_mpool_magazines)) != XTNT_ESUCCESS) {
+        return res;
+    }
+    if ((res = pthread_mutex_lock(&xtnt_mpool_lock)) == XTNT_ESUCCESS) {
+        xtnt_mpool_magazine_detach(mag);
+        mag->node.link[XTNT_NODE_TAIL] = pool->set.root.link[XTNT_NODE_HEAD];
+        if (mag->node.link[XTNT_NODE_TAIL] != NULL) {
+            mag->node.link[XTNT_NODE_TAIL]->link[XTNT_NODE_HEAD] = &(mag->node);
+        }
+        pool->set.root.link[XTNT_NODE_HEAD] = &(mag->node);
+        pool->set.count++;
+        mag->pool = pool;
+        mag->id = pool->id;
+        res = pthread_mutex_unlock(&xtnt_mpool_lock);
+    }
+    return res;
+}
+
+/**
+ * @brief Claim the calling thread's magazine for a pool
+ *
+ * @param[in] pool The pool to find a magazine for
+ * @return magazine or NULL when the slot caches blocks of another pool, or
+ * cannot be attached to the pool
+ */
+static inline struct xtnt_mpool_magazine *
+xtnt_mpool_magazine(
+    struct xtnt_memory_object *pool)
+{
+    struct xtnt_mpool_magazine *mag = &(xtnt_mpool_magazines[pool->id % XTNT_MPOOL_MAGAZINES]);
+    if (mag->id != pool->id) {
+        if (mag->count != XTNT_ZERO ||
+            xtnt_mpool_magazine_attach(mag, pool) != XTNT_ESUCCESS) {
+            return NULL;
+        }
+    }
+    return mag;
+}
+
+/**
+ * @brief Allocate blocks from a memory pool
+ *
+ * @param[in] pool The memory pool to allocate from
+ * @param[in] count The number of blocks to allocate
+ * @param[out] allocation Array of `count` pointers to store blocks to
+ * @retval XTNT_ESUCCESS on allocation of all blocks
+ * @retval ENOMEM when the pool has fewer than `count` free blocks
+ *
+ * @note Allocation is served from a thread local magazine first, then from
+ * the shared lock-free free list. A mutex is only taken when a magazine slot
+ * of the thread changes pool. On ENOMEM no blocks are kept by the caller.
+ *
+ * @warning Each thread may cache up to XTNT_MPOOL_MAGAZINE_SIZE free blocks,
+ * so a pool sized close to its peak usage can report ENOMEM while free blocks
+ * are cached by other threads. A thread's magazines return to their pools
+ * when it exits.
+ */
+xtnt_status_t
+xtnt_mpool_allocate(
+    struct xtnt_memory_object *pool,
+    xtnt_uint_t count,
+    void **allocation)
+{
+    xtnt_status_t res = XTNT_ESUCCESS;
+    struct xtnt_mpool_magazine *mag = xtnt_mpool_magazine(pool);
+    xtnt_uint_t idx = XTNT_ZERO;
+    xtnt_uint_t got = XTNT_ZERO;
+    while (idx < count) {
+        if (mag != NULL && mag->count != XTNT_ZERO) {
+            allocation[idx++] = mag->block[--(mag->count)];
+        } else if (mag != NULL && (count - idx) < (XTNT_MPOOL_MAGAZINE_SIZE >> 1)) {
+            if ((mag->count = xtnt_mpool_pop(pool, XTNT_MPOOL_MAGAZINE_SIZE >> 1, mag->block)) == XTNT_ZERO) {
+                break;
+            }
+        } else {
+            if ((got = xtnt_mpool_pop(pool, count - idx, &(allocation[idx]))) == XTNT_ZERO) {
+                break;
+            }
+            idx += got;
+        }
+    }
+    if (idx < count) {
+        while (idx > XTNT_ZERO) {
+            xtnt_mpool_deallocate(pool, &(allocation[--idx]));
+        }
+        res = ENOMEM;
+    }
+    return res;
+}
+
+/**
+ * @brief Create a memory pool of fixed size blocks
+ *
+ * @param[in] size The size of each block
+ * @param[in] count The number of blocks
+ * @param[out] pool Pointer reference to store pool to
+ * @retval XTNT_ESUCCESS on allocation and initialization
+ * @retval EINVAL on 0 size or count, or count beyond 2^32 - 2 blocks
+ * @retval errno on `malloc()`, `posix_memalign()` or `pthread_mutex_init()`
+ *
+ * @note Block size is rounded up to a multiple of XTNT_MPOOL_ALIGN, and blocks
+ * are aligned to XTNT_MPOOL_ALIGN.
+ */
+xtnt_status_t
+xtnt_mpool_create(
+    size_t size,
+    xtnt_uint_t count,
+    struct xtnt_memory_object **pool)
+{
+    xtnt_status_t res = XTNT_ESUCCESS;
+    struct xtnt_memory_object *mpool = NULL;
+    size = (size + (XTNT_MPOOL_ALIGN - 1)) & ~((size_t) XTNT_MPOOL_ALIGN - 1);
+    if (size == XTNT_ZERO || count == XTNT_ZERO ||
+        count >= XTNT_MPOOL_INDEX_MASK || count > (SIZE_MAX / size)) {
+        res = EINVAL;
+    } else if ((mpool = malloc(sizeof(struct xtnt_memory_object))) != NULL) {
+        mpool->state = XTNT_ZERO;
+        if ((res = posix_memalign(&(mpool->base), XTNT_MPOOL_ALIGN, size * count)) == XTNT_ESUCCESS) {
+            if ((res = pthread_mutex_init(&(mpool->lock), NULL)) == XTNT_ESUCCESS) {
+                xtnt_node_set_initialize_lock(&(mpool->set), XTNT_SET_LOCK_NONE);
+                mpool->size = size;
+                mpool->count = count;
+                mpool->id = __atomic_add_fetch(&xtnt_mpool_ids, 1, __ATOMIC_RELAXED);
+                for (uint32_t index = 1; index < count; index++) {
+                    *xtnt_mpool_link(mpool, index) = index + 1;
+                }
+                *xtnt_mpool_link(mpool, (uint32_t) count) = XTNT_ZERO;
+                mpool->head = 1;
+            } else {
+                free(mpool->base);
+                free(mpool);
+                mpool = NULL;
+            }
+        } else {
+            free(mpool);
+            mpool = NULL;
+        }
+    } else {
+        res = errno;
+    }
+    *pool = mpool;
+    return res;
+}
+
+/**
+ * @brief Return a block to a memory pool
+ *
+ * @param[in] pool The memory pool the block was allocated from
+ * @param[in,out] allocation Pointer reference of the block, set to NULL
+ * @retval XTNT_ESUCCESS always
+ *
+ * @note Blocks return to the thread local magazine first. A full magazine
+ * returns half its blocks to the shared free list with a single exchange.
+ */
+xtnt_status_t
+xtnt_mpool_deallocate(
+    struct xtnt_memory_object *pool,
+    void **allocation)
+{
+    struct xtnt_mpool_magazine *mag = xtnt_mpool_magazine(pool);
+    if (mag != NULL) {
+        if (mag->count == XTNT_MPOOL_MAGAZINE_SIZE) {
+            mag->count -= (XTNT_MPOOL_MAGAZINE_SIZE >> 1);
+            xtnt_mpool_push(pool, &(mag->block[mag->count]), XTNT_MPOOL_MAGAZINE_SIZE >> 1);
+        }
+        mag->block[mag->count++] = *allocation;
+    } else {
+        xtnt_mpool_push(pool, allocation, 1);
+    }
+    *allocation = NULL;
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Destroy a memory pool
+ *
+ * @param[in,out] pool Pointer reference of the pool, set to NULL
+ * @retval XTNT_ESUCCESS on deallocation
+ * @retval errno on `pthread_mutex_destroy()`
+ *
+ * @retval return value of `pthread_mutex_lock()` or `pthread_mutex_unlock()`
+ *
+ * @warning All blocks are released with the pool, including blocks still held
+ * by callers or cached in the magazines of other threads. Those magazines are
+ * emptied and detached, so the pool must not be in use by other threads.
+ */
+xtnt_status_t
+xtnt_mpool_destroy(
+    struct xtnt_memory_object **pool)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_memory_object *mpool = *pool;
+    if ((res = pthread_mutex_lock(&xtnt_mpool_lock)) != XTNT_ESUCCESS) {
+        return res;
+    }
+    while (mpool->set.root.link[XTNT_NODE_HEAD] != NULL) {
+        xtnt_mpool_magazine_detach((struct xtnt_mpool_magazine *) mpool->set.root.link[XTNT_NODE_HEAD]);
+    }
+    if ((res = pthread_mutex_unlock(&xtnt_mpool_lock)) != XTNT_ESUCCESS) {
+        return res;
+    }
+    if ((res = pthread_mutex_destroy(&(mpool->lock))) == XTNT_ESUCCESS) {
+        xtnt_node_set_uninitialize(&(mpool->set));
+        free(mpool->base);
+        free(mpool);
+        *pool = NULL;
+    } else {
+        XTNT_LOCK_SET_DESTROY_FAIL(mpool->state);
+    }
+    return res;
+}
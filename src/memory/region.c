@@ -26,3 +26,307 @@ SOFTWARE.
 
 ===============================================================================
 */
+
+#include <extant/memory/region.h>
+
+/**
+ * @struct xtnt_mregion_chunk
+ *
+ * Header of a region chunk, followed by the chunk memory
+ */
+struct xtnt_mregion_chunk
+{
+    struct xtnt_node node;
+    size_t size;
+    size_t used;
+    size_t last;
+};
+
+#define XTNT_MREGION_CHUNK_HEADER \
+    ((sizeof(struct xtnt_mregion_chunk) + (XTNT_MREGION_ALIGN - 1)) & ~((size_t) XTNT_MREGION_ALIGN - 1))
+
+/**
+ * @brief Reference the memory of a chunk
+ *
+ * @param[in] chunk The chunk header
+ * @return the first usable byte of the chunk
+ */
+static inline char *
+xtnt_mregion_data(
+    struct xtnt_mregion_chunk *chunk)
+{
+    return (char *) chunk + XTNT_MREGION_CHUNK_HEADER;
+}
+
+/**
+ * @brief Allocate a chunk and append it to the region
+ *
+ * @param[in] region The region to append to
+ * @param[in] size The usable size of the chunk
+ * @return chunk or NULL on `malloc()` failure, errno is ENOMEM when the
+ * size does not fit a chunk
+ */
+static struct xtnt_mregion_chunk *
+xtnt_mregion_chunk_append(
+    struct xtnt_memory_object *region,
+    size_t size)
+{
+    struct xtnt_mregion_chunk *chunk = NULL;
+    if (size > SIZE_MAX - XTNT_MREGION_CHUNK_HEADER) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    chunk = malloc(XTNT_MREGION_CHUNK_HEADER + size);
+    if (chunk != NULL) {
+        xtnt_node_initialize(&(chunk->node), XTNT_ZERO, XTNT_ZERO, chunk);
+        chunk->size = size;
+        chunk->used = XTNT_ZERO;
+        chunk->last = XTNT_ZERO;
+        if (region->set.root.link[XTNT_NODE_TAIL] != NULL) {
+            region->set.root.link[XTNT_NODE_TAIL]->link[XTNT_NODE_TAIL] = &(chunk->node);
+            chunk->node.link[XTNT_NODE_HEAD] = region->set.root.link[XTNT_NODE_TAIL];
+        } else {
+            region->set.root.link[XTNT_NODE_HEAD] = &(chunk->node);
+        }
+        region->set.root.link[XTNT_NODE_TAIL] = &(chunk->node);
+        region->set.count++;
+    }
+    return chunk;
+}
+
+/**
+ * @brief Allocate memory from a region
+ *
+ * @param[in] region The region to allocate from
+ * @param[in] size The number of bytes to allocate
+ * @param[out] allocation Pointer reference to store allocation to
+ * @retval XTNT_ESUCCESS on allocation
+ * @retval result of `xtnt_mregion_allocate_aligned()`
+ *
+ * @note The allocation is aligned to XTNT_MREGION_ALIGN
+ */
+xtnt_status_t
+xtnt_mregion_allocate(
+    struct xtnt_memory_object *region,
+    size_t size,
+    void **allocation)
+{
+    return xtnt_mregion_allocate_aligned(region, size, XTNT_MREGION_ALIGN, allocation);
+}
+
+/**
+ * @brief Allocate aligned memory from a region
+ *
+ * @param[in] region The region to allocate from
+ * @param[in] size The number of bytes to allocate
+ * @param[in] alignment Power of 2 alignment of the allocation
+ * @param[out] allocation Pointer reference to store allocation to
+ * @retval XTNT_ESUCCESS on allocation
+ * @retval EINVAL on alignment not a power of 2
+ * @retval ENOMEM on size too large for a chunk, or failure to append a chunk
+ * @retval return value of `pthread_mutex_lock()` or `pthread_mutex_unlock()`
+ *
+ * @note Allocation bumps an offset in the current chunk. When the current
+ * chunk is exhausted, the next chunk retained by a previous reset is reused,
+ * or a new chunk of at least the region size is appended.
+ */
+xtnt_status_t
+xtnt_mregion_allocate_aligned(
+    struct xtnt_memory_object *region,
+    size_t size,
+    size_t alignment,
+    void **allocation)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_mregion_chunk *chunk = NULL;
+    struct xtnt_node *next = NULL;
+    uintptr_t offset = XTNT_ZERO;
+    *allocation = NULL;
+    if (alignment == XTNT_ZERO || (alignment & (alignment - 1)) != XTNT_ZERO) {
+        return EINVAL;
+    }
+    if (size > SIZE_MAX - alignment - XTNT_MREGION_CHUNK_HEADER) {
+        return ENOMEM;
+    }
+    if ((res = pthread_mutex_lock(&(region->lock))) == XTNT_ESUCCESS) {
+        chunk = (struct xtnt_mregion_chunk *) region->set.root.link[XTNT_NODE_MIDDLE];
+        while (*allocation == NULL) {
+            offset = ((uintptr_t) xtnt_mregion_data(chunk) + chunk->used + (alignment - 1)) & ~((uintptr_t) alignment - 1);
+            offset -= (uintptr_t) xtnt_mregion_data(chunk);
+            if (offset <= chunk->size && size <= chunk->size - offset) {
+                chunk->last = chunk->used;
+                chunk->used = offset + size;
+                *allocation = xtnt_mregion_data(chunk) + offset;
+                region->set.root.link[XTNT_NODE_MIDDLE] = &(chunk->node);
+            } else if ((next = chunk->node.link[XTNT_NODE_TAIL]) != NULL) {
+                chunk = (struct xtnt_mregion_chunk *) next;
+                chunk->used = XTNT_ZERO;
+                chunk->last = XTNT_ZERO;
+            } else if ((chunk = xtnt_mregion_chunk_append(region,
+                        (size + alignment > region->size) ? size + alignment : region->size)) == NULL) {
+                res = ENOMEM;
+                break;
+            }
+        }
+        xtnt_status_t unlock = pthread_mutex_unlock(&(region->lock));
+        if (unlock != XTNT_ESUCCESS) {
+            XTNT_LOCK_SET_UNLOCK_FAIL(region->state);
+            res = unlock;
+        }
+    } else {
+        XTNT_LOCK_SET_LOCK_FAIL(region->state);
+    }
+    return res;
+}
+
+/**
+ * @brief Create a memory region
+ *
+ * @param[in] size The size of each chunk of the region
+ * @param[out] region Pointer reference to store region to
+ * @retval XTNT_ESUCCESS on allocation and initialization
+ * @retval EINVAL on 0 size
+ * @retval errno on `malloc()` or `pthread_mutex_init()`
+ * @retval result of `xtnt_node_set_initialize()`
+ */
+xtnt_status_t
+xtnt_mregion_create(
+    size_t size,
+    struct xtnt_memory_object **region)
+{
+    xtnt_status_t res = XTNT_ESUCCESS;
+    struct xtnt_memory_object *mregion = NULL;
+    struct xtnt_mregion_chunk *chunk = NULL;
+    if (size == XTNT_ZERO) {
+        res = EINVAL;
+    } else if ((mregion = malloc(sizeof(struct xtnt_memory_object))) != NULL) {
+        mregion->size = size;
+        mregion->state = XTNT_ZERO;
+        mregion->count = XTNT_ZERO;
+        mregion->head = XTNT_ZERO;
+        mregion->id = XTNT_ZERO;
+        if ((res = xtnt_node_set_initialize(&(mregion->set))) == XTNT_ESUCCESS) {
+            if ((res = pthread_mutex_init(&(mregion->lock), NULL)) == XTNT_ESUCCESS) {
+                if ((chunk = xtnt_mregion_chunk_append(mregion, size)) != NULL) {
+                    mregion->set.root.link[XTNT_NODE_MIDDLE] = &(chunk->node);
+                    mregion->base = chunk;
+                } else {
+                    res = errno;
+                    pthread_mutex_destroy(&(mregion->lock));
+                }
+            } else {
+                XTNT_LOCK_SET_INIT_FAIL(mregion->state);
+            }
+            if (res != XTNT_ESUCCESS) {
+                xtnt_node_set_uninitialize(&(mregion->set));
+            }
+        }
+        if (res != XTNT_ESUCCESS) {
+            free(mregion);
+            mregion = NULL;
+        }
+    } else {
+        res = errno;
+    }
+    *region = mregion;
+    return res;
+}
+
+/**
+ * @brief Release an allocation to a region
+ *
+ * @param[in] region The region the allocation came from
+ * @param[in,out] allocation Pointer reference of allocation, set to NULL
+ * @retval XTNT_ESUCCESS on release
+ * @retval return value of `pthread_mutex_lock()` or `pthread_mutex_unlock()`
+ *
+ * @note Only the most recent allocation of the current chunk is returned to
+ * the region. Any other memory is reclaimed by `xtnt_mregion_reset()`.
+ */
+xtnt_status_t
+xtnt_mregion_deallocate(
+    struct xtnt_memory_object *region,
+    void **allocation)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_mregion_chunk *chunk = NULL;
+    if ((res = pthread_mutex_lock(&(region->lock))) == XTNT_ESUCCESS) {
+        chunk = (struct xtnt_mregion_chunk *) region->set.root.link[XTNT_NODE_MIDDLE];
+        if (chunk->used != chunk->last && (char *) *allocation >= xtnt_mregion_data(chunk) + chunk->last &&
+            (char *) *allocation < xtnt_mregion_data(chunk) + chunk->used) {
+            chunk->used = chunk->last;
+        }
+        *allocation = NULL;
+        if ((res = pthread_mutex_unlock(&(region->lock))) != XTNT_ESUCCESS) {
+            XTNT_LOCK_SET_UNLOCK_FAIL(region->state);
+        }
+    } else {
+        XTNT_LOCK_SET_LOCK_FAIL(region->state);
+    }
+    return res;
+}
+
+/**
+ * @brief Destroy a memory region
+ *
+ * @param[in,out] region Pointer reference of region, set to NULL
+ * @retval XTNT_ESUCCESS on deallocation
+ * @retval errno on `pthread_mutex_destroy()`
+ *
+ * @warning All allocations made from the region are released.
+ */
+xtnt_status_t
+xtnt_mregion_destroy(
+    struct xtnt_memory_object **region)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_memory_object *mregion = *region;
+    struct xtnt_node *chunk = NULL;
+    struct xtnt_node *next = NULL;
+    if ((res = pthread_mutex_destroy(&(mregion->lock))) == XTNT_ESUCCESS) {
+        chunk = mregion->set.root.link[XTNT_NODE_HEAD];
+        while (chunk != NULL) {
+            next = chunk->link[XTNT_NODE_TAIL];
+            free(chunk);
+            chunk = next;
+        }
+        xtnt_node_set_uninitialize(&(mregion->set));
+        free(mregion);
+        *region = NULL;
+    } else {
+        XTNT_LOCK_SET_DESTROY_FAIL(mregion->state);
+    }
+    return res;
+}
+
+/**
+ * @brief Release every allocation of a region at once
+ *
+ * @param[in] region The region to reset
+ * @retval XTNT_ESUCCESS on reset
+ * @retval return value of `pthread_mutex_lock()` or `pthread_mutex_unlock()`
+ *
+ * @note This is O(1). Chunks are retained and reused in order by later
+ * allocations, each chunk being rewound when allocation reaches it.
+ *
+ * @warning Memory from prior allocations must no longer be referenced.
+ */
+xtnt_status_t
+xtnt_mregion_reset(
+    struct xtnt_memory_object *region)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_mregion_chunk *chunk = NULL;
+    if ((res = pthread_mutex_lock(&(region->lock))) == XTNT_ESUCCESS) {
+        chunk = (struct xtnt_mregion_chunk *) region->set.root.link[XTNT_NODE_HEAD];
+        chunk->used = XTNT_ZERO;
+        chunk->last = XTNT_ZERO;
+        region->set.root.link[XTNT_NODE_MIDDLE] = &(chunk->node);
+        if ((res = pthread_mutex_unlock(&(region->lock))) != XTNT_ESUCCESS) {
+            XTNT_LOCK_SET_UNLOCK_FAIL(region->state);
+        }
+    } else {
+        XTNT_LOCK_SET_LOCK_FAIL(region->state);
+    }
+    return res;
+}
@@ -27,7 +27,514 @@ SOFTWARE.
 ===============================================================================
 */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // mremap
+#endif /* ifndef _GNU_SOURCE */
+
 #include <extant/set/array.h>
+#include <extant/set/sort.h>
+
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif /* if defined(__AVX2__) */
+
+/*
+ * The member table and the key column of an array are columns allocated
+ * apart from the set, so they can move while the set stays put. Each column
+ * records its allocated bytes in a cache line ahead of its first slot, so it
+ * is freed the way it was allocated: from XTNT_ARRAY_MAP_SIZE bytes it is
+ * mapped, and resized with mremap where available instead of copied.
+ */
+
+#define XTNT_ARRAY_COLUMN (64) /**< Bytes ahead of the first slot of a column */
+
+/*
+ * Columns replaced while XTNT_SET_LOCK_SEQLOCK readers may still scan them,
+ * chained from root.value until the array is destroyed.
+ */
+struct xtnt_array_retired {
+    struct xtnt_array_retired *next;
+    void *column;
+};
+
+/**
+ * @brief Round a column allocation up to whole pages
+ *
+ * @param[in] bytes The allocated bytes of a column
+ * @return bytes rounded up to the page size
+ */
+static size_t
+xtnt_array_pages(
+    size_t bytes)
+{
+    size_t page = (size_t) sysconf(_SC_PAGESIZE);
+    return (bytes + page - 1) & ~(page - 1);
+}
+
+/**
+ * @brief Allocate a column
+ *
+ * @param[in] bytes The bytes of slots
+ * @return first slot of the column or NULL
+ */
+static void *
+xtnt_array_column_alloc(
+    size_t bytes)
+{
+    size_t total = bytes + XTNT_ARRAY_COLUMN;
+    char *block = NULL;
+    if (total >= XTNT_ARRAY_MAP_SIZE) {
+        block = mmap(NULL, xtnt_array_pages(total), PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (block == MAP_FAILED) {
+            return NULL;
+        }
+    } else if ((block = malloc(total)) == NULL) {
+        return NULL;
+    }
+    *((size_t *) block) = total;
+    return block + XTNT_ARRAY_COLUMN;
+}
+
+/**
+ * @brief Free a column
+ *
+ * @param[in] column First slot of the column, or NULL
+ */
+static void
+xtnt_array_column_free(
+    void *column)
+{
+    char *block = NULL;
+    if (column == NULL) {
+        return;
+    }
+    block = (char *) column - XTNT_ARRAY_COLUMN;
+    if (*((size_t *) block) >= XTNT_ARRAY_MAP_SIZE) {
+        munmap(block, xtnt_array_pages(*((size_t *) block)));
+    } else {
+        free(block);
+    }
+}
+
+/**
+ * @brief Resize a column, keeping the slots both sizes hold
+ *
+ * @param[in] column First slot of the column
+ * @param[in] bytes The new bytes of slots
+ * @return first slot of the resized column or NULL with the column intact
+ *
+ * @note A mapped column is remapped, the kernel moves its pages instead of
+ * copying them. A column crossing XTNT_ARRAY_MAP_SIZE is copied once.
+ */
+static void *
+xtnt_array_column_resize(
+    void *column,
+    size_t bytes)
+{
+    char *block = (char *) column - XTNT_ARRAY_COLUMN;
+    size_t total = *((size_t *) block);
+    size_t resize = bytes + XTNT_ARRAY_COLUMN;
+    char *moved = NULL;
+    if (total < XTNT_ARRAY_MAP_SIZE && resize < XTNT_ARRAY_MAP_SIZE) {
+        if ((moved = realloc(block, resize)) == NULL) {
+            return NULL;
+        }
+        *((size_t *) moved) = resize;
+        return moved + XTNT_ARRAY_COLUMN;
+    }
+#ifdef MREMAP_MAYMOVE
+    if (total >= XTNT_ARRAY_MAP_SIZE && resize >= XTNT_ARRAY_MAP_SIZE) {
+        moved = mremap(block, xtnt_array_pages(total), xtnt_array_pages(resize), MREMAP_MAYMOVE);
+        if (moved == MAP_FAILED) {
+            return NULL;
+        }
+        *((size_t *) moved) = resize;
+        return moved + XTNT_ARRAY_COLUMN;
+    }
+#endif /* ifdef MREMAP_MAYMOVE */
+    if ((moved = xtnt_array_column_alloc(bytes)) != NULL) {
+        memcpy(moved, column, ((total < resize) ? total : resize) - XTNT_ARRAY_COLUMN);
+        xtnt_array_column_free(column);
+    }
+    return moved;
+}
+
+/**
+ * @brief Evaluate the slots a column has room for
+ *
+ * @param[in] column First slot of the column
+ * @param[in] width The bytes of a slot
+ * @return slots allocated to the column
+ */
+static size_t
+xtnt_array_column_slots(
+    void *column,
+    size_t width)
+{
+    return (*((size_t *) ((char *) column - XTNT_ARRAY_COLUMN)) - XTNT_ARRAY_COLUMN) / width;
+}
+
+/**
+ * @brief Copy a column into a new one and retire the old one
+ *
+ * @param[in] array The XTNT_SET_LOCK_SEQLOCK array, write locked
+ * @param[in] column First slot of the column
+ * @param[in] bytes The new bytes of slots
+ * @param[in] keep The bytes of slots to copy
+ * @return first slot of the new column or NULL with the column intact
+ *
+ * @note Optimistic readers may still scan the old column, so it stays
+ * readable until `xtnt_array_destroy()`. See `xtnt_array_resize()` for
+ * what bounds the retired columns.
+ */
+static void *
+xtnt_array_column_retire(
+    struct xtnt_node_set *array,
+    void *column,
+    size_t bytes,
+    size_t keep)
+{
+    struct xtnt_array_retired *retired = NULL;
+    void *moved = NULL;
+    if ((retired = malloc(sizeof(struct xtnt_array_retired))) == NULL) {
+        return NULL;
+    }
+    if ((moved = xtnt_array_column_alloc(bytes)) == NULL) {
+        free(retired);
+        return NULL;
+    }
+    memcpy(moved, column, keep);
+    retired->column = column;
+    retired->next = (struct xtnt_array_retired *) array->root.value;
+    array->root.value = retired;
+    return moved;
+}
+
+/**
+ * @brief Point the tail link of an array at its last slot
+ *
+ * @param[in] array The array, write locked
+ */
+static void
+xtnt_array_tail(
+    struct xtnt_node_set *array)
+{
+    struct xtnt_node **table = (struct xtnt_node **) array->root.link[XTNT_NODE_HEAD];
+    array->root.link[XTNT_NODE_TAIL] = (array->count) ? (struct xtnt_node *) (table + (array->count - 1)) : NULL;
+}
+
+/**
+ * @brief Resize the columns of a XTNT_SET_LOCK_SEQLOCK array
+ *
+ * @param[in] array The XTNT_SET_LOCK_SEQLOCK array, write locked
+ * @param[in] size The slots to hold, no fewer than the member count
+ * @retval XTNT_ESUCCESS on resize
+ * @retval ENOMEM when a column can not be allocated, the members are intact
+ *
+ * @note Columns are never reallocated to shrink, only `size` is lowered,
+ * and a column outgrown is replaced by one of at least twice its slots.
+ * Every retired column is therefore less than half the next, and the
+ * retired columns add up to less than the live one however the array
+ * alternates growing and shrinking.
+ */
+static xtnt_status_t
+xtnt_array_resize_seqlock(
+    struct xtnt_node_set *array,
+    size_t size)
+{
+    void *table = array->root.link[XTNT_NODE_HEAD];
+    void *keys = array->root.link[XTNT_NODE_MIDDLE];
+    size_t limit = (SIZE_MAX - XTNT_ARRAY_COLUMN) / sizeof(struct xtnt_node *);
+    size_t slots = xtnt_array_column_slots(table, sizeof(struct xtnt_node *));
+    if (size > slots) {
+        slots = (slots > (limit >> 1) || (slots << 1) < size) ? size : slots << 1;
+        if ((table = xtnt_array_column_retire(array, table, sizeof(struct xtnt_node *) * slots,
+                                              sizeof(struct xtnt_node *) * array->size)) == NULL) {
+            return ENOMEM;
+        }
+        __atomic_store_n(&(array->root.link[XTNT_NODE_HEAD]), table, __ATOMIC_RELEASE);
+        xtnt_array_tail(array);
+    }
+    if (keys != NULL && size > (slots = xtnt_array_column_slots(keys, sizeof(xtnt_uint_t)))) {
+        slots = (slots > (limit >> 1) || (slots << 1) < size) ? size : slots << 1;
+        if ((keys = xtnt_array_column_retire(array, keys, sizeof(xtnt_uint_t) * slots,
+                                             sizeof(xtnt_uint_t) * array->size)) == NULL) {
+            // The table grew, both columns still hold the old size
+            return ENOMEM;
+        }
+        __atomic_store_n(&(array->root.link[XTNT_NODE_MIDDLE]), keys, __ATOMIC_RELEASE);
+    }
+    array->size = (xtnt_uint_t) size;
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Resize the table and key column of an array
+ *
+ * @param[in] array The array, write locked
+ * @param[in] size The slots to hold, no fewer than the member count
+ * @retval XTNT_ESUCCESS on resize
+ * @retval EOVERFLOW when `size` slots can not be counted or addressed
+ * @retval ENOMEM when a column can not be allocated, the members are intact
+ *
+ * @note A XTNT_SET_LOCK_SEQLOCK array is resized by
+ * `xtnt_array_resize_seqlock()`. Otherwise a new table is published before
+ * the count can grow into it and after the count has shrunk out of the old
+ * one.
+ */
+static xtnt_status_t
+xtnt_array_resize(
+    struct xtnt_node_set *array,
+    size_t size)
+{
+    void *table = array->root.link[XTNT_NODE_HEAD];
+    void *keys = array->root.link[XTNT_NODE_MIDDLE];
+    if ((xtnt_uint_t) size != size ||
+        size > (SIZE_MAX - XTNT_ARRAY_COLUMN) / sizeof(struct xtnt_node *)) {
+        return EOVERFLOW;
+    }
+    if (array->policy == XTNT_SET_LOCK_SEQLOCK) {
+        return xtnt_array_resize_seqlock(array, size);
+    }
+    if ((table = xtnt_array_column_resize(table, sizeof(struct xtnt_node *) * size)) == NULL) {
+        return ENOMEM;
+    }
+    array->root.link[XTNT_NODE_HEAD] = table;
+    xtnt_array_tail(array);
+    if (keys != NULL) {
+        if ((keys = xtnt_array_column_resize(keys, sizeof(xtnt_uint_t) * size)) == NULL) {
+            // Both columns still hold the smaller of the two sizes
+            if (size < array->size) {
+                array->size = (xtnt_uint_t) size;
+            }
+            return ENOMEM;
+        }
+        __atomic_store_n(&(array->root.link[XTNT_NODE_MIDDLE]), keys, __ATOMIC_RELEASE);
+    }
+    array->size = (xtnt_uint_t) size;
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Double the slots of an array
+ *
+ * @param[in] array The array, write locked
+ * @retval XTNT_ESUCCESS on grow
+ * @retval result of `xtnt_array_resize()`
+ *
+ * @note An empty array grows to XTNT_ARRAY_SIZE slots. Doubling keeps the
+ * copies of a run of pushes to a constant number per push.
+ */
+static xtnt_status_t
+xtnt_array_double(
+    struct xtnt_node_set *array)
+{
+    if (array->size < XTNT_ARRAY_SIZE) {
+        return xtnt_array_resize(array, XTNT_ARRAY_SIZE);
+    }
+    return xtnt_array_resize(array, (size_t) array->size << 1);
+}
+
+/**
+ * @brief Grow an array to hold a number of slots
+ *
+ * @param[in] array The array, write locked
+ * @param[in] need The slots to hold
+ * @retval XTNT_ESUCCESS when the slots are held
+ * @retval result of `xtnt_array_resize()`
+ *
+ * @note The array doubles until it holds `need` slots, in one resize, so a
+ * bulk push copies the table at most once.
+ */
+static xtnt_status_t
+xtnt_array_reserve(
+    struct xtnt_node_set *array,
+    size_t need)
+{
+    size_t size = (array->size < XTNT_ARRAY_SIZE) ? XTNT_ARRAY_SIZE : (size_t) array->size;
+    if (need <= array->size) {
+        return XTNT_ESUCCESS;
+    }
+    while (size < need && size <= (SIZE_MAX >> 1)) {
+        size <<= 1;
+    }
+    return xtnt_array_resize(array, (size < need) ? need : size);
+}
+
+/**
+ * @brief Sort the members of an array to the front of its table
+ *
+ * @param[in] array The array, write locked
+ * @param[in] compare The order to sort in
+ * @param[in] threads The most threads to sort with, see
+ * `xtnt_sort_table_parallel()`
+ * @param[in] cutoff The fewest members per thread
+ * @retval XTNT_ESUCCESS on sort
+ * @retval result of `xtnt_sort_table_parallel()`
+ *
+ * @note Empty slots move behind the members, keeping the slot count. The key
+ * column of an XTNT_ARRAY_MODE_KEYED array is rewritten in the new order.
+ */
+static xtnt_status_t
+xtnt_array_order(
+    struct xtnt_node_set *array,
+    xtnt_node_compare_fn compare,
+    size_t threads,
+    size_t cutoff)
+{
+    xtnt_status_t res = XTNT_ESUCCESS;
+    struct xtnt_node **table = (struct xtnt_node **) array->root.link[XTNT_NODE_HEAD];
+    xtnt_uint_t *keys = (xtnt_uint_t *) array->root.link[XTNT_NODE_MIDDLE];
+    size_t members = 0;
+    for (xtnt_uint_t idx = 0; idx < array->count; idx++) {
+        if (table[idx] != NULL) {
+            table[members++] = table[idx];
+        }
+    }
+    for (size_t idx = members; idx < array->count; idx++) {
+        table[idx] = NULL;
+    }
+    res = xtnt_sort_table_parallel(table, members, compare, threads, cutoff);
+    if (keys != NULL) {
+        for (xtnt_uint_t idx = 0; idx < array->count; idx++) {
+            keys[idx] = (table[idx] != NULL) ? table[idx]->key : XTNT_ZERO;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Return the first non-NULL member among matching lanes
+ *
+ * @param[in] table The member table
+ * @param[in] base The index of lane 0
+ * @param[in] lanes One bit per lane whose key matched
+ * @return member or NULL when every matching slot is empty
+ */
+static inline struct xtnt_node *
+xtnt_array_match(
+    struct xtnt_node **table,
+    xtnt_uint_t base,
+    unsigned int lanes)
+{
+    for (; lanes != 0; lanes &= lanes - 1) {
+        if (table[base + __builtin_ctz(lanes)] != NULL) {
+            return table[base + __builtin_ctz(lanes)];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Find the first member with a key in the key column of an array
+ *
+ * @param[in] table The member table
+ * @param[in] keys The key column of an XTNT_ARRAY_MODE_KEYED array
+ * @param[in] count The slots to compare
+ * @param[in] key The key to match
+ * @return node on match or NULL
+ *
+ * @note The column is compared 256 bits at a time when built with AVX2,
+ * 128 bits with SSE2, and one key at a time otherwise. Empty slots hold
+ * key 0, so a match is only returned for a non-NULL member.
+ */
+static struct xtnt_node *
+xtnt_array_find_keyed(
+    struct xtnt_node **table,
+    const xtnt_uint_t *keys,
+    xtnt_uint_t count,
+    xtnt_uint_t key)
+{
+    struct xtnt_node *node = NULL;
+    xtnt_uint_t idx = 0;
+#if defined(__AVX2__)
+    if (sizeof(xtnt_uint_t) == sizeof(uint32_t)) {
+        __m256i needle = _mm256_set1_epi32((int) key);
+        for (; idx + 8 <= count; idx += 8) {
+            __m256i cmp = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) (keys + idx)), needle);
+            unsigned int lanes = (unsigned int) _mm256_movemask_ps(_mm256_castsi256_ps(cmp));
+            if (lanes && (node = xtnt_array_match(table, idx, lanes)) != NULL) {
+                return node;
+            }
+        }
+    } else {
+        __m256i needle = _mm256_set1_epi64x((long long) key);
+        for (; idx + 4 <= count; idx += 4) {
+            __m256i cmp = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *) (keys + idx)), needle);
+            unsigned int lanes = (unsigned int) _mm256_movemask_pd(_mm256_castsi256_pd(cmp));
+            if (lanes && (node = xtnt_array_match(table, idx, lanes)) != NULL) {
+                return node;
+            }
+        }
+    }
+#elif defined(__SSE2__)
+    if (sizeof(xtnt_uint_t) == sizeof(uint32_t)) {
+        __m128i needle = _mm_set1_epi32((int) key);
+        for (; idx + 4 <= count; idx += 4) {
+            __m128i cmp = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) (keys + idx)), needle);
+            unsigned int lanes = (unsigned int) _mm_movemask_ps(_mm_castsi128_ps(cmp));
+            if (lanes && (node = xtnt_array_match(table, idx, lanes)) != NULL) {
+                return node;
+            }
+        }
+    } else {
+        // SSE2 has no 64 bit compare, both halves of a lane must match
+        __m128i needle = _mm_set1_epi64x((long long) key);
+        for (; idx + 2 <= count; idx += 2) {
+            __m128i cmp = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) (keys + idx)), needle);
+            cmp = _mm_and_si128(cmp, _mm_shuffle_epi32(cmp, _MM_SHUFFLE(2, 3, 0, 1)));
+            unsigned int lanes = (unsigned int) _mm_movemask_pd(_mm_castsi128_pd(cmp));
+            if (lanes && (node = xtnt_array_match(table, idx, lanes)) != NULL) {
+                return node;
+            }
+        }
+    }
+#endif /* if defined(__AVX2__) */
+    for (; idx < count; idx++) {
+        if (keys[idx] == key && table[idx] != NULL) {
+            return table[idx];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Find the first node with a key in an array
+ *
+ * @param[in] table The member table
+ * @param[in] keys The key column, or NULL in XTNT_ARRAY_MODE_POINTER
+ * @param[in] count The slots to compare
+ * @param[in] key The key to match
+ * @return node on match or NULL
+ *
+ * @note The columns and count are passed in so an optimistic reader scans
+ * one validated snapshot of them.
+ */
+static struct xtnt_node *
+xtnt_array_find(
+    struct xtnt_node **table,
+    const xtnt_uint_t *keys,
+    xtnt_uint_t count,
+    xtnt_uint_t key)
+{
+    struct xtnt_node *node = NULL;
+    if (keys != NULL) {
+        return xtnt_array_find_keyed(table, keys, count, key);
+    }
+    for (xtnt_uint_t idx = 0; idx < count; idx++) {
+        if ((node = table[idx]) != NULL && node->key == key) {
+            return node;
+        }
+    }
+    return NULL;
+}
 
 /**
  * @brief Create a finite sized array
@@ -38,74 +545,162 @@ SOFTWARE.
  * @retval errno on malloc
  * @retval of xtnt_node_set_initialize
  *
+ * @note The array uses the XTNT_SET_LOCK_MUTEX policy.
+ *
  * @todo Fix function documentation, implementation and create unit tests.
  */
 xtnt_status_t
 xtnt_array_create(
     xtnt_uint_t count,
     struct xtnt_node_set **array)
+{
+    return xtnt_array_create_lock(count, XTNT_SET_LOCK_MUTEX, array);
+}
+
+/**
+ * @brief Create a finite sized array with a locking policy
+ *
+ * @param[in] count The size of the array
+ * @param[in] policy The locking policy, see `xtnt_node_set_initialize_lock()`
+ * @param[out] array Pointer to array reference to set
+ * @retval XTNT_ESUCCESS on allocation and initialization
+ * @retval result of `xtnt_array_create_mode()`
+ *
+ * @note The array is created in XTNT_ARRAY_MODE_POINTER.
+ */
+xtnt_status_t
+xtnt_array_create_lock(
+    xtnt_uint_t count,
+    xtnt_uint_t policy,
+    struct xtnt_node_set **array)
+{
+    return xtnt_array_create_mode(count, XTNT_ARRAY_MODE_POINTER, policy, array);
+}
+
+/**
+ * @brief Create a finite sized array with a mode and a locking policy
+ *
+ * @param[in] count The size of the array
+ * @param[in] mode XTNT_ARRAY_MODE_POINTER or XTNT_ARRAY_MODE_KEYED
+ * @param[in] policy The locking policy, see `xtnt_node_set_initialize_lock()`
+ * @param[out] array Pointer to array reference to set
+ * @retval XTNT_ESUCCESS on allocation and initialization
+ * @retval EINVAL on an unknown mode
+ * @retval EOVERFLOW when `count` slots can not be addressed
+ * @retval ENOMEM on allocation failure
+ * @retval of xtnt_node_set_initialize_lock
+ *
+ * @note Every member of a new array is NULL. The array installs
+ * `xtnt_array_if` for the `xtnt_set_*` operations.
+ *
+ * @note `count` slots are both the length and the capacity of the new
+ * array, `xtnt_array_push()` and the grow and shrink operations change them.
+ *
+ * @note An XTNT_ARRAY_MODE_KEYED array keeps the key of each member in a
+ * column at root.link[XTNT_NODE_MIDDLE], so `xtnt_array_search()` compares
+ * keys in bulk instead of loading every node.
+ */
+xtnt_status_t
+xtnt_array_create_mode(
+    xtnt_uint_t count,
+    xtnt_uint_t mode,
+    xtnt_uint_t policy,
+    struct xtnt_node_set **array)
 {
     xtnt_status_t res = XTNT_ESUCCESS;
-    struct xtnt_node_set *marray = malloc(sizeof(struct xtnt_node_set) + (sizeof(struct xtnt_node) * count));
-    struct xtnt_node *narray = (struct xtnt_node *) (marray + sizeof(struct xtnt_node_set));
-
-    if (marray != NULL) {
-        if ((res = xtnt_node_set_initialize(marray)) == XTNT_ESUCCESS) {
-            if ((res = pthread_mutex_lock(&(marray->lock))) == XTNT_ESUCCESS) {
-                marray->root.link[XTNT_NODE_HEAD] = narray;
-                marray->root.link[XTNT_NODE_TAIL] = narray + (count - 1);
-                marray->count = count;
-                if ((res = pthread_mutex_unlock(&(marray->lock))) != XTNT_ESUCCESS) {
-                    XTNT_LOCK_SET_UNLOCK_FAIL(marray->root.state);
-                }
-                *array = marray;
-            } else {
-                XTNT_LOCK_SET_LOCK_FAIL(marray->root.state);
+    struct xtnt_node_set *marray = NULL;
+    struct xtnt_node **table = NULL;
+    xtnt_uint_t *keys = NULL;
+    size_t slots = (size_t) count;
+
+    *array = NULL;
+    if (mode != XTNT_ARRAY_MODE_POINTER && mode != XTNT_ARRAY_MODE_KEYED) {
+        return EINVAL;
+    }
+    if (slots > (SIZE_MAX - XTNT_ARRAY_COLUMN) / sizeof(struct xtnt_node *)) {
+        return EOVERFLOW;
+    }
+    if ((marray = malloc(sizeof(struct xtnt_node_set))) == NULL ||
+        (table = xtnt_array_column_alloc(sizeof(struct xtnt_node *) * count)) == NULL ||
+        (mode == XTNT_ARRAY_MODE_KEYED &&
+         (keys = xtnt_array_column_alloc(sizeof(xtnt_uint_t) * count)) == NULL)) {
+        xtnt_array_column_free(table);
+        free(marray);
+        return ENOMEM;
+    }
+    if ((res = xtnt_node_set_initialize_lock(marray, policy)) == XTNT_ESUCCESS) {
+        if ((res = xtnt_node_set_write_lock(marray)) == XTNT_ESUCCESS) {
+            memset(table, 0, sizeof(struct xtnt_node *) * count);
+            if (keys != NULL) {
+                memset(keys, 0, sizeof(xtnt_uint_t) * count);
             }
-        } else {
-            free(marray);
-            *array = NULL;
+            marray->root.link[XTNT_NODE_HEAD] = (struct xtnt_node *) table;
+            marray->root.link[XTNT_NODE_MIDDLE] = (struct xtnt_node *) keys;
+            marray->root.value = NULL;
+            XTNT_MODE_SET_VALUE(marray->root.state, mode);
+            marray->count = count;
+            marray->size = count;
+            marray->fn = &xtnt_array_if;
+            xtnt_array_tail(marray);
+            res = xtnt_node_set_write_unlock(marray);
+            *array = marray;
         }
     } else {
-        res = errno;
+        xtnt_array_column_free(keys);
+        xtnt_array_column_free(table);
+        free(marray);
     }
     return res;
 }
 
+extern inline xtnt_status_t
+xtnt_array_delete(
+    struct xtnt_node_set *array,
+    xtnt_uint_t index,
+    struct xtnt_node **node);
+
 /**
- * @brief Delete a node from an array
+ * @brief Delete a run of nodes from an array
  *
- * @param[in] array the node set to delete from
- * @param[in] index the node to delete
- * @param[out] node pointer of deleted node ( can be NULL )
- * @return node pointer of deleted or NULL
+ * @param[in] array The array to delete from
+ * @param[in] index The first slot to delete
+ * @param[in] count The number of slots to delete
+ * @param[out] nodes The deleted nodes, NULL for empty slots ( can be NULL )
+ * @retval XTNT_ESUCCESS on delete
+ * @retval EINVAL when the run ends past the last slot, the array is unchanged
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
  *
- * @note Deleted nodes in an array are a NULL pointer
- *
- * @todo Fix function documentation, implementation and create unit tests.
+ * @note The slots are emptied as with `xtnt_array_delete()` under one lock.
  */
 xtnt_status_t
-xtnt_array_delete(
+xtnt_array_delete_many(
     struct xtnt_node_set *array,
     xtnt_uint_t index,
-    struct xtnt_node **node)
+    xtnt_uint_t count,
+    struct xtnt_node **nodes)
 {
-    *node = NULL;
-    xtnt_int_t fail = pthread_mutex_lock(&(array->lock));
-    if (fail) {
-        XTNT_LOCK_SET_LOCK_FAIL(array->root.state);
-    }
-    if (index < array->count) {
-        if (((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[index] != NULL) {
-            *node = ((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[index];
-            ((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[index] = NULL;
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    struct xtnt_node **table = NULL;
+    if ((res = xtnt_node_set_write_lock(array)) == XTNT_ESUCCESS) {
+        if (index <= array->count && count <= array->count - index) {
+            table = (struct xtnt_node **) array->root.link[XTNT_NODE_HEAD];
+            if (nodes != NULL) {
+                memcpy(nodes, &(table[index]), sizeof(struct xtnt_node *) * count);
+            }
+            memset(&(table[index]), 0, sizeof(struct xtnt_node *) * count);
+            if (XTNT_MODE(array->root.state) == XTNT_ARRAY_MODE_KEYED) {
+                memset(&(((xtnt_uint_t *) array->root.link[XTNT_NODE_MIDDLE])[index]), 0, sizeof(xtnt_uint_t) * count);
+            }
+        } else {
+            res = EINVAL;
+        }
+        if ((unlock = xtnt_node_set_write_unlock(array)) != XTNT_ESUCCESS) {
+            res = unlock;
         }
     }
-    fail = pthread_mutex_unlock(&(array->lock));
-    if (fail) {
-        XTNT_LOCK_SET_UNLOCK_FAIL(array->root.state);
-    }
-    return fail;
+    return res;
 }
 
 /**
@@ -125,85 +720,260 @@ xtnt_array_destroy(
 {
     xtnt_status_t status = XTNT_EFAILURE;
     struct xtnt_node_set *a = *array;
-    if ((status = pthread_mutex_lock(&(a->lock))) == XTNT_ESUCCESS) {
-        if ((status = pthread_mutex_unlock(&(a->lock))) == XTNT_ESUCCESS){
+    struct xtnt_array_retired *retired = NULL;
+    if ((status = xtnt_node_set_write_lock(a)) == XTNT_ESUCCESS) {
+        if ((status = xtnt_node_set_write_unlock(a)) == XTNT_ESUCCESS){
+            while ((retired = (struct xtnt_array_retired *) a->root.value) != NULL) {
+                a->root.value = retired->next;
+                xtnt_array_column_free(retired->column);
+                free(retired);
+            }
+            xtnt_array_column_free(a->root.link[XTNT_NODE_MIDDLE]);
+            xtnt_array_column_free(a->root.link[XTNT_NODE_HEAD]);
             free(a);
             *array = NULL;
-        } else {
-            XTNT_LOCK_SET_UNLOCK_FAIL(a->root.state);
         }
-    } else {
-        XTNT_LOCK_SET_LOCK_FAIL(a->root.state);
-        status = XTNT_EFAILURE;
     }
     return status;
 }
 
+extern inline xtnt_status_t
+xtnt_array_get(
+    struct xtnt_node_set *array,
+    xtnt_uint_t index,
+    struct xtnt_node **node);
+
 /**
- * @brief Get an array member
+ * @brief Grow an array to twice its slots
  *
- * @param[in] array The node set to get from
- * @param[in] index The index to get
- * @param[out] node Pointer to node pointer retrieved
- * @return node or NULL on empty or invalid index
+ * @param[in] array The array to grow
+ * @retval XTNT_ESUCCESS on grow
+ * @retval result of `xtnt_array_double()`
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
  *
- * @todo Fix function documentation, implementation and create unit tests.
+ * @note The added slots are beyond the member count, they are filled with
+ * `xtnt_array_push()`.
  */
 xtnt_status_t
-xtnt_array_get(
+xtnt_array_grow(
+    struct xtnt_node_set *array)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(array)) == XTNT_ESUCCESS) {
+        res = xtnt_array_double(array);
+        if ((unlock = xtnt_node_set_write_unlock(array)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Grow an array to hold `eval` slots
+ *
+ * @param[in] array The array to grow
+ * @param[in] eval The number of slots to hold
+ * @retval XTNT_ESUCCESS on grow, or when `eval` slots fit already
+ * @retval EOVERFLOW when `eval` slots can not be addressed
+ * @retval result of `xtnt_array_resize()`
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note Growing ahead of a known number of pushes avoids the resizes they
+ * would otherwise trigger. A XTNT_SET_LOCK_SEQLOCK array that outgrows its
+ * columns keeps the old ones until `xtnt_array_destroy()` and at least
+ * doubles them, see `xtnt_array_resize_seqlock()`.
+ */
+xtnt_status_t
+xtnt_array_grow_eval(
+    struct xtnt_node_set *array,
+    size_t eval)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(array)) == XTNT_ESUCCESS) {
+        if (eval > array->size) {
+            res = xtnt_array_resize(array, eval);
+        }
+        if ((unlock = xtnt_node_set_write_unlock(array)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+extern inline xtnt_status_t
+xtnt_array_insert(
+    struct xtnt_node_set *array,
+    struct xtnt_node *node,
+    xtnt_uint_t index);
+
+/**
+ * @brief Insert a run of nodes into an array
+ *
+ * @param[in] array The array to insert into
+ * @param[in] index The first slot to set
+ * @param[in] count The number of nodes
+ * @param[in] nodes The nodes to set from `index` on
+ * @retval XTNT_ESUCCESS on insert
+ * @retval EINVAL when the run ends past the last slot, the array is unchanged
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note The slots are set as with `xtnt_array_insert()` under one lock, use
+ * `xtnt_array_push_many()` to add slots.
+ */
+xtnt_status_t
+xtnt_array_insert_many(
     struct xtnt_node_set *array,
     xtnt_uint_t index,
-    struct xtnt_node **node)
+    xtnt_uint_t count,
+    struct xtnt_node **nodes)
 {
-    xtnt_int_t fail = pthread_mutex_lock(&(array->lock));
-    if (fail) {
-        XTNT_LOCK_SET_LOCK_FAIL(array->root.state);
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    xtnt_uint_t *keys = NULL;
+    if ((res = xtnt_node_set_write_lock(array)) == XTNT_ESUCCESS) {
+        if (index <= array->count && count <= array->count - index) {
+            memcpy(&(((struct xtnt_node **) array->root.link[XTNT_NODE_HEAD])[index]), nodes,
+                   sizeof(struct xtnt_node *) * count);
+            if (XTNT_MODE(array->root.state) == XTNT_ARRAY_MODE_KEYED) {
+                keys = (xtnt_uint_t *) array->root.link[XTNT_NODE_MIDDLE];
+                for (xtnt_uint_t idx = 0; idx < count; idx++) {
+                    keys[index + idx] = (nodes[idx] != NULL) ? nodes[idx]->key : XTNT_ZERO;
+                }
+            }
+        } else {
+            res = EINVAL;
+        }
+        if ((unlock = xtnt_node_set_write_unlock(array)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
     }
-    if (index < array->count) {
-        if (((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[index] != NULL) {
-             *node = ((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[index];
+    return res;
+}
+
+/**
+ * @brief Pop the last slot of an array
+ *
+ * @param[in] array The array to pop from
+ * @param[out] node Pointer to the node popped, NULL when the slot was empty
+ * or the array has no slots
+ * @retval XTNT_ESUCCESS on pop
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note The slots of the array are kept, `xtnt_array_shrink()` releases
+ * them.
+ */
+xtnt_status_t
+xtnt_array_pop(
+    struct xtnt_node_set *array,
+    struct xtnt_node **node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    *node = NULL;
+    if ((res = xtnt_node_set_write_lock(array)) == XTNT_ESUCCESS) {
+        if (array->count) {
+            array->count--;
+            *node = ((struct xtnt_node **) array->root.link[XTNT_NODE_HEAD])[array->count];
+            ((struct xtnt_node **) array->root.link[XTNT_NODE_HEAD])[array->count] = NULL;
+            if (XTNT_MODE(array->root.state) == XTNT_ARRAY_MODE_KEYED) {
+                ((xtnt_uint_t *) array->root.link[XTNT_NODE_MIDDLE])[array->count] = XTNT_ZERO;
+            }
+            xtnt_array_tail(array);
+        }
+        if ((unlock = xtnt_node_set_write_unlock(array)) != XTNT_ESUCCESS) {
+            res = unlock;
         }
     }
-    fail = pthread_mutex_unlock(&(array->lock));
-    if (fail) {
-        XTNT_LOCK_SET_UNLOCK_FAIL(array->root.state);
+    return res;
+}
+
+/**
+ * @brief Push a node into a new last slot of an array
+ *
+ * @param[in] array The array to push into
+ * @param[in] node The node to push
+ * @retval XTNT_ESUCCESS on push
+ * @retval result of `xtnt_array_double()`, the array is unchanged
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note A full array doubles its slots, so pushes take amortized constant
+ * time. Columns from XTNT_ARRAY_MAP_SIZE bytes are remapped rather than
+ * copied where mremap is available.
+ */
+xtnt_status_t
+xtnt_array_push(
+    struct xtnt_node_set *array,
+    struct xtnt_node *node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(array)) == XTNT_ESUCCESS) {
+        if (array->count < array->size || (res = xtnt_array_double(array)) == XTNT_ESUCCESS) {
+            ((struct xtnt_node **) array->root.link[XTNT_NODE_HEAD])[array->count] = node;
+            if (XTNT_MODE(array->root.state) == XTNT_ARRAY_MODE_KEYED) {
+                ((xtnt_uint_t *) array->root.link[XTNT_NODE_MIDDLE])[array->count] = (node != NULL) ? node->key : XTNT_ZERO;
+            }
+            array->count++;
+            xtnt_array_tail(array);
+        }
+        if ((unlock = xtnt_node_set_write_unlock(array)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
     }
-    return fail;
+    return res;
 }
 
 /**
- * @brief Insert a node into an array
+ * @brief Push a run of nodes into new last slots of an array
  *
- * @param[in] array The node set to insert into
- * @param[in] node The node to insert
- * @param[in] index The index to insert the node at
- * @return node pointer or NULL on failure
+ * @param[in] array The array to push into
+ * @param[in] count The number of nodes
+ * @param[in] nodes The nodes to push, in order
+ * @retval XTNT_ESUCCESS on push
+ * @retval EOVERFLOW when the slots can not be counted, the array is unchanged
+ * @retval result of `xtnt_array_resize()`, the array is unchanged
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
  *
- * @todo Fix function documentation, implementation and create unit tests.
+ * @note The array grows once for the whole run and the count is updated
+ * once, under one lock.
  */
 xtnt_status_t
-xtnt_array_insert(
+xtnt_array_push_many(
     struct xtnt_node_set *array,
-    struct xtnt_node *node,
-    xtnt_uint_t index)
+    xtnt_uint_t count,
+    struct xtnt_node **nodes)
 {
-    xtnt_int_t fail = XTNT_ESUCCESS;
-    fail = pthread_mutex_lock(&(array->lock));
-    if (fail == 0) {
-        if (index < array->count) {
-                ((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[index] = node;
-        } else {
-            fail = EINVAL;
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    xtnt_uint_t *keys = NULL;
+    if ((res = xtnt_node_set_write_lock(array)) == XTNT_ESUCCESS) {
+        if ((xtnt_uint_t) (array->count + count) < count) {
+            res = EOVERFLOW;
+        } else if ((res = xtnt_array_reserve(array, (size_t) array->count + count)) == XTNT_ESUCCESS) {
+            memcpy(&(((struct xtnt_node **) array->root.link[XTNT_NODE_HEAD])[array->count]), nodes,
+                   sizeof(struct xtnt_node *) * count);
+            if (XTNT_MODE(array->root.state) == XTNT_ARRAY_MODE_KEYED) {
+                keys = (xtnt_uint_t *) array->root.link[XTNT_NODE_MIDDLE];
+                for (xtnt_uint_t idx = 0; idx < count; idx++) {
+                    keys[array->count + idx] = (nodes[idx] != NULL) ? nodes[idx]->key : XTNT_ZERO;
+                }
+            }
+            array->count += count;
+            xtnt_array_tail(array);
         }
-        xtnt_int_t fail_unlock = pthread_mutex_unlock(&(array->lock));
-        if (fail_unlock){
-            XTNT_LOCK_SET_UNLOCK_FAIL(array->root.state);
-            fail = fail_unlock;
+        if ((unlock = xtnt_node_set_write_unlock(array)) != XTNT_ESUCCESS) {
+            res = unlock;
         }
-    } else {
-        XTNT_LOCK_SET_LOCK_FAIL(array->root.state);
     }
-    return fail;
+    return res;
 }
 
 /**
@@ -214,6 +984,9 @@ xtnt_array_insert(
  * @param[out] node Node pointer to set on match
  * @return node on found or NULL on no match or error
  *
+ * @note A XTNT_SET_LOCK_SEQLOCK array is read without locking while no
+ * writer interferes.
+ *
  * @todo Fix function documentation, implementation and create unit tests.
  */
 xtnt_status_t
@@ -222,23 +995,40 @@ xtnt_array_search(
     xtnt_uint_t key,
     struct xtnt_node **node)
 {   
-    xtnt_int_t fail = pthread_mutex_lock(&(array->lock));
-    if (fail) {
-        XTNT_LOCK_SET_LOCK_FAIL(array->root.state);
-        return fail;
-    }
-    for (xtnt_uint_t idx = 0; idx < array->count; idx++){
-        if (((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[idx] != NULL &&
-            ((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[idx]->key == key) {
-            *node = ((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[idx];
-            break;
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_uint_t sequence = XTNT_ZERO;
+    struct xtnt_node *found = NULL;
+    struct xtnt_node **table = NULL;
+    const xtnt_uint_t *keys = NULL;
+    xtnt_uint_t count = XTNT_ZERO;
+    if (array->policy == XTNT_SET_LOCK_SEQLOCK) {
+        for (xtnt_uint_t retry = 0; retry < XTNT_SET_SEQLOCK_RETRY; retry++) {
+            sequence = xtnt_node_set_read_begin(array);
+            table = (struct xtnt_node **) array->root.link[XTNT_NODE_HEAD];
+            keys = (const xtnt_uint_t *) array->root.link[XTNT_NODE_MIDDLE];
+            count = array->count;
+            // Scan only a count and columns no writer changed in between
+            if (!xtnt_node_set_read_validate(array, sequence)) {
+                continue;
+            }
+            found = xtnt_array_find(table, keys, count, key);
+            if (xtnt_node_set_read_validate(array, sequence)) {
+                if (found != NULL) {
+                    *node = found;
+                }
+                return XTNT_ESUCCESS;
+            }
         }
     }
-    fail = pthread_mutex_unlock(&(array->lock));
-    if (fail) {
-        XTNT_LOCK_SET_UNLOCK_FAIL(array->root.state);
+    if ((res = xtnt_node_set_read_lock(array)) == XTNT_ESUCCESS) {
+        if ((found = xtnt_array_find((struct xtnt_node **) array->root.link[XTNT_NODE_HEAD],
+                                     (const xtnt_uint_t *) array->root.link[XTNT_NODE_MIDDLE],
+                                     array->count, key)) != NULL) {
+            *node = found;
+        }
+        res = xtnt_node_set_read_unlock(array);
     }
-    return fail;
+    return res;
 }
 
 /**
@@ -260,10 +1050,9 @@ xtnt_array_search_fn(
     struct xtnt_node **node)
 {   
     xtnt_uint_t (*test)(void *, void *) = test_fn;
-    xtnt_int_t fail = pthread_mutex_lock(&(array->lock));
-    if (fail) {
-        XTNT_LOCK_SET_LOCK_FAIL(array->root.state);
-        return fail;
+    xtnt_status_t res = xtnt_node_set_read_lock(array);
+    if (res) {
+        return res;
     }
     for (xtnt_uint_t idx = 0; idx < array->count; idx++){
         if (((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[idx] != NULL &&
@@ -272,9 +1061,281 @@ xtnt_array_search_fn(
             break;
         }
     }
-    fail = pthread_mutex_unlock(&(array->lock));
-    if (fail) {
-        XTNT_LOCK_SET_UNLOCK_FAIL(array->root.state);
+    return xtnt_node_set_read_unlock(array);
+}
+
+/**
+ * @brief Shrink an array to its member count
+ *
+ * @param[in] array The array to shrink
+ * @retval XTNT_ESUCCESS on shrink, or when no slot is spare
+ * @retval result of `xtnt_array_resize()`
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note A XTNT_SET_LOCK_SEQLOCK array keeps its columns and only lowers its
+ * slot count, so no memory is released until `xtnt_array_destroy()`.
+ */
+xtnt_status_t
+xtnt_array_shrink(
+    struct xtnt_node_set *array)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(array)) == XTNT_ESUCCESS) {
+        if (array->size > array->count) {
+            res = xtnt_array_resize(array, array->count);
+        }
+        if ((unlock = xtnt_node_set_write_unlock(array)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Shrink an array to `eval` slots, no fewer than its member count
+ *
+ * @param[in] array The array to shrink
+ * @param[in] eval The number of slots to hold
+ * @retval XTNT_ESUCCESS on shrink, or when it holds no more than `eval`
+ * @retval result of `xtnt_array_resize()`
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note As for `xtnt_array_shrink()`, a XTNT_SET_LOCK_SEQLOCK array keeps
+ * its columns.
+ */
+xtnt_status_t
+xtnt_array_shrink_eval(
+    struct xtnt_node_set *array,
+    size_t eval)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(array)) == XTNT_ESUCCESS) {
+        if (eval < array->count) {
+            eval = array->count;
+        }
+        if (eval < array->size) {
+            res = xtnt_array_resize(array, eval);
+        }
+        if ((unlock = xtnt_node_set_write_unlock(array)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Sort an array by ascending key
+ *
+ * @param[in] array The array to sort
+ * @retval XTNT_ESUCCESS on sort
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note From XTNT_SORT_RADIX members the keys are radix sorted, see
+ * `xtnt_sort_table_key()`. Empty slots move behind the members.
+ */
+xtnt_status_t
+xtnt_array_sort(
+    struct xtnt_node_set *array)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(array)) == XTNT_ESUCCESS) {
+        res = xtnt_array_order(array, xtnt_node_compare_key, 1, XTNT_ZERO);
+        if ((unlock = xtnt_node_set_write_unlock(array)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Sort an array by a comparison function
+ *
+ * @param[in] array The array to sort
+ * @param[in] compare The order to sort in, see `xtnt_node_compare_fn`
+ * @retval XTNT_ESUCCESS on sort
+ * @retval EINVAL without a comparison function
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note The members are sorted with introsort, see `xtnt_sort_table()`,
+ * which is not stable, unless `compare` is one of the key orders. Empty
+ * slots move behind the members.
+ */
+xtnt_status_t
+xtnt_array_sort_fn(
+    struct xtnt_node_set *array,
+    xtnt_node_compare_fn compare)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if (compare == NULL) {
+        return EINVAL;
+    }
+    if ((res = xtnt_node_set_write_lock(array)) == XTNT_ESUCCESS) {
+        res = xtnt_array_order(array, compare, 1, XTNT_ZERO);
+        if ((unlock = xtnt_node_set_write_unlock(array)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Sort an array with a team of threads
+ *
+ * @param[in] array The array to sort
+ * @param[in] compare The order to sort in, see `xtnt_node_compare_fn`
+ * @param[in] threads The most threads to sort with, or 0 for the online CPUs
+ * @param[in] cutoff The fewest members per thread, or 0 for
+ * XTNT_SORT_PARALLEL
+ * @retval XTNT_ESUCCESS on sort
+ * @retval EINVAL without a comparison function
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note The array stays write locked while the team sorts it, see
+ * `xtnt_sort_table_parallel()`. With `xtnt_node_compare_key()` or
+ * `xtnt_node_compare_key_reverse()` each thread radix sorts its run.
+ */
+xtnt_status_t
+xtnt_array_sort_parallel(
+    struct xtnt_node_set *array,
+    xtnt_node_compare_fn compare,
+    size_t threads,
+    size_t cutoff)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if (compare == NULL) {
+        return EINVAL;
+    }
+    if ((res = xtnt_node_set_write_lock(array)) == XTNT_ESUCCESS) {
+        res = xtnt_array_order(array, compare, threads, cutoff);
+        if ((unlock = xtnt_node_set_write_unlock(array)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Sort an array by descending key
+ *
+ * @param[in] array The array to sort
+ * @retval XTNT_ESUCCESS on sort
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note Empty slots move behind the members.
+ */
+xtnt_status_t
+xtnt_array_sort_reverse(
+    struct xtnt_node_set *array)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(array)) == XTNT_ESUCCESS) {
+        res = xtnt_array_order(array, xtnt_node_compare_key_reverse, 1, XTNT_ZERO);
+        if ((unlock = xtnt_node_set_write_unlock(array)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+static xtnt_status_t
+xtnt_array_index(
+    struct xtnt_node_set *array,
+    xtnt_int_t index,
+    struct xtnt_node **node)
+{
+    if (index < 0) {
+        return EINVAL;
+    }
+    return xtnt_array_get(array, (xtnt_uint_t) index, node);
+}
+
+static xtnt_status_t
+xtnt_array_insert_at(
+    struct xtnt_node_set *array,
+    xtnt_uint_t index,
+    struct xtnt_node *node,
+    struct xtnt_node **replaced)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(array)) == XTNT_ESUCCESS) {
+        if (index < array->count) {
+            *replaced = ((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[index];
+            ((struct xtnt_node**) array->root.link[XTNT_NODE_HEAD])[index] = node;
+            if (XTNT_MODE(array->root.state) == XTNT_ARRAY_MODE_KEYED) {
+                ((xtnt_uint_t *) array->root.link[XTNT_NODE_MIDDLE])[index] = (node != NULL) ? node->key : XTNT_ZERO;
+            }
+        } else {
+            res = EINVAL;
+        }
+        if ((unlock = xtnt_node_set_write_unlock(array)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Visit the member after the cursor, by index
+ *
+ * @param[in] array The array, read locked
+ * @param[in] iter The cursor, its index the next slot
+ * @param[out] node The member, or NULL past the last slot
+ * @retval XTNT_ESUCCESS on visit
+ *
+ * @note Empty slots are skipped.
+ */
+static xtnt_status_t
+xtnt_array_next(
+    struct xtnt_node_set *array,
+    struct xtnt_set_iter *iter,
+    struct xtnt_node **node)
+{
+    struct xtnt_node **table = (struct xtnt_node **) array->root.link[XTNT_NODE_HEAD];
+    *node = NULL;
+    while (*node == NULL && iter->index < array->count) {
+        *node = table[iter->index++];
     }
-    return fail;
+    return XTNT_ESUCCESS;
 }
+
+/**
+ * @brief Array Node Set interface
+ */
+const struct xtnt_node_set_if xtnt_array_if = {
+    .index = xtnt_array_index,
+    .search = xtnt_array_search,
+    .search_fn = xtnt_array_search_fn,
+    .first = xtnt_node_set_enotsup_out,
+    .last = xtnt_node_set_enotsup_out,
+    .peek = xtnt_node_set_enotsup_out,
+    .root = xtnt_node_set_enotsup_out,
+    .state = xtnt_node_set_enotsup_state,
+    .insert = xtnt_node_set_enotsup_node,
+    .insert_at = xtnt_array_insert_at,
+    .push = xtnt_array_push,
+    .remove = xtnt_node_set_enotsup_node,
+    .remove_at = xtnt_array_delete,
+    .pop = xtnt_array_pop,
+    .sort = xtnt_array_sort,
+    .sort_reverse = xtnt_array_sort_reverse,
+    .sort_fn = xtnt_array_sort_fn,
+    .grow = xtnt_array_grow,
+    .grow_eval = xtnt_array_grow_eval,
+    .shrink = xtnt_array_shrink,
+    .shrink_eval = xtnt_array_shrink_eval,
+    .next = xtnt_array_next,
+    .seek = xtnt_node_set_enotsup_seek
+};
@@ -29,6 +29,173 @@ SOFTWARE.
 
 #include <extant/set/common.h>
 
+#if defined(__x86_64__) || defined(__i386__)
+#define XTNT_SET_SPIN_PAUSE() __builtin_ia32_pause()
+#else
+#define XTNT_SET_SPIN_PAUSE() __asm__ __volatile__ ("" ::: "memory")
+#endif
+
+/**
+ * @brief Visit the next member of a set read locked for a cursor
+ *
+ * @param[in] iter The cursor
+ * @param[out] node The member, or NULL past the last or past a range
+ * @retval XTNT_ESUCCESS on visit
+ * @retval return value of the set's next operation
+ */
+static xtnt_status_t
+xtnt_set_iter_step(
+    struct xtnt_set_iter *iter,
+    struct xtnt_node **node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = iter->set->fn->next(iter->set, iter, node)) == XTNT_ESUCCESS) {
+        if (*node != NULL && (iter->mode & XTNT_SET_ITER_RANGE) && (*node)->key > iter->upper) {
+            *node = NULL;
+        }
+        if (*node == NULL) {
+            iter->mode |= XTNT_SET_ITER_END;
+        } else {
+            iter->node = *node;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Copy the members a cursor visits into its table
+ *
+ * @param[in] iter The cursor, its set read locked
+ * @retval XTNT_ESUCCESS on copy
+ * @retval ENOMEM when the table cannot grow
+ * @retval return value of the set's next operation
+ *
+ * @note The table starts at the member count and doubles if a set has
+ * more members to visit than it counts.
+ */
+static xtnt_status_t
+xtnt_set_iter_copy(
+    struct xtnt_set_iter *iter)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_node *node = NULL;
+    struct xtnt_node **table = NULL;
+    size_t size = (iter->set->count > 0) ? iter->set->count : 1;
+    if ((iter->table = malloc(sizeof(struct xtnt_node *) * size)) == NULL) {
+        return ENOMEM;
+    }
+    while ((res = xtnt_set_iter_step(iter, &node)) == XTNT_ESUCCESS && node != NULL) {
+        if (iter->count == size) {
+            if ((table = realloc(iter->table, sizeof(struct xtnt_node *) * size * 2)) == NULL) {
+                res = ENOMEM;
+                break;
+            }
+            iter->table = table;
+            size *= 2;
+        }
+        iter->table[iter->count++] = node;
+    }
+    if (res != XTNT_ESUCCESS) {
+        free(iter->table);
+        iter->table = NULL;
+        iter->count = 0;
+    }
+    return res;
+}
+
+/**
+ * @brief Start a cursor, positioned at lower for XTNT_SET_ITER_RANGE
+ *
+ * @param[in] set The Node Set to visit
+ * @param[out] iter The cursor
+ * @param[in] mode XTNT_SET_ITER_LOCK or XTNT_SET_ITER_SNAPSHOT, with
+ * XTNT_SET_ITER_RANGE
+ * @param[in] lower The least key of a range
+ * @param[in] upper The greatest key of a range
+ * @retval XTNT_ESUCCESS on start
+ * @retval EINVAL on an unknown mode
+ * @retval ENOTSUP before locking, when the set type cannot be visited or,
+ * for XTNT_SET_ITER_RANGE, is not ordered by key
+ * @retval result of `xtnt_set_iter_copy()` or the set's seek operation
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ */
+static xtnt_status_t
+xtnt_set_iter_open(
+    struct xtnt_node_set *set,
+    struct xtnt_set_iter *iter,
+    xtnt_uint_t mode,
+    xtnt_uint_t lower,
+    xtnt_uint_t upper)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if ((mode & ~(XTNT_SET_ITER_SNAPSHOT | XTNT_SET_ITER_RANGE)) != 0) {
+        return EINVAL;
+    }
+    if (set->fn->next == xtnt_node_set_enotsup_next ||
+        ((mode & XTNT_SET_ITER_RANGE) && set->fn->seek == xtnt_node_set_enotsup_seek)) {
+        return ENOTSUP;
+    }
+    iter->set = set;
+    iter->node = NULL;
+    iter->table = NULL;
+    iter->index = 0;
+    iter->count = 0;
+    iter->upper = upper;
+    iter->mode = mode;
+    if ((res = xtnt_node_set_read_lock(set)) != XTNT_ESUCCESS) {
+        return res;
+    }
+    if (mode & XTNT_SET_ITER_RANGE) {
+        res = set->fn->seek(set, iter, lower);
+    }
+    if (res == XTNT_ESUCCESS && (mode & XTNT_SET_ITER_SNAPSHOT)) {
+        res = xtnt_set_iter_copy(iter);
+        iter->node = NULL;
+        iter->index = 0;
+        iter->mode &= ~XTNT_SET_ITER_END;
+    }
+    if (res != XTNT_ESUCCESS || (mode & XTNT_SET_ITER_SNAPSHOT)) {
+        if ((unlock = xtnt_node_set_read_unlock(set)) != XTNT_ESUCCESS) {
+            free(iter->table);
+            iter->table = NULL;
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Call a function on each member a started cursor visits
+ *
+ * @param[in] iter The cursor
+ * @param[in] visit The function to call
+ * @param[in] ctx Context passed into the function
+ * @retval XTNT_ESUCCESS once every member is visited
+ * @retval the first status of visit other than XTNT_ESUCCESS
+ * @retval result of `xtnt_set_iter_next()` or `xtnt_set_iter_end()`
+ */
+static xtnt_status_t
+xtnt_set_iter_visit(
+    struct xtnt_set_iter *iter,
+    xtnt_node_visit_fn visit,
+    void *ctx)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t end = XTNT_EFAILURE;
+    struct xtnt_node *node = NULL;
+    while ((res = xtnt_set_iter_next(iter, &node)) == XTNT_ESUCCESS && node != NULL) {
+        if ((res = visit(ctx, node)) != XTNT_ESUCCESS) {
+            break;
+        }
+    }
+    if ((end = xtnt_set_iter_end(iter)) != XTNT_ESUCCESS) {
+        res = end;
+    }
+    return res;
+}
+
 /**
  * @brief Copy a node set
  *
@@ -42,25 +209,17 @@ xtnt_node_set_copy(
     struct xtnt_node_set *dst)
 {
     xtnt_status_t res = XTNT_EFAILURE;
-    if ((res = pthread_mutex_lock(&(src->lock))) == XTNT_ESUCCESS) {
-        if ((res = pthread_mutex_lock(&(dst->lock))) == XTNT_ESUCCESS) {
+    if ((res = xtnt_node_set_read_lock(src)) == XTNT_ESUCCESS) {
+        if ((res = xtnt_node_set_write_lock(dst)) == XTNT_ESUCCESS) {
             dst->root.link[XTNT_NODE_HEAD] = src->root.link[XTNT_NODE_HEAD];
             dst->root.link[XTNT_NODE_MIDDLE] = src->root.link[XTNT_NODE_MIDDLE];
             dst->root.link[XTNT_NODE_TAIL] = src->root.link[XTNT_NODE_TAIL];
             dst->count = src->count;
             XTNT_STATE_SET_VALUE(dst->root.state, XTNT_ZERO);
-            if ((res = pthread_mutex_unlock(&(dst->lock))) == XTNT_ESUCCESS) {
-                if ((res = pthread_mutex_unlock(&(src->lock))) != XTNT_ESUCCESS) {
-                    XTNT_LOCK_SET_UNLOCK_FAIL(src->root.state);
-                }
-            } else {
-                XTNT_LOCK_SET_UNLOCK_FAIL(dst->root.state);
+            if ((res = xtnt_node_set_write_unlock(dst)) == XTNT_ESUCCESS) {
+                res = xtnt_node_set_read_unlock(src);
             }
-        } else {
-            XTNT_LOCK_SET_LOCK_FAIL(dst->root.state);
         }
-    } else {
-        XTNT_LOCK_SET_LOCK_FAIL(src->root.state);
     }
     return res;
 }
@@ -69,24 +228,80 @@ xtnt_node_set_copy(
  * @brief Initialize a Node Set
  *
  * @param[in] set The Node Set to initialize
+ *
+ * @note The set uses the XTNT_SET_LOCK_MUTEX policy.
  */
 xtnt_status_t
 xtnt_node_set_initialize(
     struct xtnt_node_set *set)
+{
+    return xtnt_node_set_initialize_lock(set, XTNT_SET_LOCK_MUTEX);
+}
+
+/**
+ * @brief Initialize a Node Set with a locking policy
+ *
+ * @param[in] set The Node Set to initialize
+ * @param[in] policy XTNT_SET_LOCK_MUTEX, XTNT_SET_LOCK_RWLOCK,
+ * XTNT_SET_LOCK_SEQLOCK, XTNT_SET_LOCK_SPIN or XTNT_SET_LOCK_NONE
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval EINVAL on an unknown policy
+ * @retval return value of the lock initialization
+ *
+ * @note With XTNT_SET_LOCK_RWLOCK the read operations of arrays, lists,
+ * queues and stacks share the lock. With XTNT_SET_LOCK_SEQLOCK writers take
+ * the mutex and make the sequence odd while they modify the set, and
+ * `xtnt_array_get()`, `xtnt_array_search()`, `xtnt_list_get()`,
+ * `xtnt_list_search()`, `xtnt_queue_peek()` and `xtnt_stack_peek()` read
+ * without writing to the set, retrying when the sequence changed. After
+ * XTNT_SET_SEQLOCK_RETRY failed attempts the reader takes the mutex.
+ *
+ * @warning With XTNT_SET_LOCK_SEQLOCK a reader may follow a link to a node
+ * that a writer has just removed. Removed nodes must stay readable memory,
+ * such as nodes from a pool, while readers may still be running.
+ *
+ * @note XTNT_SET_LOCK_SPIN suits sets held for a few instructions at a
+ * time. XTNT_SET_LOCK_NONE does no synchronization at all, for sets only one
+ * thread uses at a time such as per worker scratch sets.
+ *
+ * @note Trees and hash sets have no optimistic reads, they take the mutex
+ * to read a XTNT_SET_LOCK_SEQLOCK set. *
+ * @note The set has no type until a type installs its interface, every
+ * `xtnt_set_*` operation returns ENOTSUP until then.
+ */
+xtnt_status_t
+xtnt_node_set_initialize_lock(
+    struct xtnt_node_set *set,
+    xtnt_uint_t policy)
 {
     xtnt_status_t res = XTNT_EFAILURE;
-    if ((res = pthread_mutex_init(&(set->lock), NULL)) == XTNT_ZERO) {
-        if ((res = pthread_mutex_lock(&(set->lock))) == XTNT_ZERO) {
+    switch (policy) {
+        case XTNT_SET_LOCK_MUTEX:
+        case XTNT_SET_LOCK_SEQLOCK:
+            res = pthread_mutex_init(&(set->lock), NULL);
+            break;
+        case XTNT_SET_LOCK_RWLOCK:
+            res = pthread_rwlock_init(&(set->rwlock), NULL);
+            break;
+        case XTNT_SET_LOCK_SPIN:
+        case XTNT_SET_LOCK_NONE:
+            set->spin = XTNT_ZERO;
+            res = XTNT_ESUCCESS;
+            break;
+        default:
+            return EINVAL;
+    }
+    if (res == XTNT_ZERO) {
+        set->policy = policy;
+        set->sequence = XTNT_ZERO;
+        if ((res = xtnt_node_set_write_lock(set)) == XTNT_ZERO) {
             set->root.link[0] = NULL;
             set->root.link[1] = NULL;
             set->root.link[2] = NULL;
             set->count = XTNT_ZERO;
             set->root.state = XTNT_ZERO;
-            if ((res = pthread_mutex_unlock(&(set->lock))) != XTNT_ZERO) {
-                XTNT_LOCK_SET_UNLOCK_FAIL(set->root.state);
-            }
-        } else {
-            XTNT_LOCK_SET_LOCK_FAIL(set->root.state);
+            set->fn = &xtnt_node_set_enotsup_if;
+            res = xtnt_node_set_write_unlock(set);
         }
     } else {
         XTNT_LOCK_SET_INIT_FAIL(set->root.state);
@@ -109,20 +324,330 @@ xtnt_node_set_uninitialize(
     struct xtnt_node_set *set)
 {
     xtnt_status_t res = XTNT_EFAILURE;
-    if ((res = pthread_mutex_lock(&(set->lock))) == XTNT_ZERO) {
-        if ((res = pthread_mutex_unlock(&(set->lock))) == XTNT_ZERO) {
-            if ((res = pthread_mutex_destroy(&(set->lock))) != XTNT_ZERO) {
+    if ((res = xtnt_node_set_write_lock(set)) == XTNT_ZERO) {
+        if ((res = xtnt_node_set_write_unlock(set)) == XTNT_ZERO) {
+            if (set->policy == XTNT_SET_LOCK_RWLOCK) {
+                res = pthread_rwlock_destroy(&(set->rwlock));
+            } else if (set->policy == XTNT_SET_LOCK_MUTEX ||
+                       set->policy == XTNT_SET_LOCK_SEQLOCK) {
+                res = pthread_mutex_destroy(&(set->lock));
+            }
+            if (res != XTNT_ZERO) {
                 XTNT_LOCK_SET_DESTROY_FAIL(set->root.state);
             }
-        } else {
-            XTNT_LOCK_SET_UNLOCK_FAIL(set->root.state);
         }
-    } else {
-        XTNT_LOCK_SET_LOCK_FAIL(set->root.state);
     }
     return res;
 }
 
+/**
+ * @brief Wait for the spin lock of a XTNT_SET_LOCK_SPIN Node Set
+ *
+ * @param[in] set The Node Set to lock
+ *
+ * @note The slow path of the inline lock operations. Waiters read the flag
+ * without writing it, pausing twice as long after each look, and yield once
+ * a pause run reaches XTNT_SET_SPIN_LIMIT.
+ */
+void
+xtnt_node_set_spin_wait(
+    struct xtnt_node_set *set)
+{
+    xtnt_uint_t spins = 1;
+    do {
+        while (__atomic_load_n(&(set->spin), __ATOMIC_RELAXED)) {
+            if (spins < XTNT_SET_SPIN_LIMIT) {
+                for (xtnt_uint_t idx = 0; idx < spins; idx++) {
+                    XTNT_SET_SPIN_PAUSE();
+                }
+                spins <<= 1;
+            } else {
+                sched_yield();
+            }
+        }
+    } while (__atomic_exchange_n(&(set->spin), 1, __ATOMIC_ACQUIRE));
+}
+
+/**
+ * @brief Stand in for an unsupported sort, sort_reverse, grow or shrink
+ *
+ * @param[in] set The Node Set
+ * @retval ENOTSUP always
+ */
+xtnt_status_t
+xtnt_node_set_enotsup(
+    struct xtnt_node_set *set)
+{
+    (void) set;
+    return ENOTSUP;
+}
+
+/**
+ * @brief Stand in for an unsupported grow_eval or shrink_eval
+ *
+ * @param[in] set The Node Set
+ * @param[in] eval Unused
+ * @retval ENOTSUP always
+ */
+xtnt_status_t
+xtnt_node_set_enotsup_eval(
+    struct xtnt_node_set *set,
+    size_t eval)
+{
+    (void) set;
+    (void) eval;
+    return ENOTSUP;
+}
+
+/**
+ * @brief Stand in for an unsupported sort_fn
+ *
+ * @param[in] set The Node Set
+ * @param[in] compare Unused
+ * @retval ENOTSUP always
+ */
+xtnt_status_t
+xtnt_node_set_enotsup_fn(
+    struct xtnt_node_set *set,
+    xtnt_node_compare_fn compare)
+{
+    (void) set;
+    (void) compare;
+    return ENOTSUP;
+}
+
+/**
+ * @brief Stand in for an unsupported index
+ *
+ * @param[in] set The Node Set
+ * @param[in] index Unused
+ * @param[out] found Untouched
+ * @retval ENOTSUP always
+ */
+xtnt_status_t
+xtnt_node_set_enotsup_index(
+    struct xtnt_node_set *set,
+    xtnt_int_t index,
+    struct xtnt_node **found)
+{
+    (void) set;
+    (void) index;
+    (void) found;
+    return ENOTSUP;
+}
+
+/**
+ * @brief Stand in for an unsupported insert_at
+ *
+ * @param[in] set The Node Set
+ * @param[in] index Unused
+ * @param[in] node Unused
+ * @param[out] replaced Untouched
+ * @retval ENOTSUP always
+ */
+xtnt_status_t
+xtnt_node_set_enotsup_insert_at(
+    struct xtnt_node_set *set,
+    xtnt_uint_t index,
+    struct xtnt_node *node,
+    struct xtnt_node **replaced)
+{
+    (void) set;
+    (void) index;
+    (void) node;
+    (void) replaced;
+    return ENOTSUP;
+}
+
+/**
+ * @brief Stand in for an unsupported search or remove_at
+ *
+ * @param[in] set The Node Set
+ * @param[in] key Unused
+ * @param[out] found Untouched
+ * @retval ENOTSUP always
+ */
+xtnt_status_t
+xtnt_node_set_enotsup_key(
+    struct xtnt_node_set *set,
+    xtnt_uint_t key,
+    struct xtnt_node **found)
+{
+    (void) set;
+    (void) key;
+    (void) found;
+    return ENOTSUP;
+}
+
+/**
+ * @brief Stand in for an unsupported next
+ *
+ * @param[in] set The Node Set
+ * @param[in] iter Unused
+ * @param[out] node Untouched
+ * @retval ENOTSUP always
+ */
+xtnt_status_t
+xtnt_node_set_enotsup_next(
+    struct xtnt_node_set *set,
+    struct xtnt_set_iter *iter,
+    struct xtnt_node **node)
+{
+    (void) set;
+    (void) iter;
+    (void) node;
+    return ENOTSUP;
+}
+
+/**
+ * @brief Stand in for an unsupported insert, push or remove
+ *
+ * @param[in] set The Node Set
+ * @param[in] node Unused
+ * @retval ENOTSUP always
+ */
+xtnt_status_t
+xtnt_node_set_enotsup_node(
+    struct xtnt_node_set *set,
+    struct xtnt_node *node)
+{
+    (void) set;
+    (void) node;
+    return ENOTSUP;
+}
+
+/**
+ * @brief Stand in for an unsupported first, last, peek, root or pop
+ *
+ * @param[in] set The Node Set
+ * @param[out] node Untouched
+ * @retval ENOTSUP always
+ */
+xtnt_status_t
+xtnt_node_set_enotsup_out(
+    struct xtnt_node_set *set,
+    struct xtnt_node **node)
+{
+    (void) set;
+    (void) node;
+    return ENOTSUP;
+}
+
+/**
+ * @brief Stand in for an unsupported search_fn
+ *
+ * @param[in] set The Node Set
+ * @param[in] fn Unused
+ * @param[in] needle Unused
+ * @param[out] found Untouched
+ * @retval ENOTSUP always
+ */
+xtnt_status_t
+xtnt_node_set_enotsup_search_fn(
+    struct xtnt_node_set *set,
+    void *fn,
+    void *needle,
+    struct xtnt_node **found)
+{
+    (void) set;
+    (void) fn;
+    (void) needle;
+    (void) found;
+    return ENOTSUP;
+}
+
+/**
+ * @brief Stand in for the seek of an unordered set
+ *
+ * @param[in] set The Node Set
+ * @param[in] iter Unused
+ * @param[in] key Unused
+ * @retval ENOTSUP always
+ */
+xtnt_status_t
+xtnt_node_set_enotsup_seek(
+    struct xtnt_node_set *set,
+    struct xtnt_set_iter *iter,
+    xtnt_uint_t key)
+{
+    (void) set;
+    (void) iter;
+    (void) key;
+    return ENOTSUP;
+}
+
+/**
+ * @brief Stand in for an unsupported state
+ *
+ * @param[in] set The Node Set
+ * @param[out] state Untouched
+ * @retval ENOTSUP always
+ */
+xtnt_status_t
+xtnt_node_set_enotsup_state(
+    struct xtnt_node_set *set,
+    xtnt_uint_t **state)
+{
+    (void) set;
+    (void) state;
+    return ENOTSUP;
+}
+
+/**
+ * @brief Node Set interface of a set with no type, every operation is
+ * ENOTSUP
+ */
+const struct xtnt_node_set_if xtnt_node_set_enotsup_if = {
+    .index = xtnt_node_set_enotsup_index,
+    .search = xtnt_node_set_enotsup_key,
+    .search_fn = xtnt_node_set_enotsup_search_fn,
+    .first = xtnt_node_set_enotsup_out,
+    .last = xtnt_node_set_enotsup_out,
+    .peek = xtnt_node_set_enotsup_out,
+    .root = xtnt_node_set_enotsup_out,
+    .state = xtnt_node_set_enotsup_state,
+    .insert = xtnt_node_set_enotsup_node,
+    .insert_at = xtnt_node_set_enotsup_insert_at,
+    .push = xtnt_node_set_enotsup_node,
+    .remove = xtnt_node_set_enotsup_node,
+    .remove_at = xtnt_node_set_enotsup_key,
+    .pop = xtnt_node_set_enotsup_out,
+    .sort = xtnt_node_set_enotsup,
+    .sort_reverse = xtnt_node_set_enotsup,
+    .sort_fn = xtnt_node_set_enotsup_fn,
+    .grow = xtnt_node_set_enotsup,
+    .grow_eval = xtnt_node_set_enotsup_eval,
+    .shrink = xtnt_node_set_enotsup,
+    .shrink_eval = xtnt_node_set_enotsup_eval,
+    .next = xtnt_node_set_enotsup_next,
+    .seek = xtnt_node_set_enotsup_seek
+};
+
+extern inline xtnt_status_t
+xtnt_node_set_read_lock(
+    struct xtnt_node_set *set);
+
+extern inline xtnt_status_t
+xtnt_node_set_read_unlock(
+    struct xtnt_node_set *set);
+
+extern inline xtnt_status_t
+xtnt_node_set_write_lock(
+    struct xtnt_node_set *set);
+
+extern inline xtnt_status_t
+xtnt_node_set_write_unlock(
+    struct xtnt_node_set *set);
+
+extern inline xtnt_uint_t
+xtnt_node_set_read_begin(
+    struct xtnt_node_set *set);
+
+extern inline xtnt_uint_t
+xtnt_node_set_read_validate(
+    struct xtnt_node_set *set,
+    xtnt_uint_t sequence);
+
 extern inline xtnt_status_t
 xtnt_set_index(
     struct xtnt_node_set *set,
@@ -259,9 +784,9 @@ xtnt_set_sort_reverse(
 extern inline xtnt_status_t
 xtnt_set_sort_fn(
     struct xtnt_node_set *set,
-    void *fn)
+    xtnt_node_compare_fn compare)
 {
-    return set->fn->sort_fn(set, fn);
+    return set->fn->sort_fn(set, compare);
 }
 
 extern inline xtnt_status_t
@@ -293,3 +818,168 @@ xtnt_set_shrink_eval(
 {
     return set->fn->shrink_eval(set, eval);
 }
+
+/**
+ * @brief Start a cursor over the members of a Node Set
+ *
+ * @param[in] set The Node Set to visit
+ * @param[out] iter The cursor
+ * @param[in] mode XTNT_SET_ITER_LOCK or XTNT_SET_ITER_SNAPSHOT
+ * @retval XTNT_ESUCCESS on start
+ * @retval EINVAL on an unknown mode
+ * @retval ENOMEM when a snapshot cannot be allocated
+ * @retval ENOTSUP when the set type cannot be visited
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ *
+ * @remark A XTNT_SET_ITER_LOCK cursor holds the read lock of the set until
+ * `xtnt_set_iter_end()`, so the whole walk takes the lock once and sees no
+ * writer. Do not modify the set through the same thread meanwhile. A
+ * XTNT_SET_ITER_SNAPSHOT cursor copies the members under the lock and
+ * releases it at once, its members must stay valid until they are visited.
+ *
+ * @note Members are visited in the order of the set: lists and stacks from
+ * their head, queues from the oldest, arrays by index, trees and skip lists
+ * by ascending key, hash sets in slot order.
+ */
+xtnt_status_t
+xtnt_set_iter_begin(
+    struct xtnt_node_set *set,
+    struct xtnt_set_iter *iter,
+    xtnt_uint_t mode)
+{
+    return xtnt_set_iter_open(set, iter, mode, XTNT_ZERO, XTNT_ZERO);
+}
+
+/**
+ * @brief Start a cursor over the members of an ordered set in a key range
+ *
+ * @param[in] set The Node Set to visit
+ * @param[out] iter The cursor
+ * @param[in] lower The least key to visit
+ * @param[in] upper The greatest key to visit
+ * @param[in] mode XTNT_SET_ITER_LOCK or XTNT_SET_ITER_SNAPSHOT
+ * @retval XTNT_ESUCCESS on start
+ * @retval ENOTSUP when the set is not ordered by key
+ * @retval result of `xtnt_set_iter_begin()`
+ *
+ * @note The cursor seeks to lower in O(log n) on trees and skip lists,
+ * then visits in key order until passing upper.
+ */
+xtnt_status_t
+xtnt_set_iter_range(
+    struct xtnt_node_set *set,
+    struct xtnt_set_iter *iter,
+    xtnt_uint_t lower,
+    xtnt_uint_t upper,
+    xtnt_uint_t mode)
+{
+    return xtnt_set_iter_open(set, iter, mode | XTNT_SET_ITER_RANGE, lower, upper);
+}
+
+/**
+ * @brief Visit the next member of a cursor
+ *
+ * @param[in] iter The cursor from `xtnt_set_iter_begin()`
+ * @param[out] node The member, or NULL once every member is visited
+ * @retval XTNT_ESUCCESS on visit
+ * @retval ENOTSUP when the set type cannot be visited
+ */
+xtnt_status_t
+xtnt_set_iter_next(
+    struct xtnt_set_iter *iter,
+    struct xtnt_node **node)
+{
+    *node = NULL;
+    if (iter->mode & XTNT_SET_ITER_END) {
+        return XTNT_ESUCCESS;
+    }
+    if (iter->mode & XTNT_SET_ITER_SNAPSHOT) {
+        if (iter->index < iter->count) {
+            *node = iter->table[iter->index++];
+        } else {
+            iter->mode |= XTNT_SET_ITER_END;
+        }
+        return XTNT_ESUCCESS;
+    }
+    return xtnt_set_iter_step(iter, node);
+}
+
+/**
+ * @brief Finish a cursor, releasing its lock or snapshot
+ *
+ * @param[in] iter The cursor from `xtnt_set_iter_begin()`
+ * @retval XTNT_ESUCCESS on finish
+ * @retval return value of `xtnt_node_set_read_unlock()`
+ */
+xtnt_status_t
+xtnt_set_iter_end(
+    struct xtnt_set_iter *iter)
+{
+    iter->mode |= XTNT_SET_ITER_END;
+    if (iter->mode & XTNT_SET_ITER_SNAPSHOT) {
+        free(iter->table);
+        iter->table = NULL;
+        iter->count = 0;
+        return XTNT_ESUCCESS;
+    }
+    return xtnt_node_set_read_unlock(iter->set);
+}
+
+/**
+ * @brief Call a function on each member of a Node Set
+ *
+ * @param[in] set The Node Set to visit
+ * @param[in] visit The function to call, see `xtnt_node_visit_fn`
+ * @param[in] ctx Context passed into the function
+ * @retval XTNT_ESUCCESS once every member is visited
+ * @retval the first status of visit other than XTNT_ESUCCESS
+ * @retval result of `xtnt_set_iter_begin()`
+ *
+ * @note The set is read locked once for the whole walk, in the order of
+ * `xtnt_set_iter_begin()`. The function must not modify the set.
+ */
+xtnt_status_t
+xtnt_set_for_each(
+    struct xtnt_node_set *set,
+    xtnt_node_visit_fn visit,
+    void *ctx)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_set_iter iter;
+    if ((res = xtnt_set_iter_begin(set, &iter, XTNT_SET_ITER_LOCK)) == XTNT_ESUCCESS) {
+        res = xtnt_set_iter_visit(&iter, visit, ctx);
+    }
+    return res;
+}
+
+/**
+ * @brief Call a function on each member of an ordered set in a key range
+ *
+ * @param[in] set The Node Set to visit
+ * @param[in] lower The least key to visit
+ * @param[in] upper The greatest key to visit
+ * @param[in] visit The function to call, see `xtnt_node_visit_fn`
+ * @param[in] ctx Context passed into the function
+ * @retval XTNT_ESUCCESS once every member in range is visited
+ * @retval the first status of visit other than XTNT_ESUCCESS
+ * @retval result of `xtnt_set_iter_range()`
+ *
+ * @note The set is read locked once for the whole walk, as with
+ * `xtnt_set_for_each()`.
+ */
+xtnt_status_t
+xtnt_set_for_each_range(
+    struct xtnt_node_set *set,
+    xtnt_uint_t lower,
+    xtnt_uint_t upper,
+    xtnt_node_visit_fn visit,
+    void *ctx)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_set_iter iter;
+    if ((res = xtnt_set_iter_range(set, &iter, lower, upper, XTNT_SET_ITER_LOCK)) == XTNT_ESUCCESS) {
+        res = xtnt_set_iter_visit(&iter, visit, ctx);
+    }
+    return res;
+}
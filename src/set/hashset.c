@@ -0,0 +1,826 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/set/hashset.h>
+
+/**
+ * @struct xtnt_hashset_table
+ *
+ * Open addressed table of member references, kept in Robin Hood order
+ */
+struct xtnt_hashset_table
+{
+    size_t size;
+    size_t count;
+    size_t migrated;
+    struct xtnt_node *slot[];
+};
+
+/**
+ * @def XTNT_HASHSET_TABLE(S)
+ * Reference the table of set S receiving inserts
+ */
+#define XTNT_HASHSET_TABLE(S) ((struct xtnt_hashset_table *) (S)->root.link[XTNT_NODE_HEAD])
+
+/**
+ * @def XTNT_HASHSET_OLD(S)
+ * Reference the table of set S being migrated, or NULL
+ */
+#define XTNT_HASHSET_OLD(S) ((struct xtnt_hashset_table *) (S)->root.link[XTNT_NODE_TAIL])
+
+/**
+ * @brief Evaluate the slot a key hashes to
+ *
+ * @param[in] table The table to evaluate for
+ * @param[in] key The key to hash
+ * @return home slot of the key
+ */
+static inline size_t
+xtnt_hashset_home(
+    const struct xtnt_hashset_table *table,
+    xtnt_uint_t key)
+{
+    uint64_t hash = (uint64_t) key * 0x9E3779B97F4A7C15ULL;
+    return (size_t) (hash ^ (hash >> 32)) & (table->size - 1);
+}
+
+/**
+ * @brief Evaluate how far the member at a slot is from its home slot
+ *
+ * @param[in] table The table holding the member
+ * @param[in] idx The slot holding the member
+ * @return probe distance of the member
+ */
+static inline size_t
+xtnt_hashset_distance(
+    const struct xtnt_hashset_table *table,
+    size_t idx)
+{
+    return (idx - xtnt_hashset_home(table, table->slot[idx]->key)) & (table->size - 1);
+}
+
+/**
+ * @brief Find the slot of a key
+ *
+ * @param[in] table The table to search, or NULL
+ * @param[in] key The key to find
+ * @return slot of the key, or SIZE_MAX when not found
+ *
+ * @note The probe stops at the first member closer to its home than the
+ * key would be, as the key would have displaced it on insert.
+ */
+static size_t
+xtnt_hashset_find(
+    const struct xtnt_hashset_table *table,
+    xtnt_uint_t key)
+{
+    size_t idx;
+    size_t dist = XTNT_ZERO;
+    if (table == NULL) {
+        return SIZE_MAX;
+    }
+    idx = xtnt_hashset_home(table, key);
+    while (table->slot[idx] != NULL) {
+        if (table->slot[idx]->key == key) {
+            return idx;
+        }
+        if (xtnt_hashset_distance(table, idx) < dist) {
+            break;
+        }
+        idx = (idx + 1) & (table->size - 1);
+        dist++;
+    }
+    return SIZE_MAX;
+}
+
+/**
+ * @brief Place a node not yet in the table
+ *
+ * @param[in] table The table to place into, with at least one free slot
+ * @param[in] node The node to place
+ *
+ * @note A node probing past a member closer to its home takes the slot,
+ * and the displaced member continues the probe.
+ */
+static void
+xtnt_hashset_place(
+    struct xtnt_hashset_table *table,
+    struct xtnt_node *node)
+{
+    struct xtnt_node *swap = NULL;
+    size_t idx = xtnt_hashset_home(table, node->key);
+    size_t dist = XTNT_ZERO;
+    size_t other;
+    while (table->slot[idx] != NULL) {
+        if ((other = xtnt_hashset_distance(table, idx)) < dist) {
+            swap = table->slot[idx];
+            table->slot[idx] = node;
+            node = swap;
+            dist = other;
+        }
+        idx = (idx + 1) & (table->size - 1);
+        dist++;
+    }
+    table->slot[idx] = node;
+    table->count++;
+}
+
+/**
+ * @brief Erase the member at a slot
+ *
+ * @param[in] table The table to erase from
+ * @param[in] idx The slot of the member
+ * @return the erased member
+ *
+ * @note Following members are shifted back a slot until one is at its home
+ * slot, leaving no tombstones.
+ */
+static struct xtnt_node *
+xtnt_hashset_erase(
+    struct xtnt_hashset_table *table,
+    size_t idx)
+{
+    struct xtnt_node *erased = table->slot[idx];
+    size_t next = (idx + 1) & (table->size - 1);
+    while (table->slot[next] != NULL && xtnt_hashset_distance(table, next) != XTNT_ZERO) {
+        table->slot[idx] = table->slot[next];
+        idx = next;
+        next = (next + 1) & (table->size - 1);
+    }
+    table->slot[idx] = NULL;
+    table->count--;
+    return erased;
+}
+
+/**
+ * @brief Move members from the old table into the current table
+ *
+ * @param[in] set The set being resized
+ * @param[in] count The maximum number of members to move
+ *
+ * @note Members are erased from the front of the old table, so lookups in
+ * the old table remain valid while it drains. The old table is released
+ * once empty.
+ */
+static void
+xtnt_hashset_migrate(
+    struct xtnt_node_set *set,
+    size_t count)
+{
+    struct xtnt_hashset_table *old = XTNT_HASHSET_OLD(set);
+    if (old == NULL) {
+        return;
+    }
+    while (count > XTNT_ZERO && old->count > XTNT_ZERO) {
+        if (old->migrated == old->size) {
+            old->migrated = XTNT_ZERO;
+        }
+        if (old->slot[old->migrated] == NULL) {
+            old->migrated++;
+            continue;
+        }
+        xtnt_hashset_place(XTNT_HASHSET_TABLE(set), xtnt_hashset_erase(old, old->migrated));
+        count--;
+    }
+    if (old->count == XTNT_ZERO) {
+        free(old);
+        set->root.link[XTNT_NODE_TAIL] = NULL;
+    }
+}
+
+/**
+ * @brief Evaluate the slots needed to hold a number of members
+ *
+ * @param[in] eval The number of members
+ * @return power of 2 slots, or 0 on overflow
+ */
+static size_t
+xtnt_hashset_slots(
+    size_t eval)
+{
+    size_t slots = XTNT_HASHSET_SIZE;
+    if (eval > SIZE_MAX / XTNT_HASHSET_LOAD_DEN) {
+        return XTNT_ZERO;
+    }
+    while (slots / XTNT_HASHSET_LOAD_DEN * XTNT_HASHSET_LOAD_NUM < eval) {
+        if (slots > SIZE_MAX / 2) {
+            return XTNT_ZERO;
+        }
+        slots <<= 1;
+    }
+    return slots;
+}
+
+/**
+ * @brief Replace the current table with one of `slots` slots
+ *
+ * @param[in] set The set to resize
+ * @param[in] slots The power of 2 slots of the new table
+ * @retval XTNT_ESUCCESS on resize
+ * @retval ENOMEM on allocation failure
+ *
+ * @note A resize still migrating is completed first. The members of the
+ * replaced table are migrated as the set is modified.
+ */
+static xtnt_status_t
+xtnt_hashset_resize(
+    struct xtnt_node_set *set,
+    size_t slots)
+{
+    struct xtnt_hashset_table *table = NULL;
+    struct xtnt_hashset_table *current = NULL;
+    xtnt_hashset_migrate(set, SIZE_MAX);
+    if ((table = calloc(1, sizeof(struct xtnt_hashset_table) +
+                          (slots * sizeof(struct xtnt_node *)))) == NULL) {
+        return ENOMEM;
+    }
+    table->size = slots;
+    current = XTNT_HASHSET_TABLE(set);
+    if (current != NULL && current->count > XTNT_ZERO) {
+        set->root.link[XTNT_NODE_TAIL] = (struct xtnt_node *) current;
+    } else {
+        free(current);
+    }
+    set->root.link[XTNT_NODE_HEAD] = (struct xtnt_node *) table;
+    set->size = slots;
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Grow the table to hold `eval` members without locking
+ *
+ * @param[in] set The set to grow
+ * @param[in] eval The number of members to hold
+ * @retval XTNT_ESUCCESS on grow, or when `eval` members fit already
+ * @retval EOVERFLOW when `eval` members can not be addressed
+ * @retval result of `xtnt_hashset_resize()`
+ */
+static xtnt_status_t
+xtnt_hashset_grow_locked(
+    struct xtnt_node_set *set,
+    size_t eval)
+{
+    size_t slots = xtnt_hashset_slots(eval);
+    if (slots == XTNT_ZERO) {
+        return EOVERFLOW;
+    }
+    if (XTNT_HASHSET_TABLE(set) == NULL || slots > XTNT_HASHSET_TABLE(set)->size) {
+        return xtnt_hashset_resize(set, slots);
+    }
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Shrink the table to hold `eval` members without locking
+ *
+ * @param[in] set The set to shrink
+ * @param[in] eval The number of members to hold, raised to the member count
+ * @retval XTNT_ESUCCESS on shrink, or when the table is already smallest
+ * @retval result of `xtnt_hashset_resize()`
+ */
+static xtnt_status_t
+xtnt_hashset_shrink_locked(
+    struct xtnt_node_set *set,
+    size_t eval)
+{
+    size_t slots = xtnt_hashset_slots((eval < set->count) ? set->count : eval);
+    if (XTNT_HASHSET_TABLE(set) != NULL && slots < XTNT_HASHSET_TABLE(set)->size) {
+        return xtnt_hashset_resize(set, slots);
+    }
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Delete a node from the set
+ *
+ * @param[in] set The set to delete from
+ * @param[in] key The key of the node to delete
+ * @param[out] deleted The node removed from the set or NULL if not found
+ * @retval XTNT_ESUCCESS on successful delete or key not found
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ */
+xtnt_status_t
+xtnt_hashset_delete(
+    struct xtnt_node_set *set,
+    xtnt_uint_t key,
+    struct xtnt_node **deleted)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(set)) == XTNT_ESUCCESS) {
+        *deleted = xtnt_hashset_delete_locked(set, key);
+        res = xtnt_node_set_write_unlock(set);
+    }
+    return res;
+}
+
+/**
+ * @brief Delete a node from the set while holding its lock
+ *
+ * @param[in] set The set to delete from, locked by the caller
+ * @param[in] key The key of the node to delete
+ * @return the node removed from the set or NULL if not found
+ */
+struct xtnt_node *
+xtnt_hashset_delete_locked(
+    struct xtnt_node_set *set,
+    xtnt_uint_t key)
+{
+    struct xtnt_node *deleted = NULL;
+    size_t idx;
+    xtnt_hashset_migrate(set, XTNT_HASHSET_MIGRATE);
+    if ((idx = xtnt_hashset_find(XTNT_HASHSET_TABLE(set), key)) != SIZE_MAX) {
+        deleted = xtnt_hashset_erase(XTNT_HASHSET_TABLE(set), idx);
+    } else if ((idx = xtnt_hashset_find(XTNT_HASHSET_OLD(set), key)) != SIZE_MAX) {
+        deleted = xtnt_hashset_erase(XTNT_HASHSET_OLD(set), idx);
+        xtnt_hashset_migrate(set, XTNT_ZERO);
+    }
+    if (deleted != NULL) {
+        set->count--;
+    }
+    return deleted;
+}
+
+/**
+ * @brief Double the slots of the set
+ *
+ * @param[in] set The set to grow
+ * @retval XTNT_ESUCCESS on grow
+ * @retval EOVERFLOW when the slots can not be doubled
+ * @retval result of `xtnt_hashset_resize()`
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ */
+xtnt_status_t
+xtnt_hashset_grow(
+    struct xtnt_node_set *set)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(set)) == XTNT_ESUCCESS) {
+        if (XTNT_HASHSET_TABLE(set) == NULL) {
+            res = xtnt_hashset_resize(set, XTNT_HASHSET_SIZE);
+        } else if (XTNT_HASHSET_TABLE(set)->size > SIZE_MAX / 2) {
+            res = EOVERFLOW;
+        } else {
+            res = xtnt_hashset_resize(set, XTNT_HASHSET_TABLE(set)->size << 1);
+        }
+        if ((unlock = xtnt_node_set_write_unlock(set)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Grow the set to hold `eval` members without exceeding its load
+ *
+ * @param[in] set The set to grow
+ * @param[in] eval The number of members to hold
+ * @retval XTNT_ESUCCESS on grow, or when `eval` members fit already
+ * @retval EOVERFLOW when `eval` members can not be addressed
+ * @retval result of `xtnt_hashset_resize()`
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note Growing ahead of a known number of inserts avoids the resizes
+ * they would otherwise trigger.
+ */
+xtnt_status_t
+xtnt_hashset_grow_eval(
+    struct xtnt_node_set *set,
+    size_t eval)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(set)) == XTNT_ESUCCESS) {
+        res = xtnt_hashset_grow_locked(set, eval);
+        if ((unlock = xtnt_node_set_write_unlock(set)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Initialize a Node Set as a hash set
+ *
+ * @param[in] set The Node Set to initialize
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval result of `xtnt_hashset_initialize_lock()`
+ *
+ * @note This installs the `xtnt_hashset_if` interface so the `xtnt_set_*`
+ * functions operate on the hash set. No table is allocated until the first
+ * insert or grow.
+ */
+xtnt_status_t
+xtnt_hashset_initialize(
+    struct xtnt_node_set *set)
+{
+    return xtnt_hashset_initialize_lock(set, XTNT_SET_LOCK_MUTEX);
+}
+
+/**
+ * @brief Initialize a Node Set as a hash set with a locking policy
+ *
+ * @param[in] set The Node Set to initialize
+ * @param[in] policy The locking policy, see `xtnt_node_set_initialize_lock()`
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval result of `xtnt_node_set_initialize_lock()`
+ */
+xtnt_status_t
+xtnt_hashset_initialize_lock(
+    struct xtnt_node_set *set,
+    xtnt_uint_t policy)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_initialize_lock(set, policy)) == XTNT_ESUCCESS) {
+        set->size = XTNT_ZERO;
+        set->fn = &xtnt_hashset_if;
+    }
+    return res;
+}
+
+/**
+ * @brief Insert a node into the set
+ *
+ * @param[in] set The set to insert into
+ * @param[in] node The node to insert
+ * @retval XTNT_ESUCCESS on insert
+ * @retval EEXIST when a node with the same key is a member
+ * @retval EOVERFLOW or ENOMEM when the set can not grow
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note When the insert would exceed the maximum load the slots are doubled,
+ * and each following insert or delete moves up to XTNT_HASHSET_MIGRATE
+ * members into the new table, so no insert pays for a full rehash.
+ */
+xtnt_status_t
+xtnt_hashset_insert(
+    struct xtnt_node_set *set,
+    struct xtnt_node *node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(set)) == XTNT_ESUCCESS) {
+        res = xtnt_hashset_insert_locked(set, node);
+        if ((unlock = xtnt_node_set_write_unlock(set)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Insert a node into the set while holding its lock
+ *
+ * @param[in] set The set to insert into, locked by the caller
+ * @param[in] node The node to insert
+ * @retval XTNT_ESUCCESS on insert
+ * @retval EEXIST when a node with the same key is a member
+ * @retval EOVERFLOW or ENOMEM when the set can not grow
+ */
+xtnt_status_t
+xtnt_hashset_insert_locked(
+    struct xtnt_node_set *set,
+    struct xtnt_node *node)
+{
+    xtnt_status_t res = XTNT_ESUCCESS;
+    struct xtnt_hashset_table *table = NULL;
+    xtnt_hashset_migrate(set, XTNT_HASHSET_MIGRATE);
+    table = XTNT_HASHSET_TABLE(set);
+    if (xtnt_hashset_find(table, node->key) != SIZE_MAX ||
+        xtnt_hashset_find(XTNT_HASHSET_OLD(set), node->key) != SIZE_MAX) {
+        res = EEXIST;
+    } else if (table == NULL ||
+               (set->count + 1) > table->size / XTNT_HASHSET_LOAD_DEN * XTNT_HASHSET_LOAD_NUM) {
+        res = xtnt_hashset_grow_locked(set, (table == NULL) ? 1 :
+                                       table->size / XTNT_HASHSET_LOAD_DEN * XTNT_HASHSET_LOAD_NUM * 2);
+    }
+    if (res == XTNT_ESUCCESS) {
+        xtnt_hashset_place(XTNT_HASHSET_TABLE(set), node);
+        set->count++;
+    }
+    return res;
+}
+
+/**
+ * @brief Insert a node, replacing the member with the same key
+ *
+ * @param[in] set The set to insert into
+ * @param[in] node The node to insert
+ * @param[out] replaced The member replaced by the node, or NULL
+ * @retval XTNT_ESUCCESS on insert or replace
+ * @retval EOVERFLOW or ENOMEM when the set can not grow
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ */
+xtnt_status_t
+xtnt_hashset_replace(
+    struct xtnt_node_set *set,
+    struct xtnt_node *node,
+    struct xtnt_node **replaced)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(set)) == XTNT_ESUCCESS) {
+        res = xtnt_hashset_replace_locked(set, node, replaced);
+        if ((unlock = xtnt_node_set_write_unlock(set)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Insert or replace a node while holding the set lock
+ *
+ * @param[in] set The set to insert into, locked by the caller
+ * @param[in] node The node to insert
+ * @param[out] replaced The member replaced by the node, or NULL
+ * @retval XTNT_ESUCCESS on insert or replace
+ * @retval EOVERFLOW or ENOMEM when the set can not grow
+ *
+ * @note A replaced member's slot is reused, so no migration is needed.
+ */
+xtnt_status_t
+xtnt_hashset_replace_locked(
+    struct xtnt_node_set *set,
+    struct xtnt_node *node,
+    struct xtnt_node **replaced)
+{
+    struct xtnt_hashset_table *table = XTNT_HASHSET_TABLE(set);
+    size_t idx;
+    *replaced = NULL;
+    if ((idx = xtnt_hashset_find(table, node->key)) == SIZE_MAX) {
+        table = XTNT_HASHSET_OLD(set);
+        idx = xtnt_hashset_find(table, node->key);
+    }
+    if (idx != SIZE_MAX) {
+        *replaced = table->slot[idx];
+        table->slot[idx] = node;
+        return XTNT_ESUCCESS;
+    }
+    return xtnt_hashset_insert_locked(set, node);
+}
+
+/**
+ * @brief Search the set for key
+ *
+ * @param[in] set The set to search
+ * @param[in] key The key to match
+ * @param[out] found Reference to matching node or NULL
+ * @retval XTNT_ESUCCESS on search
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ *
+ * @note Searches do not migrate members, they probe both tables while a
+ * resize is in progress.
+ */
+xtnt_status_t
+xtnt_hashset_search(
+    struct xtnt_node_set *set,
+    xtnt_uint_t key,
+    struct xtnt_node **found)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_read_lock(set)) == XTNT_ESUCCESS) {
+        *found = xtnt_hashset_search_locked(set, key);
+        res = xtnt_node_set_read_unlock(set);
+    }
+    return res;
+}
+
+/**
+ * @brief Search the set for key while holding its lock
+ *
+ * @param[in] set The set to search, locked by the caller
+ * @param[in] key The key to match
+ * @return matching node or NULL
+ */
+struct xtnt_node *
+xtnt_hashset_search_locked(
+    struct xtnt_node_set *set,
+    xtnt_uint_t key)
+{
+    size_t idx;
+    if ((idx = xtnt_hashset_find(XTNT_HASHSET_TABLE(set), key)) != SIZE_MAX) {
+        return XTNT_HASHSET_TABLE(set)->slot[idx];
+    }
+    if ((idx = xtnt_hashset_find(XTNT_HASHSET_OLD(set), key)) != SIZE_MAX) {
+        return XTNT_HASHSET_OLD(set)->slot[idx];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Search the set for a node matched by function
+ *
+ * @param[in] set The set to search
+ * @param[in] test_fn The test function to call on each node
+ * @param[in] ctx Context passed into the test function
+ * @param[out] found Reference to first matching node or NULL
+ * @retval XTNT_ESUCCESS on search
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ *
+ * @remark The test returns non-zero on match with the signature:
+ *
+ * @code
+ * xtnt_uint_t callback(void *ctx, struct xtnt_node *node);
+ * @endcode
+ *
+ * @note Members are visited in slot order, not key order.
+ */
+xtnt_status_t
+xtnt_hashset_search_fn(
+    struct xtnt_node_set *set,
+    void *test_fn,
+    void *ctx,
+    struct xtnt_node **found)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_uint_t (*test)(void *, struct xtnt_node *) = test_fn;
+    struct xtnt_hashset_table *tables[2];
+    if ((res = xtnt_node_set_read_lock(set)) == XTNT_ESUCCESS) {
+        *found = NULL;
+        tables[0] = XTNT_HASHSET_TABLE(set);
+        tables[1] = XTNT_HASHSET_OLD(set);
+        for (xtnt_uint_t t = 0; t < 2 && *found == NULL; t++) {
+            for (size_t idx = 0; tables[t] != NULL && idx < tables[t]->size; idx++) {
+                if (tables[t]->slot[idx] != NULL && test(ctx, tables[t]->slot[idx]) != 0) {
+                    *found = tables[t]->slot[idx];
+                    break;
+                }
+            }
+        }
+        res = xtnt_node_set_read_unlock(set);
+    }
+    return res;
+}
+
+/**
+ * @brief Shrink the set to the fewest slots holding its members
+ *
+ * @param[in] set The set to shrink
+ * @retval XTNT_ESUCCESS on shrink, or when the table is already smallest
+ * @retval result of `xtnt_hashset_resize()`
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ */
+xtnt_status_t
+xtnt_hashset_shrink(
+    struct xtnt_node_set *set)
+{
+    return xtnt_hashset_shrink_eval(set, XTNT_ZERO);
+}
+
+/**
+ * @brief Shrink the set to the fewest slots holding `eval` members
+ *
+ * @param[in] set The set to shrink
+ * @param[in] eval The number of members to hold, raised to the member count
+ * @retval XTNT_ESUCCESS on shrink, or when the table is already smallest
+ * @retval result of `xtnt_hashset_resize()`
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note The set never shrinks on its own, deletes leave the slots in place.
+ */
+xtnt_status_t
+xtnt_hashset_shrink_eval(
+    struct xtnt_node_set *set,
+    size_t eval)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(set)) == XTNT_ESUCCESS) {
+        res = xtnt_hashset_shrink_locked(set, eval);
+        if ((unlock = xtnt_node_set_write_unlock(set)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Uninitialize a hash set, releasing its tables
+ *
+ * @param[in] set The set to uninitialize
+ * @retval result of `xtnt_node_set_uninitialize()`
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note Member nodes are owned by the caller and are not released.
+ */
+xtnt_status_t
+xtnt_hashset_uninitialize(
+    struct xtnt_node_set *set)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(set)) == XTNT_ESUCCESS) {
+        free(XTNT_HASHSET_TABLE(set));
+        free(XTNT_HASHSET_OLD(set));
+        set->root.link[XTNT_NODE_HEAD] = NULL;
+        set->root.link[XTNT_NODE_TAIL] = NULL;
+        set->count = XTNT_ZERO;
+        set->size = XTNT_ZERO;
+        if ((res = xtnt_node_set_write_unlock(set)) == XTNT_ESUCCESS) {
+            res = xtnt_node_set_uninitialize(set);
+        }
+    }
+    return res;
+}
+
+static xtnt_status_t
+xtnt_hashset_remove(
+    struct xtnt_node_set *set,
+    struct xtnt_node *node)
+{
+    struct xtnt_node *deleted = NULL;
+    return xtnt_hashset_delete(set, node->key, &deleted);
+}
+
+/**
+ * @brief Visit the member after the cursor, in slot order
+ *
+ * @param[in] set The set, read locked
+ * @param[in] iter The cursor, its index the next slot of the table and
+ * then of the table being migrated from
+ * @param[out] node The member, or NULL past the last slot
+ * @retval XTNT_ESUCCESS on visit
+ */
+static xtnt_status_t
+xtnt_hashset_next(
+    struct xtnt_node_set *set,
+    struct xtnt_set_iter *iter,
+    struct xtnt_node **node)
+{
+    struct xtnt_hashset_table *table = XTNT_HASHSET_TABLE(set);
+    struct xtnt_hashset_table *old = XTNT_HASHSET_OLD(set);
+    size_t size = (table != NULL) ? table->size : 0;
+    *node = NULL;
+    while (*node == NULL && iter->index < size) {
+        *node = table->slot[iter->index++];
+    }
+    while (*node == NULL && old != NULL && iter->index - size < old->size) {
+        *node = old->slot[iter->index++ - size];
+    }
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Hash set Node Set interface
+ */
+const struct xtnt_node_set_if xtnt_hashset_if = {
+    .index = xtnt_node_set_enotsup_index,
+    .search = xtnt_hashset_search,
+    .search_fn = xtnt_hashset_search_fn,
+    .first = xtnt_node_set_enotsup_out,
+    .last = xtnt_node_set_enotsup_out,
+    .peek = xtnt_node_set_enotsup_out,
+    .root = xtnt_node_set_enotsup_out,
+    .state = xtnt_node_set_enotsup_state,
+    .insert = xtnt_hashset_insert,
+    .insert_at = xtnt_node_set_enotsup_insert_at,
+    .push = xtnt_node_set_enotsup_node,
+    .remove = xtnt_hashset_remove,
+    .remove_at = xtnt_node_set_enotsup_key,
+    .pop = xtnt_node_set_enotsup_out,
+    .sort = xtnt_node_set_enotsup,
+    .sort_reverse = xtnt_node_set_enotsup,
+    .sort_fn = xtnt_node_set_enotsup_fn,
+    .grow = xtnt_hashset_grow,
+    .grow_eval = xtnt_hashset_grow_eval,
+    .shrink = xtnt_hashset_shrink,
+    .shrink_eval = xtnt_hashset_shrink_eval,
+    .next = xtnt_hashset_next,
+    .seek = xtnt_node_set_enotsup_seek
+};
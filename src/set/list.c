@@ -28,6 +28,102 @@ SOFTWARE.
 */
 
 #include <extant/set/list.h>
+#include <extant/set/sort.h>
+
+/**
+ * @brief Find the node at an index of a list
+ *
+ * @param[in] list The Node List to read
+ * @param[in] index The Node index to retrieve
+ * @return node at index or NULL on invalid index
+ *
+ * @note The walk also ends on a NULL link, so an optimistic read racing a
+ * writer ends as well. Its result is discarded when validation fails.
+ */
+static struct xtnt_node *
+xtnt_list_at(
+    struct xtnt_node_set *list,
+    xtnt_uint_t index)
+{
+    struct xtnt_node *node = NULL;
+    xtnt_uint_t count = list->count;
+    xtnt_uint_t dir = XTNT_NODE_HEAD;
+    if (count > index) {
+        if (index < (count >> 1)) {
+            node = list->root.link[XTNT_NODE_HEAD];
+            dir = XTNT_NODE_TAIL;
+        } else {
+            node = list->root.link[XTNT_NODE_TAIL];
+            index = count - (index + 1);
+        }
+        for (xtnt_uint_t idx = 0; idx < index && node != NULL; idx++) {
+            node = node->link[dir];
+        }
+    }
+    return node;
+}
+
+/**
+ * @brief Find the first node with a key in a list
+ *
+ * @param[in] list The Node List to read
+ * @param[in] key The key to match
+ * @return node on match or NULL
+ *
+ * @note At most count nodes are visited, so an optimistic read racing a
+ * writer cannot follow a transient cycle forever.
+ */
+static struct xtnt_node *
+xtnt_list_find(
+    struct xtnt_node_set *list,
+    xtnt_uint_t key)
+{
+    struct xtnt_node *node = list->root.link[XTNT_NODE_HEAD];
+    xtnt_uint_t count = list->count;
+    for (xtnt_uint_t idx = 0; idx < count && node != NULL; idx++) {
+        if (node->key == key) {
+            return node;
+        }
+        node = node->link[XTNT_NODE_TAIL];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Add a back linked chain to the list
+ *
+ * @param[in] list The Node List to add to
+ * @param[in] head The first node of the chain, inserted first
+ * @param[in] tail The last node of the chain, the new head
+ * @param[in] count The number of nodes in the chain
+ * @retval XTNT_ESUCCESS on insert
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ */
+static xtnt_status_t
+xtnt_list_splice(
+    struct xtnt_node_set *list,
+    struct xtnt_node *head,
+    struct xtnt_node *tail,
+    xtnt_uint_t count)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if (count == 0) {
+        return XTNT_ESUCCESS;
+    }
+    if ((res = xtnt_node_set_write_lock(list)) == XTNT_ESUCCESS) {
+        if (list->count == 0) {
+            list->root.link[XTNT_NODE_TAIL] = head;
+        } else {
+            head->link[XTNT_NODE_TAIL] = list->root.link[XTNT_NODE_HEAD];
+            list->root.link[XTNT_NODE_HEAD]->link[XTNT_NODE_HEAD] = head;
+        }
+        list->root.link[XTNT_NODE_HEAD] = tail;
+        list->count += count;
+        res = xtnt_node_set_write_unlock(list);
+    }
+    return res;
+}
 
 /**
  * @brief Remove a node from the list
@@ -45,7 +141,7 @@ xtnt_list_delete(
 {
     xtnt_status_t res = XTNT_EFAILURE;
     xtnt_uint_t dir = XTNT_NODE_HEAD;
-    if ((res = pthread_mutex_lock(&(list->lock))) == XTNT_ESUCCESS) {
+    if ((res = xtnt_node_set_write_lock(list)) == XTNT_ESUCCESS) {
         if (list->count > index) {
             if (index < (list->count >> 1)) {
                 *deleted = list->root.link[XTNT_NODE_HEAD];
@@ -77,11 +173,7 @@ xtnt_list_delete(
         } else {
             *deleted = NULL;
         }
-        if ((res = pthread_mutex_unlock(&(list->lock))) != XTNT_ESUCCESS) {
-            XTNT_LOCK_SET_UNLOCK_FAIL(list->root.state);
-        }
-    } else {
-        XTNT_LOCK_SET_LOCK_FAIL(list->root.state);
+        res = xtnt_node_set_write_unlock(list);
     }
     return res;
 }
@@ -93,6 +185,9 @@ xtnt_list_delete(
  * @param[in] index The Node index to retreive
  * @param[out] node The Node found at index or NULL
  * @return node at index or NULL on invalid index or error
+ *
+ * @note A XTNT_SET_LOCK_SEQLOCK list is read without locking while no
+ * writer interferes.
  */
 xtnt_status_t
 xtnt_list_get(
@@ -101,67 +196,172 @@ xtnt_list_get(
     struct xtnt_node **node)
 {
     xtnt_status_t res = XTNT_EFAILURE;
-    xtnt_uint_t dir = XTNT_NODE_HEAD;
-    if ((res = pthread_mutex_lock(&(list->lock))) == XTNT_ESUCCESS) {
-        if (list->count > index) {
-            if (index < (list->count >> 1)) {
-                *node = list->root.link[XTNT_NODE_HEAD];
-                dir = XTNT_NODE_TAIL;
-            } else {
-                *node = list->root.link[XTNT_NODE_TAIL];
-                index = list->count - (index + 1);
-            }
-            for (xtnt_uint_t idx = 0; idx < index; idx++) {
-                *node = (*node)->link[dir];
+    xtnt_uint_t sequence = XTNT_ZERO;
+    if (list->policy == XTNT_SET_LOCK_SEQLOCK) {
+        for (xtnt_uint_t retry = 0; retry < XTNT_SET_SEQLOCK_RETRY; retry++) {
+            sequence = xtnt_node_set_read_begin(list);
+            *node = xtnt_list_at(list, index);
+            if (xtnt_node_set_read_validate(list, sequence)) {
+                return XTNT_ESUCCESS;
             }
-        } else {
-            *node = NULL;
-        }
-        if ((res = pthread_mutex_unlock(&(list->lock))) != XTNT_ESUCCESS) {
-            XTNT_LOCK_SET_UNLOCK_FAIL(list->root.state);
         }
-    } else {
-        XTNT_LOCK_SET_LOCK_FAIL(list->root.state);
+    }
+    if ((res = xtnt_node_set_read_lock(list)) == XTNT_ESUCCESS) {
+        *node = xtnt_list_at(list, index);
+        res = xtnt_node_set_read_unlock(list);
+    }
+    return res;
+}
+
+/**
+ * @brief Initialize a Node Set as a list
+ *
+ * @param[in] list The Node Set to initialize
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval result of `xtnt_list_initialize_lock()`
+ */
+xtnt_status_t
+xtnt_list_initialize(
+    struct xtnt_node_set *list)
+{
+    return xtnt_list_initialize_lock(list, XTNT_SET_LOCK_MUTEX);
+}
+
+/**
+ * @brief Initialize a Node Set as a list with a locking policy
+ *
+ * @param[in] list The Node Set to initialize
+ * @param[in] policy The locking policy, see `xtnt_node_set_initialize_lock()`
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval result of `xtnt_node_set_initialize_lock()`
+ *
+ * @note The list installs `xtnt_list_if` for the `xtnt_set_*` operations.
+ */
+xtnt_status_t
+xtnt_list_initialize_lock(
+    struct xtnt_node_set *list,
+    xtnt_uint_t policy)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_initialize_lock(list, policy)) == XTNT_ESUCCESS) {
+        list->fn = &xtnt_list_if;
     }
     return res;
 }
 
+extern inline xtnt_status_t
+xtnt_list_insert(
+    struct xtnt_node_set *list,
+    struct xtnt_node *node);
+
 /**
- * @brief Add a node to the list
+ * @brief Add a chain of nodes to the list
  *
  * @param[in] list The Node Set to add to
- * @param[in] node The Node to add
- * @return node added or NULL on error
+ * @param[in] head The first node of a chain linked through
+ * link[XTNT_NODE_HEAD] and ending with NULL, or NULL
+ * @retval XTNT_ESUCCESS on insert
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note The list ends as if each node had been inserted in chain order, the
+ * last node at index 0, with one lock and one count update. The chain is
+ * walked before locking.
  *
  * @warning
- * Do not re-add an existing member to the list. To attach the same value,
- * create a new node with the value, and add the new node instead.
+ * Do not add an existing member to the list, see `xtnt_list_insert()`.
  */
 xtnt_status_t
-xtnt_list_insert(
+xtnt_list_insert_chain(
+    struct xtnt_node_set *list,
+    struct xtnt_node *head)
+{
+    struct xtnt_node *tail = NULL;
+    xtnt_uint_t count = XTNT_ZERO;
+    xtnt_node_chain(head, &tail, &count);
+    return xtnt_list_splice(list, head, tail, count);
+}
+
+/**
+ * @brief Add a table of nodes to the list
+ *
+ * @param[in] list The Node Set to add to
+ * @param[in] count The number of nodes
+ * @param[in] nodes The nodes to add, in insert order
+ * @retval XTNT_ESUCCESS on insert
+ * @retval EINVAL on a NULL node
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note The nodes are linked into a chain before locking, then added as
+ * with `xtnt_list_insert_chain()`.
+ */
+xtnt_status_t
+xtnt_list_insert_many(
     struct xtnt_node_set *list,
-    struct xtnt_node *node)
+    xtnt_uint_t count,
+    struct xtnt_node **nodes)
 {
     xtnt_status_t res = XTNT_EFAILURE;
-    if ((res = pthread_mutex_lock(&(list->lock))) == XTNT_ESUCCESS) {
-        if (list->count == 0){
-            // We are the head and tail
-            list->root.link[XTNT_NODE_HEAD] = node;
-            list->root.link[XTNT_NODE_TAIL] = node;
-        } else {
-            // We have a new tail
-            node->link[XTNT_NODE_TAIL] = list->root.link[XTNT_NODE_HEAD];
-            // We are a new head to our tail
-            list->root.link[XTNT_NODE_HEAD]->link[XTNT_NODE_HEAD] = node;
-            // We are the new head
-            list->root.link[XTNT_NODE_HEAD] = node;
-        }
-        list->count++;
-        if ((res = pthread_mutex_unlock(&(list->lock))) != XTNT_ESUCCESS) {
-            XTNT_LOCK_SET_UNLOCK_FAIL(list->root.state);
+    struct xtnt_node *head = NULL;
+    struct xtnt_node *tail = NULL;
+    if ((res = xtnt_node_chain_table(nodes, count, &head, &tail)) != XTNT_ESUCCESS) {
+        return res;
+    }
+    return xtnt_list_splice(list, head, tail, count);
+}
+
+/**
+ * @brief Unlink a table of members from the list
+ *
+ * @param[in] list The Node Set to remove from
+ * @param[in] count The number of nodes
+ * @param[in] nodes The members to remove, NULL entries are skipped
+ * @retval XTNT_ESUCCESS on removal
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note Each member is unlinked in place under one lock with one count
+ * update, no index walk is needed. The links of removed nodes are cleared.
+ *
+ * @warning
+ * Every node must be a distinct member of the list, as found by
+ * `xtnt_list_search()` or `xtnt_list_get()`.
+ */
+xtnt_status_t
+xtnt_list_remove_many(
+    struct xtnt_node_set *list,
+    xtnt_uint_t count,
+    struct xtnt_node **nodes)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_uint_t removed = XTNT_ZERO;
+    struct xtnt_node *newer = NULL;
+    struct xtnt_node *older = NULL;
+    if ((res = xtnt_node_set_write_lock(list)) == XTNT_ESUCCESS) {
+        for (xtnt_uint_t idx = 0; idx < count; idx++) {
+            if (nodes[idx] == NULL) {
+                continue;
+            }
+            // The links at either end may be stale, the root tells the ends
+            newer = (nodes[idx] == list->root.link[XTNT_NODE_HEAD]) ? NULL : nodes[idx]->link[XTNT_NODE_HEAD];
+            older = (nodes[idx] == list->root.link[XTNT_NODE_TAIL]) ? NULL : nodes[idx]->link[XTNT_NODE_TAIL];
+            if (newer != NULL) {
+                newer->link[XTNT_NODE_TAIL] = older;
+            } else {
+                list->root.link[XTNT_NODE_HEAD] = older;
+            }
+            if (older != NULL) {
+                older->link[XTNT_NODE_HEAD] = newer;
+            } else {
+                list->root.link[XTNT_NODE_TAIL] = newer;
+            }
+            nodes[idx]->link[XTNT_NODE_HEAD] = NULL;
+            nodes[idx]->link[XTNT_NODE_TAIL] = NULL;
+            removed++;
         }
-    } else {
-        XTNT_LOCK_SET_LOCK_FAIL(list->root.state);
+        list->count -= removed;
+        res = xtnt_node_set_write_unlock(list);
     }
     return res;
 }
@@ -198,7 +398,7 @@ xtnt_list_replace(
 {
     xtnt_status_t res = XTNT_EFAILURE;
     xtnt_uint_t dir = XTNT_NODE_HEAD;
-    if ((res = pthread_mutex_lock(&(list->lock))) == XTNT_ESUCCESS) {
+    if ((res = xtnt_node_set_write_lock(list)) == XTNT_ESUCCESS) {
         if (list->count > index) {
             if (index < (list->count >> 1)) {
                 *replaced = list->root.link[XTNT_NODE_HEAD];
@@ -225,11 +425,7 @@ xtnt_list_replace(
         } else {
             *replaced = NULL;
         }
-        if ((res = pthread_mutex_unlock(&(list->lock))) != XTNT_ESUCCESS) {
-            XTNT_LOCK_SET_UNLOCK_FAIL(list->root.state);
-        }
-    } else {
-        XTNT_LOCK_SET_LOCK_FAIL(list->root.state);
+        res = xtnt_node_set_write_unlock(list);
     }
     return res;
 }
@@ -241,6 +437,9 @@ xtnt_list_replace(
  * @param[in] key The key to match
  * @param[out] found Reference to matching Node or NULL
  * @return node on match or NULL
+ *
+ * @note A XTNT_SET_LOCK_SEQLOCK list is read without locking while no
+ * writer interferes.
  */
 xtnt_status_t
 xtnt_list_search(
@@ -249,21 +448,19 @@ xtnt_list_search(
     struct xtnt_node **found)
 {
     xtnt_status_t res = XTNT_EFAILURE;
-    if ((res = pthread_mutex_lock(&(list->lock))) == XTNT_ESUCCESS) {
-        *found = list->root.link[XTNT_NODE_HEAD];
-        do {
-            if (*found == NULL || (*found)->key == key) {
-                break;
+    xtnt_uint_t sequence = XTNT_ZERO;
+    if (list->policy == XTNT_SET_LOCK_SEQLOCK) {
+        for (xtnt_uint_t retry = 0; retry < XTNT_SET_SEQLOCK_RETRY; retry++) {
+            sequence = xtnt_node_set_read_begin(list);
+            *found = xtnt_list_find(list, key);
+            if (xtnt_node_set_read_validate(list, sequence)) {
+                return XTNT_ESUCCESS;
             }
-        } while ((*found = (*found)->link[XTNT_NODE_TAIL]));
-        if ((res = pthread_mutex_unlock(&(list->lock))) != XTNT_ESUCCESS) {
-            XTNT_LOCK_SET_UNLOCK_FAIL(list->root.state);
-        }
-        if ((res = pthread_mutex_unlock(&(list->lock))) != XTNT_ESUCCESS) {
-            XTNT_LOCK_SET_UNLOCK_FAIL(list->root.state);
         }
-    } else {
-        XTNT_LOCK_SET_LOCK_FAIL(list->root.state);
+    }
+    if ((res = xtnt_node_set_read_lock(list)) == XTNT_ESUCCESS) {
+        *found = xtnt_list_find(list, key);
+        res = xtnt_node_set_read_unlock(list);
     }
     return res;
 }
@@ -294,21 +491,177 @@ xtnt_list_search_fn(
 {
     xtnt_status_t res = XTNT_EFAILURE;
     xtnt_uint_t (*test)(void *, struct xtnt_node *) = test_fn;
-    if ((res = pthread_mutex_lock(&(list->lock))) == XTNT_ESUCCESS) {
+    if ((res = xtnt_node_set_read_lock(list)) == XTNT_ESUCCESS) {
         *found = list->root.link[XTNT_NODE_HEAD];
         do {
             if (*found == NULL || (test(ctx, *found) != 0)) {
                 break;
             }
         } while ((*found = (*found)->link[XTNT_NODE_TAIL]));
-        if ((res = pthread_mutex_unlock(&(list->lock))) != XTNT_ESUCCESS) {
-            XTNT_LOCK_SET_UNLOCK_FAIL(list->root.state);
-        }
-        if ((res = pthread_mutex_unlock(&(list->lock))) != XTNT_ESUCCESS) {
-            XTNT_LOCK_SET_UNLOCK_FAIL(list->root.state);
+        res = xtnt_node_set_read_unlock(list);
+    }
+    return res;
+}
+
+/**
+ * @brief Sort a list by ascending key
+ *
+ * @param[in] list The Node Set to sort
+ * @retval XTNT_ESUCCESS on sort
+ * @retval result of `xtnt_list_sort_fn()`
+ */
+xtnt_status_t
+xtnt_list_sort(
+    struct xtnt_node_set *list)
+{
+    return xtnt_list_sort_fn(list, xtnt_node_compare_key);
+}
+
+/**
+ * @brief Sort a list by a comparison function
+ *
+ * @param[in] list The Node Set to sort
+ * @param[in] compare The order to sort in, see `xtnt_node_compare_fn`
+ * @retval XTNT_ESUCCESS on sort
+ * @retval EINVAL without a comparison function
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note The nodes are relinked in place with a stable merge sort, see
+ * `xtnt_sort_chain()`, so sorting allocates nothing and no node moves.
+ */
+xtnt_status_t
+xtnt_list_sort_fn(
+    struct xtnt_node_set *list,
+    xtnt_node_compare_fn compare)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if (compare == NULL) {
+        return EINVAL;
+    }
+    if ((res = xtnt_node_set_write_lock(list)) == XTNT_ESUCCESS) {
+        res = xtnt_sort_chain(&(list->root.link[XTNT_NODE_HEAD]),
+                              &(list->root.link[XTNT_NODE_TAIL]), compare);
+        if ((unlock = xtnt_node_set_write_unlock(list)) != XTNT_ESUCCESS) {
+            res = unlock;
         }
-    } else {
-        XTNT_LOCK_SET_LOCK_FAIL(list->root.state);
     }
     return res;
 }
+
+/**
+ * @brief Sort a list by descending key
+ *
+ * @param[in] list The Node Set to sort
+ * @retval XTNT_ESUCCESS on sort
+ * @retval result of `xtnt_list_sort_fn()`
+ */
+xtnt_status_t
+xtnt_list_sort_reverse(
+    struct xtnt_node_set *list)
+{
+    return xtnt_list_sort_fn(list, xtnt_node_compare_key_reverse);
+}
+
+static xtnt_status_t
+xtnt_list_index(
+    struct xtnt_node_set *list,
+    xtnt_int_t index,
+    struct xtnt_node **node)
+{
+    if (index < 0) {
+        return EINVAL;
+    }
+    return xtnt_list_get(list, (xtnt_uint_t) index, node);
+}
+
+static xtnt_status_t
+xtnt_list_first(
+    struct xtnt_node_set *list,
+    struct xtnt_node **first)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_read_lock(list)) == XTNT_ESUCCESS) {
+        *first = list->root.link[XTNT_NODE_HEAD];
+        res = xtnt_node_set_read_unlock(list);
+    }
+    return res;
+}
+
+static xtnt_status_t
+xtnt_list_last(
+    struct xtnt_node_set *list,
+    struct xtnt_node **last)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_read_lock(list)) == XTNT_ESUCCESS) {
+        *last = list->root.link[XTNT_NODE_TAIL];
+        res = xtnt_node_set_read_unlock(list);
+    }
+    return res;
+}
+
+static xtnt_status_t
+xtnt_list_insert_at(
+    struct xtnt_node_set *list,
+    xtnt_uint_t index,
+    struct xtnt_node *node,
+    struct xtnt_node **replaced)
+{
+    return xtnt_list_replace(list, node, index, replaced);
+}
+
+/**
+ * @brief Visit the member after the cursor, from the head
+ *
+ * @param[in] list The list, read locked
+ * @param[in] iter The cursor
+ * @param[out] node The member, or NULL past the tail
+ * @retval XTNT_ESUCCESS on visit
+ */
+static xtnt_status_t
+xtnt_list_next(
+    struct xtnt_node_set *list,
+    struct xtnt_set_iter *iter,
+    struct xtnt_node **node)
+{
+    if (iter->node == NULL) {
+        *node = list->root.link[XTNT_NODE_HEAD];
+    } else {
+        // The first member inserted keeps whatever link it came with
+        *node = (iter->node == list->root.link[XTNT_NODE_TAIL]) ? NULL : iter->node->link[XTNT_NODE_TAIL];
+    }
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief List Node Set interface
+ *
+ * @note first is the most recently inserted node, last the oldest.
+ */
+const struct xtnt_node_set_if xtnt_list_if = {
+    .index = xtnt_list_index,
+    .search = xtnt_list_search,
+    .search_fn = xtnt_list_search_fn,
+    .first = xtnt_list_first,
+    .last = xtnt_list_last,
+    .peek = xtnt_node_set_enotsup_out,
+    .root = xtnt_node_set_enotsup_out,
+    .state = xtnt_node_set_enotsup_state,
+    .insert = xtnt_list_insert,
+    .insert_at = xtnt_list_insert_at,
+    .push = xtnt_node_set_enotsup_node,
+    .remove = xtnt_node_set_enotsup_node,
+    .remove_at = xtnt_list_delete,
+    .pop = xtnt_node_set_enotsup_out,
+    .sort = xtnt_list_sort,
+    .sort_reverse = xtnt_list_sort_reverse,
+    .sort_fn = xtnt_list_sort_fn,
+    .grow = xtnt_node_set_enotsup,
+    .grow_eval = xtnt_node_set_enotsup_eval,
+    .shrink = xtnt_node_set_enotsup,
+    .shrink_eval = xtnt_node_set_enotsup_eval,
+    .next = xtnt_list_next,
+    .seek = xtnt_node_set_enotsup_seek
+};
@@ -0,0 +1,418 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/set/list/clist.h>
+
+/**
+ * @brief Walk to a member of a compact list by index
+ *
+ * @param[in] list The compact list to read
+ * @param[in] index The index of the member
+ * @return member at index or NULL
+ *
+ * @note The walk starts from the nearer end and stops at NULL, so a reader
+ * racing a writer under XTNT_SET_LOCK_SEQLOCK ends instead of faulting.
+ */
+static struct xtnt_cnode *
+xtnt_clist_at(
+    struct xtnt_node_set *list,
+    xtnt_uint_t index)
+{
+    struct xtnt_cnode *node = NULL;
+    xtnt_uint_t dir = XTNT_CNODE_TAIL;
+    xtnt_uint_t count = list->count;
+    if (index >= count) {
+        return NULL;
+    }
+    if (index < (count >> 1)) {
+        node = (struct xtnt_cnode *) list->root.link[XTNT_NODE_HEAD];
+    } else {
+        node = (struct xtnt_cnode *) list->root.link[XTNT_NODE_TAIL];
+        index = count - (index + 1);
+        dir = XTNT_CNODE_HEAD;
+    }
+    for (; node != NULL && index > 0; index--) {
+        node = node->link[dir];
+    }
+    return node;
+}
+
+/**
+ * @brief Find the newest member of a compact list with a key
+ *
+ * @param[in] list The compact list to read
+ * @param[in] key The key to match
+ * @return member on match or NULL
+ */
+static struct xtnt_cnode *
+xtnt_clist_find(
+    struct xtnt_node_set *list,
+    xtnt_uint_t key)
+{
+    struct xtnt_cnode *node = (struct xtnt_cnode *) list->root.link[XTNT_NODE_HEAD];
+    for (xtnt_uint_t idx = list->count; node != NULL && idx > 0; idx--) {
+        if (node->key == key) {
+            return node;
+        }
+        node = node->link[XTNT_CNODE_TAIL];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Unlink a member from a compact list
+ *
+ * @param[in] list The compact list, write locked
+ * @param[in] node The member to unlink
+ */
+static void
+xtnt_clist_unlink(
+    struct xtnt_node_set *list,
+    struct xtnt_cnode *node)
+{
+    struct xtnt_cnode *newer = node->link[XTNT_CNODE_HEAD];
+    struct xtnt_cnode *older = node->link[XTNT_CNODE_TAIL];
+    if (newer != NULL) {
+        newer->link[XTNT_CNODE_TAIL] = older;
+    } else {
+        list->root.link[XTNT_NODE_HEAD] = (struct xtnt_node *) older;
+    }
+    if (older != NULL) {
+        older->link[XTNT_CNODE_HEAD] = newer;
+    } else {
+        list->root.link[XTNT_NODE_TAIL] = (struct xtnt_node *) newer;
+    }
+    node->link[XTNT_CNODE_HEAD] = NULL;
+    node->link[XTNT_CNODE_TAIL] = NULL;
+    list->count--;
+}
+
+/**
+ * @brief Delete a compact list member by index
+ *
+ * @param[in] list The compact list to modify
+ * @param[in] index The index of the member to delete
+ * @param[out] deleted The member removed or NULL on an invalid index
+ * @retval XTNT_ESUCCESS on success
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ */
+xtnt_status_t
+xtnt_clist_delete(
+    struct xtnt_node_set *list,
+    xtnt_uint_t index,
+    struct xtnt_cnode **deleted)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(list)) == XTNT_ESUCCESS) {
+        if ((*deleted = xtnt_clist_at(list, index)) != NULL) {
+            xtnt_clist_unlink(list, *deleted);
+        }
+        res = xtnt_node_set_write_unlock(list);
+    }
+    return res;
+}
+
+/**
+ * @brief Get a compact list member by index
+ *
+ * @param[in] list The compact list to read
+ * @param[in] index The index of the member
+ * @param[out] node The member at index or NULL
+ * @retval XTNT_ESUCCESS on success
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ *
+ * @note A XTNT_SET_LOCK_SEQLOCK list is read without locking while no
+ * writer interferes.
+ */
+xtnt_status_t
+xtnt_clist_get(
+    struct xtnt_node_set *list,
+    xtnt_uint_t index,
+    struct xtnt_cnode **node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_uint_t sequence = XTNT_ZERO;
+    if (list->policy == XTNT_SET_LOCK_SEQLOCK) {
+        for (xtnt_uint_t retry = 0; retry < XTNT_SET_SEQLOCK_RETRY; retry++) {
+            sequence = xtnt_node_set_read_begin(list);
+            *node = xtnt_clist_at(list, index);
+            if (xtnt_node_set_read_validate(list, sequence)) {
+                return XTNT_ESUCCESS;
+            }
+        }
+    }
+    if ((res = xtnt_node_set_read_lock(list)) == XTNT_ESUCCESS) {
+        *node = xtnt_clist_at(list, index);
+        res = xtnt_node_set_read_unlock(list);
+    }
+    return res;
+}
+
+/**
+ * @brief Initialize a Node Set as a compact list
+ *
+ * @param[in] list The Node Set to initialize
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval result of `xtnt_clist_initialize_lock()`
+ */
+xtnt_status_t
+xtnt_clist_initialize(
+    struct xtnt_node_set *list)
+{
+    return xtnt_clist_initialize_lock(list, XTNT_SET_LOCK_MUTEX);
+}
+
+/**
+ * @brief Initialize a Node Set as a compact list with a locking policy
+ *
+ * @param[in] list The Node Set to initialize
+ * @param[in] policy The locking policy, see `xtnt_node_set_initialize_lock()`
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval result of `xtnt_node_set_initialize_lock()`
+ *
+ * @note The list installs `xtnt_clist_if` for the `xtnt_set_*` operations.
+ */
+xtnt_status_t
+xtnt_clist_initialize_lock(
+    struct xtnt_node_set *list,
+    xtnt_uint_t policy)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_initialize_lock(list, policy)) == XTNT_ESUCCESS) {
+        list->fn = &xtnt_clist_if;
+    }
+    return res;
+}
+
+/**
+ * @brief Insert a member at the head of a compact list
+ *
+ * @param[in] list The compact list to modify
+ * @param[in] node The member to insert
+ * @retval XTNT_ESUCCESS on success
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ */
+xtnt_status_t
+xtnt_clist_insert(
+    struct xtnt_node_set *list,
+    struct xtnt_cnode *node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_cnode *head = NULL;
+    if ((res = xtnt_node_set_write_lock(list)) == XTNT_ESUCCESS) {
+        head = (struct xtnt_cnode *) list->root.link[XTNT_NODE_HEAD];
+        node->link[XTNT_CNODE_HEAD] = NULL;
+        node->link[XTNT_CNODE_TAIL] = head;
+        if (head != NULL) {
+            head->link[XTNT_CNODE_HEAD] = node;
+        } else {
+            list->root.link[XTNT_NODE_TAIL] = (struct xtnt_node *) node;
+        }
+        list->root.link[XTNT_NODE_HEAD] = (struct xtnt_node *) node;
+        list->count++;
+        res = xtnt_node_set_write_unlock(list);
+    }
+    return res;
+}
+
+/**
+ * @brief Remove the newest member of a compact list
+ *
+ * @param[in] list The compact list to modify
+ * @param[out] node The member removed or NULL if the list is empty
+ * @retval XTNT_ESUCCESS on success
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ */
+xtnt_status_t
+xtnt_clist_pop(
+    struct xtnt_node_set *list,
+    struct xtnt_cnode **node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(list)) == XTNT_ESUCCESS) {
+        if ((*node = (struct xtnt_cnode *) list->root.link[XTNT_NODE_HEAD]) != NULL) {
+            xtnt_clist_unlink(list, *node);
+        }
+        res = xtnt_node_set_write_unlock(list);
+    }
+    return res;
+}
+
+/**
+ * @brief Remove a member from a compact list
+ *
+ * @param[in] list The compact list to modify
+ * @param[in] node The member to remove
+ * @retval XTNT_ESUCCESS on success
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @warning The node must be a member of the list, it is unlinked from its
+ * neighbours without a walk.
+ */
+xtnt_status_t
+xtnt_clist_remove(
+    struct xtnt_node_set *list,
+    struct xtnt_cnode *node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(list)) == XTNT_ESUCCESS) {
+        xtnt_clist_unlink(list, node);
+        res = xtnt_node_set_write_unlock(list);
+    }
+    return res;
+}
+
+/**
+ * @brief Search for a key in a compact list
+ *
+ * @param[in] list The compact list to read
+ * @param[in] key The key to match
+ * @param[out] found The newest member with the key or NULL
+ * @retval XTNT_ESUCCESS on success
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ *
+ * @note A XTNT_SET_LOCK_SEQLOCK list is read without locking while no
+ * writer interferes.
+ */
+xtnt_status_t
+xtnt_clist_search(
+    struct xtnt_node_set *list,
+    xtnt_uint_t key,
+    struct xtnt_cnode **found)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_uint_t sequence = XTNT_ZERO;
+    if (list->policy == XTNT_SET_LOCK_SEQLOCK) {
+        for (xtnt_uint_t retry = 0; retry < XTNT_SET_SEQLOCK_RETRY; retry++) {
+            sequence = xtnt_node_set_read_begin(list);
+            *found = xtnt_clist_find(list, key);
+            if (xtnt_node_set_read_validate(list, sequence)) {
+                return XTNT_ESUCCESS;
+            }
+        }
+    }
+    if ((res = xtnt_node_set_read_lock(list)) == XTNT_ESUCCESS) {
+        *found = xtnt_clist_find(list, key);
+        res = xtnt_node_set_read_unlock(list);
+    }
+    return res;
+}
+
+/**
+ * @brief Search a compact list with a test function
+ *
+ * @param[in] list The compact list to read
+ * @param[in] test_fn The test, returning 0 on match
+ * @param[in] ctx Context passed to the test
+ * @param[out] found The newest matching member or NULL
+ * @retval XTNT_ESUCCESS on success
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ *
+ * @remark The test has the signature:
+ *
+ * @code
+ * xtnt_uint_t callback(void *ctx, struct xtnt_cnode *node);
+ * @endcode
+ */
+xtnt_status_t
+xtnt_clist_search_fn(
+    struct xtnt_node_set *list,
+    void *test_fn,
+    void *ctx,
+    struct xtnt_cnode **found)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_uint_t (*test)(void *, struct xtnt_cnode *) = test_fn;
+    if ((res = xtnt_node_set_read_lock(list)) == XTNT_ESUCCESS) {
+        *found = (struct xtnt_cnode *) list->root.link[XTNT_NODE_HEAD];
+        while (*found != NULL && test(ctx, *found) != 0) {
+            *found = (*found)->link[XTNT_CNODE_TAIL];
+        }
+        res = xtnt_node_set_read_unlock(list);
+    }
+    return res;
+}
+
+static xtnt_status_t
+xtnt_clist_set_insert(
+    struct xtnt_node_set *list,
+    struct xtnt_node *node)
+{
+    return xtnt_clist_insert(list, (struct xtnt_cnode *) node);
+}
+
+static xtnt_status_t
+xtnt_clist_set_remove(
+    struct xtnt_node_set *list,
+    struct xtnt_node *node)
+{
+    return xtnt_clist_remove(list, (struct xtnt_cnode *) node);
+}
+
+/**
+ * @brief Compact list Node Set interface
+ *
+ * @note Only insert, push and remove are installed, they take compact nodes
+ * cast to `struct xtnt_node` and insert at the head. Every operation that
+ * returns or visits members is ENOTSUP, since generic code reads the fields
+ * of `struct xtnt_node` past the end of a compact node. Use the typed
+ * `xtnt_clist_*` functions to read the list.
+ */
+const struct xtnt_node_set_if xtnt_clist_if = {
+    .index = xtnt_node_set_enotsup_index,
+    .search = xtnt_node_set_enotsup_key,
+    .search_fn = xtnt_node_set_enotsup_search_fn,
+    .first = xtnt_node_set_enotsup_out,
+    .last = xtnt_node_set_enotsup_out,
+    .peek = xtnt_node_set_enotsup_out,
+    .root = xtnt_node_set_enotsup_out,
+    .state = xtnt_node_set_enotsup_state,
+    .insert = xtnt_clist_set_insert,
+    .insert_at = xtnt_node_set_enotsup_insert_at,
+    .push = xtnt_clist_set_insert,
+    .remove = xtnt_clist_set_remove,
+    .remove_at = xtnt_node_set_enotsup_key,
+    .pop = xtnt_node_set_enotsup_out,
+    .sort = xtnt_node_set_enotsup,
+    .sort_reverse = xtnt_node_set_enotsup,
+    .sort_fn = xtnt_node_set_enotsup_fn,
+    .grow = xtnt_node_set_enotsup,
+    .grow_eval = xtnt_node_set_enotsup_eval,
+    .shrink = xtnt_node_set_enotsup,
+    .shrink_eval = xtnt_node_set_enotsup_eval,
+    .next = xtnt_node_set_enotsup_next,
+    .seek = xtnt_node_set_enotsup_seek
+};
@@ -0,0 +1,803 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/set/list/skiplist.h>
+
+#define XTNT_SKIPLIST_HEAD(list) ((struct xtnt_skiplist_head *) (list)->root.link[XTNT_NODE_MIDDLE])
+
+/*
+ * A tower of forward links. The span of a level counts the members from the
+ * tower to the next one on that level, or to the end of the list. The key
+ * of the member is kept in the tower, so walks never read the member.
+ */
+struct xtnt_skiplist_tower {
+    struct xtnt_node *node;
+    xtnt_uint_t key;
+    xtnt_uint_t height;
+    struct xtnt_skiplist_level {
+        struct xtnt_skiplist_tower *next;
+        xtnt_uint_t span;
+    } level[];
+};
+
+/*
+ * The list's own tower of XTNT_SKIPLIST_LEVELS, the levels in use, the
+ * height generator, and the towers kept for reuse by height.
+ */
+struct xtnt_skiplist_head {
+    struct xtnt_skiplist_tower *tower;
+    xtnt_uint_t levels;
+    uint64_t seed;
+    struct xtnt_skiplist_tower *reuse[XTNT_SKIPLIST_LEVELS];
+};
+
+/**
+ * @brief Draw the height of a new tower
+ *
+ * @param[in] head The head of the list
+ * @return height from 1, each level a quarter as likely as the one below
+ */
+static xtnt_uint_t
+xtnt_skiplist_height(
+    struct xtnt_skiplist_head *head)
+{
+    xtnt_uint_t height = 1;
+    uint64_t bits = 0;
+    head->seed ^= head->seed << 13;
+    head->seed ^= head->seed >> 7;
+    head->seed ^= head->seed << 17;
+    for (bits = head->seed; height < XTNT_SKIPLIST_LEVELS && (bits & 3) == 0; bits >>= 2) {
+        height++;
+    }
+    return height;
+}
+
+/**
+ * @brief Allocate a tower, reusing a kept one of the same height
+ *
+ * @param[in] head The head of the list
+ * @param[in] height The levels of the tower
+ * @return tower or NULL
+ */
+static struct xtnt_skiplist_tower *
+xtnt_skiplist_tower_alloc(
+    struct xtnt_skiplist_head *head,
+    xtnt_uint_t height)
+{
+    struct xtnt_skiplist_tower *tower = head->reuse[height - 1];
+    if (tower != NULL) {
+        head->reuse[height - 1] = tower->level[0].next;
+        return tower;
+    }
+    tower = malloc(sizeof(struct xtnt_skiplist_tower) + sizeof(struct xtnt_skiplist_level) * height);
+    if (tower != NULL) {
+        tower->height = height;
+    }
+    return tower;
+}
+
+/**
+ * @brief Release the tower of a removed member
+ *
+ * @param[in] list The list, write locked
+ * @param[in] tower The tower
+ *
+ * @note Under XTNT_SET_LOCK_SEQLOCK the tower is kept for a member of the
+ * same height, so the links an optimistic reader follows stay towers with
+ * as many levels as it reads.
+ */
+static void
+xtnt_skiplist_tower_free(
+    struct xtnt_node_set *list,
+    struct xtnt_skiplist_tower *tower)
+{
+    struct xtnt_skiplist_head *head = XTNT_SKIPLIST_HEAD(list);
+    if (list->policy == XTNT_SET_LOCK_SEQLOCK) {
+        __atomic_store_n(&(tower->level[0].next), head->reuse[tower->height - 1], __ATOMIC_RELEASE);
+        head->reuse[tower->height - 1] = tower;
+    } else {
+        free(tower);
+    }
+}
+
+/**
+ * @brief Find the tower of the member with a key
+ *
+ * @param[in] list The list to read
+ * @param[in] key The key to find
+ * @param[out] index The index of the member, or NULL
+ * @return tower or NULL
+ *
+ * @note Links are loaded with acquire and the walk takes a bounded number
+ * of steps, so a reader racing a writer ends with a result to discard. Only
+ * towers are read, which are never freed while readers may run.
+ */
+static struct xtnt_skiplist_tower *
+xtnt_skiplist_find(
+    struct xtnt_node_set *list,
+    xtnt_uint_t key,
+    xtnt_uint_t *index)
+{
+    struct xtnt_skiplist_head *head = XTNT_SKIPLIST_HEAD(list);
+    struct xtnt_skiplist_tower *tower = head->tower;
+    struct xtnt_skiplist_tower *next = NULL;
+    xtnt_uint_t levels = head->levels;
+    xtnt_uint_t steps = (list->count + 1) * XTNT_SKIPLIST_LEVELS;
+    xtnt_uint_t rank = 0;
+    if (levels > XTNT_SKIPLIST_LEVELS) {
+        levels = XTNT_SKIPLIST_LEVELS;
+    }
+    while (levels-- > 0) {
+        while ((next = __atomic_load_n(&(tower->level[levels].next), __ATOMIC_ACQUIRE)) != NULL &&
+               next->key < key) {
+            rank += tower->level[levels].span;
+            tower = next;
+            if (--steps == 0) {
+                return NULL;
+            }
+        }
+    }
+    next = __atomic_load_n(&(tower->level[0].next), __ATOMIC_ACQUIRE);
+    if (next == NULL || next->key != key) {
+        return NULL;
+    }
+    if (index != NULL) {
+        *index = rank;
+    }
+    return next;
+}
+
+/**
+ * @brief Find the tower of the member at an index
+ *
+ * @param[in] list The list to read
+ * @param[in] index The index of the member
+ * @return tower or NULL
+ *
+ * @note Spans are summed down the levels, so the walk is O(log n) and
+ * bounded as `xtnt_skiplist_find()` is.
+ */
+static struct xtnt_skiplist_tower *
+xtnt_skiplist_at(
+    struct xtnt_node_set *list,
+    xtnt_uint_t index)
+{
+    struct xtnt_skiplist_head *head = XTNT_SKIPLIST_HEAD(list);
+    struct xtnt_skiplist_tower *tower = head->tower;
+    struct xtnt_skiplist_tower *next = NULL;
+    xtnt_uint_t levels = head->levels;
+    xtnt_uint_t steps = (list->count + 1) * XTNT_SKIPLIST_LEVELS;
+    xtnt_uint_t rank = 0;
+    if (index >= list->count) {
+        return NULL;
+    }
+    if (levels > XTNT_SKIPLIST_LEVELS) {
+        levels = XTNT_SKIPLIST_LEVELS;
+    }
+    // Members are ranked from 1, the head being rank 0
+    index++;
+    while (levels-- > 0) {
+        while ((next = __atomic_load_n(&(tower->level[levels].next), __ATOMIC_ACQUIRE)) != NULL &&
+               rank + tower->level[levels].span <= index) {
+            rank += tower->level[levels].span;
+            tower = next;
+            if (--steps == 0) {
+                return NULL;
+            }
+        }
+        if (rank == index) {
+            return tower;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Collect the last tower before a member on every level
+ *
+ * @param[in] list The list, write locked
+ * @param[in] key The key of the member, used when `index` is XTNT_UINT_MAX
+ * @param[in] index The index of the member
+ * @param[out] update The last tower before the member on each level
+ * @param[out] rank The rank of each tower in `update`, or NULL
+ * @return tower following update[0]
+ */
+static struct xtnt_skiplist_tower *
+xtnt_skiplist_path(
+    struct xtnt_node_set *list,
+    xtnt_uint_t key,
+    xtnt_uint_t index,
+    struct xtnt_skiplist_tower **update,
+    xtnt_uint_t *rank)
+{
+    struct xtnt_skiplist_head *head = XTNT_SKIPLIST_HEAD(list);
+    struct xtnt_skiplist_tower *tower = head->tower;
+    struct xtnt_skiplist_tower *next = NULL;
+    xtnt_uint_t traversed = 0;
+    for (xtnt_uint_t level = head->levels; level-- > 0;) {
+        while ((next = tower->level[level].next) != NULL &&
+               ((index == XTNT_UINT_MAX) ? next->key < key :
+                traversed + tower->level[level].span <= index)) {
+            traversed += tower->level[level].span;
+            tower = next;
+        }
+        update[level] = tower;
+        if (rank != NULL) {
+            rank[level] = traversed;
+        }
+    }
+    return tower->level[0].next;
+}
+
+/**
+ * @brief Unlink a member's tower from every level
+ *
+ * @param[in] list The list, write locked
+ * @param[in] update The last tower before the member on each level
+ * @param[in] tower The member's tower
+ */
+static void
+xtnt_skiplist_unlink(
+    struct xtnt_node_set *list,
+    struct xtnt_skiplist_tower **update,
+    struct xtnt_skiplist_tower *tower)
+{
+    struct xtnt_skiplist_head *head = XTNT_SKIPLIST_HEAD(list);
+    struct xtnt_node *node = tower->node;
+    for (xtnt_uint_t level = 0; level < head->levels; level++) {
+        if (update[level]->level[level].next == tower) {
+            update[level]->level[level].span += tower->level[level].span - 1;
+            __atomic_store_n(&(update[level]->level[level].next), tower->level[level].next, __ATOMIC_RELEASE);
+        } else {
+            update[level]->level[level].span--;
+        }
+    }
+    if (node->link[XTNT_NODE_HEAD] != NULL) {
+        node->link[XTNT_NODE_HEAD]->link[XTNT_NODE_TAIL] = node->link[XTNT_NODE_TAIL];
+    } else {
+        list->root.link[XTNT_NODE_HEAD] = node->link[XTNT_NODE_TAIL];
+    }
+    if (node->link[XTNT_NODE_TAIL] != NULL) {
+        node->link[XTNT_NODE_TAIL]->link[XTNT_NODE_HEAD] = node->link[XTNT_NODE_HEAD];
+    } else {
+        list->root.link[XTNT_NODE_TAIL] = node->link[XTNT_NODE_HEAD];
+    }
+    while (head->levels > 1 && head->tower->level[head->levels - 1].next == NULL) {
+        head->levels--;
+    }
+    node->link[XTNT_NODE_MIDDLE] = NULL;
+    list->count--;
+    xtnt_skiplist_tower_free(list, tower);
+}
+
+/**
+ * @brief Delete the member at an index
+ *
+ * @param[in] list The list to delete from
+ * @param[in] index The index of the member
+ * @param[out] deleted The member deleted or NULL for an invalid index
+ * @retval XTNT_ESUCCESS on delete or invalid index
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ */
+xtnt_status_t
+xtnt_skiplist_delete(
+    struct xtnt_node_set *list,
+    xtnt_uint_t index,
+    struct xtnt_node **deleted)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_skiplist_tower *update[XTNT_SKIPLIST_LEVELS];
+    struct xtnt_skiplist_tower *tower = NULL;
+    *deleted = NULL;
+    if ((res = xtnt_node_set_write_lock(list)) == XTNT_ESUCCESS) {
+        if (index < list->count) {
+            tower = xtnt_skiplist_path(list, XTNT_ZERO, index, update, NULL);
+            *deleted = tower->node;
+            xtnt_skiplist_unlink(list, update, tower);
+        }
+        res = xtnt_node_set_write_unlock(list);
+    }
+    return res;
+}
+
+/**
+ * @brief Get the member at an index
+ *
+ * @param[in] list The list to read
+ * @param[in] index The index of the member, by ascending key
+ * @param[out] node The member or NULL for an invalid index
+ * @retval XTNT_ESUCCESS on read
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ *
+ * @note A XTNT_SET_LOCK_SEQLOCK list is read without locking while no
+ * writer interferes.
+ */
+xtnt_status_t
+xtnt_skiplist_get(
+    struct xtnt_node_set *list,
+    xtnt_uint_t index,
+    struct xtnt_node **node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_uint_t sequence = XTNT_ZERO;
+    struct xtnt_skiplist_tower *tower = NULL;
+    struct xtnt_node *member = NULL;
+    if (list->policy == XTNT_SET_LOCK_SEQLOCK) {
+        for (xtnt_uint_t retry = 0; retry < XTNT_SET_SEQLOCK_RETRY; retry++) {
+            sequence = xtnt_node_set_read_begin(list);
+            tower = xtnt_skiplist_at(list, index);
+            member = (tower != NULL) ? tower->node : NULL;
+            if (xtnt_node_set_read_validate(list, sequence)) {
+                *node = member;
+                return XTNT_ESUCCESS;
+            }
+        }
+    }
+    if ((res = xtnt_node_set_read_lock(list)) == XTNT_ESUCCESS) {
+        tower = xtnt_skiplist_at(list, index);
+        *node = (tower != NULL) ? tower->node : NULL;
+        res = xtnt_node_set_read_unlock(list);
+    }
+    return res;
+}
+
+/**
+ * @brief Initialize a Node Set as an indexed skip list
+ *
+ * @param[in] list The Node Set to initialize
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval result of `xtnt_skiplist_initialize_lock()`
+ */
+xtnt_status_t
+xtnt_skiplist_initialize(
+    struct xtnt_node_set *list)
+{
+    return xtnt_skiplist_initialize_lock(list, XTNT_SET_LOCK_MUTEX);
+}
+
+/**
+ * @brief Initialize a Node Set as an indexed skip list with a locking policy
+ *
+ * @param[in] list The Node Set to initialize
+ * @param[in] policy The locking policy, see `xtnt_node_set_initialize_lock()`
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval ENOMEM when the list's tower can not be allocated
+ * @retval result of `xtnt_node_set_initialize_lock()`
+ *
+ * @note Release the list with `xtnt_skiplist_uninitialize()`, which frees
+ * the towers.
+ */
+xtnt_status_t
+xtnt_skiplist_initialize_lock(
+    struct xtnt_node_set *list,
+    xtnt_uint_t policy)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_skiplist_head *head = NULL;
+    if ((res = xtnt_node_set_initialize_lock(list, policy)) != XTNT_ESUCCESS) {
+        return res;
+    }
+    if ((head = calloc(1, sizeof(struct xtnt_skiplist_head))) == NULL ||
+        (head->tower = calloc(1, sizeof(struct xtnt_skiplist_tower) +
+                                 sizeof(struct xtnt_skiplist_level) * XTNT_SKIPLIST_LEVELS)) == NULL) {
+        free(head);
+        xtnt_node_set_uninitialize(list);
+        return ENOMEM;
+    }
+    head->tower->height = XTNT_SKIPLIST_LEVELS;
+    head->levels = 1;
+    head->seed = (uint64_t) (uintptr_t) head ^ 0x9e3779b97f4a7c15ULL;
+    list->root.link[XTNT_NODE_MIDDLE] = (struct xtnt_node *) head;
+    list->fn = &xtnt_skiplist_if;
+    return res;
+}
+
+/**
+ * @brief Insert a node in key order
+ *
+ * @param[in] list The list to insert into
+ * @param[in] node The node to insert
+ * @retval XTNT_ESUCCESS on insert
+ * @retval EEXIST when a node with the same key is a member
+ * @retval ENOMEM when the node's tower can not be allocated
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note A new tower is filled before it is linked, lowest level first, so
+ * an optimistic reader only reaches complete towers.
+ */
+xtnt_status_t
+xtnt_skiplist_insert(
+    struct xtnt_node_set *list,
+    struct xtnt_node *node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    struct xtnt_skiplist_head *head = XTNT_SKIPLIST_HEAD(list);
+    struct xtnt_skiplist_tower *update[XTNT_SKIPLIST_LEVELS];
+    struct xtnt_skiplist_tower *tower = NULL;
+    struct xtnt_skiplist_tower *next = NULL;
+    xtnt_uint_t rank[XTNT_SKIPLIST_LEVELS];
+    xtnt_uint_t height = 0;
+    xtnt_uint_t level = 0;
+    if ((res = xtnt_node_set_write_lock(list)) != XTNT_ESUCCESS) {
+        return res;
+    }
+    next = xtnt_skiplist_path(list, node->key, XTNT_UINT_MAX, update, rank);
+    if (next != NULL && next->key == node->key) {
+        res = EEXIST;
+    } else if ((tower = xtnt_skiplist_tower_alloc(head, (height = xtnt_skiplist_height(head)))) == NULL) {
+        res = ENOMEM;
+    } else {
+        for (level = head->levels; level < height; level++) {
+            update[level] = head->tower;
+            rank[level] = 0;
+            head->tower->level[level].span = list->count;
+        }
+        tower->node = node;
+        tower->key = node->key;
+        for (level = 0; level < height; level++) {
+            tower->level[level].next = update[level]->level[level].next;
+            tower->level[level].span = update[level]->level[level].span - (rank[0] - rank[level]);
+        }
+        node->link[XTNT_NODE_MIDDLE] = (struct xtnt_node *) tower;
+        node->link[XTNT_NODE_HEAD] = (update[0] == head->tower) ? NULL : update[0]->node;
+        node->link[XTNT_NODE_TAIL] = (next != NULL) ? next->node : NULL;
+        if (node->link[XTNT_NODE_HEAD] != NULL) {
+            node->link[XTNT_NODE_HEAD]->link[XTNT_NODE_TAIL] = node;
+        } else {
+            list->root.link[XTNT_NODE_HEAD] = node;
+        }
+        if (node->link[XTNT_NODE_TAIL] != NULL) {
+            node->link[XTNT_NODE_TAIL]->link[XTNT_NODE_HEAD] = node;
+        } else {
+            list->root.link[XTNT_NODE_TAIL] = node;
+        }
+        for (level = 0; level < height; level++) {
+            update[level]->level[level].span = rank[0] - rank[level] + 1;
+            __atomic_store_n(&(update[level]->level[level].next), tower, __ATOMIC_RELEASE);
+        }
+        for (; level < head->levels; level++) {
+            update[level]->level[level].span++;
+        }
+        if (height > head->levels) {
+            head->levels = height;
+        }
+        list->count++;
+    }
+    if ((unlock = xtnt_node_set_write_unlock(list)) != XTNT_ESUCCESS) {
+        res = unlock;
+    }
+    return res;
+}
+
+/**
+ * @brief Find the index of the member with a key
+ *
+ * @param[in] list The list to read
+ * @param[in] key The key to find
+ * @param[out] index The index of the member, unchanged when not found
+ * @retval XTNT_ESUCCESS on found
+ * @retval ENOENT when no member has the key
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ */
+xtnt_status_t
+xtnt_skiplist_rank(
+    struct xtnt_node_set *list,
+    xtnt_uint_t key,
+    xtnt_uint_t *index)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    xtnt_uint_t sequence = XTNT_ZERO;
+    xtnt_uint_t rank = XTNT_ZERO;
+    if (list->policy == XTNT_SET_LOCK_SEQLOCK) {
+        for (xtnt_uint_t retry = 0; retry < XTNT_SET_SEQLOCK_RETRY; retry++) {
+            sequence = xtnt_node_set_read_begin(list);
+            res = (xtnt_skiplist_find(list, key, &rank) != NULL) ? XTNT_ESUCCESS : ENOENT;
+            if (xtnt_node_set_read_validate(list, sequence)) {
+                if (res == XTNT_ESUCCESS) {
+                    *index = rank;
+                }
+                return res;
+            }
+        }
+    }
+    if ((res = xtnt_node_set_read_lock(list)) == XTNT_ESUCCESS) {
+        res = (xtnt_skiplist_find(list, key, index) != NULL) ? XTNT_ESUCCESS : ENOENT;
+        if ((unlock = xtnt_node_set_read_unlock(list)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Remove the member with a key
+ *
+ * @param[in] list The list to remove from
+ * @param[in] key The key of the member
+ * @param[out] removed The member removed or NULL if not found
+ * @retval XTNT_ESUCCESS on remove or key not found
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ */
+xtnt_status_t
+xtnt_skiplist_remove(
+    struct xtnt_node_set *list,
+    xtnt_uint_t key,
+    struct xtnt_node **removed)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_skiplist_tower *update[XTNT_SKIPLIST_LEVELS];
+    struct xtnt_skiplist_tower *tower = NULL;
+    *removed = NULL;
+    if ((res = xtnt_node_set_write_lock(list)) == XTNT_ESUCCESS) {
+        tower = xtnt_skiplist_path(list, key, XTNT_UINT_MAX, update, NULL);
+        if (tower != NULL && tower->key == key) {
+            *removed = tower->node;
+            xtnt_skiplist_unlink(list, update, tower);
+        }
+        res = xtnt_node_set_write_unlock(list);
+    }
+    return res;
+}
+
+/**
+ * @brief Search for the member with a key
+ *
+ * @param[in] list The list to read
+ * @param[in] key The key to find
+ * @param[out] found The member or NULL
+ * @retval XTNT_ESUCCESS on read
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ *
+ * @note A XTNT_SET_LOCK_SEQLOCK list is read without locking while no
+ * writer interferes.
+ */
+xtnt_status_t
+xtnt_skiplist_search(
+    struct xtnt_node_set *list,
+    xtnt_uint_t key,
+    struct xtnt_node **found)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_uint_t sequence = XTNT_ZERO;
+    struct xtnt_skiplist_tower *tower = NULL;
+    struct xtnt_node *member = NULL;
+    if (list->policy == XTNT_SET_LOCK_SEQLOCK) {
+        for (xtnt_uint_t retry = 0; retry < XTNT_SET_SEQLOCK_RETRY; retry++) {
+            sequence = xtnt_node_set_read_begin(list);
+            tower = xtnt_skiplist_find(list, key, NULL);
+            member = (tower != NULL) ? tower->node : NULL;
+            if (xtnt_node_set_read_validate(list, sequence)) {
+                *found = member;
+                return XTNT_ESUCCESS;
+            }
+        }
+    }
+    if ((res = xtnt_node_set_read_lock(list)) == XTNT_ESUCCESS) {
+        tower = xtnt_skiplist_find(list, key, NULL);
+        *found = (tower != NULL) ? tower->node : NULL;
+        res = xtnt_node_set_read_unlock(list);
+    }
+    return res;
+}
+
+/**
+ * @brief Search the members in key order for one matched by function
+ *
+ * @param[in] list The list to read
+ * @param[in] test_fn The test function to call on each member
+ * @param[in] ctx Context passed into the test function
+ * @param[out] found The first member matched or NULL
+ * @retval XTNT_ESUCCESS on read
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ *
+ * @remark The test returns non-zero on match, as `xtnt_list_search_fn()`.
+ */
+xtnt_status_t
+xtnt_skiplist_search_fn(
+    struct xtnt_node_set *list,
+    void *test_fn,
+    void *ctx,
+    struct xtnt_node **found)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_uint_t (*test)(void *, struct xtnt_node *) = test_fn;
+    if ((res = xtnt_node_set_read_lock(list)) == XTNT_ESUCCESS) {
+        for (*found = list->root.link[XTNT_NODE_HEAD]; *found != NULL;
+             *found = (*found)->link[XTNT_NODE_TAIL]) {
+            if (test(ctx, *found) != 0) {
+                break;
+            }
+        }
+        res = xtnt_node_set_read_unlock(list);
+    }
+    return res;
+}
+
+/**
+ * @brief Uninitialize a skip list, releasing its towers
+ *
+ * @param[in] list The list to uninitialize
+ * @retval result of `xtnt_node_set_uninitialize()`
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note Member nodes are owned by the caller and are not released.
+ */
+xtnt_status_t
+xtnt_skiplist_uninitialize(
+    struct xtnt_node_set *list)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_skiplist_head *head = XTNT_SKIPLIST_HEAD(list);
+    struct xtnt_skiplist_tower *tower = NULL;
+    struct xtnt_skiplist_tower *next = NULL;
+    if ((res = xtnt_node_set_write_lock(list)) == XTNT_ESUCCESS) {
+        for (tower = head->tower->level[0].next; tower != NULL; tower = next) {
+            next = tower->level[0].next;
+            tower->node->link[XTNT_NODE_MIDDLE] = NULL;
+            free(tower);
+        }
+        for (xtnt_uint_t height = 0; height < XTNT_SKIPLIST_LEVELS; height++) {
+            for (tower = head->reuse[height]; tower != NULL; tower = next) {
+                next = tower->level[0].next;
+                free(tower);
+            }
+        }
+        free(head->tower);
+        free(head);
+        list->root.link[XTNT_NODE_HEAD] = NULL;
+        list->root.link[XTNT_NODE_MIDDLE] = NULL;
+        list->root.link[XTNT_NODE_TAIL] = NULL;
+        list->count = XTNT_ZERO;
+        if ((res = xtnt_node_set_write_unlock(list)) == XTNT_ESUCCESS) {
+            res = xtnt_node_set_uninitialize(list);
+        }
+    }
+    return res;
+}
+
+static xtnt_status_t
+xtnt_skiplist_index(
+    struct xtnt_node_set *list,
+    xtnt_int_t index,
+    struct xtnt_node **node)
+{
+    if (index < 0) {
+        return EINVAL;
+    }
+    return xtnt_skiplist_get(list, (xtnt_uint_t) index, node);
+}
+
+static xtnt_status_t
+xtnt_skiplist_first(
+    struct xtnt_node_set *list,
+    struct xtnt_node **first)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_read_lock(list)) == XTNT_ESUCCESS) {
+        *first = list->root.link[XTNT_NODE_HEAD];
+        res = xtnt_node_set_read_unlock(list);
+    }
+    return res;
+}
+
+static xtnt_status_t
+xtnt_skiplist_last(
+    struct xtnt_node_set *list,
+    struct xtnt_node **last)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_read_lock(list)) == XTNT_ESUCCESS) {
+        *last = list->root.link[XTNT_NODE_TAIL];
+        res = xtnt_node_set_read_unlock(list);
+    }
+    return res;
+}
+
+static xtnt_status_t
+xtnt_skiplist_remove_node(
+    struct xtnt_node_set *list,
+    struct xtnt_node *node)
+{
+    struct xtnt_node *removed = NULL;
+    return xtnt_skiplist_remove(list, node->key, &removed);
+}
+
+static xtnt_status_t
+xtnt_skiplist_next(
+    struct xtnt_node_set *list,
+    struct xtnt_set_iter *iter,
+    struct xtnt_node **node)
+{
+    *node = (iter->node == NULL) ? list->root.link[XTNT_NODE_HEAD] : iter->node->link[XTNT_NODE_TAIL];
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Place a cursor before the least member with key or greater
+ *
+ * @param[in] list The list, read locked
+ * @param[in] iter The cursor
+ * @param[in] key The least key to visit
+ * @retval XTNT_ESUCCESS on seek
+ *
+ * @note The towers are walked down as for an insert of key, O(log n).
+ */
+static xtnt_status_t
+xtnt_skiplist_seek(
+    struct xtnt_node_set *list,
+    struct xtnt_set_iter *iter,
+    xtnt_uint_t key)
+{
+    struct xtnt_skiplist_tower *update[XTNT_SKIPLIST_LEVELS];
+    xtnt_skiplist_path(list, key, XTNT_UINT_MAX, update, NULL);
+    iter->node = (update[0] == XTNT_SKIPLIST_HEAD(list)->tower) ? NULL : update[0]->node;
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Skip List Node Set interface
+ *
+ * @note first is the least key, last the greatest. Members are placed by
+ * key, so insert_at and push are not supported.
+ */
+const struct xtnt_node_set_if xtnt_skiplist_if = {
+    .index = xtnt_skiplist_index,
+    .search = xtnt_skiplist_search,
+    .search_fn = xtnt_skiplist_search_fn,
+    .first = xtnt_skiplist_first,
+    .last = xtnt_skiplist_last,
+    .peek = xtnt_node_set_enotsup_out,
+    .root = xtnt_node_set_enotsup_out,
+    .state = xtnt_node_set_enotsup_state,
+    .insert = xtnt_skiplist_insert,
+    .insert_at = xtnt_node_set_enotsup_insert_at,
+    .push = xtnt_node_set_enotsup_node,
+    .remove = xtnt_skiplist_remove_node,
+    .remove_at = xtnt_skiplist_delete,
+    .pop = xtnt_node_set_enotsup_out,
+    .sort = xtnt_node_set_enotsup,
+    .sort_reverse = xtnt_node_set_enotsup,
+    .sort_fn = xtnt_node_set_enotsup_fn,
+    .grow = xtnt_node_set_enotsup,
+    .grow_eval = xtnt_node_set_enotsup_eval,
+    .shrink = xtnt_node_set_enotsup,
+    .shrink_eval = xtnt_node_set_enotsup_eval,
+    .next = xtnt_skiplist_next,
+    .seek = xtnt_skiplist_seek
+};
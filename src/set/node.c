@@ -29,6 +29,131 @@ SOFTWARE.
 
 #include <extant/set/common.h>
 
+/**
+ * @brief Initialize a compact node
+ *
+ * @param[in] node Compact node to initialize
+ * @param[in] key Key to set for the node
+ * @param[in] value Node value pointer
+ * @retval XTNT_ESUCCESS always
+ */
+xtnt_status_t
+xtnt_cnode_initialize(
+    struct xtnt_cnode *node,
+    xtnt_uint_t key,
+    void *value)
+{
+    node->link[XTNT_CNODE_HEAD] = NULL;
+    node->link[XTNT_CNODE_TAIL] = NULL;
+    node->key = key;
+    node->value = value;
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Back link a chain of nodes and find its last node
+ *
+ * @param[in] head The first node of a chain linked through
+ * link[XTNT_NODE_HEAD] and ending with NULL, or NULL
+ * @param[out] tail The last node of the chain or NULL
+ * @param[out] count The number of nodes in the chain
+ * @retval XTNT_ESUCCESS always
+ *
+ * @note Each link[XTNT_NODE_TAIL] is set to the node before it, so the chain
+ * has the shape a run of pushes onto a list, queue or stack leaves behind.
+ * This is the walk the bulk operations do before they take a lock.
+ */
+xtnt_status_t
+xtnt_node_chain(
+    struct xtnt_node *head,
+    struct xtnt_node **tail,
+    xtnt_uint_t *count)
+{
+    struct xtnt_node *prev = NULL;
+    *count = XTNT_ZERO;
+    for (struct xtnt_node *node = head; node != NULL; node = node->link[XTNT_NODE_HEAD]) {
+        node->link[XTNT_NODE_TAIL] = prev;
+        prev = node;
+        (*count)++;
+    }
+    *tail = prev;
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Link a table of nodes into a chain
+ *
+ * @param[in] nodes The nodes in chain order
+ * @param[in] count The number of nodes
+ * @param[out] head The first node of the chain or NULL
+ * @param[out] tail The last node of the chain or NULL
+ * @retval XTNT_ESUCCESS on link
+ * @retval EINVAL on a NULL node
+ *
+ * @note The chain runs through link[XTNT_NODE_HEAD] and ends with NULL, with
+ * back links as `xtnt_node_chain()` sets them.
+ */
+xtnt_status_t
+xtnt_node_chain_table(
+    struct xtnt_node **nodes,
+    xtnt_uint_t count,
+    struct xtnt_node **head,
+    struct xtnt_node **tail)
+{
+    struct xtnt_node *prev = NULL;
+    *head = *tail = NULL;
+    for (xtnt_uint_t idx = 0; idx < count; idx++) {
+        if (nodes[idx] == NULL) {
+            return EINVAL;
+        }
+    }
+    for (xtnt_uint_t idx = 0; idx < count; idx++) {
+        nodes[idx]->link[XTNT_NODE_TAIL] = prev;
+        if (prev != NULL) {
+            prev->link[XTNT_NODE_HEAD] = nodes[idx];
+        }
+        prev = nodes[idx];
+    }
+    if (prev != NULL) {
+        prev->link[XTNT_NODE_HEAD] = NULL;
+        *head = nodes[0];
+        *tail = prev;
+    }
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Order two nodes by ascending key
+ *
+ * @param[in] a The first node
+ * @param[in] b The second node
+ * @return -1, 0 or 1 as the key of `a` is less than, equal to or greater
+ * than the key of `b`
+ */
+xtnt_int_t
+xtnt_node_compare_key(
+    const struct xtnt_node *a,
+    const struct xtnt_node *b)
+{
+    return (a->key > b->key) - (a->key < b->key);
+}
+
+/**
+ * @brief Order two nodes by descending key
+ *
+ * @param[in] a The first node
+ * @param[in] b The second node
+ * @return -1, 0 or 1 as the key of `a` is greater than, equal to or less
+ * than the key of `b`
+ */
+xtnt_int_t
+xtnt_node_compare_key_reverse(
+    const struct xtnt_node *a,
+    const struct xtnt_node *b)
+{
+    return (a->key < b->key) - (a->key > b->key);
+}
+
 /**
  * @brief Initialize a node with empty values
  *
@@ -29,99 +29,361 @@ SOFTWARE.
 
 #include <extant/set/queue.h>
 
+extern inline void
+xtnt_queue_mpsc_link(
+    struct xtnt_node_set *queue,
+    struct xtnt_node *node);
+
+extern inline struct xtnt_node *
+xtnt_queue_locked_pop(
+    struct xtnt_node_set *queue);
+
+extern inline xtnt_status_t
+xtnt_queue_peek(
+    struct xtnt_node_set *queue,
+    struct xtnt_node **node);
+
+extern inline xtnt_status_t
+xtnt_queue_pop(
+    struct xtnt_node_set *queue,
+    struct xtnt_node **node);
+
+extern inline xtnt_status_t
+xtnt_queue_push(
+    struct xtnt_node_set *queue,
+    struct xtnt_node *node);
+
 /**
- * @brief Peek at the next entry in a queue
+ * @brief Add a back linked chain to the queue
+ *
+ * @param[in] queue The `xtnt_node_set` to operate on
+ * @param[in] head The oldest node of the chain
+ * @param[in] tail The newest node of the chain
+ * @param[in] count The number of nodes in the chain
+ * @retval XTNT_ESUCCESS on successful push
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
  *
- * @param[in] queue The xtnt_node_set to operate on
- * @param[out] node The xtnt_node or NULL if queue is empty
- * @retval XTNT_ESUCCESS on successful peek
- * @retval return value of `pthread_mutex_lock()` or `pthread_mutex_unlock()`
- * calls.
+ * @note In XTNT_QUEUE_MODE_MPSC the chain is published with one exchange of
+ * the producer end, the consumer sees the inner links once it sees the head.
  */
-xtnt_status_t
-xtnt_queue_peek(
+static xtnt_status_t
+xtnt_queue_splice(
     struct xtnt_node_set *queue,
-    struct xtnt_node **node)
+    struct xtnt_node *head,
+    struct xtnt_node *tail,
+    xtnt_uint_t count)
 {
     xtnt_status_t res = XTNT_EFAILURE;
-    if ((res = pthread_mutex_lock(&(queue->lock))) == XTNT_ESUCCESS) {
-        if (queue->root.link[XTNT_NODE_TAIL] != NULL) {
-            *node = queue->root.link[XTNT_NODE_TAIL];
-        }
-        if ((res = pthread_mutex_unlock(&(queue->lock))) != XTNT_ESUCCESS) {
-            XTNT_LOCK_SET_UNLOCK_FAIL(queue->root.state);
+    struct xtnt_node *prev = NULL;
+    if (count == 0) {
+        return XTNT_ESUCCESS;
+    }
+    if (XTNT_MODE(queue->root.state) == XTNT_QUEUE_MODE_MPSC) {
+        __atomic_add_fetch(&(queue->count), count, __ATOMIC_RELAXED);
+        __atomic_store_n(&(tail->link[XTNT_NODE_HEAD]), NULL, __ATOMIC_RELAXED);
+        prev = __atomic_exchange_n(&(queue->root.link[XTNT_NODE_MIDDLE]), tail, __ATOMIC_ACQ_REL);
+        __atomic_store_n(&(prev->link[XTNT_NODE_HEAD]), head, __ATOMIC_RELEASE);
+        return XTNT_ESUCCESS;
+    }
+    if ((res = xtnt_node_set_write_lock(queue)) == XTNT_ESUCCESS) {
+        if (queue->root.link[XTNT_NODE_HEAD] != NULL) {
+            queue->root.link[XTNT_NODE_HEAD]->link[XTNT_NODE_HEAD] = head;
+            head->link[XTNT_NODE_TAIL] = queue->root.link[XTNT_NODE_HEAD];
+        } else {
+            queue->root.link[XTNT_NODE_TAIL] = head;
         }
-    } else {
-        XTNT_LOCK_SET_LOCK_FAIL(queue->root.state);
+        queue->root.link[XTNT_NODE_HEAD] = tail;
+        queue->count += count;
+        res = xtnt_node_set_write_unlock(queue);
     }
     return res;
 }
 
 /**
- * @brief Remove the next entry in the queue
+ * @brief Remove the next entry from an MPSC queue
  *
  * @param[in] queue The `xtnt_node_set` to operate on
- * @param[out] node The xtnt_node or NULL if queue is empty
- * @retval XTNT_ESUCCESS on successful pop
- * @retval return value of `pthread_mutex_lock()` or `pthread_mutex_unlock()`
+ * @return the oldest node, or NULL if empty
+ *
+ * @note Only the single consumer may call this. NULL is also returned while
+ * a producer is between claiming the producer end and linking its node, the
+ * count of the queue still includes that node.
+ */
+struct xtnt_node *
+xtnt_queue_mpsc_pop(
+    struct xtnt_node_set *queue)
+{
+    struct xtnt_node *stub = &(queue->root);
+    struct xtnt_node *tail = queue->root.link[XTNT_NODE_TAIL];
+    struct xtnt_node *next = __atomic_load_n(&(tail->link[XTNT_NODE_HEAD]), __ATOMIC_ACQUIRE);
+    if (tail == stub) {
+        if (next == NULL) {
+            return NULL;
+        }
+        queue->root.link[XTNT_NODE_TAIL] = tail = next;
+        next = __atomic_load_n(&(next->link[XTNT_NODE_HEAD]), __ATOMIC_ACQUIRE);
+    }
+    if (next == NULL) {
+        if (tail != __atomic_load_n(&(queue->root.link[XTNT_NODE_MIDDLE]), __ATOMIC_ACQUIRE)) {
+            return NULL;
+        }
+        // Last node, requeue the stub behind it so the node can be released
+        xtnt_queue_mpsc_link(queue, stub);
+        if ((next = __atomic_load_n(&(tail->link[XTNT_NODE_HEAD]), __ATOMIC_ACQUIRE)) == NULL) {
+            return NULL;
+        }
+    }
+    queue->root.link[XTNT_NODE_TAIL] = next;
+    tail->link[XTNT_NODE_HEAD] = NULL;
+    __atomic_sub_fetch(&(queue->count), 1, __ATOMIC_RELAXED);
+    return tail;
+}
+
+/**
+ * @brief Detach every entry of the queue as one chain
+ *
+ * @param[in] queue The `xtnt_node_set` to operate on
+ * @param[out] head The oldest xtnt_node or NULL if queue is empty
+ * @retval XTNT_ESUCCESS on successful drain
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note The chain runs from the oldest node to the newest through
+ * link[XTNT_NODE_HEAD], ending with NULL. A locked queue is detached in
+ * one critical section regardless of length.
+ *
+ * @note In XTNT_QUEUE_MODE_MPSC only the consumer may drain. There the stub
+ * node may sit anywhere in the chain, so the consumer unlinks the nodes one
+ * at a time without locking, ending at the newest node that is fully linked.
  */
 xtnt_status_t
-xtnt_queue_pop(
+xtnt_queue_drain(
     struct xtnt_node_set *queue,
-    struct xtnt_node **node)
+    struct xtnt_node **head)
 {
     xtnt_status_t res = XTNT_EFAILURE;
-    if ((res = pthread_mutex_lock(&(queue->lock))) == XTNT_ESUCCESS) {
-        *node = queue->root.link[XTNT_NODE_TAIL];
-        if (*node != NULL) {
-            if ((uintptr_t) queue->root.link[XTNT_NODE_HEAD] ^
-                (uintptr_t) queue->root.link[XTNT_NODE_TAIL]) {
-                (*node)->link[XTNT_NODE_HEAD]->link[XTNT_NODE_TAIL] = NULL;
-                queue->root.link[XTNT_NODE_TAIL] = (*node)->link[XTNT_NODE_HEAD];
+    struct xtnt_node *node = NULL;
+    struct xtnt_node *last = NULL;
+    if (XTNT_MODE(queue->root.state) == XTNT_QUEUE_MODE_MPSC) {
+        *head = NULL;
+        while ((node = xtnt_queue_mpsc_pop(queue)) != NULL) {
+            if (last != NULL) {
+                last->link[XTNT_NODE_HEAD] = node;
             } else {
-                queue->root.link[XTNT_NODE_TAIL] = NULL;
-                queue->root.link[XTNT_NODE_HEAD] = NULL;
+                *head = node;
             }
-            queue->count--;
+            last = node;
         }
-        if ((res = pthread_mutex_unlock(&(queue->lock))) == XTNT_ESUCCESS) {
-            XTNT_LOCK_SET_UNLOCK_FAIL(queue->root.state);
+        return XTNT_ESUCCESS;
+    }
+    if ((res = xtnt_node_set_write_lock(queue)) == XTNT_ESUCCESS) {
+        *head = queue->root.link[XTNT_NODE_TAIL];
+        if (*head != NULL) {
+            queue->root.link[XTNT_NODE_HEAD]->link[XTNT_NODE_HEAD] = NULL;
+            queue->root.link[XTNT_NODE_TAIL] = NULL;
+            queue->root.link[XTNT_NODE_HEAD] = NULL;
+            queue->count = XTNT_ZERO;
         }
-    } else {
-        XTNT_LOCK_SET_LOCK_FAIL(queue->root.state);
+        res = xtnt_node_set_write_unlock(queue);
+    }
+    return res;
+}
+
+/**
+ * @brief Initialize a Node Set as a queue
+ *
+ * @param[in] queue The Node Set to initialize
+ * @param[in] mode XTNT_QUEUE_MODE_LOCKED or XTNT_QUEUE_MODE_MPSC
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval result of `xtnt_queue_initialize_lock()`
+ */
+xtnt_status_t
+xtnt_queue_initialize(
+    struct xtnt_node_set *queue,
+    xtnt_uint_t mode)
+{
+    return xtnt_queue_initialize_lock(queue, mode, XTNT_SET_LOCK_MUTEX);
+}
+
+/**
+ * @brief Initialize a Node Set as a queue with a locking policy
+ *
+ * @param[in] queue The Node Set to initialize
+ * @param[in] mode XTNT_QUEUE_MODE_LOCKED or XTNT_QUEUE_MODE_MPSC
+ * @param[in] policy The locking policy, see `xtnt_node_set_initialize_lock()`
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval result of `xtnt_node_set_initialize_lock()`
+ *
+ * @note The queue installs `xtnt_queue_if` for the `xtnt_set_*` operations.
+ * An XTNT_QUEUE_MODE_MPSC queue only takes the lock to drain and peek.
+ */
+xtnt_status_t
+xtnt_queue_initialize_lock(
+    struct xtnt_node_set *queue,
+    xtnt_uint_t mode,
+    xtnt_uint_t policy)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_initialize_lock(queue, policy)) == XTNT_ESUCCESS) {
+        XTNT_MODE_SET_VALUE(queue->root.state, mode);
+        if (mode == XTNT_QUEUE_MODE_MPSC) {
+            // The root is the stub node, both ends start on it
+            queue->root.link[XTNT_NODE_MIDDLE] = &(queue->root);
+            queue->root.link[XTNT_NODE_TAIL] = &(queue->root);
+        }
+        queue->fn = &xtnt_queue_if;
     }
     return res;
 }
 
 /**
- * @brief Add an entry to the queue
+ * @brief Remove up to max entries from the queue
  *
  * @param[in] queue The `xtnt_node_set` to operate on
- * @param[in] node The `xtnt_node` to add to the queue
- * @retval XTNT_ESUCCESS on successful push
- * @retval return value of `pthread_mutex_lock()` or `pthread_mutex_unlock()`
+ * @param[in] max The most entries to remove, the capacity of nodes
+ * @param[out] nodes The removed nodes, oldest first
+ * @param[out] count The number of nodes removed, zero if queue is empty
+ * @retval XTNT_ESUCCESS on successful pop
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note A locked queue takes the lock once for the whole batch. In
+ * XTNT_QUEUE_MODE_MPSC only one thread may pop, without locking.
  */
 xtnt_status_t
-xtnt_queue_push(
+xtnt_queue_pop_batch(
     struct xtnt_node_set *queue,
-    struct xtnt_node *node)
+    xtnt_uint_t max,
+    struct xtnt_node **nodes,
+    xtnt_uint_t *count)
 {
     xtnt_status_t res = XTNT_EFAILURE;
-    if ((res = pthread_mutex_lock(&(queue->lock))) == XTNT_ESUCCESS) {
-        if (queue->root.link[XTNT_NODE_HEAD] != NULL) {
-            queue->root.link[XTNT_NODE_HEAD]->link[XTNT_NODE_HEAD] = node;
-            node->link[XTNT_NODE_TAIL] = queue->root.link[XTNT_NODE_HEAD];
-            queue->root.link[XTNT_NODE_HEAD] = node;
-        } else {
-            queue->root.link[XTNT_NODE_TAIL] = node;
-            queue->root.link[XTNT_NODE_HEAD] = node;
+    *count = XTNT_ZERO;
+    if (XTNT_MODE(queue->root.state) == XTNT_QUEUE_MODE_MPSC) {
+        while (*count < max && (nodes[*count] = xtnt_queue_mpsc_pop(queue)) != NULL) {
+            (*count)++;
         }
-        queue->count++;
-        if ((res = pthread_mutex_unlock(&(queue->lock))) != XTNT_ESUCCESS) {
-            XTNT_LOCK_SET_UNLOCK_FAIL(queue->root.state);
+        return XTNT_ESUCCESS;
+    }
+    if ((res = xtnt_node_set_write_lock(queue)) == XTNT_ESUCCESS) {
+        while (*count < max && (nodes[*count] = xtnt_queue_locked_pop(queue)) != NULL) {
+            (*count)++;
         }
-    } else {
-        XTNT_LOCK_SET_LOCK_FAIL(queue->root.state);
+        res = xtnt_node_set_write_unlock(queue);
     }
     return res;
 }
+
+/**
+ * @brief Add a chain of entries to the queue
+ *
+ * @param[in] queue The `xtnt_node_set` to operate on
+ * @param[in] head The oldest node of a chain linked through
+ * link[XTNT_NODE_HEAD] and ending with NULL, or NULL
+ * @retval XTNT_ESUCCESS on successful push
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note The chain is queued in order as one push, with one lock and one
+ * count update however long it is. The chain of `xtnt_queue_drain()` can
+ * be pushed as is. The chain is walked before locking.
+ *
+ * @note In XTNT_QUEUE_MODE_MPSC any number of threads may push chains
+ * without locking.
+ */
+xtnt_status_t
+xtnt_queue_push_chain(
+    struct xtnt_node_set *queue,
+    struct xtnt_node *head)
+{
+    struct xtnt_node *tail = NULL;
+    xtnt_uint_t count = XTNT_ZERO;
+    xtnt_node_chain(head, &tail, &count);
+    return xtnt_queue_splice(queue, head, tail, count);
+}
+
+/**
+ * @brief Add a table of entries to the queue
+ *
+ * @param[in] queue The `xtnt_node_set` to operate on
+ * @param[in] count The number of nodes
+ * @param[in] nodes The nodes to add, oldest first
+ * @retval XTNT_ESUCCESS on successful push
+ * @retval EINVAL on a NULL node
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note The nodes are linked into a chain before locking, then queued as
+ * with `xtnt_queue_push_chain()`.
+ */
+xtnt_status_t
+xtnt_queue_push_many(
+    struct xtnt_node_set *queue,
+    xtnt_uint_t count,
+    struct xtnt_node **nodes)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_node *head = NULL;
+    struct xtnt_node *tail = NULL;
+    if ((res = xtnt_node_chain_table(nodes, count, &head, &tail)) != XTNT_ESUCCESS) {
+        return res;
+    }
+    return xtnt_queue_splice(queue, head, tail, count);
+}
+
+/**
+ * @brief Visit the member after the cursor, from the oldest
+ *
+ * @param[in] queue The queue, read locked
+ * @param[in] iter The cursor
+ * @param[out] node The member, or NULL past the newest
+ * @retval XTNT_ESUCCESS on visit
+ * @retval ENOTSUP in XTNT_QUEUE_MODE_MPSC, which producers link unlocked
+ */
+static xtnt_status_t
+xtnt_queue_next(
+    struct xtnt_node_set *queue,
+    struct xtnt_set_iter *iter,
+    struct xtnt_node **node)
+{
+    if (XTNT_MODE(queue->root.state) == XTNT_QUEUE_MODE_MPSC) {
+        return ENOTSUP;
+    }
+    if (iter->node == NULL) {
+        *node = queue->root.link[XTNT_NODE_TAIL];
+    } else {
+        // The newest member's link is not cleared by push
+        *node = (iter->node == queue->root.link[XTNT_NODE_HEAD]) ? NULL : iter->node->link[XTNT_NODE_HEAD];
+    }
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Queue Node Set interface
+ */
+const struct xtnt_node_set_if xtnt_queue_if = {
+    .index = xtnt_node_set_enotsup_index,
+    .search = xtnt_node_set_enotsup_key,
+    .search_fn = xtnt_node_set_enotsup_search_fn,
+    .first = xtnt_node_set_enotsup_out,
+    .last = xtnt_node_set_enotsup_out,
+    .peek = xtnt_queue_peek,
+    .root = xtnt_node_set_enotsup_out,
+    .state = xtnt_node_set_enotsup_state,
+    .insert = xtnt_node_set_enotsup_node,
+    .insert_at = xtnt_node_set_enotsup_insert_at,
+    .push = xtnt_queue_push,
+    .remove = xtnt_node_set_enotsup_node,
+    .remove_at = xtnt_node_set_enotsup_key,
+    .pop = xtnt_queue_pop,
+    .sort = xtnt_node_set_enotsup,
+    .sort_reverse = xtnt_node_set_enotsup,
+    .sort_fn = xtnt_node_set_enotsup_fn,
+    .grow = xtnt_node_set_enotsup,
+    .grow_eval = xtnt_node_set_enotsup_eval,
+    .shrink = xtnt_node_set_enotsup,
+    .shrink_eval = xtnt_node_set_enotsup_eval,
+    .next = xtnt_queue_next,
+    .seek = xtnt_node_set_enotsup_seek
+};
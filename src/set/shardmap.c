@@ -0,0 +1,366 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/set/shardmap.h>
+
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @struct xtnt_shardmap_shard
+ *
+ * A hash set shard padded so neighbouring shard locks share no cache line
+ */
+struct xtnt_shardmap_shard
+{
+    struct xtnt_node_set set __attribute__((aligned(XTNT_SHARDMAP_ALIGN)));
+};
+
+/**
+ * @brief Select the shard of a key
+ *
+ * @param[in] map The map to select in
+ * @param[in] key The key to select for
+ * @return shard index
+ *
+ * @note The key is mixed with a finalizer independent of the hash set slot
+ * hash, so keys sharing a shard still spread over its slots.
+ */
+static inline size_t
+xtnt_shardmap_index(
+    const struct xtnt_shardmap *map,
+    xtnt_uint_t key)
+{
+    uint64_t h = (uint64_t) key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return (size_t) h & (map->shards - 1);
+}
+
+/**
+ * @brief Order a run of keys by shard
+ *
+ * @param[in] count The number of keys, at most XTNT_SHARDMAP_BATCH
+ * @param[in] shard The shard of each key
+ * @param[out] order The key indexes, grouped by shard
+ *
+ * @note A counting sort, stable so keys of a shard keep their batch order.
+ */
+static void
+xtnt_shardmap_order(
+    size_t count,
+    const uint16_t *shard,
+    uint16_t *order)
+{
+    uint16_t start[XTNT_SHARDMAP_MAX + 1];
+    memset(start, 0, sizeof(start));
+    for (size_t idx = 0; idx < count; idx++) {
+        start[shard[idx] + 1]++;
+    }
+    for (size_t s = 1; s <= XTNT_SHARDMAP_MAX; s++) {
+        start[s] += start[s - 1];
+    }
+    for (size_t idx = 0; idx < count; idx++) {
+        order[start[shard[idx]]++] = (uint16_t) idx;
+    }
+}
+
+/**
+ * @brief Allocate and initialize a sharded map
+ *
+ * @param[in] shards The number of shards, or 0 to size by the online CPUs
+ * @param[out] map Pointer reference to store the map to
+ * @retval XTNT_ESUCCESS on allocation and initialization
+ * @retval return value of `posix_memalign()` or `xtnt_hashset_initialize()`
+ *
+ * @note Shards are rounded up to a power of 2 and limited to
+ * XTNT_SHARDMAP_MAX. Sized by CPU count, a map has XTNT_SHARDMAP_FACTOR
+ * shards per online CPU so contending threads rarely meet on one lock.
+ */
+xtnt_status_t
+xtnt_shardmap_create(
+    size_t shards,
+    struct xtnt_shardmap **map)
+{
+    xtnt_status_t res = XTNT_ESUCCESS;
+    struct xtnt_shardmap *mmap = NULL;
+    void *block = NULL;
+    size_t want = shards;
+    size_t idx;
+    if (want == XTNT_ZERO) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        want = (size_t) ((cpus > 0) ? cpus : 1) * XTNT_SHARDMAP_FACTOR;
+    }
+    for (shards = 1; shards < want && shards < XTNT_SHARDMAP_MAX; shards <<= 1) {
+        ;
+    }
+    *map = NULL;
+    if ((mmap = malloc(sizeof(struct xtnt_shardmap))) == NULL) {
+        return errno;
+    }
+    if ((res = posix_memalign(&block, XTNT_SHARDMAP_ALIGN,
+                              shards * sizeof(struct xtnt_shardmap_shard))) != XTNT_ESUCCESS) {
+        free(mmap);
+        return res;
+    }
+    mmap->shard = block;
+    mmap->shards = shards;
+    for (idx = 0; idx < shards; idx++) {
+        if ((res = xtnt_hashset_initialize(&(mmap->shard[idx].set))) != XTNT_ESUCCESS) {
+            while (idx-- > 0) {
+                xtnt_hashset_uninitialize(&(mmap->shard[idx].set));
+            }
+            free(mmap->shard);
+            free(mmap);
+            return res;
+        }
+    }
+    *map = mmap;
+    return res;
+}
+
+/**
+ * @brief Delete a node from the map
+ *
+ * @param[in] map The map to delete from
+ * @param[in] key The key of the node to delete
+ * @param[out] deleted The node removed from the map or NULL if not found
+ * @retval result of `xtnt_hashset_delete()`
+ */
+xtnt_status_t
+xtnt_shardmap_delete(
+    struct xtnt_shardmap *map,
+    xtnt_uint_t key,
+    struct xtnt_node **deleted)
+{
+    return xtnt_hashset_delete(&(map->shard[xtnt_shardmap_index(map, key)].set), key, deleted);
+}
+
+/**
+ * @brief Uninitialize and deallocate a sharded map
+ *
+ * @param[in] map Pointer reference of the map to destroy
+ * @retval XTNT_ESUCCESS on destroy
+ * @retval result of the first failing `xtnt_hashset_uninitialize()`
+ *
+ * @note Member nodes are owned by the caller and are not released.
+ */
+xtnt_status_t
+xtnt_shardmap_destroy(
+    struct xtnt_shardmap **map)
+{
+    xtnt_status_t res = XTNT_ESUCCESS;
+    xtnt_status_t shard_res = XTNT_ESUCCESS;
+    for (size_t idx = 0; idx < (*map)->shards; idx++) {
+        if ((shard_res = xtnt_hashset_uninitialize(&((*map)->shard[idx].set))) != XTNT_ESUCCESS &&
+            res == XTNT_ESUCCESS) {
+            res = shard_res;
+        }
+    }
+    free((*map)->shard);
+    free(*map);
+    *map = NULL;
+    return res;
+}
+
+/**
+ * @brief Call a function on each member of a sharded map
+ *
+ * @param[in] map The map to visit
+ * @param[in] visit The function to call, see `xtnt_node_visit_fn`
+ * @param[in] ctx Context passed into the function
+ * @retval XTNT_ESUCCESS once every member is visited
+ * @retval the first status of visit other than XTNT_ESUCCESS
+ * @retval result of `xtnt_set_for_each()`
+ *
+ * @note Each shard is read locked once while its members are visited, so
+ * the walk is consistent per shard but not across them.
+ */
+xtnt_status_t
+xtnt_shardmap_for_each(
+    struct xtnt_shardmap *map,
+    xtnt_node_visit_fn visit,
+    void *ctx)
+{
+    xtnt_status_t res = XTNT_ESUCCESS;
+    for (size_t idx = 0; idx < map->shards && res == XTNT_ESUCCESS; idx++) {
+        res = xtnt_set_for_each(&(map->shard[idx].set), visit, ctx);
+    }
+    return res;
+}
+
+/**
+ * @brief Get the node of a key
+ *
+ * @param[in] map The map to search
+ * @param[in] key The key to match
+ * @param[out] found Reference to matching node or NULL
+ * @retval result of `xtnt_hashset_search()`
+ */
+xtnt_status_t
+xtnt_shardmap_get(
+    struct xtnt_shardmap *map,
+    xtnt_uint_t key,
+    struct xtnt_node **found)
+{
+    return xtnt_hashset_search(&(map->shard[xtnt_shardmap_index(map, key)].set), key, found);
+}
+
+/**
+ * @brief Get the nodes of a batch of keys
+ *
+ * @param[in] map The map to search
+ * @param[in] count The number of keys
+ * @param[in] keys The keys to match
+ * @param[out] found Array receiving the matching node, or NULL, of each key
+ * @retval XTNT_ESUCCESS on search
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ *
+ * @note Keys are grouped by shard XTNT_SHARDMAP_BATCH at a time, and each
+ * shard lock is taken once per group rather than once per key.
+ */
+xtnt_status_t
+xtnt_shardmap_get_batch(
+    struct xtnt_shardmap *map,
+    size_t count,
+    const xtnt_uint_t *keys,
+    struct xtnt_node **found)
+{
+    xtnt_status_t res = XTNT_ESUCCESS;
+    uint16_t shard[XTNT_SHARDMAP_BATCH];
+    uint16_t order[XTNT_SHARDMAP_BATCH];
+    struct xtnt_node_set *set = NULL;
+    size_t base, run, idx, end;
+    for (base = 0; base < count; base += run) {
+        run = (count - base < XTNT_SHARDMAP_BATCH) ? count - base : XTNT_SHARDMAP_BATCH;
+        for (idx = 0; idx < run; idx++) {
+            shard[idx] = (uint16_t) xtnt_shardmap_index(map, keys[base + idx]);
+        }
+        xtnt_shardmap_order(run, shard, order);
+        for (idx = 0; idx < run; idx = end) {
+            set = &(map->shard[shard[order[idx]]].set);
+            if ((res = xtnt_node_set_read_lock(set)) != XTNT_ESUCCESS) {
+                return res;
+            }
+            for (end = idx; end < run && shard[order[end]] == shard[order[idx]]; end++) {
+                found[base + order[end]] = xtnt_hashset_search_locked(set, keys[base + order[end]]);
+            }
+            if ((res = xtnt_node_set_read_unlock(set)) != XTNT_ESUCCESS) {
+                return res;
+            }
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Put a node in the map, replacing the node with the same key
+ *
+ * @param[in] map The map to put into
+ * @param[in] node The node to put
+ * @param[out] replaced The node replaced, or NULL
+ * @retval result of `xtnt_hashset_replace()`
+ */
+xtnt_status_t
+xtnt_shardmap_put(
+    struct xtnt_shardmap *map,
+    struct xtnt_node *node,
+    struct xtnt_node **replaced)
+{
+    return xtnt_hashset_replace(&(map->shard[xtnt_shardmap_index(map, node->key)].set),
+                                node, replaced);
+}
+
+/**
+ * @brief Put a batch of nodes in the map
+ *
+ * @param[in] map The map to put into
+ * @param[in] count The number of nodes
+ * @param[in] nodes The nodes to put
+ * @param[out] replaced Array receiving the node replaced by each node, or
+ * NULL when not wanted
+ * @retval XTNT_ESUCCESS on put
+ * @retval result of `xtnt_hashset_replace_locked()`
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note Nodes are grouped by shard XTNT_SHARDMAP_BATCH at a time, and each
+ * shard lock is taken once per group rather than once per node. On failure,
+ * nodes of the failing group and later groups may not have been put.
+ *
+ * @warning Two nodes of the same key in one batch leave the later one in the
+ * map, with the earlier reported as replaced.
+ */
+xtnt_status_t
+xtnt_shardmap_put_batch(
+    struct xtnt_shardmap *map,
+    size_t count,
+    struct xtnt_node **nodes,
+    struct xtnt_node **replaced)
+{
+    xtnt_status_t res = XTNT_ESUCCESS;
+    xtnt_status_t unlock = XTNT_ESUCCESS;
+    uint16_t shard[XTNT_SHARDMAP_BATCH];
+    uint16_t order[XTNT_SHARDMAP_BATCH];
+    struct xtnt_node_set *set = NULL;
+    struct xtnt_node *old = NULL;
+    size_t base, run, idx, end;
+    for (base = 0; base < count; base += run) {
+        run = (count - base < XTNT_SHARDMAP_BATCH) ? count - base : XTNT_SHARDMAP_BATCH;
+        for (idx = 0; idx < run; idx++) {
+            shard[idx] = (uint16_t) xtnt_shardmap_index(map, nodes[base + idx]->key);
+        }
+        xtnt_shardmap_order(run, shard, order);
+        for (idx = 0; idx < run; idx = end) {
+            set = &(map->shard[shard[order[idx]]].set);
+            if ((res = xtnt_node_set_write_lock(set)) != XTNT_ESUCCESS) {
+                return res;
+            }
+            for (end = idx; end < run && shard[order[end]] == shard[order[idx]]; end++) {
+                if ((res = xtnt_hashset_replace_locked(set, nodes[base + order[end]], &old)) != XTNT_ESUCCESS) {
+                    break;
+                }
+                if (replaced != NULL) {
+                    replaced[base + order[end]] = old;
+                }
+            }
+            if ((unlock = xtnt_node_set_write_unlock(set)) != XTNT_ESUCCESS) {
+                return unlock;
+            }
+            if (res != XTNT_ESUCCESS) {
+                return res;
+            }
+        }
+    }
+    return res;
+}
@@ -0,0 +1,642 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <extant/set/sort.h>
+
+#include <string.h>
+#include <unistd.h>
+
+#define XTNT_SORT_LEVELS (sizeof(size_t) * 8) /**< Pending runs of a chain merge sort */
+#define XTNT_SORT_DIGIT (8) /**< Key bits sorted by each radix pass */
+#define XTNT_SORT_BUCKETS (1 << XTNT_SORT_DIGIT) /**< Buckets of a radix pass */
+
+/*
+ * A parallel sort shares this between its team, each member knowing only
+ * its index. The team size is settled once every worker has started.
+ */
+struct xtnt_sort_team {
+    struct xtnt_node **table;
+    struct xtnt_node **buffer;
+    size_t count;
+    xtnt_node_compare_fn compare;
+    size_t threads;
+    xtnt_uint_t started;
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_barrier_t round;
+};
+
+struct xtnt_sort_worker {
+    pthread_t thread;
+    struct xtnt_sort_team *team;
+    size_t index;
+};
+
+/**
+ * @brief Merge two sorted chains linked through link[XTNT_NODE_TAIL]
+ *
+ * @param[in] a The chain of earlier members, kept first among equals
+ * @param[in] b The chain of later members
+ * @param[in] compare The order of the chains
+ * @return head of the merged chain
+ */
+static struct xtnt_node *
+xtnt_sort_merge(
+    struct xtnt_node *a,
+    struct xtnt_node *b,
+    xtnt_node_compare_fn compare)
+{
+    struct xtnt_node *head = NULL;
+    struct xtnt_node **next = &head;
+    while (a != NULL && b != NULL) {
+        if (compare(b, a) < 0) {
+            *next = b;
+            b = b->link[XTNT_NODE_TAIL];
+        } else {
+            *next = a;
+            a = a->link[XTNT_NODE_TAIL];
+        }
+        next = &((*next)->link[XTNT_NODE_TAIL]);
+    }
+    *next = (a != NULL) ? a : b;
+    return head;
+}
+
+/**
+ * @brief Sort a table by insertion
+ *
+ * @param[in] table The nodes to sort
+ * @param[in] count The nodes in the table
+ * @param[in] compare The order to sort in
+ */
+static void
+xtnt_sort_insertion(
+    struct xtnt_node **table,
+    size_t count,
+    xtnt_node_compare_fn compare)
+{
+    struct xtnt_node *node = NULL;
+    size_t idx = 0;
+    for (size_t next = 1; next < count; next++) {
+        node = table[next];
+        for (idx = next; idx > 0 && compare(node, table[idx - 1]) < 0; idx--) {
+            table[idx] = table[idx - 1];
+        }
+        table[idx] = node;
+    }
+}
+
+/**
+ * @brief Sift a node down a binary heap
+ *
+ * @param[in] table The heap
+ * @param[in] parent The slot of the node to sift
+ * @param[in] count The nodes in the heap
+ * @param[in] compare The order of the heap, greatest first
+ */
+static void
+xtnt_sort_sift(
+    struct xtnt_node **table,
+    size_t parent,
+    size_t count,
+    xtnt_node_compare_fn compare)
+{
+    struct xtnt_node *node = table[parent];
+    size_t child = 0;
+    while ((child = 2 * parent + 1) < count) {
+        if (child + 1 < count && compare(table[child], table[child + 1]) < 0) {
+            child++;
+        }
+        if (compare(node, table[child]) >= 0) {
+            break;
+        }
+        table[parent] = table[child];
+        parent = child;
+    }
+    table[parent] = node;
+}
+
+/**
+ * @brief Sort a table as a binary heap
+ *
+ * @param[in] table The nodes to sort
+ * @param[in] count The nodes in the table
+ * @param[in] compare The order to sort in
+ *
+ * @note Introsort falls back to heapsort when partitioning goes badly, so
+ * no input costs more than O(n log n) comparisons.
+ */
+static void
+xtnt_sort_heap(
+    struct xtnt_node **table,
+    size_t count,
+    xtnt_node_compare_fn compare)
+{
+    struct xtnt_node *swap = NULL;
+    for (size_t idx = count / 2; idx > 0; idx--) {
+        xtnt_sort_sift(table, idx - 1, count, compare);
+    }
+    while (count > 1) {
+        swap = table[--count];
+        table[count] = table[0];
+        table[0] = swap;
+        xtnt_sort_sift(table, 0, count, compare);
+    }
+}
+
+/**
+ * @brief Sort a table with introsort
+ *
+ * @param[in] table The nodes to sort
+ * @param[in] count The nodes in the table
+ * @param[in] depth The partitions left before falling back to heapsort
+ * @param[in] compare The order to sort in
+ *
+ * @note The pivot is the median of the first, middle and last node. The
+ * smaller side is sorted by recursion and the larger one by the loop, so the
+ * stack stays O(log n) deep.
+ */
+static void
+xtnt_sort_intro(
+    struct xtnt_node **table,
+    size_t count,
+    size_t depth,
+    xtnt_node_compare_fn compare)
+{
+    struct xtnt_node *swap = NULL;
+    struct xtnt_node *pivot = NULL;
+    size_t low = 0;
+    size_t high = 0;
+    while (count > XTNT_SORT_INSERTION) {
+        if (depth-- == 0) {
+            xtnt_sort_heap(table, count, compare);
+            return;
+        }
+        high = count / 2;
+        if (compare(table[high], table[0]) < 0) {
+            swap = table[high]; table[high] = table[0]; table[0] = swap;
+        }
+        if (compare(table[count - 1], table[high]) < 0) {
+            swap = table[high]; table[high] = table[count - 1]; table[count - 1] = swap;
+            if (compare(table[high], table[0]) < 0) {
+                swap = table[high]; table[high] = table[0]; table[0] = swap;
+            }
+        }
+        pivot = table[high];
+        // Hoare partition, both sides hold at least one node
+        low = 0;
+        high = count - 1;
+        for (;;) {
+            while (compare(table[low], pivot) < 0) {
+                low++;
+            }
+            while (compare(pivot, table[high]) < 0) {
+                high--;
+            }
+            if (low >= high) {
+                break;
+            }
+            swap = table[low]; table[low] = table[high]; table[high] = swap;
+            low++;
+            high--;
+        }
+        if (high + 1 < count - high - 1) {
+            xtnt_sort_intro(table, high + 1, depth, compare);
+            table += high + 1;
+            count -= high + 1;
+        } else {
+            xtnt_sort_intro(table + high + 1, count - high - 1, depth, compare);
+            count = high + 1;
+        }
+    }
+    xtnt_sort_insertion(table, count, compare);
+}
+
+/**
+ * @brief Count the nodes of a run taken among the first nodes of a merge
+ *
+ * @param[in] a The earlier run, first among equals
+ * @param[in] na The nodes of `a`
+ * @param[in] b The later run
+ * @param[in] nb The nodes of `b`
+ * @param[in] diagonal The first nodes of the merge to split
+ * @param[in] compare The order of the runs
+ * @return nodes of `a` among the first `diagonal` nodes of the merge
+ *
+ * @note A binary search along the merge path, so a merge splits into
+ * independent parts of any size.
+ */
+static size_t
+xtnt_sort_split(
+    struct xtnt_node **a,
+    size_t na,
+    struct xtnt_node **b,
+    size_t nb,
+    size_t diagonal,
+    xtnt_node_compare_fn compare)
+{
+    size_t low = (diagonal > nb) ? diagonal - nb : 0;
+    size_t high = (diagonal < na) ? diagonal : na;
+    size_t mid = 0;
+    while (low < high) {
+        mid = low + (high - low) / 2;
+        if (compare(b[diagonal - mid - 1], a[mid]) < 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return low;
+}
+
+/**
+ * @brief Merge the part of a round of run merges one worker writes
+ *
+ * @param[in] src The sorted runs
+ * @param[in] dst The table to merge into
+ * @param[in] count The nodes of the table
+ * @param[in] width The nodes of each run
+ * @param[in] low The first slot of `dst` to write
+ * @param[in] high The slot after the last to write
+ * @param[in] compare The order of the runs
+ */
+static void
+xtnt_sort_merge_slice(
+    struct xtnt_node **src,
+    struct xtnt_node **dst,
+    size_t count,
+    size_t width,
+    size_t low,
+    size_t high,
+    xtnt_node_compare_fn compare)
+{
+    struct xtnt_node **out = NULL;
+    size_t mid = 0;
+    size_t end = 0;
+    size_t first = 0;
+    size_t last = 0;
+    size_t a = 0;
+    size_t a_end = 0;
+    size_t b = 0;
+    size_t b_end = 0;
+    for (size_t start = low - low % (2 * width); start < high; start += 2 * width) {
+        mid = (start + width < count) ? start + width : count;
+        end = (mid + width < count) ? mid + width : count;
+        first = ((low > start) ? low : start) - start;
+        last = ((high < end) ? high : end) - start;
+        a = xtnt_sort_split(src + start, mid - start, src + mid, end - mid, first, compare);
+        a_end = xtnt_sort_split(src + start, mid - start, src + mid, end - mid, last, compare);
+        b = mid + first - a;
+        b_end = mid + last - a_end;
+        a += start;
+        a_end += start;
+        for (out = dst + start + first; a < a_end && b < b_end; out++) {
+            *out = (compare(src[b], src[a]) < 0) ? src[b++] : src[a++];
+        }
+        while (a < a_end) {
+            *(out++) = src[a++];
+        }
+        while (b < b_end) {
+            *(out++) = src[b++];
+        }
+    }
+}
+
+/**
+ * @brief Sort a table by the key order of a comparison when it has one
+ *
+ * @param[in] table The nodes to sort
+ * @param[in] count The nodes in the table
+ * @param[in] compare The order to sort in
+ */
+static void
+xtnt_sort_run(
+    struct xtnt_node **table,
+    size_t count,
+    xtnt_node_compare_fn compare)
+{
+    if (compare == xtnt_node_compare_key) {
+        xtnt_sort_table_key(table, count, XTNT_ZERO);
+    } else if (compare == xtnt_node_compare_key_reverse) {
+        xtnt_sort_table_key(table, count, 1);
+    } else {
+        xtnt_sort_table(table, count, compare);
+    }
+}
+
+/**
+ * @brief Sort one run, then merge one slice of each round, as a team member
+ *
+ * @param[in] arg The `struct xtnt_sort_worker` of the member
+ * @return NULL
+ */
+static void *
+xtnt_sort_work(
+    void *arg)
+{
+    struct xtnt_sort_worker *worker = arg;
+    struct xtnt_sort_team *team = worker->team;
+    struct xtnt_node **src = team->table;
+    struct xtnt_node **dst = team->buffer;
+    struct xtnt_node **swap = NULL;
+    size_t width = 0;
+    size_t low = 0;
+    size_t high = 0;
+    pthread_mutex_lock(&(team->lock));
+    while (!team->started) {
+        pthread_cond_wait(&(team->start), &(team->lock));
+    }
+    pthread_mutex_unlock(&(team->lock));
+    width = (team->count + team->threads - 1) / team->threads;
+    low = worker->index * width;
+    if (low < team->count) {
+        xtnt_sort_run(team->table + low, (low + width < team->count) ? width : team->count - low,
+                      team->compare);
+    }
+    // Every round merges pairs of runs twice as wide, each worker writing
+    // an equal slice of the table
+    low = team->count * worker->index / team->threads;
+    high = team->count * (worker->index + 1) / team->threads;
+    for (; width < team->count; width <<= 1) {
+        pthread_barrier_wait(&(team->round));
+        xtnt_sort_merge_slice(src, dst, team->count, width, low, high, team->compare);
+        swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if (src != team->table) {
+        // The last round may still read the table
+        pthread_barrier_wait(&(team->round));
+        memcpy(team->table + low, src + low, sizeof(struct xtnt_node *) * (high - low));
+    }
+    return NULL;
+}
+
+/**
+ * @brief Sort a chain of nodes in place with a merge sort
+ *
+ * @param[in,out] head The first node of the chain, set to the first sorted
+ * @param[in,out] tail The last node of the chain, set to the last sorted
+ * @param[in] compare The order to sort in
+ * @retval XTNT_ESUCCESS on sort
+ * @retval EINVAL without a comparison function
+ *
+ * @note The chain is linked through link[XTNT_NODE_TAIL] and relinked
+ * through link[XTNT_NODE_HEAD] once sorted. Runs are merged as the digits of
+ * a binary counter, one pending run per level, so the sort is stable,
+ * O(n log n) and allocates nothing.
+ */
+xtnt_status_t
+xtnt_sort_chain(
+    struct xtnt_node **head,
+    struct xtnt_node **tail,
+    xtnt_node_compare_fn compare)
+{
+    struct xtnt_node *pending[XTNT_SORT_LEVELS] = { NULL };
+    struct xtnt_node *node = *head;
+    struct xtnt_node *next = NULL;
+    struct xtnt_node *carry = NULL;
+    size_t level = 0;
+    if (compare == NULL) {
+        return EINVAL;
+    }
+    for (; node != NULL; node = next) {
+        next = node->link[XTNT_NODE_TAIL];
+        node->link[XTNT_NODE_TAIL] = NULL;
+        carry = node;
+        for (level = 0; pending[level] != NULL; level++) {
+            carry = xtnt_sort_merge(pending[level], carry, compare);
+            pending[level] = NULL;
+        }
+        pending[level] = carry;
+    }
+    carry = NULL;
+    for (level = 0; level < XTNT_SORT_LEVELS; level++) {
+        if (pending[level] != NULL) {
+            carry = xtnt_sort_merge(pending[level], carry, compare);
+        }
+    }
+    *head = carry;
+    *tail = NULL;
+    for (node = carry; node != NULL; node = node->link[XTNT_NODE_TAIL]) {
+        node->link[XTNT_NODE_HEAD] = *tail;
+        *tail = node;
+    }
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Sort a table of nodes in place with introsort
+ *
+ * @param[in] table The nodes to sort, none NULL
+ * @param[in] count The nodes in the table
+ * @param[in] compare The order to sort in
+ * @retval XTNT_ESUCCESS on sort
+ * @retval EINVAL without a comparison function
+ *
+ * @note The sort is not stable. It takes O(n log n) comparisons on any
+ * input and O(log n) stack.
+ */
+xtnt_status_t
+xtnt_sort_table(
+    struct xtnt_node **table,
+    size_t count,
+    xtnt_node_compare_fn compare)
+{
+    size_t depth = 0;
+    if (compare == NULL) {
+        return EINVAL;
+    }
+    for (size_t bits = count; bits > 1; bits >>= 1) {
+        depth += 2;
+    }
+    xtnt_sort_intro(table, count, depth, compare);
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Sort a table of nodes in place with a team of threads
+ *
+ * @param[in] table The nodes to sort, none NULL
+ * @param[in] count The nodes in the table
+ * @param[in] compare The order to sort in
+ * @param[in] threads The most threads to sort with, or 0 for the online CPUs
+ * @param[in] cutoff The fewest nodes per thread, or 0 for XTNT_SORT_PARALLEL
+ * @retval XTNT_ESUCCESS on sort
+ * @retval EINVAL without a comparison function
+ *
+ * @note The table is cut into one run per thread, each sorted alone, then
+ * the runs are merged in rounds through a buffer. Each merge is split along
+ * its merge path so every thread writes an equal slice of every round.
+ *
+ * @note Runs ordered by `xtnt_node_compare_key()` or
+ * `xtnt_node_compare_key_reverse()` are radix sorted, so by key the sort is
+ * stable. Any other comparison sorts runs with introsort.
+ *
+ * @note A table too small for two threads, or a failed allocation or thread
+ * creation, is sorted with the threads at hand, down to the calling one.
+ */
+xtnt_status_t
+xtnt_sort_table_parallel(
+    struct xtnt_node **table,
+    size_t count,
+    xtnt_node_compare_fn compare,
+    size_t threads,
+    size_t cutoff)
+{
+    struct xtnt_sort_team team;
+    struct xtnt_sort_worker *workers = NULL;
+    size_t started = 1;
+    if (compare == NULL) {
+        return EINVAL;
+    }
+    if (threads == XTNT_ZERO) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (size_t) ((cpus > 0) ? cpus : 1);
+    }
+    if (cutoff == XTNT_ZERO) {
+        cutoff = XTNT_SORT_PARALLEL;
+    }
+    if (threads > count / cutoff) {
+        threads = count / cutoff;
+    }
+    if (threads > XTNT_SORT_THREADS) {
+        threads = XTNT_SORT_THREADS;
+    }
+    if (threads < 2 ||
+        (workers = malloc(sizeof(struct xtnt_sort_worker) * threads)) == NULL) {
+        xtnt_sort_run(table, count, compare);
+        return XTNT_ESUCCESS;
+    }
+    if ((team.buffer = malloc(sizeof(struct xtnt_node *) * count)) == NULL) {
+        free(workers);
+        xtnt_sort_run(table, count, compare);
+        return XTNT_ESUCCESS;
+    }
+    team.table = table;
+    team.count = count;
+    team.compare = compare;
+    team.started = XTNT_ZERO;
+    pthread_mutex_init(&(team.lock), NULL);
+    pthread_cond_init(&(team.start), NULL);
+    for (; started < threads; started++) {
+        workers[started].team = &team;
+        workers[started].index = started;
+        if (pthread_create(&(workers[started].thread), NULL, xtnt_sort_work, &(workers[started])) != 0) {
+            break;
+        }
+    }
+    // The team is the threads that started, the caller being member 0
+    team.threads = started;
+    pthread_barrier_init(&(team.round), NULL, (unsigned int) started);
+    pthread_mutex_lock(&(team.lock));
+    team.started = 1;
+    pthread_cond_broadcast(&(team.start));
+    pthread_mutex_unlock(&(team.lock));
+    workers[0].team = &team;
+    workers[0].index = 0;
+    xtnt_sort_work(&(workers[0]));
+    while (--started > 0) {
+        pthread_join(workers[started].thread, NULL);
+    }
+    pthread_barrier_destroy(&(team.round));
+    pthread_cond_destroy(&(team.start));
+    pthread_mutex_destroy(&(team.lock));
+    free(team.buffer);
+    free(workers);
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Sort a table of nodes in place by key
+ *
+ * @param[in] table The nodes to sort, none NULL
+ * @param[in] count The nodes in the table
+ * @param[in] reverse Non-zero to sort by descending key
+ * @retval XTNT_ESUCCESS on sort
+ *
+ * @note From XTNT_SORT_RADIX nodes the keys are copied next to their nodes
+ * and sorted with a least significant digit radix sort, one pass per key
+ * byte that differs among the nodes, so the sort is stable and O(n). Fewer
+ * nodes, or a failed allocation, fall back to `xtnt_sort_table()`.
+ */
+xtnt_status_t
+xtnt_sort_table_key(
+    struct xtnt_node **table,
+    size_t count,
+    xtnt_uint_t reverse)
+{
+    size_t histogram[sizeof(xtnt_uint_t)][XTNT_SORT_BUCKETS];
+    struct xtnt_entry *from = NULL;
+    struct xtnt_entry *to = NULL;
+    struct xtnt_entry *swap = NULL;
+    size_t offset = 0;
+    size_t bucket = 0;
+    size_t digit = 0;
+    if (count < XTNT_SORT_RADIX ||
+        count > SIZE_MAX / (2 * sizeof(struct xtnt_entry)) ||
+        (from = malloc(2 * sizeof(struct xtnt_entry) * count)) == NULL) {
+        return xtnt_sort_table(table, count,
+            (reverse) ? xtnt_node_compare_key_reverse : xtnt_node_compare_key);
+    }
+    to = from + count;
+    memset(histogram, 0, sizeof(histogram));
+    // Count every digit in one pass over the nodes
+    for (size_t idx = 0; idx < count; idx++) {
+        from[idx].key = table[idx]->key;
+        from[idx].value = table[idx];
+        for (digit = 0; digit < sizeof(xtnt_uint_t); digit++) {
+            histogram[digit][(from[idx].key >> (digit * XTNT_SORT_DIGIT)) & (XTNT_SORT_BUCKETS - 1)]++;
+        }
+    }
+    for (digit = 0; digit < sizeof(xtnt_uint_t); digit++) {
+        // A digit all keys share leaves the order as it is
+        if (histogram[digit][(from[0].key >> (digit * XTNT_SORT_DIGIT)) & (XTNT_SORT_BUCKETS - 1)] == count) {
+            continue;
+        }
+        offset = 0;
+        for (size_t idx = 0; idx < XTNT_SORT_BUCKETS; idx++) {
+            bucket = (reverse) ? XTNT_SORT_BUCKETS - 1 - idx : idx;
+            offset += histogram[digit][bucket];
+            histogram[digit][bucket] = offset - histogram[digit][bucket];
+        }
+        for (size_t idx = 0; idx < count; idx++) {
+            bucket = (from[idx].key >> (digit * XTNT_SORT_DIGIT)) & (XTNT_SORT_BUCKETS - 1);
+            to[histogram[digit][bucket]++] = from[idx];
+        }
+        swap = from;
+        from = to;
+        to = swap;
+    }
+    for (size_t idx = 0; idx < count; idx++) {
+        table[idx] = (struct xtnt_node *) from[idx].value;
+    }
+    free((from < to) ? from : to);
+    return XTNT_ESUCCESS;
+}
@@ -30,98 +30,229 @@ SOFTWARE.
 #include <extant/set/stack.h>
 
 /**
- * @brief Peek at the next entry in a stack
+ * @brief Add a back linked chain to the stack
  *
- * @param[in] stack The xtnt_node_set to operate on
- * @param[out] node The xtnt_node or NULL if stack is empty
- * @retval XTNT_ESUCCESS on successful peek
- * @retval return value of `pthread_mutex_lock()` or `pthread_mutex_unlock()`
- * calls.
+ * @param[in] stack The `xtnt_node_set` to operate on
+ * @param[in] head The first node of the chain, pushed first
+ * @param[in] tail The last node of the chain, the new top
+ * @param[in] count The number of nodes in the chain
+ * @retval XTNT_ESUCCESS on successful push
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
  */
-xtnt_status_t
-xtnt_stack_peek(
+static xtnt_status_t
+xtnt_stack_splice(
     struct xtnt_node_set *stack,
-    struct xtnt_node **node)
+    struct xtnt_node *head,
+    struct xtnt_node *tail,
+    xtnt_uint_t count)
 {
     xtnt_status_t res = XTNT_EFAILURE;
-    if ((res = pthread_mutex_lock(&(stack->lock))) == XTNT_ESUCCESS) {
-        if (stack->root.link[XTNT_NODE_HEAD] != NULL) {
-            *node = stack->root.link[XTNT_NODE_HEAD];
-        }
-        if ((res = pthread_mutex_unlock(&(stack->lock))) != XTNT_ESUCCESS) {
-            XTNT_LOCK_SET_UNLOCK_FAIL(stack->root.state);
+    if (count == 0) {
+        return XTNT_ESUCCESS;
+    }
+    if ((res = xtnt_node_set_write_lock(stack)) == XTNT_ESUCCESS) {
+        if (stack->root.link[XTNT_NODE_TAIL] != NULL) {
+            stack->root.link[XTNT_NODE_HEAD]->link[XTNT_NODE_HEAD] = head;
+            head->link[XTNT_NODE_TAIL] = stack->root.link[XTNT_NODE_HEAD];
+        } else {
+            stack->root.link[XTNT_NODE_TAIL] = head;
         }
-    } else {
-        XTNT_LOCK_SET_LOCK_FAIL(stack->root.state);
+        stack->root.link[XTNT_NODE_HEAD] = tail;
+        stack->count += count;
+        res = xtnt_node_set_write_unlock(stack);
+    }
+    return res;
+}
+
+/**
+ * @brief Initialize a Node Set as a stack
+ *
+ * @param[in] stack The Node Set to initialize
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval result of `xtnt_stack_initialize_lock()`
+ */
+xtnt_status_t
+xtnt_stack_initialize(
+    struct xtnt_node_set *stack)
+{
+    return xtnt_stack_initialize_lock(stack, XTNT_SET_LOCK_MUTEX);
+}
+
+/**
+ * @brief Initialize a Node Set as a stack with a locking policy
+ *
+ * @param[in] stack The Node Set to initialize
+ * @param[in] policy The locking policy, see `xtnt_node_set_initialize_lock()`
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval result of `xtnt_node_set_initialize_lock()`
+ *
+ * @note The stack installs `xtnt_stack_if` for the `xtnt_set_*` operations.
+ */
+xtnt_status_t
+xtnt_stack_initialize_lock(
+    struct xtnt_node_set *stack,
+    xtnt_uint_t policy)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_initialize_lock(stack, policy)) == XTNT_ESUCCESS) {
+        stack->fn = &xtnt_stack_if;
     }
     return res;
 }
 
+extern inline struct xtnt_node *
+xtnt_stack_locked_pop(
+    struct xtnt_node_set *stack);
+
+extern inline xtnt_status_t
+xtnt_stack_peek(
+    struct xtnt_node_set *stack,
+    struct xtnt_node **node);
+
+extern inline xtnt_status_t
+xtnt_stack_pop(
+    struct xtnt_node_set *stack,
+    struct xtnt_node **node);
+
+extern inline xtnt_status_t
+xtnt_stack_push(
+    struct xtnt_node_set *stack,
+    struct xtnt_node *node);
+
 /**
- * @brief Remove the next entry in the stack
+ * @brief Remove up to max entries from the stack
  *
  * @param[in] stack The `xtnt_node_set` to operate on
- * @param[out] node The xtnt_node or NULL if stack is empty
+ * @param[in] max The most entries to remove, the capacity of nodes
+ * @param[out] nodes The removed nodes, top first
+ * @param[out] count The number of nodes removed, zero if stack is empty
  * @retval XTNT_ESUCCESS on successful pop
- * @retval return value of `pthread_mutex_lock()` or `pthread_mutex_unlock()`
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note The lock is taken once for the whole batch.
  */
 xtnt_status_t
-xtnt_stack_pop(
+xtnt_stack_pop_batch(
     struct xtnt_node_set *stack,
-    struct xtnt_node **node)
+    xtnt_uint_t max,
+    struct xtnt_node **nodes,
+    xtnt_uint_t *count)
 {
     xtnt_status_t res = XTNT_EFAILURE;
-    if ((res = pthread_mutex_lock(&(stack->lock))) == XTNT_ESUCCESS) {
-        *node = stack->root.link[XTNT_NODE_HEAD];
-        if (*node != NULL) {
-            // Use of size_t to compare pointers lead to any bugs?
-            if ((size_t) stack->root.link[XTNT_NODE_HEAD] ^ (size_t) stack->root.link[XTNT_NODE_TAIL]) {
-                (*node)->link[XTNT_NODE_TAIL]->link[XTNT_NODE_HEAD] = NULL;
-                stack->root.link[XTNT_NODE_HEAD] = (*node)->link[XTNT_NODE_TAIL];
-            } else {
-                stack->root.link[XTNT_NODE_HEAD] = NULL;
-                stack->root.link[XTNT_NODE_TAIL] = NULL;
-            }
-            stack->count--;
+    *count = XTNT_ZERO;
+    if ((res = xtnt_node_set_write_lock(stack)) == XTNT_ESUCCESS) {
+        while (*count < max && (nodes[*count] = xtnt_stack_locked_pop(stack)) != NULL) {
+            (*count)++;
         }
-        if ((res = pthread_mutex_unlock(&(stack->lock))) == XTNT_ESUCCESS) {
-            XTNT_LOCK_SET_UNLOCK_FAIL(stack->root.state);
-        }
-    } else {
-        XTNT_LOCK_SET_LOCK_FAIL(stack->root.state);
+        res = xtnt_node_set_write_unlock(stack);
     }
     return res;
 }
 
 /**
- * @brief Add an entry to the stack
+ * @brief Add a chain of entries to the stack
  *
  * @param[in] stack The `xtnt_node_set` to operate on
- * @param[in] node The `xtnt_node` to add to the stack
+ * @param[in] head The first node of a chain linked through
+ * link[XTNT_NODE_HEAD] and ending with NULL, or NULL
  * @retval XTNT_ESUCCESS on successful push
- * @retval return value of `pthread_mutex_lock()` or `pthread_mutex_unlock()`
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note The chain is pushed in order as one push, with one lock and one
+ * count update, leaving its last node on top. The chain is walked before
+ * locking.
  */
 xtnt_status_t
-xtnt_stack_push(
+xtnt_stack_push_chain(
+    struct xtnt_node_set *stack,
+    struct xtnt_node *head)
+{
+    struct xtnt_node *tail = NULL;
+    xtnt_uint_t count = XTNT_ZERO;
+    xtnt_node_chain(head, &tail, &count);
+    return xtnt_stack_splice(stack, head, tail, count);
+}
+
+/**
+ * @brief Add a table of entries to the stack
+ *
+ * @param[in] stack The `xtnt_node_set` to operate on
+ * @param[in] count The number of nodes
+ * @param[in] nodes The nodes to add, the last ends on top
+ * @retval XTNT_ESUCCESS on successful push
+ * @retval EINVAL on a NULL node
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note The nodes are linked into a chain before locking, then pushed as
+ * with `xtnt_stack_push_chain()`.
+ */
+xtnt_status_t
+xtnt_stack_push_many(
     struct xtnt_node_set *stack,
-    struct xtnt_node *node)
+    xtnt_uint_t count,
+    struct xtnt_node **nodes)
 {
     xtnt_status_t res = XTNT_EFAILURE;
-    if ((res = pthread_mutex_lock(&(stack->lock))) == XTNT_ESUCCESS) {
-        if (stack->root.link[XTNT_NODE_TAIL] != NULL) {
-            stack->root.link[XTNT_NODE_HEAD]->link[XTNT_NODE_HEAD] = node;
-            node->link[XTNT_NODE_TAIL] = stack->root.link[XTNT_NODE_HEAD];
-            stack->root.link[XTNT_NODE_HEAD] = node;
-        } else {
-            stack->root.link[XTNT_NODE_TAIL] = node;
-            stack->root.link[XTNT_NODE_HEAD] = node;
-        }
-        stack->count++;
-        if ((res = pthread_mutex_unlock(&(stack->lock))) != XTNT_ESUCCESS) {
-            XTNT_LOCK_SET_UNLOCK_FAIL(stack->root.state);
-        }
+    struct xtnt_node *head = NULL;
+    struct xtnt_node *tail = NULL;
+    if ((res = xtnt_node_chain_table(nodes, count, &head, &tail)) != XTNT_ESUCCESS) {
+        return res;
+    }
+    return xtnt_stack_splice(stack, head, tail, count);
+}
+
+/**
+ * @brief Visit the member after the cursor, from the top
+ *
+ * @param[in] stack The stack, read locked
+ * @param[in] iter The cursor
+ * @param[out] node The member, or NULL past the bottom
+ * @retval XTNT_ESUCCESS on visit
+ */
+static xtnt_status_t
+xtnt_stack_next(
+    struct xtnt_node_set *stack,
+    struct xtnt_set_iter *iter,
+    struct xtnt_node **node)
+{
+    if (iter->node == NULL) {
+        *node = stack->root.link[XTNT_NODE_HEAD];
     } else {
-        XTNT_LOCK_SET_LOCK_FAIL(stack->root.state);
+        // The bottom member's link is not cleared by push
+        *node = (iter->node == stack->root.link[XTNT_NODE_TAIL]) ? NULL : iter->node->link[XTNT_NODE_TAIL];
     }
-    return res;
+    return XTNT_ESUCCESS;
 }
+
+/**
+ * @brief Stack Node Set interface
+ */
+const struct xtnt_node_set_if xtnt_stack_if = {
+    .index = xtnt_node_set_enotsup_index,
+    .search = xtnt_node_set_enotsup_key,
+    .search_fn = xtnt_node_set_enotsup_search_fn,
+    .first = xtnt_node_set_enotsup_out,
+    .last = xtnt_node_set_enotsup_out,
+    .peek = xtnt_stack_peek,
+    .root = xtnt_node_set_enotsup_out,
+    .state = xtnt_node_set_enotsup_state,
+    .insert = xtnt_node_set_enotsup_node,
+    .insert_at = xtnt_node_set_enotsup_insert_at,
+    .push = xtnt_stack_push,
+    .remove = xtnt_node_set_enotsup_node,
+    .remove_at = xtnt_node_set_enotsup_key,
+    .pop = xtnt_stack_pop,
+    .sort = xtnt_node_set_enotsup,
+    .sort_reverse = xtnt_node_set_enotsup,
+    .sort_fn = xtnt_node_set_enotsup_fn,
+    .grow = xtnt_node_set_enotsup,
+    .grow_eval = xtnt_node_set_enotsup_eval,
+    .shrink = xtnt_node_set_enotsup,
+    .shrink_eval = xtnt_node_set_enotsup_eval,
+    .next = xtnt_stack_next,
+    .seek = xtnt_node_set_enotsup_seek
+};
@@ -26,3 +26,708 @@ SOFTWARE.
 
 ===============================================================================
 */
+
+#include <extant/set/tree.h>
+
+/**
+ * @def XTNT_RBTREE_PSEUDO(T)
+ * The set root acts as parent of the tree root, held at link[XTNT_NODE_LEFT]
+ */
+#define XTNT_RBTREE_PSEUDO(T) (&((T)->root))
+
+/**
+ * @def XTNT_RBTREE_OTHER(D)
+ * The opposite child direction of D
+ */
+#define XTNT_RBTREE_OTHER(D) ((D) ^ XTNT_NODE_RIGHT)
+
+/**
+ * @def XTNT_RBTREE_IS_RED(N)
+ * Evaluate to non-zero if N is a red node, NULL leaves are black
+ */
+#define XTNT_RBTREE_IS_RED(N) ((N) != NULL && XTNT_TREE_COLOR(N) == XTNT_TREE_RED)
+
+/**
+ * @brief Store the color in the mode of a node
+ *
+ * @param[in] node The node to color
+ * @param[in] color XTNT_TREE_RED or XTNT_TREE_BLACK
+ */
+static inline void
+xtnt_rbtree_color_set(
+    struct xtnt_node *node,
+    xtnt_uint_t color)
+{
+    XTNT_MODE_SET_VALUE(node->state, color);
+}
+
+/**
+ * @brief Find the least member above a key without locking
+ *
+ * @param[in] tree The tree to read, either an AVL or a red-black tree
+ * @param[in] key The key to compare with
+ * @param[in] strict Non-zero for the least key greater than key, zero for
+ * the least key greater or equal
+ * @return member or NULL
+ */
+static struct xtnt_node *
+xtnt_tree_bound(
+    struct xtnt_node_set *tree,
+    xtnt_uint_t key,
+    xtnt_uint_t strict)
+{
+    struct xtnt_node *bound = NULL;
+    struct xtnt_node *walk = tree->root.link[XTNT_NODE_LEFT];
+    while (walk != NULL) {
+        if (key < walk->key || (!strict && key == walk->key)) {
+            bound = walk;
+            walk = walk->link[XTNT_NODE_LEFT];
+        } else {
+            walk = walk->link[XTNT_NODE_RIGHT];
+        }
+    }
+    return bound;
+}
+
+/**
+ * @brief Rotate subtree once in dir, recoloring the old and new subtree root
+ *
+ * @param[in] root The subtree root
+ * @param[in] dir The direction to rotate toward
+ * @return new subtree root
+ */
+static struct xtnt_node *
+xtnt_rbtree_rotate(
+    struct xtnt_node *root,
+    xtnt_uint_t dir)
+{
+    struct xtnt_node *save = root->link[XTNT_RBTREE_OTHER(dir)];
+    root->link[XTNT_RBTREE_OTHER(dir)] = save->link[dir];
+    save->link[dir] = root;
+    xtnt_rbtree_color_set(root, XTNT_TREE_RED);
+    xtnt_rbtree_color_set(save, XTNT_TREE_BLACK);
+    return save;
+}
+
+/**
+ * @brief Rotate the child of the subtree against dir, then the subtree in dir
+ *
+ * @param[in] root The subtree root
+ * @param[in] dir The direction to rotate toward
+ * @return new subtree root
+ */
+static struct xtnt_node *
+xtnt_rbtree_rotate_double(
+    struct xtnt_node *root,
+    xtnt_uint_t dir)
+{
+    root->link[XTNT_RBTREE_OTHER(dir)] = xtnt_rbtree_rotate(
+        root->link[XTNT_RBTREE_OTHER(dir)], XTNT_RBTREE_OTHER(dir));
+    return xtnt_rbtree_rotate(root, dir);
+}
+
+/**
+ * @brief Insert a node into the tree without locking
+ *
+ * @param[in] tree The tree to insert into
+ * @param[in] node The node to insert
+ * @retval XTNT_ESUCCESS on insert
+ * @retval EEXIST when a node with the same key is a member
+ *
+ * @note This is a single top-down pass; colors are flipped and red
+ * violations rotated away on the descent, so no path is kept.
+ */
+static xtnt_status_t
+xtnt_rbtree_insert_node(
+    struct xtnt_node_set *tree,
+    struct xtnt_node *node)
+{
+    struct xtnt_node *t = XTNT_RBTREE_PSEUDO(tree);
+    struct xtnt_node *g = NULL;
+    struct xtnt_node *p = NULL;
+    struct xtnt_node *q = t->link[XTNT_NODE_LEFT];
+    xtnt_uint_t dir = XTNT_NODE_LEFT;
+    xtnt_uint_t last = XTNT_NODE_LEFT;
+    xtnt_uint_t top = XTNT_NODE_LEFT;
+
+    node->link[XTNT_NODE_LEFT] = node->link[XTNT_NODE_RIGHT] = NULL;
+    xtnt_rbtree_color_set(node, XTNT_TREE_RED);
+    if (q == NULL) {
+        t->link[XTNT_NODE_LEFT] = node;
+        xtnt_rbtree_color_set(node, XTNT_TREE_BLACK);
+        tree->count++;
+        return XTNT_ESUCCESS;
+    }
+
+    while (1) {
+        if (q == NULL) {
+            p->link[dir] = q = node;
+            tree->count++;
+        } else if (XTNT_RBTREE_IS_RED(q->link[XTNT_NODE_LEFT]) &&
+                   XTNT_RBTREE_IS_RED(q->link[XTNT_NODE_RIGHT])) {
+            xtnt_rbtree_color_set(q, XTNT_TREE_RED);
+            xtnt_rbtree_color_set(q->link[XTNT_NODE_LEFT], XTNT_TREE_BLACK);
+            xtnt_rbtree_color_set(q->link[XTNT_NODE_RIGHT], XTNT_TREE_BLACK);
+        }
+
+        // Resolve a red violation between q and its parent
+        if (XTNT_RBTREE_IS_RED(q) && XTNT_RBTREE_IS_RED(p)) {
+            top = (t->link[XTNT_NODE_RIGHT] == g) ? XTNT_NODE_RIGHT : XTNT_NODE_LEFT;
+            if (q == p->link[last]) {
+                t->link[top] = xtnt_rbtree_rotate(g, XTNT_RBTREE_OTHER(last));
+            } else {
+                t->link[top] = xtnt_rbtree_rotate_double(g, XTNT_RBTREE_OTHER(last));
+            }
+        }
+
+        if (q->key == node->key) {
+            break;
+        }
+        last = dir;
+        dir = (q->key < node->key) ? XTNT_NODE_RIGHT : XTNT_NODE_LEFT;
+        if (g != NULL) {
+            t = g;
+        }
+        g = p;
+        p = q;
+        q = q->link[dir];
+    }
+
+    xtnt_rbtree_color_set(tree->root.link[XTNT_NODE_LEFT], XTNT_TREE_BLACK);
+    return (q == node) ? XTNT_ESUCCESS : EEXIST;
+}
+
+/**
+ * @brief Delete the node with key from the tree without locking
+ *
+ * @param[in] tree The tree to delete from
+ * @param[in] key The key of the node to delete
+ * @return deleted node or NULL if key not found
+ *
+ * @note This is a single top-down pass pushing a red node down ahead of
+ * the removal. The in-order neighbour q is spliced out and then takes the
+ * place of the matched node, as nodes are intrusive and cannot swap data.
+ */
+static struct xtnt_node *
+xtnt_rbtree_delete_node(
+    struct xtnt_node_set *tree,
+    xtnt_uint_t key)
+{
+    struct xtnt_node *q = XTNT_RBTREE_PSEUDO(tree);
+    struct xtnt_node *g = NULL;
+    struct xtnt_node *p = NULL;
+    struct xtnt_node *f = NULL;
+    struct xtnt_node *s = NULL;
+    xtnt_uint_t dir = XTNT_NODE_LEFT;
+    xtnt_uint_t last = XTNT_NODE_LEFT;
+    xtnt_uint_t top = XTNT_NODE_LEFT;
+
+    if (q->link[XTNT_NODE_LEFT] == NULL) {
+        return NULL;
+    }
+
+    while (q->link[dir] != NULL) {
+        last = dir;
+        g = p;
+        p = q;
+        q = q->link[dir];
+        dir = (q->key < key) ? XTNT_NODE_RIGHT : XTNT_NODE_LEFT;
+        if (q->key == key) {
+            f = q;
+        }
+
+        // Push a red node down
+        if (!XTNT_RBTREE_IS_RED(q) && !XTNT_RBTREE_IS_RED(q->link[dir])) {
+            if (XTNT_RBTREE_IS_RED(q->link[XTNT_RBTREE_OTHER(dir)])) {
+                p = p->link[last] = xtnt_rbtree_rotate(q, dir);
+            } else if ((s = p->link[XTNT_RBTREE_OTHER(last)]) != NULL) {
+                if (!XTNT_RBTREE_IS_RED(s->link[XTNT_NODE_LEFT]) &&
+                    !XTNT_RBTREE_IS_RED(s->link[XTNT_NODE_RIGHT])) {
+                    xtnt_rbtree_color_set(p, XTNT_TREE_BLACK);
+                    xtnt_rbtree_color_set(s, XTNT_TREE_RED);
+                    xtnt_rbtree_color_set(q, XTNT_TREE_RED);
+                } else {
+                    top = (g->link[XTNT_NODE_RIGHT] == p) ? XTNT_NODE_RIGHT : XTNT_NODE_LEFT;
+                    if (XTNT_RBTREE_IS_RED(s->link[last])) {
+                        g->link[top] = xtnt_rbtree_rotate_double(p, last);
+                    } else {
+                        g->link[top] = xtnt_rbtree_rotate(p, last);
+                    }
+                    xtnt_rbtree_color_set(q, XTNT_TREE_RED);
+                    xtnt_rbtree_color_set(g->link[top], XTNT_TREE_RED);
+                    xtnt_rbtree_color_set(g->link[top]->link[XTNT_NODE_LEFT], XTNT_TREE_BLACK);
+                    xtnt_rbtree_color_set(g->link[top]->link[XTNT_NODE_RIGHT], XTNT_TREE_BLACK);
+                }
+            }
+        }
+    }
+
+    if (f != NULL) {
+        // Splice out q, which has at most one child
+        p->link[(p->link[XTNT_NODE_RIGHT] == q) ? XTNT_NODE_RIGHT : XTNT_NODE_LEFT] =
+            q->link[(q->link[XTNT_NODE_LEFT] == NULL) ? XTNT_NODE_RIGHT : XTNT_NODE_LEFT];
+        if (f != q) {
+            // Move q into the position of f
+            p = XTNT_RBTREE_PSEUDO(tree);
+            dir = XTNT_NODE_LEFT;
+            while (p->link[dir] != f) {
+                p = p->link[dir];
+                dir = (p->key < key) ? XTNT_NODE_RIGHT : XTNT_NODE_LEFT;
+            }
+            q->link[XTNT_NODE_LEFT] = f->link[XTNT_NODE_LEFT];
+            q->link[XTNT_NODE_RIGHT] = f->link[XTNT_NODE_RIGHT];
+            xtnt_rbtree_color_set(q, XTNT_TREE_COLOR(f));
+            p->link[dir] = q;
+        }
+        f->link[XTNT_NODE_LEFT] = f->link[XTNT_NODE_RIGHT] = NULL;
+        tree->count--;
+    }
+
+    if (tree->root.link[XTNT_NODE_LEFT] != NULL) {
+        xtnt_rbtree_color_set(tree->root.link[XTNT_NODE_LEFT], XTNT_TREE_BLACK);
+    }
+    return f;
+}
+
+/**
+ * @brief Delete a node from the tree
+ *
+ * @param[in] tree The tree to delete from
+ * @param[in] key The key of the node to delete
+ * @param[out] deleted The node removed from the tree or NULL if not found
+ * @retval XTNT_ESUCCESS on successful delete or key not found
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ */
+xtnt_status_t
+xtnt_rbtree_delete(
+    struct xtnt_node_set *tree,
+    xtnt_uint_t key,
+    struct xtnt_node **deleted)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(tree)) == XTNT_ESUCCESS) {
+        *deleted = xtnt_rbtree_delete_node(tree, key);
+        res = xtnt_node_set_write_unlock(tree);
+    }
+    return res;
+}
+
+/**
+ * @brief Initialize a Node Set as a red-black tree
+ *
+ * @param[in] tree The Node Set to initialize
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval result of `xtnt_rbtree_initialize_lock()`
+ *
+ * @note This installs the `xtnt_rbtree_if` interface so the `xtnt_set_*`
+ * functions operate on the tree.
+ */
+xtnt_status_t
+xtnt_rbtree_initialize(
+    struct xtnt_node_set *tree)
+{
+    return xtnt_rbtree_initialize_lock(tree, XTNT_SET_LOCK_MUTEX);
+}
+
+/**
+ * @brief Initialize a Node Set as a red-black tree with a locking policy
+ *
+ * @param[in] tree The Node Set to initialize
+ * @param[in] policy The locking policy, see `xtnt_node_set_initialize_lock()`
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval result of `xtnt_node_set_initialize_lock()`
+ */
+xtnt_status_t
+xtnt_rbtree_initialize_lock(
+    struct xtnt_node_set *tree,
+    xtnt_uint_t policy)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_initialize_lock(tree, policy)) == XTNT_ESUCCESS) {
+        tree->fn = &xtnt_rbtree_if;
+    }
+    return res;
+}
+
+/**
+ * @brief Insert a node into the tree
+ *
+ * @param[in] tree The tree to insert into
+ * @param[in] node The node to insert
+ * @retval XTNT_ESUCCESS on insert
+ * @retval EEXIST when a node with the same key is a member
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note The color is stored in the mode bits of the node state.
+ */
+xtnt_status_t
+xtnt_rbtree_insert(
+    struct xtnt_node_set *tree,
+    struct xtnt_node *node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(tree)) == XTNT_ESUCCESS) {
+        res = xtnt_rbtree_insert_node(tree, node);
+        if ((unlock = xtnt_node_set_write_unlock(tree)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Replace the tree member with the same key as node
+ *
+ * @param[in] tree The tree to update
+ * @param[in] node The node to replace with
+ * @param[out] replaced The node that was replaced or NULL if key not found
+ * @retval XTNT_ESUCCESS on replace or key not found
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ */
+xtnt_status_t
+xtnt_rbtree_replace(
+    struct xtnt_node_set *tree,
+    struct xtnt_node *node,
+    struct xtnt_node **replaced)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_node *parent = XTNT_RBTREE_PSEUDO(tree);
+    xtnt_uint_t dir = XTNT_NODE_LEFT;
+    if ((res = xtnt_node_set_write_lock(tree)) == XTNT_ESUCCESS) {
+        *replaced = parent->link[dir];
+        while (*replaced != NULL && (*replaced)->key != node->key) {
+            parent = *replaced;
+            dir = (node->key < parent->key) ? XTNT_NODE_LEFT : XTNT_NODE_RIGHT;
+            *replaced = parent->link[dir];
+        }
+        if (*replaced != NULL) {
+            node->link[XTNT_NODE_LEFT] = (*replaced)->link[XTNT_NODE_LEFT];
+            node->link[XTNT_NODE_RIGHT] = (*replaced)->link[XTNT_NODE_RIGHT];
+            xtnt_rbtree_color_set(node, XTNT_TREE_COLOR(*replaced));
+            parent->link[dir] = node;
+            (*replaced)->link[XTNT_NODE_LEFT] = (*replaced)->link[XTNT_NODE_RIGHT] = NULL;
+        }
+        res = xtnt_node_set_write_unlock(tree);
+    }
+    return res;
+}
+
+/**
+ * @brief Search the tree for key
+ *
+ * @param[in] tree The tree to search
+ * @param[in] key The key to match
+ * @param[out] found Reference to matching node or NULL
+ * @retval XTNT_ESUCCESS on search
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ */
+xtnt_status_t
+xtnt_rbtree_search(
+    struct xtnt_node_set *tree,
+    xtnt_uint_t key,
+    struct xtnt_node **found)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_read_lock(tree)) == XTNT_ESUCCESS) {
+        *found = tree->root.link[XTNT_NODE_LEFT];
+        while (*found != NULL && (*found)->key != key) {
+            *found = (*found)->link[(key < (*found)->key) ? XTNT_NODE_LEFT : XTNT_NODE_RIGHT];
+        }
+        res = xtnt_node_set_read_unlock(tree);
+    }
+    return res;
+}
+
+/**
+ * @brief Search the tree in key order for a node matched by function
+ *
+ * @param[in] tree The tree to search
+ * @param[in] test_fn The test function to call on each node
+ * @param[in] ctx Context passed into the test function
+ * @param[out] found Reference to first matching node or NULL
+ * @retval XTNT_ESUCCESS on search
+ * @retval result of `xtnt_tree_iter_next()`
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ *
+ * @remark The test returns non-zero on match with the signature:
+ *
+ * @code
+ * xtnt_uint_t callback(void *ctx, struct xtnt_node *node);
+ * @endcode
+ *
+ * @note The walk keeps the ancestors still to visit on the path of a
+ * local cursor, see `xtnt_tree_iter_next()`. The path holds
+ * XTNT_SET_ITER_PATH nodes, twice the bits of a key, because the height of
+ * a red-black tree is not bounded by XTNT_TREE_MAX_HEIGHT.
+ */
+xtnt_status_t
+xtnt_rbtree_search_fn(
+    struct xtnt_node_set *tree,
+    void *test_fn,
+    void *ctx,
+    struct xtnt_node **found)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_uint_t (*test)(void *, struct xtnt_node *) = test_fn;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    struct xtnt_set_iter iter;
+    struct xtnt_node *node = NULL;
+    if ((res = xtnt_node_set_read_lock(tree)) == XTNT_ESUCCESS) {
+        *found = NULL;
+        iter.node = NULL;
+        iter.index = 0;
+        while ((res = xtnt_tree_iter_next(tree, &iter, &node)) == XTNT_ESUCCESS && node != NULL) {
+            if (test(ctx, node) != 0) {
+                *found = node;
+                break;
+            }
+            iter.node = node;
+        }
+        if ((unlock = xtnt_node_set_read_unlock(tree)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Push a node and its left descendants onto a cursor's path
+ *
+ * @param[in] iter The cursor
+ * @param[in] walk The subtree root, or NULL
+ * @retval XTNT_ESUCCESS on push
+ * @retval EOVERFLOW when the path is full, the tree is not balanced
+ */
+static inline xtnt_status_t
+xtnt_tree_iter_push(
+    struct xtnt_set_iter *iter,
+    struct xtnt_node *walk)
+{
+    while (walk != NULL) {
+        if (iter->index >= XTNT_SET_ITER_PATH) {
+            return EOVERFLOW;
+        }
+        iter->path[iter->index++] = walk;
+        walk = walk->link[XTNT_NODE_LEFT];
+    }
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Visit the member after the cursor, by ascending key
+ *
+ * @param[in] tree The tree, read locked
+ * @param[in] iter The cursor
+ * @param[out] node The member, or NULL past the greatest key
+ * @retval XTNT_ESUCCESS on visit
+ * @retval EOVERFLOW when the tree is deeper than XTNT_SET_ITER_PATH
+ *
+ * @note This is the next operation of `xtnt_avltree_if` and
+ * `xtnt_rbtree_if`. The cursor keeps the ancestors still to visit in
+ * its path, so a walk of the whole tree costs amortized O(1) per member.
+ */
+xtnt_status_t
+xtnt_tree_iter_next(
+    struct xtnt_node_set *tree,
+    struct xtnt_set_iter *iter,
+    struct xtnt_node **node)
+{
+    xtnt_status_t res = XTNT_ESUCCESS;
+    *node = NULL;
+    if (iter->node == NULL && iter->index == 0) {
+        res = xtnt_tree_iter_push(iter, tree->root.link[XTNT_NODE_LEFT]);
+    }
+    if (res == XTNT_ESUCCESS && iter->index > 0) {
+        *node = iter->path[--iter->index];
+        res = xtnt_tree_iter_push(iter, (*node)->link[XTNT_NODE_RIGHT]);
+    }
+    return res;
+}
+
+/**
+ * @brief Place a cursor before the least member with key or greater
+ *
+ * @param[in] tree The tree, read locked
+ * @param[in] iter The cursor
+ * @param[in] key The least key to visit
+ * @retval XTNT_ESUCCESS on seek
+ * @retval EOVERFLOW when the tree is deeper than XTNT_SET_ITER_PATH
+ *
+ * @note This is the seek operation of `xtnt_avltree_if` and
+ * `xtnt_rbtree_if`, one descent to the greatest key below key. Members
+ * where the descent turns left are pushed on the path for the next visit.
+ */
+xtnt_status_t
+xtnt_tree_iter_seek(
+    struct xtnt_node_set *tree,
+    struct xtnt_set_iter *iter,
+    xtnt_uint_t key)
+{
+    struct xtnt_node *walk = tree->root.link[XTNT_NODE_LEFT];
+    iter->node = NULL;
+    iter->index = 0;
+    while (walk != NULL) {
+        if (walk->key < key) {
+            iter->node = walk;
+            walk = walk->link[XTNT_NODE_RIGHT];
+        } else {
+            if (iter->index >= XTNT_SET_ITER_PATH) {
+                return EOVERFLOW;
+            }
+            iter->path[iter->index++] = walk;
+            walk = walk->link[XTNT_NODE_LEFT];
+        }
+    }
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Find the member with the least key not less than key
+ *
+ * @param[in] tree The tree to search, either an AVL or a red-black tree
+ * @param[in] key The key to compare with
+ * @param[out] found The member, or NULL when every key is less
+ * @retval XTNT_ESUCCESS on search
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ *
+ * @note Start a range scan with `xtnt_set_iter_range()`, or
+ * `xtnt_set_for_each_range()`, which seek the same way.
+ */
+xtnt_status_t
+xtnt_tree_lower_bound(
+    struct xtnt_node_set *tree,
+    xtnt_uint_t key,
+    struct xtnt_node **found)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_read_lock(tree)) == XTNT_ESUCCESS) {
+        *found = xtnt_tree_bound(tree, key, 0);
+        res = xtnt_node_set_read_unlock(tree);
+    }
+    return res;
+}
+
+/**
+ * @brief Find the member with the least key greater than key
+ *
+ * @param[in] tree The tree to search, either an AVL or a red-black tree
+ * @param[in] key The key to compare with
+ * @param[out] found The member, or NULL when no key is greater
+ * @retval XTNT_ESUCCESS on search
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ */
+xtnt_status_t
+xtnt_tree_upper_bound(
+    struct xtnt_node_set *tree,
+    xtnt_uint_t key,
+    struct xtnt_node **found)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_read_lock(tree)) == XTNT_ESUCCESS) {
+        *found = xtnt_tree_bound(tree, key, 1);
+        res = xtnt_node_set_read_unlock(tree);
+    }
+    return res;
+}
+
+/**
+ * @brief Find the node at one end of the tree
+ *
+ * @param[in] tree The tree to read
+ * @param[in] dir XTNT_NODE_LEFT for the first or XTNT_NODE_RIGHT for the last
+ * @param[out] found The node with the least or greatest key, or NULL
+ * @retval XTNT_ESUCCESS on success
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ */
+static xtnt_status_t
+xtnt_rbtree_end(
+    struct xtnt_node_set *tree,
+    xtnt_uint_t dir,
+    struct xtnt_node **found)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_read_lock(tree)) == XTNT_ESUCCESS) {
+        *found = tree->root.link[XTNT_NODE_LEFT];
+        while (*found != NULL && (*found)->link[dir] != NULL) {
+            *found = (*found)->link[dir];
+        }
+        res = xtnt_node_set_read_unlock(tree);
+    }
+    return res;
+}
+
+static xtnt_status_t
+xtnt_rbtree_first(
+    struct xtnt_node_set *tree,
+    struct xtnt_node **first)
+{
+    return xtnt_rbtree_end(tree, XTNT_NODE_LEFT, first);
+}
+
+static xtnt_status_t
+xtnt_rbtree_last(
+    struct xtnt_node_set *tree,
+    struct xtnt_node **last)
+{
+    return xtnt_rbtree_end(tree, XTNT_NODE_RIGHT, last);
+}
+
+static xtnt_status_t
+xtnt_rbtree_root(
+    struct xtnt_node_set *tree,
+    struct xtnt_node **root)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_read_lock(tree)) == XTNT_ESUCCESS) {
+        *root = tree->root.link[XTNT_NODE_LEFT];
+        res = xtnt_node_set_read_unlock(tree);
+    }
+    return res;
+}
+
+static xtnt_status_t
+xtnt_rbtree_remove(
+    struct xtnt_node_set *tree,
+    struct xtnt_node *node)
+{
+    struct xtnt_node *deleted = NULL;
+    return xtnt_rbtree_delete(tree, node->key, &deleted);
+}
+
+/**
+ * @brief Red-black tree Node Set interface
+ */
+const struct xtnt_node_set_if xtnt_rbtree_if = {
+    .index = xtnt_node_set_enotsup_index,
+    .search = xtnt_rbtree_search,
+    .search_fn = xtnt_rbtree_search_fn,
+    .first = xtnt_rbtree_first,
+    .last = xtnt_rbtree_last,
+    .peek = xtnt_node_set_enotsup_out,
+    .root = xtnt_rbtree_root,
+    .state = xtnt_node_set_enotsup_state,
+    .insert = xtnt_rbtree_insert,
+    .insert_at = xtnt_node_set_enotsup_insert_at,
+    .push = xtnt_node_set_enotsup_node,
+    .remove = xtnt_rbtree_remove,
+    .remove_at = xtnt_node_set_enotsup_key,
+    .pop = xtnt_node_set_enotsup_out,
+    .sort = xtnt_node_set_enotsup,
+    .sort_reverse = xtnt_node_set_enotsup,
+    .sort_fn = xtnt_node_set_enotsup_fn,
+    .grow = xtnt_node_set_enotsup,
+    .grow_eval = xtnt_node_set_enotsup_eval,
+    .shrink = xtnt_node_set_enotsup,
+    .shrink_eval = xtnt_node_set_enotsup_eval,
+    .next = xtnt_tree_iter_next,
+    .seek = xtnt_tree_iter_seek
+};
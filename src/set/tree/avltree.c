@@ -29,34 +29,579 @@ SOFTWARE.
 
 #include <extant/set/tree/avltree.h>
 
+/**
+ * @def XTNT_AVLTREE_PSEUDO(T)
+ * The set root acts as parent of the tree root, held at link[XTNT_NODE_LEFT]
+ */
+#define XTNT_AVLTREE_PSEUDO(T) (&((T)->root))
+
+/**
+ * @brief Store balance factor ( -1, 0, 1 ) in the mode of a node
+ *
+ * @param[in] node The node to update
+ * @param[in] balance The balance factor
+ */
+static inline void
+xtnt_avltree_balance_set(
+    struct xtnt_node *node,
+    xtnt_int_t balance)
+{
+    xtnt_uint_t mode = (xtnt_uint_t) balance & XTNT_MODE_MASK;
+    XTNT_MODE_SET_VALUE(node->state, mode);
+}
+
+/**
+ * @brief Delete the node with key from the tree without locking
+ *
+ * @param[in] tree The tree to delete from
+ * @param[in] key The key of the node to delete
+ * @return deleted node or NULL if key not found
+ *
+ * @note The path is kept on a stack bounded by XTNT_TREE_MAX_HEIGHT
+ */
+static struct xtnt_node *
+xtnt_avltree_delete_node(
+    struct xtnt_node_set *tree,
+    xtnt_uint_t key)
+{
+    struct xtnt_node *pa[XTNT_TREE_MAX_HEIGHT + 2];
+    xtnt_uint_t da[XTNT_TREE_MAX_HEIGHT + 2];
+    struct xtnt_node *p = XTNT_AVLTREE_PSEUDO(tree);
+    struct xtnt_node *r = NULL;
+    struct xtnt_node *s = NULL;
+    struct xtnt_node *w = NULL;
+    struct xtnt_node *x = NULL;
+    struct xtnt_node *y = NULL;
+    xtnt_uint_t dir = XTNT_NODE_LEFT;
+    xtnt_int_t balance = XTNT_ZERO;
+    xtnt_int_t k = XTNT_ZERO;
+    xtnt_int_t j = XTNT_ZERO;
+
+    // Descend recording the path
+    do {
+        pa[k] = p;
+        da[k++] = dir;
+        if ((p = p->link[dir]) == NULL) {
+            return NULL;
+        }
+        dir = (key < p->key) ? XTNT_NODE_LEFT : XTNT_NODE_RIGHT;
+    } while (p->key != key);
+
+    // Unlink the node, replacing it with its successor when it has two children
+    if (p->link[XTNT_NODE_RIGHT] == NULL) {
+        pa[k - 1]->link[da[k - 1]] = p->link[XTNT_NODE_LEFT];
+    } else {
+        r = p->link[XTNT_NODE_RIGHT];
+        if (r->link[XTNT_NODE_LEFT] == NULL) {
+            r->link[XTNT_NODE_LEFT] = p->link[XTNT_NODE_LEFT];
+            xtnt_avltree_balance_set(r, XTNT_AVLTREE_BALANCE(p));
+            pa[k - 1]->link[da[k - 1]] = r;
+            da[k] = XTNT_NODE_RIGHT;
+            pa[k++] = r;
+        } else {
+            j = k++;
+            while (1) {
+                da[k] = XTNT_NODE_LEFT;
+                pa[k++] = r;
+                s = r->link[XTNT_NODE_LEFT];
+                if (s->link[XTNT_NODE_LEFT] == NULL) {
+                    break;
+                }
+                r = s;
+            }
+            s->link[XTNT_NODE_LEFT] = p->link[XTNT_NODE_LEFT];
+            r->link[XTNT_NODE_LEFT] = s->link[XTNT_NODE_RIGHT];
+            s->link[XTNT_NODE_RIGHT] = p->link[XTNT_NODE_RIGHT];
+            xtnt_avltree_balance_set(s, XTNT_AVLTREE_BALANCE(p));
+            pa[j - 1]->link[da[j - 1]] = s;
+            da[j] = XTNT_NODE_RIGHT;
+            pa[j] = s;
+        }
+    }
+
+    // Rebalance back up the path
+    while (--k > 0) {
+        y = pa[k];
+        if (da[k] == XTNT_NODE_LEFT) {
+            balance = XTNT_AVLTREE_BALANCE(y) + 1;
+            if (balance != 2) {
+                xtnt_avltree_balance_set(y, balance);
+                if (balance == 1) {
+                    break;
+                }
+            } else {
+                x = y->link[XTNT_NODE_RIGHT];
+                if (XTNT_AVLTREE_BALANCE(x) == -1) {
+                    w = x->link[XTNT_NODE_LEFT];
+                    x->link[XTNT_NODE_LEFT] = w->link[XTNT_NODE_RIGHT];
+                    w->link[XTNT_NODE_RIGHT] = x;
+                    y->link[XTNT_NODE_RIGHT] = w->link[XTNT_NODE_LEFT];
+                    w->link[XTNT_NODE_LEFT] = y;
+                    xtnt_avltree_balance_set(x, (XTNT_AVLTREE_BALANCE(w) == -1) ? 1 : 0);
+                    xtnt_avltree_balance_set(y, (XTNT_AVLTREE_BALANCE(w) == 1) ? -1 : 0);
+                    xtnt_avltree_balance_set(w, 0);
+                    pa[k - 1]->link[da[k - 1]] = w;
+                } else {
+                    y->link[XTNT_NODE_RIGHT] = x->link[XTNT_NODE_LEFT];
+                    x->link[XTNT_NODE_LEFT] = y;
+                    pa[k - 1]->link[da[k - 1]] = x;
+                    if (XTNT_AVLTREE_BALANCE(x) == 0) {
+                        xtnt_avltree_balance_set(x, -1);
+                        xtnt_avltree_balance_set(y, 1);
+                        break;
+                    }
+                    xtnt_avltree_balance_set(x, 0);
+                    xtnt_avltree_balance_set(y, 0);
+                }
+            }
+        } else {
+            balance = XTNT_AVLTREE_BALANCE(y) - 1;
+            if (balance != -2) {
+                xtnt_avltree_balance_set(y, balance);
+                if (balance == -1) {
+                    break;
+                }
+            } else {
+                x = y->link[XTNT_NODE_LEFT];
+                if (XTNT_AVLTREE_BALANCE(x) == 1) {
+                    w = x->link[XTNT_NODE_RIGHT];
+                    x->link[XTNT_NODE_RIGHT] = w->link[XTNT_NODE_LEFT];
+                    w->link[XTNT_NODE_LEFT] = x;
+                    y->link[XTNT_NODE_LEFT] = w->link[XTNT_NODE_RIGHT];
+                    w->link[XTNT_NODE_RIGHT] = y;
+                    xtnt_avltree_balance_set(x, (XTNT_AVLTREE_BALANCE(w) == 1) ? -1 : 0);
+                    xtnt_avltree_balance_set(y, (XTNT_AVLTREE_BALANCE(w) == -1) ? 1 : 0);
+                    xtnt_avltree_balance_set(w, 0);
+                    pa[k - 1]->link[da[k - 1]] = w;
+                } else {
+                    y->link[XTNT_NODE_LEFT] = x->link[XTNT_NODE_RIGHT];
+                    x->link[XTNT_NODE_RIGHT] = y;
+                    pa[k - 1]->link[da[k - 1]] = x;
+                    if (XTNT_AVLTREE_BALANCE(x) == 0) {
+                        xtnt_avltree_balance_set(x, 1);
+                        xtnt_avltree_balance_set(y, -1);
+                        break;
+                    }
+                    xtnt_avltree_balance_set(x, 0);
+                    xtnt_avltree_balance_set(y, 0);
+                }
+            }
+        }
+    }
+    p->link[XTNT_NODE_LEFT] = p->link[XTNT_NODE_RIGHT] = NULL;
+    tree->count--;
+    return p;
+}
+
+/**
+ * @brief Insert a node into the tree without locking
+ *
+ * @param[in] tree The tree to insert into
+ * @param[in] node The node to insert
+ * @retval XTNT_ESUCCESS on insert
+ * @retval EEXIST when a node with the same key is a member
+ * @retval EOVERFLOW when the tree would grow taller than XTNT_TREE_MAX_HEIGHT
+ *
+ * @note A new node deeper than XTNT_TREE_MAX_HEIGHT is still inserted when
+ * the rotation at y absorbs it, as the subtree of y keeps its height.
+ */
+static xtnt_status_t
+xtnt_avltree_insert_node(
+    struct xtnt_node_set *tree,
+    struct xtnt_node *node)
+{
+    xtnt_uint_t da[XTNT_TREE_MAX_HEIGHT + 1];
+    struct xtnt_node *z = XTNT_AVLTREE_PSEUDO(tree);
+    struct xtnt_node *y = tree->root.link[XTNT_NODE_LEFT];
+    struct xtnt_node *q = z;
+    struct xtnt_node *p = y;
+    struct xtnt_node *w = NULL;
+    struct xtnt_node *x = NULL;
+    xtnt_uint_t dir = XTNT_NODE_LEFT;
+    xtnt_uint_t depth = XTNT_ZERO;
+    xtnt_int_t balance = XTNT_ZERO;
+    xtnt_int_t k = XTNT_ZERO;
+
+    // Descend, remembering the deepest unbalanced node y and its parent z
+    while (p != NULL) {
+        if (node->key == p->key) {
+            return EEXIST;
+        }
+        if (++depth > XTNT_TREE_MAX_HEIGHT) {
+            return EOVERFLOW;
+        }
+        if (XTNT_AVLTREE_BALANCE(p) != 0) {
+            z = q;
+            y = p;
+            k = XTNT_ZERO;
+        }
+        dir = (node->key < p->key) ? XTNT_NODE_LEFT : XTNT_NODE_RIGHT;
+        da[k++] = dir;
+        q = p;
+        p = p->link[dir];
+    }
+
+    // Without a rotation at y the tree grows to the depth of the new node
+    if (depth >= XTNT_TREE_MAX_HEIGHT &&
+        !(XTNT_AVLTREE_BALANCE(y) == -1 && da[0] == XTNT_NODE_LEFT) &&
+        !(XTNT_AVLTREE_BALANCE(y) == 1 && da[0] == XTNT_NODE_RIGHT)) {
+        return EOVERFLOW;
+    }
+
+    node->link[XTNT_NODE_LEFT] = node->link[XTNT_NODE_RIGHT] = NULL;
+    xtnt_avltree_balance_set(node, 0);
+    q->link[dir] = node;
+    tree->count++;
+    if (y == NULL) {
+        return XTNT_ESUCCESS;
+    }
+
+    // Update balance factors from y down to the new node, holding the
+    // balance of y aside as +/-2 does not fit in the mode bits
+    balance = XTNT_AVLTREE_BALANCE(y) + ((da[0] == XTNT_NODE_LEFT) ? -1 : 1);
+    for (p = y->link[da[0]], k = 1; p != node; p = p->link[da[k]], k++) {
+        xtnt_avltree_balance_set(p, XTNT_AVLTREE_BALANCE(p) + ((da[k] == XTNT_NODE_LEFT) ? -1 : 1));
+    }
+
+    if (balance == -2) {
+        x = y->link[XTNT_NODE_LEFT];
+        if (XTNT_AVLTREE_BALANCE(x) == -1) {
+            w = x;
+            y->link[XTNT_NODE_LEFT] = x->link[XTNT_NODE_RIGHT];
+            x->link[XTNT_NODE_RIGHT] = y;
+            xtnt_avltree_balance_set(x, 0);
+            xtnt_avltree_balance_set(y, 0);
+        } else {
+            w = x->link[XTNT_NODE_RIGHT];
+            x->link[XTNT_NODE_RIGHT] = w->link[XTNT_NODE_LEFT];
+            w->link[XTNT_NODE_LEFT] = x;
+            y->link[XTNT_NODE_LEFT] = w->link[XTNT_NODE_RIGHT];
+            w->link[XTNT_NODE_RIGHT] = y;
+            xtnt_avltree_balance_set(x, (XTNT_AVLTREE_BALANCE(w) == 1) ? -1 : 0);
+            xtnt_avltree_balance_set(y, (XTNT_AVLTREE_BALANCE(w) == -1) ? 1 : 0);
+            xtnt_avltree_balance_set(w, 0);
+        }
+    } else if (balance == 2) {
+        x = y->link[XTNT_NODE_RIGHT];
+        if (XTNT_AVLTREE_BALANCE(x) == 1) {
+            w = x;
+            y->link[XTNT_NODE_RIGHT] = x->link[XTNT_NODE_LEFT];
+            x->link[XTNT_NODE_LEFT] = y;
+            xtnt_avltree_balance_set(x, 0);
+            xtnt_avltree_balance_set(y, 0);
+        } else {
+            w = x->link[XTNT_NODE_LEFT];
+            x->link[XTNT_NODE_LEFT] = w->link[XTNT_NODE_RIGHT];
+            w->link[XTNT_NODE_RIGHT] = x;
+            y->link[XTNT_NODE_RIGHT] = w->link[XTNT_NODE_LEFT];
+            w->link[XTNT_NODE_LEFT] = y;
+            xtnt_avltree_balance_set(x, (XTNT_AVLTREE_BALANCE(w) == -1) ? 1 : 0);
+            xtnt_avltree_balance_set(y, (XTNT_AVLTREE_BALANCE(w) == 1) ? -1 : 0);
+            xtnt_avltree_balance_set(w, 0);
+        }
+    } else {
+        xtnt_avltree_balance_set(y, balance);
+        return XTNT_ESUCCESS;
+    }
+    z->link[(y == z->link[XTNT_NODE_LEFT]) ? XTNT_NODE_LEFT : XTNT_NODE_RIGHT] = w;
+    return XTNT_ESUCCESS;
+}
+
+/**
+ * @brief Delete a node from the tree
+ *
+ * @param[in] tree The tree to delete from
+ * @param[in] key The key of the node to delete
+ * @param[out] deleted The node removed from the tree or NULL if not found
+ * @retval XTNT_ESUCCESS on successful delete or key not found
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ */
 xtnt_status_t
 xtnt_avltree_delete(
     struct xtnt_node_set *tree,
     xtnt_uint_t key,
-    struct xtnt_node **deleted);
+    struct xtnt_node **deleted)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(tree)) == XTNT_ESUCCESS) {
+        *deleted = xtnt_avltree_delete_node(tree, key);
+        res = xtnt_node_set_write_unlock(tree);
+    }
+    return res;
+}
 
+/**
+ * @brief Initialize a Node Set as an AVL tree
+ *
+ * @param[in] tree The Node Set to initialize
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval result of `xtnt_avltree_initialize_lock()`
+ *
+ * @note This installs the `xtnt_avltree_if` interface so the `xtnt_set_*`
+ * functions operate on the tree.
+ */
+xtnt_status_t
+xtnt_avltree_initialize(
+    struct xtnt_node_set *tree)
+{
+    return xtnt_avltree_initialize_lock(tree, XTNT_SET_LOCK_MUTEX);
+}
+
+/**
+ * @brief Initialize a Node Set as a AVL tree with a locking policy
+ *
+ * @param[in] tree The Node Set to initialize
+ * @param[in] policy The locking policy, see `xtnt_node_set_initialize_lock()`
+ * @retval XTNT_ESUCCESS on initialization
+ * @retval result of `xtnt_node_set_initialize_lock()`
+ */
+xtnt_status_t
+xtnt_avltree_initialize_lock(
+    struct xtnt_node_set *tree,
+    xtnt_uint_t policy)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_initialize_lock(tree, policy)) == XTNT_ESUCCESS) {
+        tree->fn = &xtnt_avltree_if;
+    }
+    return res;
+}
+
+/**
+ * @brief Insert a node into the tree
+ *
+ * @param[in] tree The tree to insert into
+ * @param[in] node The node to insert
+ * @retval XTNT_ESUCCESS on insert
+ * @retval EEXIST when a node with the same key is a member
+ * @retval EOVERFLOW when the insert would exceed XTNT_TREE_MAX_HEIGHT
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ *
+ * @note The balance factor is stored in the mode bits of the node state.
+ */
 xtnt_status_t
 xtnt_avltree_insert(
     struct xtnt_node_set *tree,
-    struct xtnt_node *node);
+    struct xtnt_node *node)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_status_t unlock = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_write_lock(tree)) == XTNT_ESUCCESS) {
+        res = xtnt_avltree_insert_node(tree, node);
+        if ((unlock = xtnt_node_set_write_unlock(tree)) != XTNT_ESUCCESS) {
+            res = unlock;
+        }
+    }
+    return res;
+}
 
+/**
+ * @brief Replace the tree member with the same key as node
+ *
+ * @param[in] tree The tree to update
+ * @param[in] node The node to replace with
+ * @param[out] replaced The node that was replaced or NULL if key not found
+ * @retval XTNT_ESUCCESS on replace or key not found
+ * @retval return value of `xtnt_node_set_write_lock()` or
+ * `xtnt_node_set_write_unlock()`
+ */
 xtnt_status_t
 xtnt_avltree_replace(
     struct xtnt_node_set *tree,
     struct xtnt_node *node,
-    struct xtnt_node **replaced);
+    struct xtnt_node **replaced)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    struct xtnt_node *parent = XTNT_AVLTREE_PSEUDO(tree);
+    xtnt_uint_t dir = XTNT_NODE_LEFT;
+    if ((res = xtnt_node_set_write_lock(tree)) == XTNT_ESUCCESS) {
+        *replaced = parent->link[dir];
+        while (*replaced != NULL && (*replaced)->key != node->key) {
+            parent = *replaced;
+            dir = (node->key < parent->key) ? XTNT_NODE_LEFT : XTNT_NODE_RIGHT;
+            *replaced = parent->link[dir];
+        }
+        if (*replaced != NULL) {
+            node->link[XTNT_NODE_LEFT] = (*replaced)->link[XTNT_NODE_LEFT];
+            node->link[XTNT_NODE_RIGHT] = (*replaced)->link[XTNT_NODE_RIGHT];
+            xtnt_avltree_balance_set(node, XTNT_AVLTREE_BALANCE(*replaced));
+            parent->link[dir] = node;
+            (*replaced)->link[XTNT_NODE_LEFT] = (*replaced)->link[XTNT_NODE_RIGHT] = NULL;
+        }
+        res = xtnt_node_set_write_unlock(tree);
+    }
+    return res;
+}
 
+/**
+ * @brief Search the tree for key
+ *
+ * @param[in] tree The tree to search
+ * @param[in] key The key to match
+ * @param[out] found Reference to matching node or NULL
+ * @retval XTNT_ESUCCESS on search
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ */
 xtnt_status_t
 xtnt_avltree_search(
     struct xtnt_node_set *tree,
     xtnt_uint_t key,
-    struct xtnt_node **found);
+    struct xtnt_node **found)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_read_lock(tree)) == XTNT_ESUCCESS) {
+        *found = tree->root.link[XTNT_NODE_LEFT];
+        while (*found != NULL && (*found)->key != key) {
+            *found = (*found)->link[(key < (*found)->key) ? XTNT_NODE_LEFT : XTNT_NODE_RIGHT];
+        }
+        res = xtnt_node_set_read_unlock(tree);
+    }
+    return res;
+}
 
+/**
+ * @brief Search the tree in key order for a node matched by function
+ *
+ * @param[in] tree The tree to search
+ * @param[in] test_fn The test function to call on each node
+ * @param[in] ctx Context passed into the test function
+ * @param[out] found Reference to first matching node or NULL
+ * @retval XTNT_ESUCCESS on search
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ *
+ * @remark The test returns non-zero on match with the signature:
+ *
+ * @code
+ * xtnt_uint_t callback(void *ctx, struct xtnt_node *node);
+ * @endcode
+ */
 xtnt_status_t
 xtnt_avltree_search_fn(
     struct xtnt_node_set *tree,
     void *test_fn,
     void *ctx,
-    struct xtnt_node **found);
+    struct xtnt_node **found)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    xtnt_uint_t (*test)(void *, struct xtnt_node *) = test_fn;
+    struct xtnt_node *stack[XTNT_TREE_MAX_HEIGHT + 1];
+    struct xtnt_node *node = NULL;
+    xtnt_uint_t height = XTNT_ZERO;
+    if ((res = xtnt_node_set_read_lock(tree)) == XTNT_ESUCCESS) {
+        *found = NULL;
+        node = tree->root.link[XTNT_NODE_LEFT];
+        while (node != NULL || height > XTNT_ZERO) {
+            if (node != NULL) {
+                stack[height++] = node;
+                node = node->link[XTNT_NODE_LEFT];
+            } else {
+                node = stack[--height];
+                if (test(ctx, node) != 0) {
+                    *found = node;
+                    break;
+                }
+                node = node->link[XTNT_NODE_RIGHT];
+            }
+        }
+        res = xtnt_node_set_read_unlock(tree);
+    }
+    return res;
+}
+
+/**
+ * @brief Find the node at one end of the tree
+ *
+ * @param[in] tree The tree to read
+ * @param[in] dir XTNT_NODE_LEFT for the first or XTNT_NODE_RIGHT for the last
+ * @param[out] found The node with the least or greatest key, or NULL
+ * @retval XTNT_ESUCCESS on success
+ * @retval return value of `xtnt_node_set_read_lock()` or
+ * `xtnt_node_set_read_unlock()`
+ */
+static xtnt_status_t
+xtnt_avltree_end(
+    struct xtnt_node_set *tree,
+    xtnt_uint_t dir,
+    struct xtnt_node **found)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_read_lock(tree)) == XTNT_ESUCCESS) {
+        *found = tree->root.link[XTNT_NODE_LEFT];
+        while (*found != NULL && (*found)->link[dir] != NULL) {
+            *found = (*found)->link[dir];
+        }
+        res = xtnt_node_set_read_unlock(tree);
+    }
+    return res;
+}
 
+static xtnt_status_t
+xtnt_avltree_first(
+    struct xtnt_node_set *tree,
+    struct xtnt_node **first)
+{
+    return xtnt_avltree_end(tree, XTNT_NODE_LEFT, first);
+}
+
+static xtnt_status_t
+xtnt_avltree_last(
+    struct xtnt_node_set *tree,
+    struct xtnt_node **last)
+{
+    return xtnt_avltree_end(tree, XTNT_NODE_RIGHT, last);
+}
+
+static xtnt_status_t
+xtnt_avltree_root(
+    struct xtnt_node_set *tree,
+    struct xtnt_node **root)
+{
+    xtnt_status_t res = XTNT_EFAILURE;
+    if ((res = xtnt_node_set_read_lock(tree)) == XTNT_ESUCCESS) {
+        *root = tree->root.link[XTNT_NODE_LEFT];
+        res = xtnt_node_set_read_unlock(tree);
+    }
+    return res;
+}
+
+static xtnt_status_t
+xtnt_avltree_remove(
+    struct xtnt_node_set *tree,
+    struct xtnt_node *node)
+{
+    struct xtnt_node *deleted = NULL;
+    return xtnt_avltree_delete(tree, node->key, &deleted);
+}
 
+/**
+ * @brief AVL tree Node Set interface
+ */
+const struct xtnt_node_set_if xtnt_avltree_if = {
+    .index = xtnt_node_set_enotsup_index,
+    .search = xtnt_avltree_search,
+    .search_fn = xtnt_avltree_search_fn,
+    .first = xtnt_avltree_first,
+    .last = xtnt_avltree_last,
+    .peek = xtnt_node_set_enotsup_out,
+    .root = xtnt_avltree_root,
+    .state = xtnt_node_set_enotsup_state,
+    .insert = xtnt_avltree_insert,
+    .insert_at = xtnt_node_set_enotsup_insert_at,
+    .push = xtnt_node_set_enotsup_node,
+    .remove = xtnt_avltree_remove,
+    .remove_at = xtnt_node_set_enotsup_key,
+    .pop = xtnt_node_set_enotsup_out,
+    .sort = xtnt_node_set_enotsup,
+    .sort_reverse = xtnt_node_set_enotsup,
+    .sort_fn = xtnt_node_set_enotsup_fn,
+    .grow = xtnt_node_set_enotsup,
+    .grow_eval = xtnt_node_set_enotsup_eval,
+    .shrink = xtnt_node_set_enotsup,
+    .shrink_eval = xtnt_node_set_enotsup_eval,
+    .next = xtnt_tree_iter_next,
+    .seek = xtnt_tree_iter_seek
+};
@@ -30,6 +30,7 @@ SOFTWARE.
 #include <check.h>
 #include <extant/extant.h>
 #include <stdio.h>
+#include <string.h>
 
 START_TEST (test_XTNT_ZERO_returns_0)
 {
@@ -170,12 +171,14 @@ START_TEST (test_XTNT_LOCK_SET_VALUE_sets_correctly)
 }
 END_TEST
 
-START_TEST (test_xtnt_hash_returns_3817775)
+START_TEST (test_xtnt_hash_known_answer)
 {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ && XTNT_HASH_SEED == 0
   char name[] = "This is a string";
   xtnt_uint_t hash = xtnt_hash(name);
-  ck_assert_msg(hash == 3817775,
-		"expecting 3817775 but got %u instead", hash);
+  ck_assert_msg(hash == (xtnt_uint_t) UINT64_C(0x6a0be7099d688f31),
+		"expecting %u but got %u instead", (xtnt_uint_t) UINT64_C(0x6a0be7099d688f31), hash);
+#endif /* little endian with the default seed */
 }
 END_TEST
 
@@ -197,7 +200,7 @@ Suite * xtnt_common_suite(void)
     tcase_add_test(tc_common, test_XTNT_MODE_VALUE_results_are_correct);
     tcase_add_test(tc_common, test_XTNT_LOCK_results_are_correct);
     tcase_add_test(tc_common, test_XTNT_LOCK_VALUE_results_are_correct);
-    tcase_add_test(tc_common, test_xtnt_hash_returns_3817775);
+    tcase_add_test(tc_common, test_xtnt_hash_known_answer);
     suite_add_tcase(s, tc_common);
 
     return s;
@@ -0,0 +1,187 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <check.h>
+#include <extant/hash.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#define HASH_BUCKETS (256)
+#define HASH_KEYS (HASH_BUCKETS * 64)
+
+unsigned char bytes[256];
+
+void setup(void)
+{
+    for (int i = 0; i < (int) sizeof(bytes); i++) {
+        bytes[i] = (unsigned char) (i * 31 + 7);
+    }
+}
+
+void teardown(void)
+{
+}
+
+START_TEST (test_xtnt_hash_bytes_deterministic)
+{
+    char key[] = "This is a string";
+    uint64_t hash = xtnt_hash_bytes(key, strlen(key), 0);
+    ck_assert_msg(hash == xtnt_hash_bytes(key, strlen(key), 0),
+        "Expected equal hashes of equal keys");
+    ck_assert_msg(hash != xtnt_hash_bytes(key, strlen(key), 1),
+        "Expected seed to change the hash");
+    ck_assert_msg(hash != xtnt_hash_bytes(key, strlen(key) - 1, 0),
+        "Expected length to change the hash");
+}
+END_TEST
+
+START_TEST (test_xtnt_hash_bytes_known_answers)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    /* Lengths around each tail and block size, hashed with seed 0 */
+    static const struct {
+        size_t len;
+        uint64_t hash;
+    } known[] = {
+        { 0, UINT64_C(0x0409638ee2bde459) },
+        { 3, UINT64_C(0xaa4dada6d17eebb0) },
+        { 4, UINT64_C(0x8d9d4657e96cc294) },
+        { 8, UINT64_C(0x9654832f28858268) },
+        { 16, UINT64_C(0x36b53f8551944db0) },
+        { 17, UINT64_C(0x904849bdd1e93c7c) },
+        { 48, UINT64_C(0x3ec1b034dbe02bd7) },
+        { 49, UINT64_C(0x30161cb91c8df53e) },
+        { 100, UINT64_C(0xe0c3d79ee1609ba9) }
+    };
+    for (size_t idx = 0; idx < sizeof(known) / sizeof(known[0]); idx++) {
+        uint64_t hash = xtnt_hash_bytes(bytes, known[idx].len, 0);
+        ck_assert_msg(hash == known[idx].hash,
+            "Expected hash 0x%016llx of length %zu, but got 0x%016llx",
+            (unsigned long long) known[idx].hash, known[idx].len, (unsigned long long) hash);
+    }
+#endif /* if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ */
+}
+END_TEST
+
+START_TEST (test_xtnt_hash_bytes_lengths)
+{
+    uint64_t hash[sizeof(bytes) + 1];
+    unsigned char copy[sizeof(bytes) + 1];
+    for (size_t len = 0; len <= sizeof(bytes); len++) {
+        hash[len] = xtnt_hash_bytes(bytes, len, 0);
+        for (size_t prev = 0; prev < len; prev++) {
+            ck_assert_msg(hash[prev] != hash[len],
+                "Expected prefixes of length %zu and %zu to differ", prev, len);
+        }
+        /* Unaligned copies hash the same */
+        memcpy(copy + 1, bytes, len);
+        ck_assert_msg(xtnt_hash_bytes(copy + 1, len, 0) == hash[len],
+            "Expected unaligned key of length %zu to hash equal", len);
+    }
+}
+END_TEST
+
+START_TEST (test_xtnt_hash_bytes_avalanche)
+{
+    unsigned char key[64];
+    uint64_t base, flipped;
+    double total = 0.0;
+    int trials = 0;
+    memcpy(key, bytes, sizeof(key));
+    for (size_t len = 1; len <= sizeof(key); len += 7) {
+        base = xtnt_hash_bytes(key, len, 0);
+        for (size_t bit = 0; bit < len * 8; bit++) {
+            key[bit / 8] ^= (unsigned char) (1 << (bit % 8));
+            flipped = xtnt_hash_bytes(key, len, 0);
+            key[bit / 8] ^= (unsigned char) (1 << (bit % 8));
+            total += __builtin_popcountll(base ^ flipped);
+            trials++;
+        }
+    }
+    ck_assert_msg(total / trials > 30.0 && total / trials < 34.0,
+        "Expected a flipped bit to flip about half of the hash, but got %.2f",
+        total / trials);
+}
+END_TEST
+
+START_TEST (test_xtnt_hash_bytes_distribution)
+{
+    unsigned int bucket[HASH_BUCKETS] = { 0 };
+    char key[32];
+    double chi = 0.0;
+    double expect = (double) HASH_KEYS / HASH_BUCKETS;
+    for (int i = 0; i < HASH_KEYS; i++) {
+        /* Long keys differing only near the start, which the old hash folded away */
+        snprintf(key, sizeof(key), "%08d-common-suffix-bytes", i);
+        bucket[xtnt_hash_bytes(key, strlen(key), 0) % HASH_BUCKETS]++;
+    }
+    for (int b = 0; b < HASH_BUCKETS; b++) {
+        chi += ((bucket[b] - expect) * (bucket[b] - expect)) / expect;
+    }
+    /* 255 degrees of freedom, p < 0.001 above 330 */
+    ck_assert_msg(chi < 330.0,
+        "Expected uniform buckets, but chi-squared was %.1f", chi);
+}
+END_TEST
+
+Suite * xtnt_hash_suite(void)
+{
+    Suite *s;
+    TCase *tc_hash;
+
+    s = suite_create("xtnt_hash");
+
+    tc_hash = tcase_create("Hash");
+
+    tcase_add_checked_fixture(tc_hash, setup, teardown);
+    tcase_add_test(tc_hash, test_xtnt_hash_bytes_deterministic);
+    tcase_add_test(tc_hash, test_xtnt_hash_bytes_known_answers);
+    tcase_add_test(tc_hash, test_xtnt_hash_bytes_lengths);
+    tcase_add_test(tc_hash, test_xtnt_hash_bytes_avalanche);
+    tcase_add_test(tc_hash, test_xtnt_hash_bytes_distribution);
+    suite_add_tcase(s, tc_hash);
+
+    return s;
+}
+
+int main(void)
+{
+    int failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = xtnt_hash_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_VERBOSE);
+    failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (failed == 0) ? 0 : failed;
+}
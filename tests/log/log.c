@@ -27,23 +27,317 @@ SOFTWARE.
 ===============================================================================
 */
 
+#define _GNU_SOURCE // RTLD_NEXT
+
 #include <check.h>
 #include <extant/log.h>
 
+#include <dlfcn.h>
 #include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define LOG_MSG "logged entry\n"
+
+struct xtnt_logger *logger;
+pthread_t logger_thread;
+struct xtnt_logger_entry entry;
+char entry_msg[32];
+
+char *
+format_entry(struct xtnt_logger_entry *e)
+{
+    snprintf(e->msg, e->msg_length, LOG_MSG);
+    return e->msg;
+}
 
-struct xtnt_logger *logger; 
+#define RECORD_THREADS 4
+#define RECORD_COUNT 2000
+
+struct record_data
+{
+    unsigned int thread;
+    unsigned int index;
+};
+
+char *
+format_record(struct xtnt_logger_entry *e)
+{
+    struct record_data *d = e->data;
+    snprintf(e->msg, e->msg_length, "%u %u\n", d->thread, d->index);
+    return e->msg;
+}
+
+char *
+format_large(struct xtnt_logger_entry *e)
+{
+    memset(e->msg, 'x', e->msg_length - 2);
+    e->msg[e->msg_length - 2] = '\n';
+    e->msg[e->msg_length - 1] = '\0';
+    return e->msg;
+}
+
+void *
+record_producer(void *arg)
+{
+    struct record_data d = { (unsigned int) (uintptr_t) arg, 0 };
+    xtnt_status_t res;
+    for (; d.index < RECORD_COUNT; d.index++) {
+        while ((res = xtnt_log_record(logger, format_record, XTNT_LOG_INFO,
+                                      &d, sizeof(d))) == EAGAIN) {
+            sched_yield();
+        }
+        if (res != XTNT_ESUCCESS) {
+            return (void *) (uintptr_t) res;
+        }
+    }
+    return NULL;
+}
 
 void setup(void)
 {
+    if (xtnt_logger_create(tmpfile(), NULL, &logger) != XTNT_ESUCCESS) {
+        ck_abort_msg("Failed to create logger in setup.");
+    }
+    if (pthread_create(&logger_thread, NULL, (void *) xtnt_logger_process, logger) != 0) {
+        ck_abort_msg("Failed to start logger thread in setup.");
+    }
 }
 
 void teardown(void)
 {
+    fclose(logger->log);
+    xtnt_logger_destroy(&logger);
 }
 
 START_TEST (test_xtnt_log)
 {
+    char buf[64] = { 0 };
+    xtnt_status_t res;
+    usleep(10000); /* let the consumer go to sleep on the empty queue */
+    xtnt_logger_entry_initialize(&entry, NULL, entry_msg, sizeof(entry_msg),
+                                 format_entry, XTNT_LOG_INFO);
+    res = xtnt_log(logger, &entry);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected log to succeed, but got %d", res);
+    xtnt_logger_exit(logger);
+    pthread_join(logger_thread, NULL);
+    ck_assert_msg(logger->queue.count == 0,
+        "Expected queue drained before exit, but got %u", logger->queue.count);
+    rewind(logger->log);
+    ck_assert_msg(fgets(buf, sizeof(buf), logger->log) != NULL &&
+                  strcmp(buf, LOG_MSG) == 0,
+        "Expected entry written to log, but got '%s'", buf);
+}
+END_TEST
+
+START_TEST (test_xtnt_logger_exit_idle)
+{
+    usleep(10000); /* let the consumer go to sleep on the empty queue */
+    ck_assert_msg(logger->waiting != 0,
+        "Expected idle consumer to be waiting");
+    xtnt_logger_exit(logger);
+    ck_assert_msg(pthread_join(logger_thread, NULL) == 0,
+        "Expected sleeping consumer to wake and exit");
+}
+END_TEST
+
+START_TEST (test_xtnt_logger_cancel_idle)
+{
+    void *status = NULL;
+    usleep(10000); /* let the consumer go to sleep on the empty queue */
+    pthread_cancel(logger_thread);
+    pthread_join(logger_thread, &status);
+    ck_assert_msg(status == PTHREAD_CANCELED,
+        "Expected sleeping consumer to be cancelled");
+    ck_assert_msg(pthread_mutex_trylock(&(logger->lock)) == 0,
+        "Expected logger lock released on cancel");
+    pthread_mutex_unlock(&(logger->lock));
+}
+END_TEST
+
+START_TEST (test_xtnt_logger_entry_acquire)
+{
+    struct xtnt_logger_entry *pooled = NULL;
+    struct xtnt_logger_entry *large = NULL;
+    char buf[64] = { 0 };
+    xtnt_status_t res;
+    res = xtnt_logger_entry_acquire(logger, sizeof(xtnt_uint_t), 32,
+                                    format_entry, XTNT_LOG_INFO, &pooled);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected acquire to succeed, but got %d", res);
+    ck_assert_msg(pooled->pool == logger->entries,
+        "Expected entry from the logger pool");
+    ck_assert_msg((char *) pooled->data > (char *) pooled &&
+                  pooled->msg > (char *) pooled->data &&
+                  pooled->msg_length == XTNT_LOG_ENTRY_MSG_SIZE,
+        "Expected data and msg trailing the entry");
+    ck_assert_msg(((uintptr_t) pooled->data % XTNT_LOG_ENTRY_ALIGN) == 0,
+        "Expected data aligned to %d", XTNT_LOG_ENTRY_ALIGN);
+    res = xtnt_logger_entry_acquire(logger, 16, XTNT_LOG_ENTRY_MSG_SIZE + 1,
+                                    format_entry, XTNT_LOG_INFO, &large);
+    ck_assert_msg(res == XTNT_ESUCCESS && large->pool == NULL,
+        "Expected oversized entry allocated from the heap");
+    xtnt_log(logger, pooled);
+    xtnt_log(logger, large);
+    xtnt_logger_exit(logger);
+    pthread_join(logger_thread, NULL);
+    rewind(logger->log);
+    ck_assert_msg(fgets(buf, sizeof(buf), logger->log) != NULL &&
+                  strcmp(buf, LOG_MSG) == 0 &&
+                  fgets(buf, sizeof(buf), logger->log) != NULL &&
+                  strcmp(buf, LOG_MSG) == 0,
+        "Expected both entries written to log");
+}
+END_TEST
+
+START_TEST (test_xtnt_logger_entry_create)
+{
+    struct xtnt_logger_entry *created = NULL;
+    xtnt_status_t res = xtnt_logger_entry_create(24, 48, format_entry,
+                                                 XTNT_LOG_WARNING, &created);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected create to succeed, but got %d", res);
+    ck_assert_msg(created->level == XTNT_LOG_WARNING,
+        "Expected level %d, but got %u", XTNT_LOG_WARNING, created->level);
+    ck_assert_msg(created->msg >= (char *) created->data + 24 &&
+                  created->msg_length == 48 && created->pool == NULL,
+        "Expected msg following data in a single heap allocation");
+    xtnt_logger_entry_destroy(&created);
+    ck_assert_msg(created == NULL,
+        "Expected entry reference cleared on destroy");
+    xtnt_logger_exit(logger);
+    pthread_join(logger_thread, NULL);
+}
+END_TEST
+
+START_TEST (test_xtnt_log_record)
+{
+    pthread_t producers[RECORD_THREADS];
+    unsigned int next[RECORD_THREADS] = { 0 };
+    unsigned int thread, index, lines = 0;
+    void *status = NULL;
+    char buf[64] = { 0 };
+    for (uintptr_t t = 0; t < RECORD_THREADS; t++) {
+        pthread_create(&producers[t], NULL, record_producer, (void *) t);
+    }
+    for (int t = 0; t < RECORD_THREADS; t++) {
+        pthread_join(producers[t], &status);
+        ck_assert_msg(status == NULL,
+            "Expected producer to log all records, but got %d",
+            (int) (uintptr_t) status);
+    }
+    xtnt_logger_exit(logger);
+    pthread_join(logger_thread, NULL);
+    rewind(logger->log);
+    while (fgets(buf, sizeof(buf), logger->log) != NULL) {
+        ck_assert_msg(sscanf(buf, "%u %u", &thread, &index) == 2 &&
+                      thread < RECORD_THREADS,
+            "Expected formatted record, but got '%s'", buf);
+        ck_assert_msg(index == next[thread],
+            "Expected record %u of thread %u, but got %u",
+            next[thread], thread, index);
+        next[thread]++;
+        lines++;
+    }
+    ck_assert_msg(lines == RECORD_THREADS * RECORD_COUNT,
+        "Expected %d records written, but got %u",
+        RECORD_THREADS * RECORD_COUNT, lines);
+}
+END_TEST
+
+START_TEST (test_xtnt_log_record_full)
+{
+    struct record_data d = { 0, 0 };
+    char big[XTNT_LOG_RECORD_DATA_SIZE + 1] = { 0 };
+    xtnt_status_t res;
+    pthread_cancel(logger_thread);
+    pthread_join(logger_thread, NULL);
+    res = xtnt_log_record(logger, format_record, XTNT_LOG_INFO, big, sizeof(big));
+    ck_assert_msg(res == EMSGSIZE,
+        "Expected oversized record refused, but got %d", res);
+    for (; d.index < XTNT_LOG_RING_SIZE; d.index++) {
+        res = xtnt_log_record(logger, format_record, XTNT_LOG_INFO, &d, sizeof(d));
+        ck_assert_msg(res == XTNT_ESUCCESS,
+            "Expected record %u to fit the ring, but got %d", d.index, res);
+    }
+    res = xtnt_log_record(logger, format_record, XTNT_LOG_INFO, &d, sizeof(d));
+    ck_assert_msg(res == EAGAIN,
+        "Expected full ring to refuse record, but got %d", res);
+}
+END_TEST
+
+START_TEST (test_xtnt_logger_change_flush)
+{
+    xtnt_status_t res;
+    res = xtnt_logger_change_flush(logger, XTNT_LOG_BUFFER_SIZE + 1, 0);
+    ck_assert_msg(res == EINVAL,
+        "Expected flush size beyond the buffer refused, but got %d", res);
+    res = xtnt_logger_change_flush(logger, 0, 10);
+    ck_assert_msg(res == XTNT_ESUCCESS && logger->flush_size == 0 &&
+                  logger->flush_usec == 10,
+        "Expected flush thresholds changed, but got %d", res);
+    xtnt_logger_exit(logger);
+    pthread_join(logger_thread, NULL);
+}
+END_TEST
+
+START_TEST (test_xtnt_logger_write_large)
+{
+    struct xtnt_logger_entry *small = NULL;
+    struct xtnt_logger_entry *large = NULL;
+    char buf[64] = { 0 };
+    size_t length = 0;
+    int c;
+    xtnt_logger_entry_create(0, 32, format_entry, XTNT_LOG_INFO, &small);
+    xtnt_logger_entry_create(0, XTNT_LOG_BUFFER_SIZE + 2, format_large,
+                             XTNT_LOG_INFO, &large);
+    xtnt_log(logger, small);
+    xtnt_log(logger, large);
+    xtnt_logger_exit(logger);
+    pthread_join(logger_thread, NULL);
+    rewind(logger->log);
+    ck_assert_msg(fgets(buf, sizeof(buf), logger->log) != NULL &&
+                  strcmp(buf, LOG_MSG) == 0,
+        "Expected buffered entry written first, but got '%s'", buf);
+    while ((c = fgetc(logger->log)) == 'x') {
+        length++;
+    }
+    ck_assert_msg(length == XTNT_LOG_BUFFER_SIZE && c == '\n',
+        "Expected %d byte message written whole, but got %zu",
+        XTNT_LOG_BUFFER_SIZE, length);
+}
+END_TEST
+
+int fail_memalign;
+
+/* Fails the entry pool allocation of a logger while fail_memalign is set */
+int
+posix_memalign(void **memptr, size_t alignment, size_t size)
+{
+    static int (*next)(void **, size_t, size_t) = NULL;
+    if (fail_memalign) {
+        return ENOMEM;
+    }
+    if (next == NULL) {
+        next = (int (*)(void **, size_t, size_t)) dlsym(RTLD_NEXT, "posix_memalign");
+    }
+    return next(memptr, alignment, size);
+}
+
+START_TEST (test_xtnt_logger_initialize_nomem)
+{
+    struct xtnt_logger failed;
+    xtnt_status_t res = XTNT_EFAILURE;
+    fail_memalign = 1;
+    res = xtnt_logger_initialize(&failed);
+    fail_memalign = 0;
+    ck_assert_msg(res == ENOMEM,
+        "Expected ENOMEM from a failed allocation, but got %d", res);
+    ck_assert_msg(failed.buffer == NULL && failed.entries == NULL,
+        "Expected the failed logger to hold no buffer or pool");
+    ck_assert_msg(XTNT_STATE(failed.state) == XTNT_LOG_ENTRY_INIT_FAIL,
+        "Expected the logger state to record the failure");
 }
 END_TEST
 
@@ -58,6 +352,15 @@ Suite * xtnt_log_suite(void)
 
     tcase_add_checked_fixture(tc_log, setup, teardown);
     tcase_add_test(tc_log, test_xtnt_log);
+    tcase_add_test(tc_log, test_xtnt_logger_exit_idle);
+    tcase_add_test(tc_log, test_xtnt_logger_cancel_idle);
+    tcase_add_test(tc_log, test_xtnt_logger_entry_acquire);
+    tcase_add_test(tc_log, test_xtnt_logger_entry_create);
+    tcase_add_test(tc_log, test_xtnt_log_record);
+    tcase_add_test(tc_log, test_xtnt_log_record_full);
+    tcase_add_test(tc_log, test_xtnt_logger_change_flush);
+    tcase_add_test(tc_log, test_xtnt_logger_write_large);
+    tcase_add_test(tc_log, test_xtnt_logger_initialize_nomem);
     suite_add_tcase(s, tc_log);
 
     return s;
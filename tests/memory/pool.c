@@ -0,0 +1,209 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <check.h>
+#include <extant/memory/pool.h>
+
+#include <stdio.h>
+
+#define POOL_BLOCKS (256)
+#define POOL_THREADS (4)
+
+struct xtnt_memory_object *pool;
+
+void setup(void)
+{
+    if (xtnt_mpool_create(24, POOL_BLOCKS, &pool) != XTNT_ESUCCESS) {
+        ck_abort_msg("Failed to create pool in setup.");
+    }
+}
+
+void teardown(void)
+{
+    if (pool != NULL) {
+        xtnt_mpool_destroy(&pool);
+    }
+}
+
+void *
+pool_worker(void *arg)
+{
+    uintptr_t id = (uintptr_t) arg;
+    void *blocks[8];
+    for (xtnt_uint_t iter = 0; iter < 20000; iter++) {
+        if (xtnt_mpool_allocate(pool, 8, blocks) != XTNT_ESUCCESS) {
+            return (void *) 1;
+        }
+        for (xtnt_uint_t idx = 0; idx < 8; idx++) {
+            *((uintptr_t *) blocks[idx]) = id;
+        }
+        for (xtnt_uint_t idx = 0; idx < 8; idx++) {
+            if (*((uintptr_t *) blocks[idx]) != id) {
+                return (void *) 2;
+            }
+            xtnt_mpool_deallocate(pool, &(blocks[idx]));
+        }
+    }
+    return NULL;
+}
+
+START_TEST (test_xtnt_mpool_create)
+{
+    ck_assert_msg(pool != NULL,
+        "Expected pool as valid pointer, but got NULL");
+    ck_assert_msg(pool->size == 32,
+        "Expected block size rounded to 32, but got %zu", pool->size);
+    ck_assert_msg(pool->count == POOL_BLOCKS,
+        "Expected %d blocks, but got %u", POOL_BLOCKS, pool->count);
+}
+END_TEST
+
+START_TEST (test_xtnt_mpool_create_invalid)
+{
+    struct xtnt_memory_object *invalid = NULL;
+    xtnt_status_t res = xtnt_mpool_create(0, 8, &invalid);
+    ck_assert_msg(res == EINVAL,
+        "Expected EINVAL for 0 size, but got %d", res);
+    ck_assert_msg(invalid == NULL,
+        "Expected NULL pool on failed create");
+}
+END_TEST
+
+START_TEST (test_xtnt_mpool_allocate)
+{
+    void *blocks[POOL_BLOCKS];
+    void *extra = NULL;
+    xtnt_status_t res = xtnt_mpool_allocate(pool, POOL_BLOCKS, blocks);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected allocation of every block to succeed, but got %d", res);
+    for (xtnt_uint_t idx = 0; idx < POOL_BLOCKS; idx++) {
+        ck_assert_msg(((uintptr_t) blocks[idx] % XTNT_MPOOL_ALIGN) == 0,
+            "Expected block %u to be aligned", idx);
+        ck_assert_msg((char *) blocks[idx] >= (char *) pool->base &&
+                      (char *) blocks[idx] < (char *) pool->base + (pool->size * POOL_BLOCKS),
+            "Expected block %u within pool memory", idx);
+        for (xtnt_uint_t cmp = 0; cmp < idx; cmp++) {
+            ck_assert_msg(blocks[idx] != blocks[cmp],
+                "Expected unique blocks, but %u and %u match", idx, cmp);
+        }
+    }
+    res = xtnt_mpool_allocate(pool, 1, &extra);
+    ck_assert_msg(res == ENOMEM,
+        "Expected ENOMEM on exhausted pool, but got %d", res);
+}
+END_TEST
+
+START_TEST (test_xtnt_mpool_deallocate)
+{
+    void *blocks[POOL_BLOCKS];
+    void *block = NULL;
+    xtnt_status_t res = xtnt_mpool_allocate(pool, POOL_BLOCKS, blocks);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected allocation of every block to succeed, but got %d", res);
+    void *released = blocks[7];
+    res = xtnt_mpool_deallocate(pool, &(blocks[7]));
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected deallocation to succeed, but got %d", res);
+    ck_assert_msg(blocks[7] == NULL,
+        "Expected deallocated reference to be NULL");
+    res = xtnt_mpool_allocate(pool, 1, &block);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected allocation after deallocation to succeed, but got %d", res);
+    ck_assert_msg(block == released,
+        "Expected the released block to be reused");
+}
+END_TEST
+
+START_TEST (test_xtnt_mpool_concurrent)
+{
+    pthread_t threads[POOL_THREADS];
+    void *blocks[POOL_BLOCKS];
+    void *result = NULL;
+    for (uintptr_t idx = 0; idx < POOL_THREADS; idx++) {
+        pthread_create(&(threads[idx]), NULL, pool_worker, (void *) (idx + 1));
+    }
+    for (xtnt_uint_t idx = 0; idx < POOL_THREADS; idx++) {
+        pthread_join(threads[idx], &result);
+        ck_assert_msg(result == NULL,
+            "Expected worker %u to finish cleanly, but got %p", idx, result);
+    }
+    xtnt_status_t res = xtnt_mpool_allocate(pool, POOL_BLOCKS, blocks);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected the magazines of exited workers returned to the pool, but got %d", res);
+    for (xtnt_uint_t idx = 0; idx < POOL_BLOCKS; idx++) {
+        xtnt_mpool_deallocate(pool, &(blocks[idx]));
+    }
+}
+END_TEST
+
+START_TEST (test_xtnt_mpool_destroy)
+{
+    xtnt_status_t res = xtnt_mpool_destroy(&pool);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected destroy to succeed, but got %d", res);
+    ck_assert_msg(pool == NULL,
+        "Expected NULL pool pointer after successful destroy");
+}
+END_TEST
+
+Suite * xtnt_mpool_suite(void)
+{
+    Suite *s;
+    TCase *tc_mpool;
+
+    s = suite_create("xtnt_mpool");
+
+    tc_mpool = tcase_create("Memory Pool");
+
+    tcase_add_checked_fixture(tc_mpool, setup, teardown);
+    tcase_add_test(tc_mpool, test_xtnt_mpool_create);
+    tcase_add_test(tc_mpool, test_xtnt_mpool_create_invalid);
+    tcase_add_test(tc_mpool, test_xtnt_mpool_allocate);
+    tcase_add_test(tc_mpool, test_xtnt_mpool_deallocate);
+    tcase_add_test(tc_mpool, test_xtnt_mpool_concurrent);
+    tcase_add_test(tc_mpool, test_xtnt_mpool_destroy);
+    suite_add_tcase(s, tc_mpool);
+
+    return s;
+}
+
+int main(void)
+{
+    int failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = xtnt_mpool_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_VERBOSE);
+    failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (failed == 0) ? 0 : failed;
+}
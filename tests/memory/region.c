@@ -0,0 +1,246 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <check.h>
+#include <extant/log.h>
+#include <extant/memory/region.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#define REGION_SIZE (256)
+
+struct xtnt_memory_object *region;
+
+void setup(void)
+{
+    if (xtnt_mregion_create(REGION_SIZE, &region) != XTNT_ESUCCESS) {
+        ck_abort_msg("Failed to create region in setup.");
+    }
+}
+
+void teardown(void)
+{
+    if (region != NULL) {
+        xtnt_mregion_destroy(&region);
+    }
+}
+
+START_TEST (test_xtnt_mregion_create)
+{
+    ck_assert_msg(region != NULL,
+        "Expected region as valid pointer, but got NULL");
+    ck_assert_msg(region->size == REGION_SIZE,
+        "Expected chunk size of %d, but got %zu", REGION_SIZE, region->size);
+    ck_assert_msg(region->set.count == 1,
+        "Expected a single chunk, but got %u", region->set.count);
+}
+END_TEST
+
+START_TEST (test_xtnt_mregion_allocate)
+{
+    void *first = NULL;
+    void *second = NULL;
+    xtnt_status_t res = xtnt_mregion_allocate(region, 10, &first);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected allocation to succeed, but got %d", res);
+    res = xtnt_mregion_allocate(region, 10, &second);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected allocation to succeed, but got %d", res);
+    ck_assert_msg(((uintptr_t) first % XTNT_MREGION_ALIGN) == 0 &&
+                  ((uintptr_t) second % XTNT_MREGION_ALIGN) == 0,
+        "Expected allocations aligned to %d", XTNT_MREGION_ALIGN);
+    ck_assert_msg((char *) second == (char *) first + XTNT_MREGION_ALIGN,
+        "Expected second allocation to follow the first");
+}
+END_TEST
+
+START_TEST (test_xtnt_mregion_allocate_aligned)
+{
+    void *small = NULL;
+    void *aligned = NULL;
+    xtnt_status_t res = xtnt_mregion_allocate_aligned(region, 1, 1, &small);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected allocation to succeed, but got %d", res);
+    res = xtnt_mregion_allocate_aligned(region, 8, 64, &aligned);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected aligned allocation to succeed, but got %d", res);
+    ck_assert_msg(((uintptr_t) aligned % 64) == 0,
+        "Expected allocation aligned to 64");
+    res = xtnt_mregion_allocate_aligned(region, 8, 24, &aligned);
+    ck_assert_msg(res == EINVAL,
+        "Expected EINVAL for alignment of 24, but got %d", res);
+}
+END_TEST
+
+START_TEST (test_xtnt_mregion_allocate_overflow)
+{
+    void *allocation = NULL;
+    struct xtnt_memory_object *huge = NULL;
+    xtnt_status_t res = xtnt_mregion_allocate(region, SIZE_MAX, &allocation);
+    ck_assert_msg(res == ENOMEM && allocation == NULL,
+        "Expected ENOMEM for a size of SIZE_MAX, but got %d", res);
+    res = xtnt_mregion_allocate_aligned(region, SIZE_MAX - 64, 64, &allocation);
+    ck_assert_msg(res == ENOMEM && allocation == NULL,
+        "Expected ENOMEM when size and alignment overflow, but got %d", res);
+    ck_assert_msg(region->set.count == 1,
+        "Expected no chunk appended, but got %u", region->set.count);
+    res = xtnt_mregion_create(SIZE_MAX, &huge);
+    ck_assert_msg(res == ENOMEM && huge == NULL,
+        "Expected ENOMEM for a chunk size of SIZE_MAX, but got %d", res);
+}
+END_TEST
+
+START_TEST (test_xtnt_mregion_allocate_chunks)
+{
+    void *allocation = NULL;
+    void *large = NULL;
+    for (xtnt_uint_t idx = 0; idx < 64; idx++) {
+        xtnt_status_t res = xtnt_mregion_allocate(region, 32, &allocation);
+        ck_assert_msg(res == XTNT_ESUCCESS,
+            "Expected allocation %u to succeed, but got %d", idx, res);
+        memset(allocation, 0xff, 32);
+    }
+    ck_assert_msg(region->set.count == 8,
+        "Expected 8 chunks, but got %u", region->set.count);
+    xtnt_status_t res = xtnt_mregion_allocate(region, REGION_SIZE * 4, &large);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected oversized allocation to succeed, but got %d", res);
+    memset(large, 0xff, REGION_SIZE * 4);
+}
+END_TEST
+
+START_TEST (test_xtnt_mregion_deallocate)
+{
+    void *first = NULL;
+    void *second = NULL;
+    void *third = NULL;
+    xtnt_mregion_allocate(region, 16, &first);
+    xtnt_mregion_allocate(region, 16, &second);
+    xtnt_status_t res = xtnt_mregion_deallocate(region, &second);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected deallocation to succeed, but got %d", res);
+    ck_assert_msg(second == NULL,
+        "Expected deallocated reference to be NULL");
+    xtnt_mregion_allocate(region, 16, &third);
+    ck_assert_msg((char *) third == (char *) first + 16,
+        "Expected most recent allocation to be reclaimed");
+}
+END_TEST
+
+START_TEST (test_xtnt_mregion_reset)
+{
+    void *first = NULL;
+    void *allocation = NULL;
+    xtnt_mregion_allocate(region, 32, &first);
+    for (xtnt_uint_t idx = 0; idx < 32; idx++) {
+        xtnt_mregion_allocate(region, 32, &allocation);
+    }
+    xtnt_uint_t chunks = region->set.count;
+    xtnt_status_t res = xtnt_mregion_reset(region);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected reset to succeed, but got %d", res);
+    xtnt_mregion_allocate(region, 32, &allocation);
+    ck_assert_msg(allocation == first,
+        "Expected allocation after reset to reuse the first chunk");
+    for (xtnt_uint_t idx = 0; idx < 32; idx++) {
+        xtnt_mregion_allocate(region, 32, &allocation);
+    }
+    ck_assert_msg(region->set.count == chunks,
+        "Expected %u chunks to be reused, but got %u", chunks, region->set.count);
+}
+END_TEST
+
+START_TEST (test_xtnt_mregion_backing_store)
+{
+    struct xtnt_node *node = NULL;
+    struct xtnt_logger_entry *entry = NULL;
+    void *data = NULL;
+    void *msg = NULL;
+    xtnt_mregion_allocate(region, sizeof(struct xtnt_node), (void **) &node);
+    ck_assert_msg(xtnt_node_initialize(node, 1, 0, NULL) == XTNT_ESUCCESS,
+        "Expected node initialization in region memory to succeed");
+    xtnt_mregion_allocate(region, sizeof(struct xtnt_logger_entry), (void **) &entry);
+    xtnt_mregion_allocate(region, 16, &data);
+    xtnt_mregion_allocate(region, 64, &msg);
+    ck_assert_msg(xtnt_logger_entry_initialize(entry, data, msg, 64, NULL, XTNT_LOG_INFO) == XTNT_ESUCCESS,
+        "Expected entry initialization in region memory to succeed");
+    ck_assert_msg(XTNT_STATE(entry->state) == XTNT_LOG_ENTRY_EXTERNAL,
+        "Expected entry to be marked as external memory");
+}
+END_TEST
+
+START_TEST (test_xtnt_mregion_destroy)
+{
+    xtnt_status_t res = xtnt_mregion_destroy(&region);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected destroy to succeed, but got %d", res);
+    ck_assert_msg(region == NULL,
+        "Expected NULL region pointer after successful destroy");
+}
+END_TEST
+
+Suite * xtnt_mregion_suite(void)
+{
+    Suite *s;
+    TCase *tc_mregion;
+
+    s = suite_create("xtnt_mregion");
+
+    tc_mregion = tcase_create("Memory Region");
+
+    tcase_add_checked_fixture(tc_mregion, setup, teardown);
+    tcase_add_test(tc_mregion, test_xtnt_mregion_create);
+    tcase_add_test(tc_mregion, test_xtnt_mregion_allocate);
+    tcase_add_test(tc_mregion, test_xtnt_mregion_allocate_aligned);
+    tcase_add_test(tc_mregion, test_xtnt_mregion_allocate_overflow);
+    tcase_add_test(tc_mregion, test_xtnt_mregion_allocate_chunks);
+    tcase_add_test(tc_mregion, test_xtnt_mregion_deallocate);
+    tcase_add_test(tc_mregion, test_xtnt_mregion_reset);
+    tcase_add_test(tc_mregion, test_xtnt_mregion_backing_store);
+    tcase_add_test(tc_mregion, test_xtnt_mregion_destroy);
+    suite_add_tcase(s, tc_mregion);
+
+    return s;
+}
+
+int main(void)
+{
+    int failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = xtnt_mregion_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_VERBOSE);
+    failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (failed == 0) ? 0 : failed;
+}
@@ -65,7 +65,7 @@ START_TEST (test_xtnt_array_create)
         ck_assert_msg(array->root.link[XTNT_NODE_TAIL] != NULL,
             "Expected link tail with valid memory pointer, but got NULL");
 
-        ck_assert_msg(array->root.link[XTNT_NODE_TAIL] == &(array->root.link[XTNT_NODE_HEAD][7]),
+        ck_assert_msg(array->root.link[XTNT_NODE_TAIL] == (struct xtnt_node *) ((struct xtnt_node **) array->root.link[XTNT_NODE_HEAD] + 7),
             "Expected link tail set to final node in array of size 8");
     } else {
         ck_assert_msg(status == XTNT_EFAILURE,
@@ -98,6 +98,314 @@ START_TEST (test_xtnt_array_destroy)
 }
 END_TEST
 
+START_TEST (test_xtnt_array_search_seqlock)
+{
+    struct xtnt_node_set *array = NULL;
+    struct xtnt_node members[8];
+    struct xtnt_node *found = NULL;
+    xtnt_status_t status = xtnt_array_create_lock(8, XTNT_SET_LOCK_SEQLOCK, &array);
+    ck_assert_msg(status == XTNT_ESUCCESS,
+        "Expected seqlock array creation to succeed, but got %d", status);
+    for (xtnt_uint_t idx = 0; idx < 8; idx++) {
+        members[idx].key = idx + 100;
+        ck_assert_msg(xtnt_array_insert(array, &members[idx], idx) == XTNT_ESUCCESS,
+            "Expected insert at %u to succeed", idx);
+    }
+    for (xtnt_uint_t idx = 0; idx < 8; idx++) {
+        found = NULL;
+        xtnt_array_get(array, idx, &found);
+        ck_assert_msg(found == &members[idx],
+            "Expected member %u from xtnt_array_get", idx);
+        found = NULL;
+        xtnt_array_search(array, idx + 100, &found);
+        ck_assert_msg(found == &members[idx],
+            "Expected member %u from xtnt_array_search", idx);
+    }
+    xtnt_array_delete(array, 3, &found);
+    found = NULL;
+    xtnt_array_search(array, 103, &found);
+    ck_assert_msg(found == NULL,
+        "Expected deleted key 103 to be missing");
+    ck_assert_msg((array->sequence & 1) == 0,
+        "Expected an even sequence with no writer, but got %u", array->sequence);
+    xtnt_array_destroy(&array);
+}
+END_TEST
+
+START_TEST (test_xtnt_array_search_keyed)
+{
+    struct xtnt_node_set *array = NULL;
+    struct xtnt_node members[37];
+    struct xtnt_node *found = NULL;
+    ck_assert_msg(xtnt_array_create_mode(37, XTNT_MODE_4, XTNT_SET_LOCK_MUTEX, &array) == EINVAL,
+        "Expected an unknown array mode to be EINVAL");
+    ck_assert_msg(xtnt_array_create_mode(37, XTNT_ARRAY_MODE_KEYED, XTNT_SET_LOCK_MUTEX, &array) == XTNT_ESUCCESS,
+        "Expected keyed array creation to succeed");
+    for (xtnt_uint_t idx = 0; idx < 37; idx++) {
+        members[idx].key = idx * 3;
+        xtnt_array_insert(array, &members[idx], idx);
+    }
+    for (xtnt_uint_t idx = 0; idx < 37; idx++) {
+        found = NULL;
+        xtnt_array_search(array, idx * 3, &found);
+        ck_assert_msg(found == &members[idx],
+            "Expected key %u from the key column", idx * 3);
+    }
+    found = NULL;
+    xtnt_array_search(array, 4, &found);
+    ck_assert_msg(found == NULL,
+        "Expected a missing key to find nothing");
+    xtnt_array_delete(array, 0, &found);
+    found = NULL;
+    xtnt_array_search(array, 0, &found);
+    ck_assert_msg(found == NULL,
+        "Expected empty slots not to match key 0");
+    members[0].key = 200;
+    xtnt_array_insert(array, &members[0], 35);
+    found = NULL;
+    xtnt_array_search(array, 200, &found);
+    ck_assert_msg(found == &members[0],
+        "Expected a reinserted member to match its new key");
+    xtnt_array_destroy(&array);
+}
+END_TEST
+
+START_TEST (test_xtnt_array_set_if)
+{
+    struct xtnt_node_set *array = NULL;
+    struct xtnt_node members[2];
+    struct xtnt_node *found = NULL;
+    xtnt_array_create(4, &array);
+    members[0].key = 10;
+    members[1].key = 11;
+    ck_assert_msg(xtnt_set_insert_at(array, 2, &members[0], &found) == XTNT_ESUCCESS && found == NULL,
+        "Expected insert_at an empty index to replace nothing");
+    ck_assert_msg(xtnt_set_insert_at(array, 2, &members[1], &found) == XTNT_ESUCCESS && found == &members[0],
+        "Expected insert_at to return the replaced member");
+    ck_assert_msg(xtnt_set_insert_at(array, 4, &members[0], &found) == EINVAL,
+        "Expected insert_at past the end to be EINVAL");
+    found = NULL;
+    xtnt_set_index(array, 2, &found);
+    ck_assert_msg(found == &members[1],
+        "Expected xtnt_set_index to read member 2");
+    found = NULL;
+    xtnt_set_search(array, 11, &found);
+    ck_assert_msg(found == &members[1],
+        "Expected xtnt_set_search to find key 11");
+    xtnt_set_remove_at(array, 2, &found);
+    ck_assert_msg(found == &members[1],
+        "Expected xtnt_set_remove_at to return member 2");
+    ck_assert_msg(xtnt_set_push(array, &members[0]) == XTNT_ESUCCESS && array->count == 5,
+        "Expected xtnt_set_push to append a fifth slot");
+    found = NULL;
+    ck_assert_msg(xtnt_set_pop(array, &found) == XTNT_ESUCCESS && found == &members[0] && array->count == 4,
+        "Expected xtnt_set_pop to remove the pushed member");
+    xtnt_array_destroy(&array);
+}
+END_TEST
+
+START_TEST (test_xtnt_array_push_pop)
+{
+    struct xtnt_node_set *array = NULL;
+    struct xtnt_node members[1000];
+    struct xtnt_node *found = NULL;
+    xtnt_array_create_mode(0, XTNT_ARRAY_MODE_KEYED, XTNT_SET_LOCK_MUTEX, &array);
+    ck_assert_msg(array->count == 0 && array->root.link[XTNT_NODE_TAIL] == NULL,
+        "Expected an empty array without a tail");
+    for (xtnt_uint_t idx = 0; idx < 1000; idx++) {
+        members[idx].key = idx + 1;
+        ck_assert_msg(xtnt_array_push(array, &members[idx]) == XTNT_ESUCCESS,
+            "Expected push %u to succeed", idx);
+    }
+    ck_assert_msg(array->count == 1000 && array->size == 1024,
+        "Expected 1000 members in 1024 slots, but got %u in %u", array->count, array->size);
+    for (xtnt_uint_t idx = 0; idx < 1000; idx += 111) {
+        found = NULL;
+        xtnt_array_get(array, idx, &found);
+        ck_assert_msg(found == &members[idx],
+            "Expected member %u kept in order across growth", idx);
+        found = NULL;
+        xtnt_array_search(array, idx + 1, &found);
+        ck_assert_msg(found == &members[idx],
+            "Expected key %u kept in the key column across growth", idx + 1);
+    }
+    ck_assert_msg(*((struct xtnt_node **) array->root.link[XTNT_NODE_TAIL]) == &members[999],
+        "Expected the tail to be the last slot");
+    for (xtnt_uint_t idx = 1000; idx > 0; idx--) {
+        xtnt_array_pop(array, &found);
+        ck_assert_msg(found == &members[idx - 1],
+            "Expected pop to return member %u", idx - 1);
+    }
+    xtnt_array_pop(array, &found);
+    ck_assert_msg(found == NULL && array->count == 0,
+        "Expected pop of an empty array to return NULL");
+    xtnt_array_destroy(&array);
+}
+END_TEST
+
+START_TEST (test_xtnt_array_grow_shrink)
+{
+    struct xtnt_node_set *array = NULL;
+    struct xtnt_node member;
+    struct xtnt_node *found = NULL;
+    xtnt_uint_t large = XTNT_ARRAY_MAP_SIZE / sizeof(struct xtnt_node *) * 2;
+    void *retired = NULL;
+    member.key = 42;
+    xtnt_array_create_lock(4, XTNT_SET_LOCK_SEQLOCK, &array);
+    xtnt_array_insert(array, &member, 3);
+    ck_assert_msg(xtnt_array_grow(array) == XTNT_ESUCCESS && array->size == XTNT_ARRAY_SIZE,
+        "Expected a small array to grow to %u slots", XTNT_ARRAY_SIZE);
+    ck_assert_msg(array->root.value != NULL,
+        "Expected a seqlock array to retire its old table");
+    ck_assert_msg(xtnt_array_grow_eval(array, 8) == XTNT_ESUCCESS && array->size == XTNT_ARRAY_SIZE,
+        "Expected grow_eval to keep slots that already fit");
+    ck_assert_msg(xtnt_array_grow_eval(array, large) == XTNT_ESUCCESS && array->size == large,
+        "Expected grow_eval to a mapped table");
+    ck_assert_msg(xtnt_array_grow(array) == XTNT_ESUCCESS && array->size == large * 2,
+        "Expected a mapped table to double");
+    xtnt_array_get(array, 3, &found);
+    ck_assert_msg(found == &member && array->count == 4,
+        "Expected members kept across growth");
+    ck_assert_msg(xtnt_array_shrink_eval(array, 2) == XTNT_ESUCCESS && array->size == 4,
+        "Expected shrink_eval to stop at the member count");
+    xtnt_array_push(array, &member);
+    ck_assert_msg(xtnt_array_shrink(array) == XTNT_ESUCCESS && array->size == 5,
+        "Expected shrink to release spare slots");
+    found = NULL;
+    xtnt_array_search(array, 42, &found);
+    ck_assert_msg(found == &member,
+        "Expected members kept across shrinking");
+    retired = array->root.value;
+    for (xtnt_uint_t idx = 0; idx < 64; idx++) {
+        xtnt_array_push(array, &member);
+        xtnt_array_grow_eval(array, large + idx);
+        xtnt_array_pop(array, &found);
+        xtnt_array_shrink(array);
+    }
+    ck_assert_msg(array->root.value == retired && array->size == 5,
+        "Expected a seqlock array to retire no column growing back into its slots");
+    xtnt_array_destroy(&array);
+}
+END_TEST
+
+static xtnt_int_t
+compare_value(
+    const struct xtnt_node *a,
+    const struct xtnt_node *b)
+{
+    return (a->value > b->value) - (a->value < b->value);
+}
+
+START_TEST (test_xtnt_array_sort)
+{
+    struct xtnt_node_set *array = NULL;
+    struct xtnt_node members[3000];
+    struct xtnt_node *node = NULL;
+    xtnt_array_create_mode(3000, XTNT_ARRAY_MODE_KEYED, XTNT_SET_LOCK_MUTEX, &array);
+    for (xtnt_uint_t idx = 0; idx < 3000; idx++) {
+        members[idx].key = (idx * 7919) % 2003;
+        members[idx].value = &members[3000 - 1 - idx];
+        if (idx % 10) {
+            xtnt_array_insert(array, &members[idx], idx);
+        }
+    }
+    ck_assert_msg(xtnt_set_sort(array) == XTNT_ESUCCESS,
+        "Expected xtnt_set_sort to sort an array");
+    for (xtnt_uint_t idx = 1; idx < 2700; idx++) {
+        xtnt_array_get(array, idx, &node);
+        ck_assert_msg(((struct xtnt_node **) array->root.link[XTNT_NODE_HEAD])[idx - 1]->key <= node->key,
+            "Expected ascending keys at %u", idx);
+        ck_assert_msg(((xtnt_uint_t *) array->root.link[XTNT_NODE_MIDDLE])[idx] == node->key,
+            "Expected the key column in the sorted order at %u", idx);
+    }
+    node = NULL;
+    xtnt_array_get(array, 2700, &node);
+    ck_assert_msg(node == NULL && array->count == 3000,
+        "Expected the empty slots behind the members");
+    xtnt_array_sort_reverse(array);
+    ck_assert_msg(((struct xtnt_node **) array->root.link[XTNT_NODE_HEAD])[0]->key == 2002,
+        "Expected the greatest key first after sort_reverse");
+    ck_assert_msg(xtnt_array_sort_parallel(array, xtnt_node_compare_key, 4, 100) == XTNT_ESUCCESS,
+        "Expected a parallel sort of an array");
+    for (xtnt_uint_t idx = 1; idx < 2700; idx++) {
+        ck_assert_msg(((struct xtnt_node **) array->root.link[XTNT_NODE_HEAD])[idx - 1]->key <=
+                      ((struct xtnt_node **) array->root.link[XTNT_NODE_HEAD])[idx]->key,
+            "Expected ascending keys at %u after a parallel sort", idx);
+    }
+    xtnt_array_sort_fn(array, compare_value);
+    for (xtnt_uint_t idx = 1; idx < 2700; idx++) {
+        ck_assert_msg(((struct xtnt_node **) array->root.link[XTNT_NODE_HEAD])[idx - 1]->value <
+                      ((struct xtnt_node **) array->root.link[XTNT_NODE_HEAD])[idx]->value,
+            "Expected ascending values at %u after sort_fn", idx);
+    }
+    xtnt_array_destroy(&array);
+}
+END_TEST
+
+START_TEST (test_xtnt_array_iter)
+{
+    struct xtnt_node_set *array = NULL;
+    struct xtnt_node nodes[8];
+    struct xtnt_node *node = NULL;
+    struct xtnt_set_iter iter;
+    xtnt_uint_t key = 0;
+    xtnt_array_create(8, &array);
+    for (xtnt_uint_t idx = 0; idx < 8; idx += 2) {
+        xtnt_node_initialize(&nodes[idx], idx, 0, NULL);
+        xtnt_array_insert(array, &nodes[idx], idx);
+    }
+    ck_assert_msg(xtnt_set_iter_begin(array, &iter, XTNT_SET_ITER_LOCK) == XTNT_ESUCCESS,
+        "Expected a cursor on an array");
+    for (key = 0; xtnt_set_iter_next(&iter, &node) == XTNT_ESUCCESS && node != NULL; key += 2) {
+        ck_assert_msg(node == &nodes[key], "Expected the member at %u, skipping empty slots", key);
+    }
+    xtnt_set_iter_end(&iter);
+    ck_assert_msg(key == 8, "Expected 4 members visited, but stopped at %u", key);
+    xtnt_array_destroy(&array);
+}
+END_TEST
+
+START_TEST (test_xtnt_array_push_many)
+{
+    struct xtnt_node_set *array = NULL;
+    struct xtnt_node members[100];
+    struct xtnt_node *batch[100];
+    struct xtnt_node *found = NULL;
+    xtnt_array_create_mode(0, XTNT_ARRAY_MODE_KEYED, XTNT_SET_LOCK_MUTEX, &array);
+    for (xtnt_uint_t idx = 0; idx < 100; idx++) {
+        members[idx].key = idx + 1;
+        batch[idx] = &members[idx];
+    }
+    xtnt_array_push(array, batch[0]);
+    ck_assert_msg(xtnt_array_push_many(array, 99, &batch[1]) == XTNT_ESUCCESS &&
+                  array->count == 100 && array->size == 128,
+        "Expected 100 members in 128 slots, but got %u in %u", array->count, array->size);
+    ck_assert_msg(*((struct xtnt_node **) array->root.link[XTNT_NODE_TAIL]) == &members[99],
+        "Expected the tail to be the last slot");
+    xtnt_array_search(array, 64, &found);
+    ck_assert_msg(found == &members[63], "Expected key 64 in the key column");
+    ck_assert_msg(xtnt_array_delete_many(array, 90, 11, NULL) == EINVAL,
+        "Expected a run past the last slot to be EINVAL");
+    ck_assert_msg(xtnt_array_delete_many(array, 10, 20, &batch[0]) == XTNT_ESUCCESS &&
+                  batch[0] == &members[10] && batch[19] == &members[29],
+        "Expected the deleted nodes returned in order");
+    found = NULL;
+    xtnt_array_search(array, 20, &found);
+    ck_assert_msg(found == NULL && array->count == 100,
+        "Expected deleted slots emptied, keeping the count");
+    ck_assert_msg(xtnt_array_insert_many(array, 0, 20, &batch[0]) == XTNT_ESUCCESS,
+        "Expected insert of 20 nodes to succeed");
+    xtnt_array_get(array, 19, &found);
+    ck_assert_msg(found == &members[29], "Expected slot 19 set from the run");
+    found = NULL;
+    xtnt_array_search(array, 30, &found);
+    ck_assert_msg(found == &members[29], "Expected the key column set from the run");
+    ck_assert_msg(xtnt_array_insert_many(array, 99, 2, &batch[0]) == EINVAL,
+        "Expected an insert past the last slot to be EINVAL");
+    xtnt_array_destroy(&array);
+}
+END_TEST
+
 START_TEST (test_xtnt_array_delete)
 {
 }
@@ -115,6 +423,14 @@ Suite * xtnt_list_suite(void)
 
     tcase_add_test(tc_xtnt_list, test_xtnt_array_create);
     tcase_add_test(tc_xtnt_list, test_xtnt_array_destroy);
+    tcase_add_test(tc_xtnt_list, test_xtnt_array_search_seqlock);
+    tcase_add_test(tc_xtnt_list, test_xtnt_array_search_keyed);
+    tcase_add_test(tc_xtnt_list, test_xtnt_array_set_if);
+    tcase_add_test(tc_xtnt_list, test_xtnt_array_push_pop);
+    tcase_add_test(tc_xtnt_list, test_xtnt_array_grow_shrink);
+    tcase_add_test(tc_xtnt_list, test_xtnt_array_sort);
+    tcase_add_test(tc_xtnt_list, test_xtnt_array_iter);
+    tcase_add_test(tc_xtnt_list, test_xtnt_array_push_many);
     suite_add_tcase(s, tc_xtnt_list);
 
     return s;
@@ -72,6 +72,127 @@ START_TEST (test_xtnt_set_uninitialize)
 }
 END_TEST
 
+START_TEST (test_xtnt_set_initialize_lock)
+{
+    struct xtnt_node_set set;
+    xtnt_uint_t policy[] = { XTNT_SET_LOCK_MUTEX, XTNT_SET_LOCK_RWLOCK, XTNT_SET_LOCK_SEQLOCK,
+                             XTNT_SET_LOCK_SPIN, XTNT_SET_LOCK_NONE };
+    xtnt_status_t res = XTNT_EFAILURE;
+    for (xtnt_uint_t idx = 0; idx < 5; idx++) {
+        res = xtnt_node_set_initialize_lock(&set, policy[idx]);
+        ck_assert_msg(res == XTNT_ESUCCESS,
+            "Expected policy %u to initialize, but got %d", policy[idx], res);
+        ck_assert_msg(set.policy == policy[idx],
+            "Expected set policy %u, but got %u", policy[idx], set.policy);
+        ck_assert_msg(xtnt_node_set_read_lock(&set) == XTNT_ESUCCESS &&
+            xtnt_node_set_read_unlock(&set) == XTNT_ESUCCESS,
+            "Expected policy %u to read lock and unlock", policy[idx]);
+        ck_assert_msg(xtnt_node_set_write_lock(&set) == XTNT_ESUCCESS &&
+            xtnt_node_set_write_unlock(&set) == XTNT_ESUCCESS,
+            "Expected policy %u to write lock and unlock", policy[idx]);
+        ck_assert_msg(xtnt_node_set_uninitialize(&set) == XTNT_ESUCCESS,
+            "Expected policy %u to uninitialize", policy[idx]);
+    }
+    res = xtnt_node_set_initialize_lock(&set, 7);
+    ck_assert_msg(res == EINVAL,
+        "Expected EINVAL for an unknown policy, but got %d", res);
+}
+END_TEST
+
+START_TEST (test_xtnt_set_read_validate)
+{
+    struct xtnt_node_set set;
+    xtnt_uint_t sequence = XTNT_ZERO;
+    xtnt_node_set_initialize_lock(&set, XTNT_SET_LOCK_SEQLOCK);
+
+    sequence = xtnt_node_set_read_begin(&set);
+    ck_assert_msg(xtnt_node_set_read_validate(&set, sequence),
+        "Expected a read without writers to validate");
+
+    xtnt_node_set_write_lock(&set);
+    ck_assert_msg(!xtnt_node_set_read_validate(&set, sequence),
+        "Expected a read started before a writer to fail");
+    ck_assert_msg(!xtnt_node_set_read_validate(&set, xtnt_node_set_read_begin(&set)),
+        "Expected a read during a writer to fail");
+    xtnt_node_set_write_unlock(&set);
+
+    ck_assert_msg(!xtnt_node_set_read_validate(&set, sequence),
+        "Expected a read spanning a writer to fail");
+    sequence = xtnt_node_set_read_begin(&set);
+    ck_assert_msg(xtnt_node_set_read_validate(&set, sequence),
+        "Expected a read after the writer to validate");
+    xtnt_node_set_uninitialize(&set);
+}
+END_TEST
+
+START_TEST (test_xtnt_set_enotsup)
+{
+    struct xtnt_node_set set;
+    struct xtnt_node node;
+    struct xtnt_node *found = NULL;
+    xtnt_node_set_initialize(&set);
+    ck_assert_msg(set.fn == &xtnt_node_set_enotsup_if,
+        "Expected a set without a type to have the ENOTSUP interface");
+    ck_assert_msg(xtnt_set_push(&set, &node) == ENOTSUP,
+        "Expected push on a set without a type to be ENOTSUP");
+    ck_assert_msg(xtnt_set_index(&set, 0, &found) == ENOTSUP,
+        "Expected index on a set without a type to be ENOTSUP");
+    ck_assert_msg(xtnt_set_grow_eval(&set, 1) == ENOTSUP,
+        "Expected grow_eval on a set without a type to be ENOTSUP");
+    ck_assert_msg(found == NULL,
+        "Expected an ENOTSUP operation to leave its output alone");
+    xtnt_node_set_uninitialize(&set);
+}
+END_TEST
+
+START_TEST (test_xtnt_set_iter)
+{
+    struct xtnt_node_set set;
+    struct xtnt_set_iter iter;
+    xtnt_node_set_initialize(&set);
+    ck_assert_msg(xtnt_set_iter_begin(&set, &iter, XTNT_SET_ITER_SNAPSHOT) == ENOTSUP,
+        "Expected a snapshot of a set without a type to be ENOTSUP");
+    ck_assert_msg(xtnt_set_iter_range(&set, &iter, 0, 1, XTNT_SET_ITER_LOCK) == ENOTSUP,
+        "Expected a range of a set without a type to be ENOTSUP");
+    ck_assert_msg(xtnt_set_iter_begin(&set, &iter, XTNT_SET_ITER_LOCK) == ENOTSUP,
+        "Expected a locked cursor of a set without a type to be ENOTSUP");
+    ck_assert_msg(xtnt_node_set_uninitialize(&set) == XTNT_ESUCCESS,
+        "Expected the set left unlocked by the refused cursors");
+}
+END_TEST
+
+static void *
+spin_writer(
+    void *arg)
+{
+    struct xtnt_node_set *set = arg;
+    for (xtnt_uint_t idx = 0; idx < 100000; idx++) {
+        xtnt_node_set_write_lock(set);
+        set->count++;
+        xtnt_node_set_write_unlock(set);
+    }
+    return NULL;
+}
+
+START_TEST (test_xtnt_set_spin_lock)
+{
+    struct xtnt_node_set set;
+    pthread_t writers[4];
+    xtnt_node_set_initialize_lock(&set, XTNT_SET_LOCK_SPIN);
+    for (xtnt_uint_t idx = 0; idx < 4; idx++) {
+        pthread_create(&writers[idx], NULL, spin_writer, &set);
+    }
+    for (xtnt_uint_t idx = 0; idx < 4; idx++) {
+        pthread_join(writers[idx], NULL);
+    }
+    ck_assert_msg(set.count == 400000,
+        "Expected 400000 exclusive increments, but got %u", set.count);
+    ck_assert_msg(set.spin == 0,
+        "Expected the spin lock released, but got %u", set.spin);
+    xtnt_node_set_uninitialize(&set);
+}
+END_TEST
+
 Suite * xtnt_set_common_suite(void)
 {
     Suite *s;
@@ -84,6 +205,11 @@ Suite * xtnt_set_common_suite(void)
     tcase_add_checked_fixture(tc_set_common, setup, teardown);
     tcase_add_test(tc_set_common, test_xtnt_set_initialize);
     tcase_add_test(tc_set_common, test_xtnt_set_uninitialize);
+    tcase_add_test(tc_set_common, test_xtnt_set_initialize_lock);
+    tcase_add_test(tc_set_common, test_xtnt_set_read_validate);
+    tcase_add_test(tc_set_common, test_xtnt_set_spin_lock);
+    tcase_add_test(tc_set_common, test_xtnt_set_enotsup);
+    tcase_add_test(tc_set_common, test_xtnt_set_iter);
     suite_add_tcase(s, tc_set_common);
 
     return s;
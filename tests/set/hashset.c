@@ -0,0 +1,263 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <check.h>
+#include <extant/set/hashset.h>
+
+#include <stdio.h>
+
+#define HASH_NODES (4096)
+
+struct xtnt_node nodes[HASH_NODES];
+struct xtnt_node_set set;
+
+xtnt_uint_t
+match_key(void *ctx, struct xtnt_node *node)
+{
+    return node->key == *((xtnt_uint_t *) ctx);
+}
+
+void setup(void)
+{
+    xtnt_uint_t i;
+    for (i = 0; i < HASH_NODES; i++) {
+        nodes[i].key = i * 7919;
+        nodes[i].value = &nodes[i];
+        nodes[i].link[0] = nodes[i].link[1] = nodes[i].link[2] = NULL;
+        nodes[i].state = 0;
+    }
+    if (xtnt_hashset_initialize(&set) != XTNT_ESUCCESS) {
+        ck_abort_msg("Failed to initialize hash set in setup.");
+    }
+}
+
+void teardown(void)
+{
+    xtnt_hashset_uninitialize(&set);
+}
+
+START_TEST (test_xtnt_hashset_insert)
+{
+    struct xtnt_node *found = NULL;
+    xtnt_uint_t i;
+    xtnt_status_t res;
+    for (i = 0; i < HASH_NODES; i++) {
+        res = xtnt_set_insert(&set, &nodes[i]);
+        ck_assert_msg(res == XTNT_ESUCCESS,
+            "Expected insert of %u to succeed, but got %d", i, res);
+        ck_assert_msg(set.count * XTNT_HASHSET_LOAD_DEN <= set.size * XTNT_HASHSET_LOAD_NUM,
+            "Expected load within bounds, but got %u of %u", set.count, set.size);
+    }
+    ck_assert_msg(set.count == HASH_NODES,
+        "Expected count of %d, but got %u", HASH_NODES, set.count);
+    for (i = 0; i < HASH_NODES; i++) {
+        xtnt_set_search(&set, nodes[i].key, &found);
+        ck_assert_msg(found == &nodes[i],
+            "Expected to find key %u", nodes[i].key);
+    }
+    xtnt_set_search(&set, 1, &found);
+    ck_assert_msg(found == NULL,
+        "Expected absent key not found");
+}
+END_TEST
+
+START_TEST (test_xtnt_hashset_lock_none)
+{
+    struct xtnt_node_set local;
+    struct xtnt_node *found = NULL;
+    xtnt_uint_t i;
+    ck_assert_msg(xtnt_hashset_initialize_lock(&local, XTNT_SET_LOCK_NONE) == XTNT_ESUCCESS,
+        "Expected an unlocked hash set to initialize");
+    for (i = 0; i < HASH_NODES; i++) {
+        xtnt_set_insert(&local, &nodes[i]);
+    }
+    for (i = 0; i < HASH_NODES; i++) {
+        xtnt_set_search(&local, nodes[i].key, &found);
+        ck_assert_msg(found == &nodes[i],
+            "Expected to find key %u", nodes[i].key);
+    }
+    ck_assert_msg(local.count == HASH_NODES,
+        "Expected count of %d, but got %u", HASH_NODES, local.count);
+    ck_assert_msg(xtnt_hashset_uninitialize(&local) == XTNT_ESUCCESS,
+        "Expected an unlocked hash set to uninitialize");
+}
+END_TEST
+
+START_TEST (test_xtnt_hashset_insert_duplicate)
+{
+    struct xtnt_node dup = { NULL, { NULL, NULL, NULL }, 7919, 0, 0 };
+    xtnt_set_insert(&set, &nodes[1]);
+    ck_assert_msg(xtnt_set_insert(&set, &dup) == EEXIST,
+        "Expected EEXIST on duplicate key");
+    ck_assert_msg(set.count == 1,
+        "Expected count of 1, but got %u", set.count);
+}
+END_TEST
+
+START_TEST (test_xtnt_hashset_remove)
+{
+    struct xtnt_node *found = NULL;
+    xtnt_uint_t i;
+    for (i = 0; i < HASH_NODES; i++) {
+        xtnt_set_insert(&set, &nodes[i]);
+    }
+    /* Remove every other node, some while a resize is still migrating */
+    for (i = 0; i < HASH_NODES; i += 2) {
+        ck_assert_msg(xtnt_set_remove(&set, &nodes[i]) == XTNT_ESUCCESS,
+            "Expected remove of %u to succeed", i);
+    }
+    ck_assert_msg(set.count == HASH_NODES / 2,
+        "Expected count of %d, but got %u", HASH_NODES / 2, set.count);
+    for (i = 0; i < HASH_NODES; i++) {
+        xtnt_set_search(&set, nodes[i].key, &found);
+        ck_assert_msg(found == ((i % 2) ? &nodes[i] : NULL),
+            "Expected key %u %s", nodes[i].key, (i % 2) ? "found" : "removed");
+    }
+    xtnt_hashset_delete(&set, 1, &found);
+    ck_assert_msg(found == NULL && set.count == HASH_NODES / 2,
+        "Expected delete of absent key to leave the set unchanged");
+}
+END_TEST
+
+START_TEST (test_xtnt_hashset_incremental)
+{
+    struct xtnt_node *found = NULL;
+    xtnt_uint_t i, resizing = 0;
+    for (i = 0; i < HASH_NODES; i++) {
+        xtnt_set_insert(&set, &nodes[i]);
+        if (set.root.link[XTNT_NODE_TAIL] != NULL) {
+            resizing++;
+            xtnt_set_search(&set, nodes[0].key, &found);
+            ck_assert_msg(found == &nodes[0],
+                "Expected search to find members of the old table");
+        }
+    }
+    ck_assert_msg(resizing > 0,
+        "Expected inserts while a resize migrates");
+}
+END_TEST
+
+START_TEST (test_xtnt_hashset_grow_shrink)
+{
+    struct xtnt_node *found = NULL;
+    xtnt_uint_t i;
+    size_t size;
+    ck_assert_msg(xtnt_set_grow_eval(&set, HASH_NODES) == XTNT_ESUCCESS &&
+                  set.size * XTNT_HASHSET_LOAD_NUM >= HASH_NODES * XTNT_HASHSET_LOAD_DEN,
+        "Expected grow to hold %d members, but got %u slots", HASH_NODES, set.size);
+    size = set.size;
+    for (i = 0; i < HASH_NODES; i++) {
+        xtnt_set_insert(&set, &nodes[i]);
+    }
+    ck_assert_msg(set.size == size && set.root.link[XTNT_NODE_TAIL] == NULL,
+        "Expected no resize after growing ahead");
+    ck_assert_msg(xtnt_set_grow(&set) == XTNT_ESUCCESS && set.size == size * 2,
+        "Expected grow to double slots, but got %u", set.size);
+    for (i = 16; i < HASH_NODES; i++) {
+        xtnt_set_remove(&set, &nodes[i]);
+    }
+    ck_assert_msg(xtnt_set_shrink_eval(&set, 64) == XTNT_ESUCCESS && set.size == 128,
+        "Expected shrink to fit 64 members, but got %u slots", set.size);
+    ck_assert_msg(xtnt_set_shrink(&set) == XTNT_ESUCCESS && set.size == 32,
+        "Expected shrink to fit 16 members, but got %u slots", set.size);
+    for (i = 0; i < 16; i++) {
+        xtnt_set_search(&set, nodes[i].key, &found);
+        ck_assert_msg(found == &nodes[i],
+            "Expected key %u kept through shrink", nodes[i].key);
+    }
+    i = nodes[3].key;
+    xtnt_set_search_fn(&set, match_key, &i, &found);
+    ck_assert_msg(found == &nodes[3],
+        "Expected search_fn to match key %u", i);
+}
+END_TEST
+
+static xtnt_status_t
+count_member(void *ctx, struct xtnt_node *node)
+{
+    xtnt_uint_t *seen = ctx;
+    seen[node->key / 7919]++;
+    return XTNT_ESUCCESS;
+}
+
+START_TEST (test_xtnt_hashset_for_each)
+{
+    xtnt_uint_t *seen = calloc(HASH_NODES, sizeof(xtnt_uint_t));
+    xtnt_uint_t i;
+    for (i = 0; i < HASH_NODES && (i < 64 || set.root.link[XTNT_NODE_TAIL] == NULL); i++) {
+        xtnt_set_insert(&set, &nodes[i]);
+    }
+    ck_assert_msg(set.root.link[XTNT_NODE_TAIL] != NULL,
+        "Expected a resize to be migrating");
+    ck_assert_msg(xtnt_set_for_each(&set, count_member, seen) == XTNT_ESUCCESS,
+        "Expected for each over a hash set");
+    for (xtnt_uint_t idx = 0; idx < HASH_NODES; idx++) {
+        ck_assert_msg(seen[idx] == (idx < i),
+            "Expected key %u visited %u times, but was %u", nodes[idx].key, idx < i, seen[idx]);
+    }
+    free(seen);
+}
+END_TEST
+
+Suite * xtnt_hashset_suite(void)
+{
+    Suite *s;
+    TCase *tc_hashset;
+
+    s = suite_create("xtnt_hashset");
+
+    tc_hashset = tcase_create("Hash set");
+
+    tcase_add_checked_fixture(tc_hashset, setup, teardown);
+    tcase_add_test(tc_hashset, test_xtnt_hashset_insert);
+    tcase_add_test(tc_hashset, test_xtnt_hashset_lock_none);
+    tcase_add_test(tc_hashset, test_xtnt_hashset_insert_duplicate);
+    tcase_add_test(tc_hashset, test_xtnt_hashset_remove);
+    tcase_add_test(tc_hashset, test_xtnt_hashset_incremental);
+    tcase_add_test(tc_hashset, test_xtnt_hashset_grow_shrink);
+    tcase_add_test(tc_hashset, test_xtnt_hashset_for_each);
+    suite_add_tcase(s, tc_hashset);
+
+    return s;
+}
+
+int main(void)
+{
+    int failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = xtnt_hashset_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_VERBOSE);
+    failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (failed == 0) ? 0 : failed;
+}
@@ -342,6 +342,229 @@ START_TEST (test_xtnt_list_search_full_beyond)
 }
 END_TEST
 
+struct search_ctx {
+    struct xtnt_node_set *list;
+    xtnt_uint_t stop;
+    xtnt_uint_t missed;
+};
+
+static void *
+search_reader(
+    void *arg)
+{
+    struct search_ctx *ctx = arg;
+    struct xtnt_node *found = NULL;
+    while (!__atomic_load_n(&(ctx->stop), __ATOMIC_ACQUIRE)) {
+        for (xtnt_uint_t key = 8; key < 16; key++) {
+            found = NULL;
+            if (xtnt_list_search(ctx->list, key, &found) != XTNT_ESUCCESS ||
+                found != &nodes[key]) {
+                __atomic_add_fetch(&(ctx->missed), 1, __ATOMIC_RELAXED);
+            }
+        }
+    }
+    return NULL;
+}
+
+/* Readers never miss the stable tail while a writer churns the head */
+static void
+search_churn(
+    xtnt_uint_t policy)
+{
+    struct xtnt_node_set list;
+    struct search_ctx ctx = { &list, 0, 0 };
+    struct xtnt_node *deleted = NULL;
+    pthread_t readers[4];
+    ck_assert_msg(xtnt_node_set_initialize_lock(&list, policy) == XTNT_ESUCCESS,
+        "Expected policy %u to initialize", policy);
+    for (xtnt_uint_t idx = 16; idx > 0; idx--) {
+        nodes[idx - 1].link[XTNT_NODE_HEAD] = nodes[idx - 1].link[XTNT_NODE_TAIL] = NULL;
+        xtnt_list_insert(&list, &nodes[idx - 1]);
+    }
+    for (xtnt_uint_t idx = 0; idx < 4; idx++) {
+        pthread_create(&readers[idx], NULL, search_reader, &ctx);
+    }
+    for (xtnt_uint_t round = 0; round < 20000; round++) {
+        xtnt_list_delete(&list, 0, &deleted);
+        deleted->link[XTNT_NODE_HEAD] = NULL;
+        xtnt_list_insert(&list, deleted);
+    }
+    __atomic_store_n(&(ctx.stop), 1, __ATOMIC_RELEASE);
+    for (xtnt_uint_t idx = 0; idx < 4; idx++) {
+        pthread_join(readers[idx], NULL);
+    }
+    ck_assert_msg(ctx.missed == 0,
+        "Expected readers to find every stable key, but missed %u", ctx.missed);
+    ck_assert_msg(list.count == 16,
+        "Expected list count of 16, but got %u", list.count);
+    xtnt_node_set_uninitialize(&list);
+}
+
+START_TEST (test_xtnt_list_search_rwlock)
+{
+    search_churn(XTNT_SET_LOCK_RWLOCK);
+}
+END_TEST
+
+START_TEST (test_xtnt_list_search_seqlock)
+{
+    search_churn(XTNT_SET_LOCK_SEQLOCK);
+}
+END_TEST
+
+START_TEST (test_xtnt_list_set_if)
+{
+    struct xtnt_node_set list;
+    struct xtnt_node *found = NULL;
+    ck_assert_msg(xtnt_list_initialize(&list) == XTNT_ESUCCESS,
+        "Expected the list to initialize");
+    for (xtnt_uint_t idx = 0; idx < 3; idx++) {
+        in_nodes[idx].link[XTNT_NODE_TAIL] = NULL;
+        xtnt_set_insert(&list, &in_nodes[idx]);
+    }
+    xtnt_set_first(&list, &found);
+    ck_assert_msg(found == &in_nodes[2],
+        "Expected xtnt_set_first to be the newest node");
+    xtnt_set_last(&list, &found);
+    ck_assert_msg(found == &in_nodes[0],
+        "Expected xtnt_set_last to be the oldest node");
+    found = NULL;
+    xtnt_set_index(&list, 1, &found);
+    ck_assert_msg(found == &in_nodes[1],
+        "Expected xtnt_set_index to read the middle node");
+    found = NULL;
+    xtnt_set_search(&list, 17, &found);
+    ck_assert_msg(found == &in_nodes[1],
+        "Expected xtnt_set_search to find key 17");
+    ck_assert_msg(xtnt_set_index(&list, -1, &found) == EINVAL,
+        "Expected a negative index to be EINVAL");
+    ck_assert_msg(xtnt_set_pop(&list, &found) == ENOTSUP,
+        "Expected a list pop to be ENOTSUP");
+    xtnt_node_set_uninitialize(&list);
+}
+END_TEST
+
+START_TEST (test_xtnt_list_sort)
+{
+    struct xtnt_node_set list;
+    struct xtnt_node *node = NULL;
+    xtnt_uint_t keys[8] = { 5, 1, 7, 3, 3, 0, 6, 2 };
+    xtnt_list_initialize(&list);
+    for (xtnt_uint_t idx = 0; idx < 8; idx++) {
+        in_nodes[idx].key = keys[idx];
+        in_nodes[idx].link[XTNT_NODE_TAIL] = NULL;
+        xtnt_list_insert(&list, &in_nodes[idx]);
+    }
+    ck_assert_msg(xtnt_set_sort(&list) == XTNT_ESUCCESS,
+        "Expected xtnt_set_sort to sort a list");
+    node = list.root.link[XTNT_NODE_HEAD];
+    ck_assert_msg(node->link[XTNT_NODE_HEAD] == NULL && node->key == 0,
+        "Expected the head to hold the least key");
+    for (; node->link[XTNT_NODE_TAIL] != NULL; node = node->link[XTNT_NODE_TAIL]) {
+        ck_assert_msg(node->key <= node->link[XTNT_NODE_TAIL]->key,
+            "Expected ascending keys, but %u came before %u", node->key,
+            node->link[XTNT_NODE_TAIL]->key);
+        ck_assert_msg(node->link[XTNT_NODE_TAIL]->link[XTNT_NODE_HEAD] == node,
+            "Expected the previous links relinked");
+    }
+    ck_assert_msg(list.root.link[XTNT_NODE_TAIL] == node && node->key == 7,
+        "Expected the tail to hold the greatest key");
+    ck_assert_msg(in_nodes[4].link[XTNT_NODE_TAIL] == &in_nodes[3],
+        "Expected equal keys to keep their list order");
+    xtnt_list_sort_reverse(&list);
+    node = list.root.link[XTNT_NODE_HEAD];
+    ck_assert_msg(node->key == 7 && ((struct xtnt_node *) list.root.link[XTNT_NODE_TAIL])->key == 0,
+        "Expected descending keys after sort_reverse");
+    ck_assert_msg(xtnt_set_sort_fn(&list, NULL) == EINVAL,
+        "Expected sort_fn without a comparison to be EINVAL");
+    xtnt_node_set_uninitialize(&list);
+}
+END_TEST
+
+START_TEST (test_xtnt_list_iter)
+{
+    struct xtnt_node_set list;
+    struct xtnt_set_iter iter;
+    struct xtnt_node *node = NULL;
+    xtnt_uint_t key = 0;
+    xtnt_list_initialize(&list);
+    // The first member keeps a stale link the cursor must not follow
+    in_nodes[0].link[XTNT_NODE_TAIL] = &nodes[0];
+    for (xtnt_uint_t idx = 0; idx < 8; idx++) {
+        xtnt_list_insert(&list, &in_nodes[idx]);
+    }
+    ck_assert_msg(xtnt_set_iter_begin(&list, &iter, XTNT_SET_ITER_LOCK) == XTNT_ESUCCESS,
+        "Expected a cursor on a list");
+    for (key = 23; xtnt_set_iter_next(&iter, &node) == XTNT_ESUCCESS && node != NULL; key--) {
+        ck_assert_msg(node->key == key, "Expected key %u from the head, but got %u", key, node->key);
+    }
+    ck_assert_msg(key == 15, "Expected 8 members visited, but stopped at %u", key);
+    ck_assert_msg(xtnt_set_iter_next(&iter, &node) == XTNT_ESUCCESS && node == NULL,
+        "Expected an ended cursor to stay ended");
+    xtnt_set_iter_end(&iter);
+    ck_assert_msg(xtnt_set_iter_begin(&list, &iter, XTNT_SET_ITER_SNAPSHOT) == XTNT_ESUCCESS &&
+                  iter.count == 8,
+        "Expected a snapshot of 8 members");
+    xtnt_list_insert(&list, &in_nodes[8]);
+    for (key = 23; xtnt_set_iter_next(&iter, &node) == XTNT_ESUCCESS && node != NULL; key--) {
+        ck_assert_msg(node->key == key, "Expected key %u from the snapshot, but got %u", key, node->key);
+    }
+    ck_assert_msg(key == 15, "Expected the snapshot to miss a later insert");
+    xtnt_set_iter_end(&iter);
+    ck_assert_msg(xtnt_set_iter_range(&list, &iter, 16, 20, XTNT_SET_ITER_LOCK) == ENOTSUP,
+        "Expected a range on an unordered list to be ENOTSUP");
+    ck_assert_msg(xtnt_set_iter_begin(&list, &iter, 8) == EINVAL,
+        "Expected an unknown cursor mode to be EINVAL");
+    xtnt_node_set_uninitialize(&list);
+}
+END_TEST
+
+START_TEST (test_xtnt_list_insert_remove_many)
+{
+    struct xtnt_node_set list;
+    struct xtnt_node *batch[4] = { &in_nodes[1], &in_nodes[2], NULL, &in_nodes[4] };
+    struct xtnt_node *removed[4] = { &in_nodes[7], &in_nodes[3], NULL, &in_nodes[0] };
+    struct xtnt_node *node = NULL;
+    const xtnt_uint_t order[5] = { 22, 21, 20, 18, 17 };
+    xtnt_list_initialize(&list);
+    xtnt_list_insert(&list, &in_nodes[0]);
+    ck_assert_msg(xtnt_list_insert_many(&list, 4, batch) == EINVAL && list.count == 1,
+        "Expected a NULL node to be EINVAL with the list unchanged");
+    batch[2] = &in_nodes[3];
+    ck_assert_msg(xtnt_list_insert_many(&list, 4, batch) == XTNT_ESUCCESS && list.count == 5,
+        "Expected 5 members after inserting 4, but got %u", list.count);
+    in_nodes[5].link[XTNT_NODE_HEAD] = &in_nodes[6];
+    in_nodes[6].link[XTNT_NODE_HEAD] = &in_nodes[7];
+    in_nodes[7].link[XTNT_NODE_HEAD] = NULL;
+    ck_assert_msg(xtnt_list_insert_chain(&list, &in_nodes[5]) == XTNT_ESUCCESS && list.count == 8,
+        "Expected 8 members after inserting a chain of 3, but got %u", list.count);
+    for (xtnt_uint_t idx = 0; idx < 8; idx++) {
+        node = NULL;
+        xtnt_list_get(&list, idx, &node);
+        ck_assert_msg(node == &in_nodes[7 - idx],
+            "Expected index %u as if inserted one at a time", idx);
+    }
+    ck_assert_msg(xtnt_list_remove_many(&list, 4, removed) == XTNT_ESUCCESS && list.count == 5,
+        "Expected 5 members after removing the head, tail and a middle node, but got %u", list.count);
+    ck_assert_msg(list.root.link[XTNT_NODE_HEAD] == &in_nodes[6] &&
+                  list.root.link[XTNT_NODE_TAIL] == &in_nodes[1],
+        "Expected new head and tail members");
+    for (xtnt_uint_t idx = 0; idx < 5; idx++) {
+        node = NULL;
+        xtnt_list_get(&list, idx, &node);
+        ck_assert_msg(node != NULL && node->key == order[idx],
+            "Expected key %u at index %u", order[idx], idx);
+    }
+    for (xtnt_uint_t idx = 4; idx > 0; idx--) {
+        node = NULL;
+        xtnt_list_get(&list, idx, &node);
+        ck_assert_msg(node->link[XTNT_NODE_HEAD]->key == order[idx - 1],
+            "Expected the back links relinked at index %u", idx);
+    }
+    xtnt_node_set_uninitialize(&list);
+}
+END_TEST
+
 Suite * xtnt_list_suite(void)
 {
     Suite *s;
@@ -368,6 +591,12 @@ Suite * xtnt_list_suite(void)
     tcase_add_test(tc_xtnt_list, test_xtnt_list_get_nodes);
 
     tcase_add_test(tc_xtnt_list, test_xtnt_list_search_empty);
+    tcase_add_test(tc_xtnt_list, test_xtnt_list_search_rwlock);
+    tcase_add_test(tc_xtnt_list, test_xtnt_list_search_seqlock);
+    tcase_add_test(tc_xtnt_list, test_xtnt_list_set_if);
+    tcase_add_test(tc_xtnt_list, test_xtnt_list_sort);
+    tcase_add_test(tc_xtnt_list, test_xtnt_list_iter);
+    tcase_add_test(tc_xtnt_list, test_xtnt_list_insert_remove_many);
 
     suite_add_tcase(s, tc_xtnt_list);
 
@@ -0,0 +1,197 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <check.h>
+#include <extant/set/list/clist.h>
+
+#include <stdio.h>
+
+#define LIST_NODES (16)
+
+struct xtnt_cnode nodes[LIST_NODES];
+struct xtnt_node_set list;
+
+void setup(void)
+{
+    for (xtnt_uint_t idx = 0; idx < LIST_NODES; idx++) {
+        xtnt_cnode_initialize(&nodes[idx], idx, &nodes[idx]);
+    }
+    if (xtnt_clist_initialize(&list) != XTNT_ESUCCESS) {
+        ck_abort_msg("Failed to initialize list in setup.");
+    }
+    for (xtnt_uint_t idx = 0; idx < LIST_NODES; idx++) {
+        xtnt_clist_insert(&list, &nodes[idx]);
+    }
+}
+
+void teardown(void)
+{
+    xtnt_node_set_uninitialize(&list);
+}
+
+START_TEST (test_xtnt_clist_size)
+{
+    ck_assert_msg(sizeof(struct xtnt_cnode) <= 32,
+        "Expected a compact node of at most 32 bytes, but have %zu",
+        sizeof(struct xtnt_cnode));
+    ck_assert_msg(sizeof(struct xtnt_entry) <= 16,
+        "Expected an entry of at most 16 bytes, but have %zu",
+        sizeof(struct xtnt_entry));
+}
+END_TEST
+
+START_TEST (test_xtnt_clist_get)
+{
+    struct xtnt_cnode *node = NULL;
+    ck_assert_msg(list.count == LIST_NODES,
+        "Expected count of %u, but have %u", LIST_NODES, list.count);
+    for (xtnt_uint_t idx = 0; idx < LIST_NODES; idx++) {
+        xtnt_clist_get(&list, idx, &node);
+        ck_assert_msg(node == &nodes[LIST_NODES - 1 - idx],
+            "Expected index %u to hold the newest first", idx);
+    }
+    xtnt_clist_get(&list, LIST_NODES, &node);
+    ck_assert_msg(node == NULL,
+        "Expected NULL past the end");
+}
+END_TEST
+
+START_TEST (test_xtnt_clist_search)
+{
+    struct xtnt_cnode *node = NULL;
+    for (xtnt_uint_t idx = 0; idx < LIST_NODES; idx++) {
+        xtnt_clist_search(&list, idx, &node);
+        ck_assert_msg(node == &nodes[idx],
+            "Expected to find key %u", idx);
+    }
+    xtnt_clist_search(&list, LIST_NODES, &node);
+    ck_assert_msg(node == NULL,
+        "Expected a missing key to find NULL");
+}
+END_TEST
+
+START_TEST (test_xtnt_clist_remove)
+{
+    struct xtnt_cnode *node = NULL;
+    xtnt_clist_remove(&list, &nodes[7]);
+    xtnt_clist_remove(&list, &nodes[0]);
+    xtnt_clist_remove(&list, &nodes[LIST_NODES - 1]);
+    xtnt_clist_delete(&list, 0, &node);
+    ck_assert_msg(node == &nodes[LIST_NODES - 2],
+        "Expected delete of index 0 to remove the newest remaining");
+    xtnt_clist_pop(&list, &node);
+    ck_assert_msg(node == &nodes[LIST_NODES - 3],
+        "Expected pop to remove the newest remaining");
+    ck_assert_msg(list.count == LIST_NODES - 5,
+        "Expected count of %u, but have %u", LIST_NODES - 5, list.count);
+    xtnt_clist_search(&list, 7, &node);
+    ck_assert_msg(node == NULL,
+        "Expected removed key 7 to be missing");
+    ck_assert_msg(list.root.link[XTNT_NODE_TAIL] == (struct xtnt_node *) &nodes[1],
+        "Expected the oldest remaining member at the tail");
+    while (list.count > 0) {
+        xtnt_clist_pop(&list, &node);
+    }
+    ck_assert_msg(list.root.link[XTNT_NODE_HEAD] == NULL &&
+                  list.root.link[XTNT_NODE_TAIL] == NULL,
+        "Expected empty ends after popping every member");
+}
+END_TEST
+
+static xtnt_status_t
+sum_keys(void *ctx, struct xtnt_node *node)
+{
+    *((xtnt_uint_t *) ctx) += node->key;
+    return XTNT_ESUCCESS;
+}
+
+START_TEST (test_xtnt_clist_set_if)
+{
+    struct xtnt_node *node = NULL;
+    struct xtnt_cnode *found = NULL;
+    struct xtnt_set_iter iter;
+    xtnt_uint_t sum = 0;
+    xtnt_set_remove(&list, (struct xtnt_node *) &nodes[3]);
+    xtnt_clist_search(&list, 3, &found);
+    ck_assert_msg(found == NULL,
+        "Expected xtnt_set_remove to unlink key 3");
+    xtnt_set_push(&list, (struct xtnt_node *) &nodes[3]);
+    xtnt_clist_get(&list, 0, &found);
+    ck_assert_msg(found == &nodes[3],
+        "Expected xtnt_set_push to insert at the head");
+    ck_assert_msg(xtnt_set_index(&list, 1, &node) == ENOTSUP &&
+                  xtnt_set_last(&list, &node) == ENOTSUP &&
+                  xtnt_set_search(&list, 3, &node) == ENOTSUP &&
+                  xtnt_set_pop(&list, &node) == ENOTSUP && node == NULL,
+        "Expected member returning operations of a compact list to be ENOTSUP");
+    ck_assert_msg(xtnt_set_sort(&list) == ENOTSUP,
+        "Expected a compact list sort to be ENOTSUP");
+    ck_assert_msg(xtnt_set_iter_begin(&list, &iter, XTNT_SET_ITER_LOCK) == ENOTSUP,
+        "Expected a cursor over a compact list to be ENOTSUP");
+    ck_assert_msg(xtnt_set_for_each(&list, sum_keys, &sum) == ENOTSUP && sum == 0,
+        "Expected for each over a compact list to be refused before visiting");
+    ck_assert_msg(list.count == LIST_NODES,
+        "Expected the refused calls to leave %u members, but have %u", LIST_NODES, list.count);
+}
+END_TEST
+
+Suite * xtnt_clist_suite(void)
+{
+    Suite *s;
+    TCase *tc_xtnt_clist;
+
+    s = suite_create("xtnt_clist");
+
+    tc_xtnt_clist = tcase_create("Compact List");
+
+    tcase_add_checked_fixture(tc_xtnt_clist, setup, teardown);
+    tcase_add_test(tc_xtnt_clist, test_xtnt_clist_size);
+    tcase_add_test(tc_xtnt_clist, test_xtnt_clist_get);
+    tcase_add_test(tc_xtnt_clist, test_xtnt_clist_search);
+    tcase_add_test(tc_xtnt_clist, test_xtnt_clist_remove);
+    tcase_add_test(tc_xtnt_clist, test_xtnt_clist_set_if);
+    suite_add_tcase(s, tc_xtnt_clist);
+
+    return s;
+}
+
+int main(void)
+{
+    int failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = xtnt_clist_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_VERBOSE);
+    failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (failed == 0) ? 0 : failed;
+}
@@ -0,0 +1,270 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <check.h>
+#include <extant/set/list/skiplist.h>
+
+#include <stdio.h>
+
+#define LIST_NODES (2000)
+
+struct xtnt_node nodes[LIST_NODES];
+struct xtnt_node_set list;
+
+/* Keys 0, 3, 6 ... inserted in a shuffled order */
+void setup(void)
+{
+    for (xtnt_uint_t idx = 0; idx < LIST_NODES; idx++) {
+        xtnt_node_initialize(&nodes[idx], idx * 3, 0, &nodes[idx]);
+    }
+    if (xtnt_skiplist_initialize(&list) != XTNT_ESUCCESS) {
+        ck_abort_msg("Failed to initialize skip list in setup.");
+    }
+    for (xtnt_uint_t idx = 0; idx < LIST_NODES; idx++) {
+        xtnt_skiplist_insert(&list, &nodes[(idx * 7919) % LIST_NODES]);
+    }
+}
+
+void teardown(void)
+{
+    xtnt_skiplist_uninitialize(&list);
+}
+
+/* Check every index against the members still linked, in key order */
+static void
+check_members(
+    struct xtnt_node_set *set)
+{
+    struct xtnt_node *node = NULL;
+    struct xtnt_node *linked = set->root.link[XTNT_NODE_HEAD];
+    xtnt_uint_t rank = 0;
+    for (xtnt_uint_t idx = 0; idx < set->count; idx++) {
+        xtnt_skiplist_get(set, idx, &node);
+        ck_assert_msg(node == linked && node != NULL,
+            "Expected index %u to be the member linked at %u", idx, idx);
+        ck_assert_msg(xtnt_skiplist_rank(set, node->key, &rank) == XTNT_ESUCCESS && rank == idx,
+            "Expected key %u to rank %u, but got %u", node->key, idx, rank);
+        if (idx > 0) {
+            ck_assert_msg(node->link[XTNT_NODE_HEAD]->key < node->key,
+                "Expected ascending keys at %u", idx);
+        }
+        linked = linked->link[XTNT_NODE_TAIL];
+    }
+    ck_assert_msg(linked == NULL,
+        "Expected %u linked members", set->count);
+    xtnt_skiplist_get(set, set->count, &node);
+    ck_assert_msg(node == NULL,
+        "Expected no member past the end");
+}
+
+START_TEST (test_xtnt_skiplist_insert)
+{
+    ck_assert_msg(list.count == LIST_NODES,
+        "Expected count of %u, but have %u", LIST_NODES, list.count);
+    check_members(&list);
+    ck_assert_msg(list.root.link[XTNT_NODE_HEAD] == &nodes[0] &&
+                  list.root.link[XTNT_NODE_TAIL] == &nodes[LIST_NODES - 1],
+        "Expected the least key at the head and the greatest at the tail");
+    ck_assert_msg(xtnt_skiplist_insert(&list, &nodes[5]) == EEXIST,
+        "Expected a member key to be EEXIST");
+}
+END_TEST
+
+START_TEST (test_xtnt_skiplist_search)
+{
+    struct xtnt_node *found = NULL;
+    xtnt_uint_t rank = 7;
+    for (xtnt_uint_t idx = 0; idx < LIST_NODES; idx += 13) {
+        xtnt_skiplist_search(&list, idx * 3, &found);
+        ck_assert_msg(found == &nodes[idx],
+            "Expected key %u to be found", idx * 3);
+    }
+    xtnt_skiplist_search(&list, 4, &found);
+    ck_assert_msg(found == NULL,
+        "Expected a missing key to find nothing");
+    ck_assert_msg(xtnt_skiplist_rank(&list, 4, &rank) == ENOENT && rank == 7,
+        "Expected a missing key to have no rank");
+}
+END_TEST
+
+START_TEST (test_xtnt_skiplist_delete)
+{
+    struct xtnt_node *deleted = NULL;
+    for (xtnt_uint_t idx = 0; idx < LIST_NODES / 2; idx++) {
+        xtnt_skiplist_delete(&list, (idx * 31) % list.count, &deleted);
+        ck_assert_msg(deleted != NULL && deleted->link[XTNT_NODE_MIDDLE] == NULL,
+            "Expected delete %u to unlink a member", idx);
+        xtnt_skiplist_remove(&list, ((idx * 7) % LIST_NODES) * 3, &deleted);
+    }
+    check_members(&list);
+    xtnt_skiplist_delete(&list, list.count, &deleted);
+    ck_assert_msg(deleted == NULL,
+        "Expected a delete past the end to delete nothing");
+    while (list.count) {
+        xtnt_skiplist_delete(&list, list.count - 1, &deleted);
+    }
+    ck_assert_msg(list.root.link[XTNT_NODE_HEAD] == NULL && list.root.link[XTNT_NODE_TAIL] == NULL,
+        "Expected an empty list to link nothing");
+    for (xtnt_uint_t idx = 0; idx < LIST_NODES; idx += 2) {
+        xtnt_skiplist_insert(&list, &nodes[idx]);
+    }
+    check_members(&list);
+}
+END_TEST
+
+START_TEST (test_xtnt_skiplist_set_if)
+{
+    struct xtnt_node *found = NULL;
+    xtnt_set_index(&list, 10, &found);
+    ck_assert_msg(found == &nodes[10],
+        "Expected xtnt_set_index to read the member of rank 10");
+    xtnt_set_first(&list, &found);
+    ck_assert_msg(found == &nodes[0],
+        "Expected xtnt_set_first to be the least key");
+    xtnt_set_last(&list, &found);
+    ck_assert_msg(found == &nodes[LIST_NODES - 1],
+        "Expected xtnt_set_last to be the greatest key");
+    ck_assert_msg(xtnt_set_remove(&list, &nodes[10]) == XTNT_ESUCCESS && list.count == LIST_NODES - 1,
+        "Expected xtnt_set_remove to remove by key");
+    xtnt_set_remove_at(&list, 10, &found);
+    ck_assert_msg(found == &nodes[11],
+        "Expected xtnt_set_remove_at to remove by index");
+    ck_assert_msg(xtnt_set_push(&list, &nodes[10]) == ENOTSUP,
+        "Expected a skip list push to be ENOTSUP");
+}
+END_TEST
+
+struct reader_ctx {
+    struct xtnt_node_set *set;
+    volatile xtnt_uint_t done;
+    xtnt_uint_t misses;
+};
+
+/* Members at even indices are never removed, so a reader must always find them */
+static void *
+reader(
+    void *arg)
+{
+    struct reader_ctx *ctx = arg;
+    struct xtnt_node *found = NULL;
+    while (!ctx->done) {
+        for (xtnt_uint_t idx = 0; idx < LIST_NODES; idx += 2) {
+            xtnt_skiplist_search(ctx->set, nodes[idx].key, &found);
+            if (found != &nodes[idx]) {
+                ctx->misses++;
+            }
+        }
+    }
+    return NULL;
+}
+
+START_TEST (test_xtnt_skiplist_seqlock)
+{
+    struct xtnt_node_set set;
+    struct xtnt_node *removed = NULL;
+    struct reader_ctx ctx = { &set, 0, 0 };
+    pthread_t thread;
+    xtnt_skiplist_initialize_lock(&set, XTNT_SET_LOCK_SEQLOCK);
+    xtnt_skiplist_uninitialize(&list);
+    for (xtnt_uint_t idx = 0; idx < LIST_NODES; idx++) {
+        xtnt_skiplist_insert(&set, &nodes[idx]);
+    }
+    pthread_create(&thread, NULL, reader, &ctx);
+    for (xtnt_uint_t round = 0; round < 200; round++) {
+        for (xtnt_uint_t idx = 1; idx < LIST_NODES; idx += 2) {
+            xtnt_skiplist_remove(&set, nodes[idx].key, &removed);
+        }
+        for (xtnt_uint_t idx = 1; idx < LIST_NODES; idx += 2) {
+            xtnt_skiplist_insert(&set, &nodes[idx]);
+        }
+    }
+    ctx.done = 1;
+    pthread_join(thread, NULL);
+    ck_assert_msg(ctx.misses == 0,
+        "Expected optimistic readers to find every kept member, but missed %u", ctx.misses);
+    check_members(&set);
+    xtnt_skiplist_uninitialize(&set);
+    xtnt_skiplist_initialize(&list);
+}
+END_TEST
+
+START_TEST (test_xtnt_skiplist_range)
+{
+    struct xtnt_set_iter iter;
+    struct xtnt_node *node = NULL;
+    xtnt_uint_t key = 0;
+    ck_assert_msg(xtnt_set_iter_range(&list, &iter, 301, 600, XTNT_SET_ITER_LOCK) == XTNT_ESUCCESS,
+        "Expected a range cursor on a skip list");
+    for (key = 303; xtnt_set_iter_next(&iter, &node) == XTNT_ESUCCESS && node != NULL; key += 3) {
+        ck_assert_msg(node->key == key, "Expected key %u, but got %u", key, node->key);
+    }
+    xtnt_set_iter_end(&iter);
+    ck_assert_msg(key == 603, "Expected the range to end at 600, but ended at %u", key);
+    xtnt_set_iter_range(&list, &iter, 0, 0, XTNT_SET_ITER_SNAPSHOT);
+    ck_assert_msg(iter.count == 1 && iter.table[0] == &nodes[0],
+        "Expected a range from the least key to hold it alone");
+    xtnt_set_iter_end(&iter);
+}
+END_TEST
+
+Suite * xtnt_skiplist_suite(void)
+{
+    Suite *s;
+    TCase *tc_xtnt_skiplist;
+
+    s = suite_create("xtnt_skiplist");
+
+    tc_xtnt_skiplist = tcase_create("Skip List");
+    tcase_add_checked_fixture(tc_xtnt_skiplist, setup, teardown);
+
+    tcase_add_test(tc_xtnt_skiplist, test_xtnt_skiplist_insert);
+    tcase_add_test(tc_xtnt_skiplist, test_xtnt_skiplist_search);
+    tcase_add_test(tc_xtnt_skiplist, test_xtnt_skiplist_delete);
+    tcase_add_test(tc_xtnt_skiplist, test_xtnt_skiplist_set_if);
+    tcase_add_test(tc_xtnt_skiplist, test_xtnt_skiplist_seqlock);
+    tcase_add_test(tc_xtnt_skiplist, test_xtnt_skiplist_range);
+    suite_add_tcase(s, tc_xtnt_skiplist);
+
+    return s;
+}
+
+int main(void)
+{
+    int failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = xtnt_skiplist_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_VERBOSE);
+    failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (failed == 0) ? 0 : failed;
+}
@@ -31,6 +31,10 @@ SOFTWARE.
 #include <extant/set/queue.h>
 
 #include <stdio.h>
+#include <stdlib.h>
+
+#define MPSC_PRODUCERS (4)
+#define MPSC_NODES (20000)
 
 struct xtnt_node node1q1, node2q1, node3q1, node1q2, node2q2, node3q2;
 struct xtnt_node_set queue1, queue2;
@@ -149,6 +153,287 @@ START_TEST (test_xtnt_empty_queue_push)
 }
 END_TEST
 
+START_TEST (test_xtnt_queue_mpsc_order)
+{
+    struct xtnt_node_set mpsc;
+    struct xtnt_node *node = NULL;
+    xtnt_queue_initialize(&mpsc, XTNT_QUEUE_MODE_MPSC);
+    xtnt_queue_pop(&mpsc, &node);
+    ck_assert_msg(node == NULL,
+        "Expected empty node, but received node.key=%u", node->key);
+    xtnt_queue_push(&mpsc, &node1q2);
+    xtnt_queue_push(&mpsc, &node2q2);
+    xtnt_queue_peek(&mpsc, &node);
+    ck_assert_msg(node == &node1q2,
+        "Expected peek of oldest node");
+    xtnt_queue_push(&mpsc, &node3q2);
+    ck_assert_msg(mpsc.count == 3,
+        "Expected count of 3, but got %u", mpsc.count);
+    for (xtnt_uint_t key = 1; key <= 3; key++) {
+        xtnt_queue_pop(&mpsc, &node);
+        ck_assert_msg(node != NULL && node->key == key,
+            "Expected node with key %u in FIFO order", key);
+    }
+    xtnt_queue_pop(&mpsc, &node);
+    ck_assert_msg(node == NULL && mpsc.count == 0,
+        "Expected empty queue after draining");
+    xtnt_queue_push(&mpsc, &node1q2);
+    xtnt_queue_pop(&mpsc, &node);
+    ck_assert_msg(node == &node1q2,
+        "Expected queue reusable after draining");
+    xtnt_node_set_uninitialize(&mpsc);
+}
+END_TEST
+
+START_TEST (test_xtnt_queue_pop_batch)
+{
+    struct xtnt_node *nodes[4] = { NULL };
+    xtnt_uint_t count = 0;
+    xtnt_status_t res = xtnt_queue_push(&queue1, &node3q1);
+    res = xtnt_queue_pop_batch(&queue1, 2, nodes, &count);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected xtnt_queue_pop_batch to succeed");
+    ck_assert_msg(count == 2 && nodes[0] == &node1q1 && nodes[1] == &node2q1,
+        "Expected the two oldest nodes, but got %u nodes", count);
+    ck_assert_msg(queue1.count == 1 && queue1.root.link[XTNT_NODE_TAIL] == &node3q1,
+        "Expected node3 left in queue");
+    xtnt_queue_pop_batch(&queue1, 4, nodes, &count);
+    ck_assert_msg(count == 1 && nodes[0] == &node3q1,
+        "Expected remaining node3, but got %u nodes", count);
+    xtnt_queue_pop_batch(&queue1, 4, nodes, &count);
+    ck_assert_msg(count == 0,
+        "Expected no nodes from empty queue, but got %u", count);
+}
+END_TEST
+
+START_TEST (test_xtnt_queue_drain)
+{
+    struct xtnt_node *head = NULL;
+    xtnt_status_t res = xtnt_queue_push(&queue1, &node3q1);
+    res = xtnt_queue_drain(&queue1, &head);
+    ck_assert_msg(res == XTNT_ESUCCESS,
+        "Expected xtnt_queue_drain to succeed");
+    ck_assert_msg(head == &node1q1 &&
+                  head->link[XTNT_NODE_HEAD] == &node2q1 &&
+                  node2q1.link[XTNT_NODE_HEAD] == &node3q1 &&
+                  node3q1.link[XTNT_NODE_HEAD] == NULL,
+        "Expected chain of node1, node2, node3 ending with NULL");
+    ck_assert_msg(queue1.count == 0 &&
+                  queue1.root.link[XTNT_NODE_HEAD] == NULL &&
+                  queue1.root.link[XTNT_NODE_TAIL] == NULL,
+        "Expected empty queue after drain");
+    xtnt_queue_drain(&queue2, &head);
+    ck_assert_msg(head == NULL,
+        "Expected NULL from draining empty queue");
+}
+END_TEST
+
+START_TEST (test_xtnt_queue_mpsc_batch)
+{
+    struct xtnt_node_set mpsc;
+    struct xtnt_node *nodes[2] = { NULL };
+    struct xtnt_node *head = NULL;
+    xtnt_uint_t count = 0;
+    xtnt_queue_initialize(&mpsc, XTNT_QUEUE_MODE_MPSC);
+    xtnt_queue_push(&mpsc, &node1q2);
+    xtnt_queue_push(&mpsc, &node2q2);
+    ck_assert_msg(xtnt_set_push(&mpsc, &node3q2) == XTNT_ESUCCESS,
+        "Expected an MPSC queue to push through the set interface");
+    xtnt_queue_pop_batch(&mpsc, 2, nodes, &count);
+    ck_assert_msg(count == 2 && nodes[0] == &node1q2 && nodes[1] == &node2q2,
+        "Expected the two oldest nodes, but got %u nodes", count);
+    xtnt_queue_push(&mpsc, &node1q2);
+    xtnt_queue_drain(&mpsc, &head);
+    ck_assert_msg(head == &node3q2 &&
+                  node3q2.link[XTNT_NODE_HEAD] == &node1q2 &&
+                  node1q2.link[XTNT_NODE_HEAD] == NULL,
+        "Expected chain of node3, node1 ending with NULL");
+    ck_assert_msg(mpsc.count == 0,
+        "Expected empty queue after drain, but count is %u", mpsc.count);
+    xtnt_node_set_uninitialize(&mpsc);
+}
+END_TEST
+
+struct xtnt_node_set mpsc_queue;
+struct xtnt_node *mpsc_nodes;
+
+void *
+mpsc_producer(void *arg)
+{
+    xtnt_uint_t producer = (xtnt_uint_t) (uintptr_t) arg;
+    for (xtnt_uint_t idx = 0; idx < MPSC_NODES; idx++) {
+        struct xtnt_node *node = &(mpsc_nodes[producer * MPSC_NODES + idx]);
+        node->key = idx;
+        node->quirk = producer;
+        xtnt_queue_push(&mpsc_queue, node);
+    }
+    return NULL;
+}
+
+START_TEST (test_xtnt_queue_mpsc_producers)
+{
+    pthread_t threads[MPSC_PRODUCERS];
+    xtnt_uint_t next[MPSC_PRODUCERS] = { 0 };
+    xtnt_uint_t popped = 0;
+    struct xtnt_node *node = NULL;
+    mpsc_nodes = calloc(MPSC_PRODUCERS * MPSC_NODES, sizeof(struct xtnt_node));
+    xtnt_queue_initialize(&mpsc_queue, XTNT_QUEUE_MODE_MPSC);
+    for (xtnt_uint_t idx = 0; idx < MPSC_PRODUCERS; idx++) {
+        pthread_create(&(threads[idx]), NULL, mpsc_producer, (void *) (uintptr_t) idx);
+    }
+    while (popped < MPSC_PRODUCERS * MPSC_NODES) {
+        xtnt_queue_pop(&mpsc_queue, &node);
+        if (node != NULL) {
+            ck_assert_msg(node->key == next[node->quirk],
+                "Expected producer %u node %u, but got %u",
+                node->quirk, next[node->quirk], node->key);
+            next[node->quirk]++;
+            popped++;
+        }
+    }
+    for (xtnt_uint_t idx = 0; idx < MPSC_PRODUCERS; idx++) {
+        pthread_join(threads[idx], NULL);
+    }
+    xtnt_queue_pop(&mpsc_queue, &node);
+    ck_assert_msg(node == NULL && mpsc_queue.count == 0,
+        "Expected empty queue, but count is %u", mpsc_queue.count);
+    xtnt_node_set_uninitialize(&mpsc_queue);
+    free(mpsc_nodes);
+}
+END_TEST
+
+START_TEST (test_xtnt_queue_set_if)
+{
+    struct xtnt_node_set mpsc;
+    struct xtnt_node *node = NULL;
+    ck_assert_msg(xtnt_queue_initialize(&mpsc, XTNT_QUEUE_MODE_MPSC) == XTNT_ESUCCESS,
+        "Expected the MPSC queue to initialize");
+    xtnt_set_push(&mpsc, &node1q2);
+    xtnt_set_push(&mpsc, &node2q2);
+    xtnt_set_peek(&mpsc, &node);
+    ck_assert_msg(node == &node1q2,
+        "Expected xtnt_set_peek to see the oldest node");
+    xtnt_set_pop(&mpsc, &node);
+    ck_assert_msg(node == &node1q2 && mpsc.count == 1,
+        "Expected xtnt_set_pop to remove the oldest node");
+    ck_assert_msg(xtnt_set_insert(&mpsc, &node3q2) == ENOTSUP,
+        "Expected a queue insert to be ENOTSUP");
+    xtnt_node_set_uninitialize(&mpsc);
+}
+END_TEST
+
+START_TEST (test_xtnt_queue_iter)
+{
+    struct xtnt_node_set queue;
+    struct xtnt_node_set mpsc;
+    struct xtnt_set_iter iter;
+    struct xtnt_node *node = NULL;
+    xtnt_uint_t key = 0;
+    xtnt_queue_initialize(&queue, XTNT_QUEUE_MODE_LOCKED);
+    // The newest member keeps a stale link the cursor must not follow
+    node3q2.link[XTNT_NODE_HEAD] = &node1q1;
+    xtnt_set_push(&queue, &node1q2);
+    xtnt_set_push(&queue, &node2q2);
+    xtnt_set_push(&queue, &node3q2);
+    ck_assert_msg(xtnt_set_iter_begin(&queue, &iter, XTNT_SET_ITER_LOCK) == XTNT_ESUCCESS,
+        "Expected a cursor on a queue");
+    for (key = 1; xtnt_set_iter_next(&iter, &node) == XTNT_ESUCCESS && node != NULL; key++) {
+        ck_assert_msg(node->key == key, "Expected key %u from the oldest, but got %u", key, node->key);
+    }
+    xtnt_set_iter_end(&iter);
+    ck_assert_msg(key == 4, "Expected 3 members visited, but stopped at %u", key);
+    xtnt_node_set_uninitialize(&queue);
+    xtnt_queue_initialize(&mpsc, XTNT_QUEUE_MODE_MPSC);
+    xtnt_set_iter_begin(&mpsc, &iter, XTNT_SET_ITER_LOCK);
+    ck_assert_msg(xtnt_set_iter_next(&iter, &node) == ENOTSUP,
+        "Expected a cursor on an MPSC queue to be ENOTSUP");
+    xtnt_set_iter_end(&iter);
+    xtnt_node_set_uninitialize(&mpsc);
+}
+END_TEST
+
+START_TEST (test_xtnt_queue_push_chain)
+{
+    struct xtnt_node_set queue;
+    struct xtnt_node *head = NULL;
+    struct xtnt_node *batch[3] = { &node1q2, &node2q2, &node3q2 };
+    struct xtnt_node *nodes[8] = { NULL };
+    xtnt_uint_t count = 0;
+    xtnt_queue_initialize(&queue, XTNT_QUEUE_MODE_LOCKED);
+    xtnt_queue_push(&queue, &node3q1);
+    xtnt_queue_drain(&queue1, &head);
+    ck_assert_msg(xtnt_queue_push_chain(&queue, head) == XTNT_ESUCCESS && queue.count == 3,
+        "Expected a drained chain of 2 pushed behind node3, but count is %u", queue.count);
+    ck_assert_msg(xtnt_queue_push_many(&queue, 3, batch) == XTNT_ESUCCESS && queue.count == 6,
+        "Expected 6 nodes after pushing 3 more, but count is %u", queue.count);
+    ck_assert_msg(xtnt_queue_push_chain(&queue, NULL) == XTNT_ESUCCESS && queue.count == 6,
+        "Expected an empty chain to leave the queue unchanged");
+    xtnt_queue_pop_batch(&queue, 8, nodes, &count);
+    ck_assert_msg(count == 6 &&
+                  nodes[0] == &node3q1 && nodes[1] == &node1q1 && nodes[2] == &node2q1 &&
+                  nodes[3] == &node1q2 && nodes[4] == &node2q2 && nodes[5] == &node3q2,
+        "Expected the chains queued in order, but got %u nodes", count);
+    xtnt_node_set_uninitialize(&queue);
+    xtnt_queue_initialize(&queue, XTNT_QUEUE_MODE_MPSC);
+    xtnt_queue_push(&queue, &node3q1);
+    ck_assert_msg(xtnt_queue_push_many(&queue, 3, batch) == XTNT_ESUCCESS && queue.count == 4,
+        "Expected 4 nodes in the MPSC queue, but count is %u", queue.count);
+    xtnt_queue_pop_batch(&queue, 8, nodes, &count);
+    ck_assert_msg(count == 4 && nodes[0] == &node3q1 && nodes[1] == &node1q2 &&
+                  nodes[2] == &node2q2 && nodes[3] == &node3q2 && queue.count == 0,
+        "Expected the MPSC chain queued in order, but got %u nodes", count);
+    xtnt_node_set_uninitialize(&queue);
+}
+END_TEST
+
+void *
+mpsc_chain_producer(void *arg)
+{
+    xtnt_uint_t producer = (xtnt_uint_t) (uintptr_t) arg;
+    struct xtnt_node *batch[8];
+    for (xtnt_uint_t idx = 0; idx < MPSC_NODES; idx += 8) {
+        for (xtnt_uint_t off = 0; off < 8; off++) {
+            batch[off] = &(mpsc_nodes[producer * MPSC_NODES + idx + off]);
+            batch[off]->key = idx + off;
+            batch[off]->quirk = producer;
+        }
+        xtnt_queue_push_many(&mpsc_queue, 8, batch);
+    }
+    return NULL;
+}
+
+START_TEST (test_xtnt_queue_mpsc_chain_producers)
+{
+    pthread_t threads[MPSC_PRODUCERS];
+    xtnt_uint_t next[MPSC_PRODUCERS] = { 0 };
+    xtnt_uint_t popped = 0;
+    struct xtnt_node *node = NULL;
+    mpsc_nodes = calloc(MPSC_PRODUCERS * MPSC_NODES, sizeof(struct xtnt_node));
+    xtnt_queue_initialize(&mpsc_queue, XTNT_QUEUE_MODE_MPSC);
+    for (xtnt_uint_t idx = 0; idx < MPSC_PRODUCERS; idx++) {
+        pthread_create(&(threads[idx]), NULL, mpsc_chain_producer, (void *) (uintptr_t) idx);
+    }
+    while (popped < MPSC_PRODUCERS * MPSC_NODES) {
+        xtnt_queue_pop(&mpsc_queue, &node);
+        if (node != NULL) {
+            ck_assert_msg(node->key == next[node->quirk],
+                "Expected producer %u node %u, but got %u",
+                node->quirk, next[node->quirk], node->key);
+            next[node->quirk]++;
+            popped++;
+        }
+    }
+    for (xtnt_uint_t idx = 0; idx < MPSC_PRODUCERS; idx++) {
+        pthread_join(threads[idx], NULL);
+    }
+    xtnt_queue_pop(&mpsc_queue, &node);
+    ck_assert_msg(node == NULL && mpsc_queue.count == 0,
+        "Expected empty queue, but count is %u", mpsc_queue.count);
+    xtnt_node_set_uninitialize(&mpsc_queue);
+    free(mpsc_nodes);
+}
+END_TEST
+
 Suite * xtnt_queue_suite(void)
 {
     Suite *s;
@@ -165,6 +450,15 @@ Suite * xtnt_queue_suite(void)
     tcase_add_test(tc_xtnt_queue, test_xtnt_empty_queue_pop);
     tcase_add_test(tc_xtnt_queue, test_xtnt_queue_push);
     tcase_add_test(tc_xtnt_queue, test_xtnt_empty_queue_push);
+    tcase_add_test(tc_xtnt_queue, test_xtnt_queue_pop_batch);
+    tcase_add_test(tc_xtnt_queue, test_xtnt_queue_drain);
+    tcase_add_test(tc_xtnt_queue, test_xtnt_queue_mpsc_order);
+    tcase_add_test(tc_xtnt_queue, test_xtnt_queue_mpsc_batch);
+    tcase_add_test(tc_xtnt_queue, test_xtnt_queue_mpsc_producers);
+    tcase_add_test(tc_xtnt_queue, test_xtnt_queue_set_if);
+    tcase_add_test(tc_xtnt_queue, test_xtnt_queue_iter);
+    tcase_add_test(tc_xtnt_queue, test_xtnt_queue_push_chain);
+    tcase_add_test(tc_xtnt_queue, test_xtnt_queue_mpsc_chain_producers);
     suite_add_tcase(s, tc_xtnt_queue);
 
     return s;
@@ -0,0 +1,239 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <check.h>
+#include <extant/set/shardmap.h>
+
+#include <stdio.h>
+
+#define MAP_NODES (4096)
+#define MAP_THREADS (4)
+
+struct xtnt_node nodes[MAP_NODES];
+struct xtnt_node others[MAP_NODES];
+struct xtnt_shardmap *map;
+
+void setup(void)
+{
+    xtnt_uint_t i;
+    for (i = 0; i < MAP_NODES; i++) {
+        nodes[i].key = i;
+        nodes[i].value = &nodes[i];
+        others[i].key = i;
+        others[i].value = &others[i];
+    }
+    if (xtnt_shardmap_create(0, &map) != XTNT_ESUCCESS) {
+        ck_abort_msg("Failed to create map in setup.");
+    }
+}
+
+void teardown(void)
+{
+    if (map != NULL) {
+        xtnt_shardmap_destroy(&map);
+    }
+}
+
+void *
+put_get_worker(void *arg)
+{
+    xtnt_uint_t part = (xtnt_uint_t) (uintptr_t) arg;
+    xtnt_uint_t per = MAP_NODES / MAP_THREADS;
+    struct xtnt_node *batch[MAP_NODES / MAP_THREADS];
+    struct xtnt_node *found[MAP_NODES / MAP_THREADS];
+    xtnt_uint_t keys[MAP_NODES / MAP_THREADS];
+    for (xtnt_uint_t i = 0; i < per; i++) {
+        batch[i] = &nodes[part * per + i];
+        keys[i] = part * per + i;
+    }
+    if (xtnt_shardmap_put_batch(map, per, batch, NULL) != XTNT_ESUCCESS ||
+        xtnt_shardmap_get_batch(map, per, keys, found) != XTNT_ESUCCESS) {
+        return (void *) 1;
+    }
+    for (xtnt_uint_t i = 0; i < per; i++) {
+        if (found[i] != batch[i]) {
+            return (void *) 1;
+        }
+    }
+    return NULL;
+}
+
+START_TEST (test_xtnt_shardmap_create)
+{
+    struct xtnt_shardmap *sized = NULL;
+    ck_assert_msg(map->shards >= 1 && map->shards <= XTNT_SHARDMAP_MAX &&
+                  (map->shards & (map->shards - 1)) == 0,
+        "Expected a power of 2 shards sized by CPU count, but got %zu", map->shards);
+    ck_assert_msg(xtnt_shardmap_create(5, &sized) == XTNT_ESUCCESS && sized->shards == 8,
+        "Expected 5 shards rounded up to 8");
+    xtnt_shardmap_destroy(&sized);
+    ck_assert_msg(sized == NULL,
+        "Expected map reference cleared on destroy");
+}
+END_TEST
+
+START_TEST (test_xtnt_shardmap_put_get)
+{
+    struct xtnt_node *found = NULL;
+    struct xtnt_node *replaced = NULL;
+    ck_assert_msg(xtnt_shardmap_put(map, &nodes[7], &replaced) == XTNT_ESUCCESS &&
+                  replaced == NULL,
+        "Expected put of a new key to replace nothing");
+    xtnt_shardmap_get(map, 7, &found);
+    ck_assert_msg(found == &nodes[7],
+        "Expected get to find the node put");
+    xtnt_shardmap_put(map, &others[7], &replaced);
+    ck_assert_msg(replaced == &nodes[7],
+        "Expected put of an existing key to replace its node");
+    xtnt_shardmap_get(map, 7, &found);
+    ck_assert_msg(found == &others[7],
+        "Expected get to find the replacing node");
+    xtnt_shardmap_delete(map, 7, &found);
+    ck_assert_msg(found == &others[7],
+        "Expected delete to remove the node");
+    xtnt_shardmap_get(map, 7, &found);
+    ck_assert_msg(found == NULL,
+        "Expected deleted key not found");
+}
+END_TEST
+
+static xtnt_status_t
+sum_keys(void *ctx, struct xtnt_node *node)
+{
+    xtnt_uint_t *sum = ctx;
+    sum[0] += node->key;
+    sum[1]++;
+    return (sum[1] == sum[2]) ? ECANCELED : XTNT_ESUCCESS;
+}
+
+START_TEST (test_xtnt_shardmap_for_each)
+{
+    struct xtnt_node *replaced = NULL;
+    xtnt_uint_t sum[3] = { 0, 0, 0 };
+    for (xtnt_uint_t i = 0; i < MAP_NODES; i++) {
+        xtnt_shardmap_put(map, &nodes[i], &replaced);
+    }
+    ck_assert_msg(xtnt_shardmap_for_each(map, sum_keys, sum) == XTNT_ESUCCESS &&
+                  sum[1] == MAP_NODES && sum[0] == MAP_NODES * (MAP_NODES - 1) / 2,
+        "Expected every key visited once, but visited %u", sum[1]);
+    sum[0] = sum[1] = 0;
+    sum[2] = 10;
+    ck_assert_msg(xtnt_shardmap_for_each(map, sum_keys, sum) == ECANCELED && sum[1] == 10,
+        "Expected the walk to stop at the first failing visit");
+}
+END_TEST
+
+START_TEST (test_xtnt_shardmap_batch)
+{
+    static struct xtnt_node *batch[MAP_NODES];
+    static struct xtnt_node *replaced[MAP_NODES];
+    static struct xtnt_node *found[MAP_NODES + 1];
+    static xtnt_uint_t keys[MAP_NODES + 1];
+    xtnt_uint_t i;
+    for (i = 0; i < MAP_NODES; i++) {
+        batch[i] = &nodes[i];
+        keys[i] = i;
+    }
+    keys[MAP_NODES] = MAP_NODES;
+    ck_assert_msg(xtnt_shardmap_put_batch(map, MAP_NODES, batch, replaced) == XTNT_ESUCCESS,
+        "Expected batch put to succeed");
+    for (i = 0; i < MAP_NODES; i += 2) {
+        batch[i] = &others[i];
+    }
+    xtnt_shardmap_put_batch(map, MAP_NODES, batch, replaced);
+    ck_assert_msg(xtnt_shardmap_get_batch(map, MAP_NODES + 1, keys, found) == XTNT_ESUCCESS,
+        "Expected batch get to succeed");
+    for (i = 0; i < MAP_NODES; i++) {
+        ck_assert_msg(found[i] == batch[i],
+            "Expected batch get of key %u in batch order", i);
+        ck_assert_msg(replaced[i] == &nodes[i],
+            "Expected batch put to report the replaced node of key %u", i);
+    }
+    ck_assert_msg(found[MAP_NODES] == NULL,
+        "Expected absent key not found in batch");
+}
+END_TEST
+
+START_TEST (test_xtnt_shardmap_threads)
+{
+    pthread_t threads[MAP_THREADS];
+    void *status = NULL;
+    xtnt_uint_t count = 0;
+    for (uintptr_t t = 0; t < MAP_THREADS; t++) {
+        pthread_create(&threads[t], NULL, put_get_worker, (void *) t);
+    }
+    for (int t = 0; t < MAP_THREADS; t++) {
+        pthread_join(threads[t], &status);
+        ck_assert_msg(status == NULL,
+            "Expected each thread to get the nodes it put");
+    }
+    for (xtnt_uint_t i = 0; i < MAP_NODES; i++) {
+        struct xtnt_node *found = NULL;
+        xtnt_shardmap_get(map, i, &found);
+        count += (found == &nodes[i]);
+    }
+    ck_assert_msg(count == MAP_NODES,
+        "Expected %d nodes in the map, but got %u", MAP_NODES, count);
+}
+END_TEST
+
+Suite * xtnt_shardmap_suite(void)
+{
+    Suite *s;
+    TCase *tc_shardmap;
+
+    s = suite_create("xtnt_shardmap");
+
+    tc_shardmap = tcase_create("Sharded map");
+
+    tcase_add_checked_fixture(tc_shardmap, setup, teardown);
+    tcase_add_test(tc_shardmap, test_xtnt_shardmap_create);
+    tcase_add_test(tc_shardmap, test_xtnt_shardmap_put_get);
+    tcase_add_test(tc_shardmap, test_xtnt_shardmap_batch);
+    tcase_add_test(tc_shardmap, test_xtnt_shardmap_threads);
+    tcase_add_test(tc_shardmap, test_xtnt_shardmap_for_each);
+    suite_add_tcase(s, tc_shardmap);
+
+    return s;
+}
+
+int main(void)
+{
+    int failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = xtnt_shardmap_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_VERBOSE);
+    failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (failed == 0) ? 0 : failed;
+}
@@ -0,0 +1,244 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <check.h>
+#include <extant/set/sort.h>
+
+#include <stdio.h>
+
+#define SORT_NODES (20000)
+
+struct xtnt_node nodes[SORT_NODES];
+struct xtnt_node *table[SORT_NODES];
+
+static xtnt_uint_t
+next_random(
+    xtnt_uint_t *seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+/* Fill the table with keys of a shape, the position of each node is its quirk */
+static void
+fill(
+    size_t count,
+    xtnt_uint_t shape)
+{
+    xtnt_uint_t seed = 7;
+    for (size_t idx = 0; idx < count; idx++) {
+        switch (shape) {
+        case 0:
+            nodes[idx].key = next_random(&seed);
+            break;
+        case 1:
+            nodes[idx].key = idx;
+            break;
+        case 2:
+            nodes[idx].key = count - idx;
+            break;
+        case 3:
+            nodes[idx].key = 42;
+            break;
+        default:
+            nodes[idx].key = (idx < count / 2) ? idx : count - idx;
+            break;
+        }
+        // Keys spread over every byte so each radix pass has work
+        nodes[idx].key = (nodes[idx].key % 1000) * (XTNT_UINT_MAX / 1000);
+        nodes[idx].quirk = idx;
+        nodes[idx].link[XTNT_NODE_HEAD] = (idx) ? &nodes[idx - 1] : NULL;
+        nodes[idx].link[XTNT_NODE_TAIL] = (idx + 1 < count) ? &nodes[idx + 1] : NULL;
+        table[idx] = &nodes[idx];
+    }
+}
+
+/* Check keys are ordered, and equal keys keep their positions when stable */
+static void
+check_order(
+    size_t count,
+    xtnt_uint_t reverse,
+    xtnt_uint_t stable)
+{
+    for (size_t idx = 1; idx < count; idx++) {
+        if (reverse) {
+            ck_assert_msg(table[idx - 1]->key >= table[idx]->key,
+                "Expected descending keys at %zu", idx);
+        } else {
+            ck_assert_msg(table[idx - 1]->key <= table[idx]->key,
+                "Expected ascending keys at %zu", idx);
+        }
+        if (stable && table[idx - 1]->key == table[idx]->key) {
+            ck_assert_msg(table[idx - 1]->quirk < table[idx]->quirk,
+                "Expected equal keys in their first order at %zu", idx);
+        }
+    }
+}
+
+/* The key order, but not one the sorts recognize as a key order */
+static xtnt_int_t
+compare_key(
+    const struct xtnt_node *a,
+    const struct xtnt_node *b)
+{
+    return (a->key > b->key) - (a->key < b->key);
+}
+
+void setup(void)
+{
+}
+
+void teardown(void)
+{
+}
+
+START_TEST (test_xtnt_sort_chain)
+{
+    struct xtnt_node *head = NULL;
+    struct xtnt_node *tail = NULL;
+    size_t idx = 0;
+    for (xtnt_uint_t shape = 0; shape < 5; shape++) {
+        fill(SORT_NODES, shape);
+        head = &nodes[0];
+        tail = &nodes[SORT_NODES - 1];
+        ck_assert_msg(xtnt_sort_chain(&head, &tail, xtnt_node_compare_key) == XTNT_ESUCCESS,
+            "Expected the chain of shape %u to sort", shape);
+        idx = 0;
+        for (struct xtnt_node *node = head; node != NULL; node = node->link[XTNT_NODE_TAIL]) {
+            ck_assert_msg(node->link[XTNT_NODE_HEAD] == ((idx) ? table[idx - 1] : NULL),
+                "Expected the previous link of member %zu", idx);
+            table[idx++] = node;
+        }
+        ck_assert_msg(idx == SORT_NODES && tail == table[SORT_NODES - 1],
+            "Expected every node between head and tail, but got %zu", idx);
+        check_order(SORT_NODES, 0, 1);
+    }
+    head = tail = NULL;
+    ck_assert_msg(xtnt_sort_chain(&head, &tail, xtnt_node_compare_key) == XTNT_ESUCCESS && head == NULL && tail == NULL,
+        "Expected an empty chain to stay empty");
+    ck_assert_msg(xtnt_sort_chain(&head, &tail, NULL) == EINVAL,
+        "Expected a chain sort without a comparison to be EINVAL");
+}
+END_TEST
+
+START_TEST (test_xtnt_sort_table)
+{
+    for (xtnt_uint_t shape = 0; shape < 5; shape++) {
+        for (size_t count = 1; count <= SORT_NODES; count *= 7) {
+            fill(count, shape);
+            ck_assert_msg(xtnt_sort_table(table, count, xtnt_node_compare_key) == XTNT_ESUCCESS,
+                "Expected %zu nodes of shape %u to sort", count, shape);
+            check_order(count, 0, 0);
+            fill(count, shape);
+            xtnt_sort_table(table, count, xtnt_node_compare_key_reverse);
+            check_order(count, 1, 0);
+        }
+    }
+    ck_assert_msg(xtnt_sort_table(table, 0, NULL) == EINVAL,
+        "Expected a table sort without a comparison to be EINVAL");
+}
+END_TEST
+
+START_TEST (test_xtnt_sort_table_key)
+{
+    for (xtnt_uint_t shape = 0; shape < 5; shape++) {
+        fill(SORT_NODES, shape);
+        ck_assert_msg(xtnt_sort_table_key(table, SORT_NODES, 0) == XTNT_ESUCCESS,
+            "Expected a radix sort of shape %u", shape);
+        check_order(SORT_NODES, 0, 1);
+        fill(SORT_NODES, shape);
+        xtnt_sort_table_key(table, SORT_NODES, 1);
+        check_order(SORT_NODES, 1, 1);
+    }
+    fill(XTNT_SORT_RADIX - 1, 0);
+    xtnt_sort_table_key(table, XTNT_SORT_RADIX - 1, 0);
+    check_order(XTNT_SORT_RADIX - 1, 0, 0);
+}
+END_TEST
+
+START_TEST (test_xtnt_sort_table_parallel)
+{
+    size_t threads[4] = { 2, 3, 7, 16 };
+    for (xtnt_uint_t shape = 0; shape < 5; shape++) {
+        for (size_t idx = 0; idx < 4; idx++) {
+            fill(SORT_NODES - shape, shape);
+            ck_assert_msg(xtnt_sort_table_parallel(table, SORT_NODES - shape, xtnt_node_compare_key,
+                                                   threads[idx], 100) == XTNT_ESUCCESS,
+                "Expected %zu threads to sort shape %u", threads[idx], shape);
+            check_order(SORT_NODES - shape, 0, 1);
+            fill(SORT_NODES - shape, shape);
+            xtnt_sort_table_parallel(table, SORT_NODES - shape, xtnt_node_compare_key_reverse,
+                                     threads[idx], 100);
+            check_order(SORT_NODES - shape, 1, 1);
+            fill(SORT_NODES - shape, shape);
+            xtnt_sort_table_parallel(table, SORT_NODES - shape, compare_key, threads[idx], 100);
+            check_order(SORT_NODES - shape, 0, 0);
+        }
+    }
+    fill(SORT_NODES, 0);
+    xtnt_sort_table_parallel(table, SORT_NODES, compare_key, 0, 0);
+    check_order(SORT_NODES, 0, 0);
+    ck_assert_msg(xtnt_sort_table_parallel(table, SORT_NODES, NULL, 2, 100) == EINVAL,
+        "Expected a parallel sort without a comparison to be EINVAL");
+}
+END_TEST
+
+Suite * xtnt_sort_suite(void)
+{
+    Suite *s;
+    TCase *tc_xtnt_sort;
+
+    s = suite_create("xtnt_sort");
+
+    tc_xtnt_sort = tcase_create("Sort");
+    tcase_add_checked_fixture(tc_xtnt_sort, setup, teardown);
+
+    tcase_add_test(tc_xtnt_sort, test_xtnt_sort_chain);
+    tcase_add_test(tc_xtnt_sort, test_xtnt_sort_table);
+    tcase_add_test(tc_xtnt_sort, test_xtnt_sort_table_key);
+    tcase_add_test(tc_xtnt_sort, test_xtnt_sort_table_parallel);
+    suite_add_tcase(s, tc_xtnt_sort);
+
+    return s;
+}
+
+int main(void)
+{
+    int failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = xtnt_sort_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_VERBOSE);
+    failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (failed == 0) ? 0 : failed;
+}
@@ -149,6 +149,76 @@ START_TEST (test_xtnt_empty_stack_push)
 }
 END_TEST
 
+START_TEST (test_xtnt_stack_set_if)
+{
+    struct xtnt_node_set stack;
+    struct xtnt_node *node = NULL;
+    ck_assert_msg(xtnt_stack_initialize(&stack) == XTNT_ESUCCESS,
+        "Expected the stack to initialize");
+    xtnt_set_push(&stack, &node1q2);
+    xtnt_set_push(&stack, &node2q2);
+    xtnt_set_peek(&stack, &node);
+    ck_assert_msg(node == &node2q2,
+        "Expected xtnt_set_peek to see the last push, but have key=%u", node->key);
+    xtnt_set_pop(&stack, &node);
+    ck_assert_msg(node == &node2q2 && stack.count == 1,
+        "Expected xtnt_set_pop to remove the last push");
+    ck_assert_msg(xtnt_set_sort(&stack) == ENOTSUP,
+        "Expected a stack sort to be ENOTSUP");
+    ck_assert_msg(xtnt_set_search(&stack, 4, &node) == ENOTSUP,
+        "Expected a stack search to be ENOTSUP");
+    xtnt_node_set_uninitialize(&stack);
+}
+END_TEST
+
+START_TEST (test_xtnt_stack_iter)
+{
+    struct xtnt_node_set stack;
+    struct xtnt_set_iter iter;
+    struct xtnt_node *node = NULL;
+    xtnt_uint_t key = 0;
+    xtnt_stack_initialize(&stack);
+    // The bottom member keeps a stale link the cursor must not follow
+    node1q2.link[XTNT_NODE_TAIL] = &node1q1;
+    xtnt_set_push(&stack, &node1q2);
+    xtnt_set_push(&stack, &node2q2);
+    xtnt_set_push(&stack, &node3q2);
+    ck_assert_msg(xtnt_set_iter_begin(&stack, &iter, XTNT_SET_ITER_SNAPSHOT) == XTNT_ESUCCESS,
+        "Expected a cursor on a stack");
+    for (key = 6; xtnt_set_iter_next(&iter, &node) == XTNT_ESUCCESS && node != NULL; key--) {
+        ck_assert_msg(node->key == key, "Expected key %u from the top, but got %u", key, node->key);
+    }
+    xtnt_set_iter_end(&iter);
+    ck_assert_msg(key == 3, "Expected 3 members visited, but stopped at %u", key);
+    xtnt_node_set_uninitialize(&stack);
+}
+END_TEST
+
+START_TEST (test_xtnt_stack_push_chain)
+{
+    struct xtnt_node *batch[2] = { &node2q2, &node3q2 };
+    struct xtnt_node *nodes[8] = { NULL };
+    xtnt_uint_t count = 0;
+    node1q2.link[XTNT_NODE_HEAD] = NULL;
+    ck_assert_msg(xtnt_stack_push_chain(&stack2, &node1q2) == XTNT_ESUCCESS && stack2.count == 1,
+        "Expected a chain of 1 pushed onto an empty stack, but count is %u", stack2.count);
+    ck_assert_msg(xtnt_stack_push_many(&stack2, 2, batch) == XTNT_ESUCCESS && stack2.count == 3,
+        "Expected 3 nodes after pushing 2 more, but count is %u", stack2.count);
+    ck_assert_msg(stack2.root.link[XTNT_NODE_HEAD] == &node3q2 &&
+                  stack2.root.link[XTNT_NODE_TAIL] == &node1q2,
+        "Expected the last node pushed on top");
+    xtnt_stack_pop_batch(&stack2, 2, nodes, &count);
+    ck_assert_msg(count == 2 && nodes[0] == &node3q2 && nodes[1] == &node2q2 && stack2.count == 1,
+        "Expected the two top nodes, but got %u nodes", count);
+    xtnt_stack_pop_batch(&stack2, 8, nodes, &count);
+    ck_assert_msg(count == 1 && nodes[0] == &node1q2,
+        "Expected the bottom node, but got %u nodes", count);
+    xtnt_stack_pop_batch(&stack2, 8, nodes, &count);
+    ck_assert_msg(count == 0 && stack2.root.link[XTNT_NODE_TAIL] == NULL,
+        "Expected no nodes from an empty stack, but got %u", count);
+}
+END_TEST
+
 Suite * xtnt_stack_suite(void)
 {
     Suite *s;
@@ -165,6 +235,9 @@ Suite * xtnt_stack_suite(void)
     tcase_add_test(tc_xtnt_stack, test_xtnt_empty_stack_pop);
     tcase_add_test(tc_xtnt_stack, test_xtnt_stack_push);
     tcase_add_test(tc_xtnt_stack, test_xtnt_empty_stack_push);
+    tcase_add_test(tc_xtnt_stack, test_xtnt_stack_set_if);
+    tcase_add_test(tc_xtnt_stack, test_xtnt_stack_iter);
+    tcase_add_test(tc_xtnt_stack, test_xtnt_stack_push_chain);
     suite_add_tcase(s, tc_xtnt_stack);
 
     return s;
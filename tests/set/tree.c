@@ -0,0 +1,303 @@
+/*
+===============================================================================
+
+This source file is part of libextant
+libextant is made available under the MIT License.
+
+Copyright (c) 2016-2020 Javier Castillo II
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+===============================================================================
+*/
+
+#include <check.h>
+#include <extant/set/tree.h>
+
+#include <stdio.h>
+
+#define TREE_NODES (1024)
+
+struct xtnt_node nodes[TREE_NODES];
+struct xtnt_node_set tree;
+
+/* Verify ordering and coloring, returning black height or -1 on violation */
+xtnt_int_t
+check_rb(struct xtnt_node *node, xtnt_uint_t *count)
+{
+    xtnt_int_t left, right;
+    if (node == NULL) {
+        return 1;
+    }
+    (*count)++;
+    if ((node->link[XTNT_NODE_LEFT] != NULL &&
+         node->link[XTNT_NODE_LEFT]->key >= node->key) ||
+        (node->link[XTNT_NODE_RIGHT] != NULL &&
+         node->link[XTNT_NODE_RIGHT]->key <= node->key)) {
+        return -1;
+    }
+    if (XTNT_TREE_COLOR(node) == XTNT_TREE_RED &&
+        ((node->link[XTNT_NODE_LEFT] != NULL &&
+          XTNT_TREE_COLOR(node->link[XTNT_NODE_LEFT]) == XTNT_TREE_RED) ||
+         (node->link[XTNT_NODE_RIGHT] != NULL &&
+          XTNT_TREE_COLOR(node->link[XTNT_NODE_RIGHT]) == XTNT_TREE_RED))) {
+        return -1;
+    }
+    left = check_rb(node->link[XTNT_NODE_LEFT], count);
+    right = check_rb(node->link[XTNT_NODE_RIGHT], count);
+    if (left < 0 || right < 0 || left != right) {
+        return -1;
+    }
+    return left + ((XTNT_TREE_COLOR(node) == XTNT_TREE_BLACK) ? 1 : 0);
+}
+
+xtnt_uint_t
+match_key(void *ctx, struct xtnt_node *node)
+{
+    return node->key >= *((xtnt_uint_t *) ctx);
+}
+
+void setup(void)
+{
+    xtnt_uint_t i;
+    for (i = 0; i < TREE_NODES; i++) {
+        nodes[i].key = i;
+        nodes[i].value = &nodes[i];
+        nodes[i].link[0] = nodes[i].link[1] = nodes[i].link[2] = NULL;
+        nodes[i].state = 0;
+    }
+    if (xtnt_rbtree_initialize(&tree) != XTNT_ESUCCESS) {
+        ck_abort_msg("Failed to initialize tree in setup.");
+    }
+}
+
+void teardown(void)
+{
+    xtnt_node_set_uninitialize(&tree);
+}
+
+START_TEST (test_xtnt_rbtree_insert)
+{
+    xtnt_uint_t i, count = 0;
+    xtnt_status_t res;
+    for (i = 0; i < TREE_NODES; i++) {
+        res = xtnt_rbtree_insert(&tree, &nodes[i]);
+        ck_assert_msg(res == XTNT_ESUCCESS,
+            "Expected insert of %u to succeed, but got %d", i, res);
+    }
+    ck_assert_msg(tree.count == TREE_NODES,
+        "Expected count of %d, but got %u", TREE_NODES, tree.count);
+    ck_assert_msg(XTNT_TREE_COLOR(tree.root.link[XTNT_NODE_LEFT]) == XTNT_TREE_BLACK,
+        "Expected root to be black");
+    ck_assert_msg(check_rb(tree.root.link[XTNT_NODE_LEFT], &count) > 0,
+        "Expected tree to satisfy red-black invariants");
+    ck_assert_msg(count == TREE_NODES,
+        "Expected %d reachable nodes, but got %u", TREE_NODES, count);
+}
+END_TEST
+
+START_TEST (test_xtnt_rbtree_insert_duplicate)
+{
+    struct xtnt_node dup = { NULL, { NULL, NULL, NULL }, 5, 0, 0 };
+    xtnt_rbtree_insert(&tree, &nodes[5]);
+    ck_assert_msg(xtnt_rbtree_insert(&tree, &dup) == EEXIST,
+        "Expected EEXIST on duplicate key");
+    ck_assert_msg(tree.count == 1,
+        "Expected count of 1, but got %u", tree.count);
+}
+END_TEST
+
+START_TEST (test_xtnt_rbtree_search)
+{
+    struct xtnt_node *found = NULL;
+    xtnt_uint_t i, needle = 701;
+    for (i = 0; i < TREE_NODES; i += 2) {
+        xtnt_rbtree_insert(&tree, &nodes[i]);
+    }
+    xtnt_rbtree_search(&tree, 512, &found);
+    ck_assert_msg(found == &nodes[512],
+        "Expected to find node 512, but got %p", (void *) found);
+    xtnt_rbtree_search(&tree, 513, &found);
+    ck_assert_msg(found == NULL,
+        "Expected NULL for absent key, but got %p", (void *) found);
+    xtnt_set_search(&tree, 42, &found);
+    ck_assert_msg(found == &nodes[42],
+        "Expected interface search to find node 42");
+    xtnt_rbtree_search_fn(&tree, match_key, &needle, &found);
+    ck_assert_msg(found == &nodes[702],
+        "Expected in-order search to find node 702");
+    needle = TREE_NODES;
+    xtnt_rbtree_search_fn(&tree, match_key, &needle, &found);
+    ck_assert_msg(found == NULL,
+        "Expected in-order search without match to give NULL");
+    xtnt_set_first(&tree, &found);
+    ck_assert_msg(found == &nodes[0], "Expected first node to be 0");
+    xtnt_set_last(&tree, &found);
+    ck_assert_msg(found == &nodes[TREE_NODES - 2],
+        "Expected last node to be %d", TREE_NODES - 2);
+}
+END_TEST
+
+START_TEST (test_xtnt_rbtree_delete)
+{
+    struct xtnt_node *deleted = NULL;
+    xtnt_uint_t i, count;
+    for (i = 0; i < TREE_NODES; i++) {
+        xtnt_rbtree_insert(&tree, &nodes[(i * 7) % TREE_NODES]);
+    }
+    for (i = 0; i < TREE_NODES; i += 3) {
+        xtnt_rbtree_delete(&tree, i, &deleted);
+        ck_assert_msg(deleted == &nodes[i],
+            "Expected to delete node %u, but got %p", i, (void *) deleted);
+        count = 0;
+        ck_assert_msg(check_rb(tree.root.link[XTNT_NODE_LEFT], &count) > 0,
+            "Expected tree to satisfy red-black invariants after delete of %u", i);
+        ck_assert_msg(count == tree.count,
+            "Expected %u reachable nodes, but got %u", tree.count, count);
+    }
+    xtnt_rbtree_delete(&tree, 0, &deleted);
+    ck_assert_msg(deleted == NULL, "Expected NULL on deleting absent key");
+    xtnt_set_remove(&tree, &nodes[1]);
+    xtnt_rbtree_search(&tree, 1, &deleted);
+    ck_assert_msg(deleted == NULL, "Expected interface remove to delete 1");
+    for (i = 0; i < TREE_NODES; i++) {
+        xtnt_rbtree_delete(&tree, i, &deleted);
+    }
+    ck_assert_msg(tree.count == 0 && tree.root.link[XTNT_NODE_LEFT] == NULL,
+        "Expected empty tree, but got count %u", tree.count);
+}
+END_TEST
+
+START_TEST (test_xtnt_rbtree_replace)
+{
+    struct xtnt_node *replaced = NULL;
+    struct xtnt_node *found = NULL;
+    struct xtnt_node other = { NULL, { NULL, NULL, NULL }, 2, 0, 0 };
+    xtnt_uint_t i, count = 0;
+    for (i = 0; i < 8; i++) {
+        xtnt_rbtree_insert(&tree, &nodes[i]);
+    }
+    xtnt_rbtree_replace(&tree, &other, &replaced);
+    ck_assert_msg(replaced == &nodes[2], "Expected node 2 to be replaced");
+    xtnt_rbtree_search(&tree, 2, &found);
+    ck_assert_msg(found == &other, "Expected replacement node in tree");
+    ck_assert_msg(check_rb(tree.root.link[XTNT_NODE_LEFT], &count) > 0 &&
+                  count == 8,
+        "Expected tree to satisfy red-black invariants after replace");
+    other.key = 100;
+    xtnt_rbtree_replace(&tree, &other, &replaced);
+    ck_assert_msg(replaced == NULL, "Expected NULL replacing absent key");
+}
+END_TEST
+
+static xtnt_status_t
+stop_at(void *ctx, struct xtnt_node *node)
+{
+    xtnt_uint_t *seen = ctx;
+    seen[1]++;
+    return (node->key == seen[0]) ? ECANCELED : XTNT_ESUCCESS;
+}
+
+START_TEST (test_xtnt_rbtree_range)
+{
+    struct xtnt_set_iter iter;
+    struct xtnt_node *found = NULL;
+    xtnt_uint_t modes[] = { XTNT_SET_ITER_LOCK, XTNT_SET_ITER_SNAPSHOT };
+    xtnt_uint_t seen[2] = { 150, 0 };
+    xtnt_uint_t key = 0;
+    for (xtnt_uint_t i = 0; i < TREE_NODES; i += 2) {
+        xtnt_rbtree_insert(&tree, &nodes[(i * 7) % TREE_NODES]);
+    }
+    xtnt_tree_lower_bound(&tree, 5, &found);
+    ck_assert_msg(found == &nodes[6], "Expected lower bound of 5 to be 6");
+    xtnt_tree_lower_bound(&tree, 6, &found);
+    ck_assert_msg(found == &nodes[6], "Expected lower bound of 6 to be 6");
+    xtnt_tree_upper_bound(&tree, 6, &found);
+    ck_assert_msg(found == &nodes[8], "Expected upper bound of 6 to be 8");
+    xtnt_tree_upper_bound(&tree, TREE_NODES - 2, &found);
+    ck_assert_msg(found == NULL, "Expected no upper bound of the greatest key");
+    for (xtnt_uint_t m = 0; m < 2; m++) {
+        ck_assert_msg(xtnt_set_iter_range(&tree, &iter, 99, 200, modes[m]) == XTNT_ESUCCESS,
+            "Expected a range cursor on a tree");
+        for (key = 100; xtnt_set_iter_next(&iter, &found) == XTNT_ESUCCESS && found != NULL; key += 2) {
+            ck_assert_msg(found->key == key,
+                "Expected key %u in range, but got %u", key, found->key);
+        }
+        ck_assert_msg(key == 202, "Expected the range to end at 200, but ended at %u", key);
+        ck_assert_msg(xtnt_set_iter_end(&iter) == XTNT_ESUCCESS, "Expected the cursor to end");
+    }
+    ck_assert_msg(xtnt_set_iter_begin(&tree, &iter, XTNT_SET_ITER_LOCK) == XTNT_ESUCCESS,
+        "Expected a cursor on a tree");
+    for (key = 0; xtnt_set_iter_next(&iter, &found) == XTNT_ESUCCESS && found != NULL; key += 2) {
+        ck_assert_msg(found->key == key, "Expected key %u, but got %u", key, found->key);
+    }
+    xtnt_set_iter_end(&iter);
+    ck_assert_msg(key == TREE_NODES, "Expected every member visited, but stopped at %u", key);
+    ck_assert_msg(xtnt_set_iter_range(&tree, &iter, 0, TREE_NODES, XTNT_SET_ITER_LOCK) == XTNT_ESUCCESS,
+        "Expected a range cursor from the least key");
+    for (key = 0; xtnt_set_iter_next(&iter, &found) == XTNT_ESUCCESS && found != NULL; key += 2) {
+        ck_assert_msg(found->key == key, "Expected key %u, but got %u", key, found->key);
+    }
+    xtnt_set_iter_end(&iter);
+    ck_assert_msg(key == TREE_NODES, "Expected the range to visit every member, but stopped at %u", key);
+    ck_assert_msg(xtnt_set_iter_range(&tree, &iter, TREE_NODES, TREE_NODES * 2, XTNT_SET_ITER_LOCK) == XTNT_ESUCCESS &&
+                  xtnt_set_iter_next(&iter, &found) == XTNT_ESUCCESS && found == NULL,
+        "Expected no member past the greatest key");
+    xtnt_set_iter_end(&iter);
+    ck_assert_msg(xtnt_set_for_each_range(&tree, 100, 200, stop_at, seen) == ECANCELED &&
+                  seen[1] == 26,
+        "Expected for each to stop at 150 after 26 members, but visited %u", seen[1]);
+}
+END_TEST
+
+Suite * xtnt_rbtree_suite(void)
+{
+    Suite *s;
+    TCase *tc_xtnt_rbtree;
+
+    s = suite_create("xtnt_rbtree");
+
+    tc_xtnt_rbtree = tcase_create("Red-Black Tree");
+
+    tcase_add_checked_fixture(tc_xtnt_rbtree, setup, teardown);
+    tcase_add_test(tc_xtnt_rbtree, test_xtnt_rbtree_insert);
+    tcase_add_test(tc_xtnt_rbtree, test_xtnt_rbtree_insert_duplicate);
+    tcase_add_test(tc_xtnt_rbtree, test_xtnt_rbtree_search);
+    tcase_add_test(tc_xtnt_rbtree, test_xtnt_rbtree_delete);
+    tcase_add_test(tc_xtnt_rbtree, test_xtnt_rbtree_replace);
+    tcase_add_test(tc_xtnt_rbtree, test_xtnt_rbtree_range);
+    suite_add_tcase(s, tc_xtnt_rbtree);
+
+    return s;
+}
+
+int main(void)
+{
+    int failed;
+    Suite *s;
+    SRunner *sr;
+
+    s = xtnt_rbtree_suite();
+    sr = srunner_create(s);
+
+    srunner_run_all(sr, CK_VERBOSE);
+    failed = srunner_ntests_failed(sr);
+    srunner_free(sr);
+    return (failed == 0) ? 0 : failed;
+}
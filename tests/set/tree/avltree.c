@@ -28,78 +28,255 @@ SOFTWARE.
 */
 
 #include <check.h>
-#include <extant/set/stack.h>
+#include <extant/set/tree/avltree.h>
 
 #include <stdio.h>
+#include <stdlib.h>
 
-struct xtnt_node node1t1, node2t1, node3t1, node1t2, node2t2, node3t2;
-struct xtnt_node_set tree1, tree2;
-xtnt_uint_t value1, value2, value3;
+#define TREE_NODES (1024)
+
+struct xtnt_node nodes[TREE_NODES];
+struct xtnt_node_set tree;
+
+/* Verify ordering and balance, returning height or -1 on violation */
+xtnt_int_t
+check_avl(struct xtnt_node *node, xtnt_uint_t *count)
+{
+    xtnt_int_t left, right;
+    if (node == NULL) {
+        return 0;
+    }
+    (*count)++;
+    if ((node->link[XTNT_NODE_LEFT] != NULL &&
+         node->link[XTNT_NODE_LEFT]->key >= node->key) ||
+        (node->link[XTNT_NODE_RIGHT] != NULL &&
+         node->link[XTNT_NODE_RIGHT]->key <= node->key)) {
+        return -1;
+    }
+    left = check_avl(node->link[XTNT_NODE_LEFT], count);
+    right = check_avl(node->link[XTNT_NODE_RIGHT], count);
+    if (left < 0 || right < 0 || right - left != XTNT_AVLTREE_BALANCE(node)) {
+        return -1;
+    }
+    return 1 + ((left > right) ? left : right);
+}
+
+xtnt_uint_t
+match_key(void *ctx, struct xtnt_node *node)
+{
+    return node->key >= *((xtnt_uint_t *) ctx);
+}
 
 void setup(void)
 {
-    node1t1.key = 1;
-    node1t1.value = &value1;
-    node1t1.link[XTNT_NODE_HEAD] = &node2t1;
-    node1t1.link[XTNT_NODE_MIDDLE] = \
-    node1t1.link[XTNT_NODE_TAIL] = NULL;
-
-    node2t1.key = 2;
-    node2t1.value = &value2;
-    node2t1.link[XTNT_NODE_HEAD] = &node3t1;
-    node2t1.link[XTNT_NODE_MIDDLE] = NULL;
-    node2t1.link[XTNT_NODE_TAIL] = &node1t1;
-
-    node3t1.key = 3;
-    node3t1.value = &value3;
-    node3t1.link[XTNT_NODE_HEAD] = \
-    node3t1.link[XTNT_NODE_MIDDLE] = NULL;
-    node3t1.link[XTNT_NODE_TAIL] = &node2t1;
-
-    tree1.root.link[XTNT_NODE_HEAD] = &node3t1;
-    tree1.root.link[XTNT_NODE_MIDDLE] = NULL;
-    tree1.root.link[XTNT_NODE_TAIL] = &node1t1;
-    tree1.count = 3;
-
-    node1t2.key = 4;
-    node1t2.value = &value1;
-    node1t2.link[0] = node1t2.link[1] = node1t2.link[2] = NULL;
-
-    node2t2.key = 5;
-    node2t2.value = &value2;
-    node2t2.link[0] = node2t2.link[1] = node2t2.link[2] = NULL;
-
-    node3t2.key = 6;
-    node3t2.value = &value3;
-    node3t2.link[0] = node3t2.link[1] = node3t2.link[2] = NULL;
-
-    tree2.root.link[XTNT_NODE_HEAD] = NULL;
-    tree2.root.link[XTNT_NODE_MIDDLE] = NULL;
-    tree2.root.link[XTNT_NODE_TAIL] = NULL;
-    tree2.count = 0;
+    xtnt_uint_t i;
+    for (i = 0; i < TREE_NODES; i++) {
+        nodes[i].key = i;
+        nodes[i].value = &nodes[i];
+        nodes[i].link[0] = nodes[i].link[1] = nodes[i].link[2] = NULL;
+        nodes[i].state = 0;
+    }
+    if (xtnt_avltree_initialize(&tree) != XTNT_ESUCCESS) {
+        ck_abort_msg("Failed to initialize tree in setup.");
+    }
 }
 
 void teardown(void)
 {
+    xtnt_node_set_uninitialize(&tree);
+}
+
+START_TEST (test_xtnt_avltree_insert)
+{
+    xtnt_uint_t i, count = 0;
+    xtnt_status_t res;
+    for (i = 0; i < TREE_NODES; i++) {
+        res = xtnt_avltree_insert(&tree, &nodes[i]);
+        ck_assert_msg(res == XTNT_ESUCCESS,
+            "Expected insert of %u to succeed, but got %d", i, res);
+    }
+    ck_assert_msg(tree.count == TREE_NODES,
+        "Expected count of %d, but got %u", TREE_NODES, tree.count);
+    ck_assert_msg(check_avl(tree.root.link[XTNT_NODE_LEFT], &count) > 0,
+        "Expected tree to satisfy AVL invariants");
+    ck_assert_msg(count == TREE_NODES,
+        "Expected %d reachable nodes, but got %u", TREE_NODES, count);
+}
+END_TEST
+
+START_TEST (test_xtnt_avltree_insert_duplicate)
+{
+    struct xtnt_node dup = { NULL, { NULL, NULL, NULL }, 5, 0, 0 };
+    xtnt_avltree_insert(&tree, &nodes[5]);
+    ck_assert_msg(xtnt_avltree_insert(&tree, &dup) == EEXIST,
+        "Expected EEXIST on duplicate key");
+    ck_assert_msg(tree.count == 1,
+        "Expected count of 1, but got %u", tree.count);
+}
+END_TEST
+
+START_TEST (test_xtnt_avltree_insert_overflow)
+{
+    struct xtnt_node_set chain;
+    xtnt_uint_t i;
+    xtnt_status_t res = XTNT_ESUCCESS;
+    /* Link a degenerate chain to exceed the height bound */
+    xtnt_node_set_initialize(&chain);
+    chain.fn = &xtnt_avltree_if;
+    for (i = 0; i < XTNT_TREE_MAX_HEIGHT - 1; i++) {
+        nodes[i].link[XTNT_NODE_RIGHT] = &nodes[i + 1];
+    }
+    chain.root.link[XTNT_NODE_LEFT] = &nodes[0];
+    res = xtnt_avltree_insert(&chain, &nodes[XTNT_TREE_MAX_HEIGHT]);
+    ck_assert_msg(res == EOVERFLOW,
+        "Expected EOVERFLOW beyond max height, but got %d", res);
+    xtnt_node_set_uninitialize(&chain);
+}
+END_TEST
+
+START_TEST (test_xtnt_avltree_insert_height)
+{
+#if XTNT_TREE_MAX_HEIGHT <= 20
+    /* Ascending keys fill a perfect tree, the last that fits the bound */
+    xtnt_uint_t full = ((xtnt_uint_t) 1 << XTNT_TREE_MAX_HEIGHT) - 1;
+    struct xtnt_node *many = calloc(full + 1, sizeof(struct xtnt_node));
+    xtnt_uint_t i, count = 0;
+    xtnt_status_t res = XTNT_ESUCCESS;
+    ck_assert_msg(many != NULL, "Failed to allocate nodes");
+    for (i = 0; i <= full && res == XTNT_ESUCCESS; i++) {
+        many[i].key = i;
+        res = xtnt_avltree_insert(&tree, &many[i]);
+    }
+    ck_assert_msg(res == EOVERFLOW && i == full + 1,
+        "Expected the first insert past a perfect tree to overflow, but got %d at %u", res, i - 1);
+    ck_assert_msg(check_avl(tree.root.link[XTNT_NODE_LEFT], &count) == XTNT_TREE_MAX_HEIGHT &&
+                  count == full && tree.count == full,
+        "Expected a perfect tree of height %d, but have %u members", XTNT_TREE_MAX_HEIGHT, count);
+    free(many);
+#endif /* if XTNT_TREE_MAX_HEIGHT <= 20 */
+}
+END_TEST
+
+START_TEST (test_xtnt_avltree_search)
+{
+    struct xtnt_node *found = NULL;
+    xtnt_uint_t i, needle = 700;
+    for (i = 0; i < TREE_NODES; i += 2) {
+        xtnt_avltree_insert(&tree, &nodes[i]);
+    }
+    xtnt_avltree_search(&tree, 512, &found);
+    ck_assert_msg(found == &nodes[512],
+        "Expected to find node 512, but got %p", (void *) found);
+    xtnt_avltree_search(&tree, 513, &found);
+    ck_assert_msg(found == NULL,
+        "Expected NULL for absent key, but got %p", (void *) found);
+    xtnt_set_search(&tree, 42, &found);
+    ck_assert_msg(found == &nodes[42],
+        "Expected interface search to find node 42");
+    xtnt_avltree_search_fn(&tree, match_key, &needle, &found);
+    ck_assert_msg(found == &nodes[700],
+        "Expected in-order search to find node 700");
+    xtnt_set_first(&tree, &found);
+    ck_assert_msg(found == &nodes[0], "Expected first node to be 0");
+    xtnt_set_last(&tree, &found);
+    ck_assert_msg(found == &nodes[TREE_NODES - 2],
+        "Expected last node to be %d", TREE_NODES - 2);
+}
+END_TEST
+
+START_TEST (test_xtnt_avltree_delete)
+{
+    struct xtnt_node *deleted = NULL;
+    xtnt_uint_t i, count;
+    for (i = 0; i < TREE_NODES; i++) {
+        xtnt_avltree_insert(&tree, &nodes[(i * 7) % TREE_NODES]);
+    }
+    for (i = 0; i < TREE_NODES; i += 3) {
+        xtnt_avltree_delete(&tree, i, &deleted);
+        ck_assert_msg(deleted == &nodes[i],
+            "Expected to delete node %u, but got %p", i, (void *) deleted);
+        count = 0;
+        ck_assert_msg(check_avl(tree.root.link[XTNT_NODE_LEFT], &count) >= 0,
+            "Expected tree to satisfy AVL invariants after delete of %u", i);
+        ck_assert_msg(count == tree.count,
+            "Expected %u reachable nodes, but got %u", tree.count, count);
+    }
+    xtnt_avltree_delete(&tree, 0, &deleted);
+    ck_assert_msg(deleted == NULL, "Expected NULL on deleting absent key");
+    xtnt_set_remove(&tree, &nodes[1]);
+    xtnt_avltree_search(&tree, 1, &deleted);
+    ck_assert_msg(deleted == NULL, "Expected interface remove to delete 1");
+}
+END_TEST
+
+START_TEST (test_xtnt_avltree_replace)
+{
+    struct xtnt_node *replaced = NULL;
+    struct xtnt_node *found = NULL;
+    struct xtnt_node other = { NULL, { NULL, NULL, NULL }, 2, 0, 0 };
+    xtnt_uint_t i, count = 0;
+    for (i = 0; i < 8; i++) {
+        xtnt_avltree_insert(&tree, &nodes[i]);
+    }
+    xtnt_avltree_replace(&tree, &other, &replaced);
+    ck_assert_msg(replaced == &nodes[2], "Expected node 2 to be replaced");
+    xtnt_avltree_search(&tree, 2, &found);
+    ck_assert_msg(found == &other, "Expected replacement node in tree");
+    ck_assert_msg(check_avl(tree.root.link[XTNT_NODE_LEFT], &count) > 0 &&
+                  count == 8,
+        "Expected tree to satisfy AVL invariants after replace");
+    other.key = 100;
+    xtnt_avltree_replace(&tree, &other, &replaced);
+    ck_assert_msg(replaced == NULL, "Expected NULL replacing absent key");
+}
+END_TEST
+
+static xtnt_status_t
+count_ordered(void *ctx, struct xtnt_node *node)
+{
+    xtnt_uint_t *seen = ctx;
+    if (node->key != seen[0]) {
+        return EINVAL;
+    }
+    seen[0]++;
+    return XTNT_ESUCCESS;
 }
 
-START_TEST (test_xtnt_avltree_simple_test)
+START_TEST (test_xtnt_avltree_for_each)
 {
+    xtnt_uint_t seen[1] = { 10 };
+    for (xtnt_uint_t i = 0; i < TREE_NODES; i++) {
+        xtnt_avltree_insert(&tree, &nodes[(i * 7) % TREE_NODES]);
+    }
+    ck_assert_msg(xtnt_set_for_each_range(&tree, 10, 500, count_ordered, seen) == XTNT_ESUCCESS &&
+                  seen[0] == 501,
+        "Expected keys 10 to 500 in order, but stopped at %u", seen[0]);
+    seen[0] = 0;
+    ck_assert_msg(xtnt_set_for_each(&tree, count_ordered, seen) == XTNT_ESUCCESS &&
+                  seen[0] == TREE_NODES,
+        "Expected every key in order, but stopped at %u", seen[0]);
 }
 END_TEST
 
 Suite * xtnt_avltree_suite(void)
 {
     Suite *s;
-    TCase *tc_xtnt_stack;
+    TCase *tc_xtnt_avltree;
 
-    s = suite_create("xtnt_stack");
+    s = suite_create("xtnt_avltree");
 
-    tc_xtnt_stack = tcase_create("Stack");
+    tc_xtnt_avltree = tcase_create("AVL Tree");
 
-    tcase_add_checked_fixture(tc_xtnt_stack, setup, teardown);
-    tcase_add_test(tc_xtnt_stack, test_xtnt_avltree_simple_test);
-    suite_add_tcase(s, tc_xtnt_stack);
+    tcase_add_checked_fixture(tc_xtnt_avltree, setup, teardown);
+    tcase_add_test(tc_xtnt_avltree, test_xtnt_avltree_insert);
+    tcase_add_test(tc_xtnt_avltree, test_xtnt_avltree_insert_duplicate);
+    tcase_add_test(tc_xtnt_avltree, test_xtnt_avltree_insert_overflow);
+    tcase_add_test(tc_xtnt_avltree, test_xtnt_avltree_insert_height);
+    tcase_add_test(tc_xtnt_avltree, test_xtnt_avltree_search);
+    tcase_add_test(tc_xtnt_avltree, test_xtnt_avltree_delete);
+    tcase_add_test(tc_xtnt_avltree, test_xtnt_avltree_replace);
+    tcase_add_test(tc_xtnt_avltree, test_xtnt_avltree_for_each);
+    suite_add_tcase(s, tc_xtnt_avltree);
 
     return s;
 }